@@ -43,6 +43,23 @@ extern "C" {
 #define COLOR_DARK_BLUE   0x0010
 #define COLOR_ICE_BLUE    0x8F1F
 
+// One filled rectangle of a batch
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+    uint16_t color;
+} display_rect_t;
+
+// One string of a batch; `text` must stay valid for the call
+typedef struct {
+    int16_t x;
+    int16_t y;
+    uint16_t color;
+    const char *text;
+} display_text_t;
+
 // Forward declaration for LVGL display
 struct _lv_display_t;
 
@@ -55,6 +72,9 @@ typedef struct {
     void *front_buffer;
     void *back_buffer;
     void *current_buffer;
+    
+    void *driver_data;                  // Backend-private state, NULL when unused
+    const struct display_backend *backend; // Host builds: picked at init; unused on the device
 } display_context_t;
 
 // Display driver functions
@@ -63,6 +83,24 @@ void display_driver_deinit(display_context_t *ctx);
 void display_driver_clear_screen(display_context_t *ctx, uint16_t color);
 void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color);
 void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color);
+// Batched forms of the two calls above: the context is checked and the target
+// set up once for the whole batch. Entries are drawn in order, so later ones
+// cover earlier ones where they overlap.
+void display_driver_draw_rectangles(display_context_t *ctx, const display_rect_t *rects, int count);
+void display_driver_draw_texts(display_context_t *ctx, const display_text_t *texts, int count);
+// Copies a width x height block of RGB565 pixels, stored row after row, clipped to the screen.
+// Pixels are native-endian uint16_t values, the same as the color arguments.
+void display_driver_draw_bitmap(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels);
+// False when a bitmap costs the backend more than the rectangles it was
+// composed of (LVGL turns it into an object per run of a color). Renderers
+// then draw rectangles instead of blitting.
+bool display_driver_blits_bitmaps(display_context_t *ctx);
+// Copies `rows` full-width rows starting at row y, pixels in the same byte
+// order as display_driver_draw_bitmap(). Backends without a frame buffer send
+// them straight to the panel and may still be transferring when this returns:
+// `pixels` must stay untouched until the next call or display_driver_flush()
+// returns.
+void display_driver_push_rows(display_context_t *ctx, int y, int rows, const uint16_t *pixels);
 void display_driver_swap_buffers(display_context_t *ctx);
 void display_driver_flush(display_context_t *ctx);
 void display_driver_task_handler(void);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 8x8 bitmap font of the frame-buffer backends, shared with renderers that
+// compose text themselves. Each glyph is DISPLAY_FONT_HEIGHT bytes, one per
+// row, with the leftmost pixel in the least significant bit.
+#define DISPLAY_FONT_WIDTH  8
+#define DISPLAY_FONT_HEIGHT 8
+
+// Horizontal run of set pixels in one row of a glyph
+typedef struct {
+    uint8_t row;
+    uint8_t x;
+    uint8_t width;
+} display_font_span_t;
+
+// Returns the glyph of `ch`, lowercase letters drawn as uppercase, or NULL
+// for characters the font does not have
+const uint8_t *display_font_glyph(char ch);
+// The set pixels of `ch` as spans, top row first and left to right within a
+// row. Returns the number of spans; 0 and NULL for characters the font does
+// not have. Drawing them is equivalent to drawing every set bit.
+int display_font_glyph_spans(char ch, const display_font_span_t **spans);
+
+#ifdef __cplusplus
+}
+#endif
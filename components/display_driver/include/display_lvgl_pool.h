@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Retained LVGL objects behind the LVGL backend's immediate-mode drawing.
+// Each frame's rectangles and strings are mapped, in call order, onto objects
+// kept from earlier frames: only the position, size, color or text that
+// differs from what an object already shows is set, objects the frame did not
+// use are hidden, and new objects are only created while the frame uses more
+// than any frame before. Object count and LVGL heap use stop growing once the
+// busiest frame has been drawn.
+//
+// A frame that clears the screen starts over with the first objects. One that
+// does not, such as the game over text, draws over what the last cleared
+// frame showed; its own objects last until the next frame, which is expected
+// to draw them again.
+//
+// Rectangles sit on one full-screen layer and strings on another above it, so
+// text stays on top whatever order objects were first created in.
+#define DISPLAY_LVGL_POOL_RECTS  256   // Further rectangles in a frame are dropped
+#define DISPLAY_LVGL_POOL_LABELS 8     // Further strings in a frame are dropped
+
+typedef struct {
+    uint32_t frames;
+    uint32_t created;                  // Objects created, layers excluded
+    uint32_t updates;                  // Position, size, color and text changes
+    uint32_t hidden;                   // Objects hidden at the end of a frame
+    uint32_t dropped;                  // Draws past the pool size
+    uint16_t rects;                    // Rectangle objects held
+    uint16_t labels;                   // Label objects held
+} display_lvgl_pool_stats_t;
+
+// Creates the two layers on `screen`. Returns false if LVGL could not.
+bool display_lvgl_pool_init(lv_obj_t *screen);
+// Deletes the layers and every object on them
+void display_lvgl_pool_deinit(void);
+
+// Starts a frame over the last cleared one: the next draw reuses the first
+// object past what that frame showed
+void display_lvgl_pool_begin_frame(void);
+// The screen was cleared: the frame's next draw reuses the first object again
+void display_lvgl_pool_clear(void);
+// Hides the objects the frame did not draw with, then starts a new frame
+void display_lvgl_pool_end_frame(void);
+
+// RGB565 colors, converted as the driver always has. Return false when the
+// pool is full or LVGL is out of memory and nothing was drawn.
+bool display_lvgl_pool_rect(int x, int y, int width, int height, uint16_t color);
+bool display_lvgl_pool_text(int x, int y, const char *text, uint16_t color);
+
+void display_lvgl_pool_get_stats(display_lvgl_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SPI link to the ST7789v2 panel used by the LVGL backend: bus setup, reset,
+// the init sequence and pixel transfers. Coordinates are display coordinates;
+// the panel offsets are added here. Free of LVGL so it can also be built on
+// the host against the bus emulator.
+
+// ST7789 commands
+#define ST7789_SWRESET   0x01
+#define ST7789_RDDID     0x04
+#define ST7789_RDDST     0x09
+#define ST7789_RDDPM     0x0A
+#define ST7789_RDDCOLMOD 0x0C
+#define ST7789_SLPIN     0x10
+#define ST7789_SLPOUT    0x11
+#define ST7789_INVOFF    0x20
+#define ST7789_INVON     0x21
+#define ST7789_DISPOFF   0x28
+#define ST7789_DISPON    0x29
+#define ST7789_CASET     0x2A
+#define ST7789_RASET     0x2B
+#define ST7789_RAMWR     0x2C
+#define ST7789_MADCTL    0x36
+#define ST7789_COLMOD    0x3A
+#define ST7789_RAMWRC    0x3C
+
+// Pixel format written by display_st7789_write_area(): RGB565, 16 bits per pixel
+#define ST7789_COLMOD_RGB565 0x55
+
+// Sets up the SPI bus and control pins, resets the panel and runs the init
+// sequence. Returns false, with everything released again, if the bus fails.
+bool display_st7789_open(void);
+void display_st7789_close(void);
+
+// One command and its parameters
+void display_st7789_command(uint8_t cmd, const uint8_t *params, size_t len);
+uint8_t display_st7789_read_register(uint8_t reg);
+// Sets the window and writes width x height pixels into it. `pixels` are
+// RGB565 in the panel's byte order, high byte first.
+void display_st7789_write_area(int x, int y, int width, int height, const uint16_t *pixels);
+
+// Called from the post-transaction hook, in interrupt context on the ESP32,
+// once the last pixel of a queued area is on the bus
+typedef void (*display_st7789_done_cb_t)(void *arg);
+
+// Queues the window commands and pixels of an area behind anything already
+// queued, so areas go out back to back, and returns without waiting for the
+// bus. It only blocks while every pooled transaction is in flight, until the
+// oldest one is sent. `pixels` is read by the bus until `done` runs, once,
+// from the post-transaction hook of the area's pixel transaction; with no
+// `done`, it may be reused after display_st7789_wait_idle(). Returns false,
+// and `done` is not called, if the area could not be queued.
+bool display_st7789_queue_area(int x, int y, int width, int height, const uint16_t *pixels,
+                               display_st7789_done_cb_t done, void *arg);
+// Waits for queued transactions to finish and collects them. The blocking
+// calls above do this themselves.
+void display_st7789_wait_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
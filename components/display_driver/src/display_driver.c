@@ -1,10 +1,12 @@
 #include "display_driver.h"
+#include "display_st7789.h"
+#include "display_lvgl_pool.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include <string.h>
 #include <stdlib.h>
-#include "esp_rom_gpio.h"
 
 #include "lvgl.h"
 
@@ -20,17 +22,12 @@ static lv_color_t *buf2 = NULL;
 static lv_obj_t *canvas = NULL;
 static lv_color_t *canvas_buf = NULL;
 
-// SPI handle for communication
-static spi_device_handle_t spi_handle = NULL;
+// Runs of a bitmap still growing downwards, and those of the current row
+static display_rect_t bitmap_open[DISPLAY_WIDTH];
+static display_rect_t bitmap_next[DISPLAY_WIDTH];
 
-// Function prototypes for LVGL callbacks and ST7789 communication
+// Function prototypes for LVGL callbacks
 static void lvgl_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
-static void display_spi_write_cmd(uint8_t cmd);
-static void display_spi_write_data(const uint8_t *data, size_t len);
-static uint8_t display_spi_read_data(void);
-static uint8_t display_read_register(uint8_t reg);
-static void display_set_window(int x, int y, int width, int height);
-static void display_init_st7789(void);
 
 bool display_driver_init(display_context_t *ctx) {
     if (!ctx) {
@@ -47,75 +44,10 @@ bool display_driver_init(display_context_t *ctx) {
     ESP_LOGI(TAG, "Waiting for display power stabilization...");
     vTaskDelay(pdMS_TO_TICKS(50));
 
-    // Initialize SPI bus configuration
-    spi_bus_config_t buscfg = {
-        .mosi_io_num = TFT_MOSI_PIN,
-        .miso_io_num = TFT_MISO_PIN, // Set to actual MISO pin number
-        .sclk_io_num = TFT_CLK_PIN,
-        .quadwp_io_num = -1,
-        .quadhd_io_num = -1,
-        .max_transfer_sz = DISPLAY_WIDTH * 64 * 2, // Match LVGL buffer size
-    };
-
-    // Initialize SPI device configuration for ST7789 compatibility
-    spi_device_interface_config_t devcfg = {
-        .clock_speed_hz = 10 * 1000 * 1000, // Reduced to 10 MHz for reliability
-        .mode = 0,  // SPI Mode 0 (CPOL=0, CPHA=0) - ST7789 standard
-        .spics_io_num = TFT_CS_PIN,
-        .queue_size = 7,
-        .flags = SPI_DEVICE_HALFDUPLEX | SPI_DEVICE_NO_DUMMY,  // Half-duplex, no dummy phase
-        .command_bits = 0,
-        .address_bits = 0,
-        .dummy_bits = 16, // ST7789 requires 16 dummy bits for reads
-        .duty_cycle_pos = 128,  // 50% duty cycle
-    };
-    
-    ESP_LOGI(TAG, "SPI Config: Clock=%lu Hz, Mode=%d, CS=GPIO%d, Flags=0x%08lX", 
-             devcfg.clock_speed_hz, devcfg.mode, devcfg.spics_io_num, devcfg.flags);
-
-    // Initialize SPI bus (use VSPI_HOST for compatibility)
-    esp_err_t ret = spi_bus_initialize(VSPI_HOST, &buscfg, SPI_DMA_CH_AUTO);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
-        return false;
-    }
-
-    // Add device to SPI bus (use VSPI_HOST)
-    ret = spi_bus_add_device(VSPI_HOST, &devcfg, &spi_handle);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
-        spi_bus_free(VSPI_HOST);
+    // SPI bus, control pins, panel reset and init sequence
+    if (!display_st7789_open()) {
         return false;
     }
-
-    // Configure DC and RST pins
-    gpio_config_t io_conf = {};
-    io_conf.intr_type = GPIO_INTR_DISABLE;
-    io_conf.mode = GPIO_MODE_OUTPUT;
-    io_conf.pin_bit_mask = (1ULL << TFT_DC_PIN) | (1ULL << TFT_RST_PIN);
-    io_conf.pull_down_en = 0;
-    io_conf.pull_up_en = 1;  // Enable pull-up for more reliable signaling
-    gpio_config(&io_conf);
-
-    ESP_LOGI(TAG, "Starting display reset sequence...");
-    
-    // Extended reset sequence for ST7789 reliability
-    // Start with reset high
-    gpio_set_level(TFT_RST_PIN, 1);
-    vTaskDelay(pdMS_TO_TICKS(10));
-    
-    // Assert reset (low) for longer period
-    gpio_set_level(TFT_RST_PIN, 0);
-    vTaskDelay(pdMS_TO_TICKS(50));  // Increased from 10ms to 50ms
-    
-    // Deassert reset and wait longer for startup
-    gpio_set_level(TFT_RST_PIN, 1);
-    vTaskDelay(pdMS_TO_TICKS(200)); // Increased from 120ms to 200ms
-    
-    ESP_LOGI(TAG, "Display reset sequence complete");
-
-    // Initialize ST7789 display
-    display_init_st7789();
     
     // Verify ST7789 communication by reading some registers
     ESP_LOGI(TAG, "Verifying ST7789 communication...");
@@ -124,10 +56,10 @@ bool display_driver_init(display_context_t *ctx) {
     // Add delay before first read
     vTaskDelay(pdMS_TO_TICKS(10));
     
-    uint8_t reg04 = display_read_register(0x04); // Read Display ID
-    uint8_t reg09 = display_read_register(0x09); // Read Display Status  
-    uint8_t reg0A = display_read_register(0x0A); // Read Display Power Mode
-    uint8_t reg0C = display_read_register(0x0C); // Read Display Pixel Format
+    uint8_t reg04 = display_st7789_read_register(0x04); // Read Display ID
+    uint8_t reg09 = display_st7789_read_register(0x09); // Read Display Status  
+    uint8_t reg0A = display_st7789_read_register(0x0A); // Read Display Power Mode
+    uint8_t reg0C = display_st7789_read_register(0x0C); // Read Display Pixel Format
     
     ESP_LOGI(TAG, "Register readback results: 0x04=0x%02X, 0x09=0x%02X, 0x0A=0x%02X, 0x0C=0x%02X", 
              reg04, reg09, reg0A, reg0C);
@@ -148,8 +80,7 @@ bool display_driver_init(display_context_t *ctx) {
         ESP_LOGE(TAG, "Failed to allocate LVGL display buffers");
         if (buf1) free(buf1);
         if (buf2) free(buf2);
-        spi_bus_remove_device(spi_handle);
-        spi_bus_free(VSPI_HOST);
+        display_st7789_close();
         return false;
     }
 
@@ -170,8 +101,17 @@ bool display_driver_init(display_context_t *ctx) {
         ESP_LOGE(TAG, "Failed to register LVGL display driver");
         free(buf1);
         free(buf2);
-        spi_bus_remove_device(spi_handle);
-        spi_bus_free(VSPI_HOST);
+        display_st7789_close();
+        return false;
+    }
+
+    // Objects the drawing calls are mapped onto, reused from frame to frame
+    if (!display_lvgl_pool_init(lv_scr_act())) {
+        ESP_LOGE(TAG, "Failed to create LVGL object pool");
+        lvgl_display = NULL;
+        free(buf1);
+        free(buf2);
+        display_st7789_close();
         return false;
     }
 
@@ -181,6 +121,7 @@ bool display_driver_init(display_context_t *ctx) {
 
     // Store the LVGL display in context for compatibility
     ctx->lvgl_display = (struct _lv_display_t *)lvgl_display;
+    ctx->driver_data = NULL;
     ctx->initialized = true;
 
     ESP_LOGI(TAG, "LVGL display driver initialized successfully");
@@ -204,7 +145,11 @@ void display_driver_deinit(display_context_t *ctx) {
         canvas = NULL;
     }
 
-    // Free LVGL buffers
+    // Delete the pooled drawing objects
+    display_lvgl_pool_deinit();
+
+    // Free LVGL buffers once a queued flush no longer reads them
+    display_st7789_wait_idle();
     if (buf1) {
         free(buf1);
         buf1 = NULL;
@@ -218,11 +163,7 @@ void display_driver_deinit(display_context_t *ctx) {
     lvgl_display = NULL;
 
     // Remove SPI device and free bus
-    if (spi_handle) {
-        spi_bus_remove_device(spi_handle);
-        spi_bus_free(VSPI_HOST);
-        spi_handle = NULL;
-    }
+    display_st7789_close();
 
     ctx->initialized = false;
     ESP_LOGI(TAG, "Display driver deinitialized");
@@ -272,6 +213,10 @@ void display_driver_clear_screen(display_context_t *ctx, uint16_t color) {
     
     // Force LVGL to invalidate and refresh
     lv_obj_invalidate(lv_scr_act());
+
+    // Everything drawn so far is covered: drawing starts over with the first
+    // pooled objects
+    display_lvgl_pool_clear();
     
     ESP_LOGI(TAG, "Background color set and screen invalidated");
 }
@@ -281,20 +226,90 @@ void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int wid
         return;
     }
 
-    // Convert RGB565 to LVGL color - use reliable lv_color_hex
-    lv_color_t lv_color = lv_color_hex(color);
-    
-    // Create a rectangle object
-    lv_obj_t *rect = lv_obj_create(lv_scr_act());
-    lv_obj_set_pos(rect, x, y);
-    lv_obj_set_size(rect, width, height);
-    
-    // Set rectangle style
-    lv_obj_set_style_bg_color(rect, lv_color, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(rect, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(rect, 0, LV_PART_MAIN);
-    lv_obj_set_style_radius(rect, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(rect, 0, LV_PART_MAIN);
+    // Reuse this frame's next rectangle object, or create one
+    display_lvgl_pool_rect(x, y, width, height, color);
+}
+
+void display_driver_draw_rectangles(display_context_t *ctx, const display_rect_t *rects, int count) {
+    if (!ctx || !ctx->initialized || !rects) {
+        return;
+    }
+
+    // Every rectangle is its own pooled LVGL object, so there is nothing to share
+    for (int i = 0; i < count; i++) {
+        display_driver_draw_rectangle(ctx, rects[i].x, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
+    }
+}
+
+void display_driver_draw_bitmap(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels) {
+    if (!ctx || !ctx->initialized || !pixels) {
+        return;
+    }
+
+    // Only the part on the screen becomes objects
+    int x0 = (x < 0) ? 0 : x;
+    int y0 = (y < 0) ? 0 : y;
+    int x1 = (x + width > DISPLAY_WIDTH) ? DISPLAY_WIDTH : x + width;
+    int y1 = (y + height > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT : y + height;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    // LVGL objects have no raw pixel path here, so each run of one color is a
+    // rectangle object. The runs of a row cover it without gaps, and a run
+    // that repeats the one above it, same columns and color, extends that
+    // rectangle down instead.
+    int open_count = 0;
+    for (int row = y0; row < y1; row++) {
+        const uint16_t *line = pixels + (size_t)(row - y) * width;
+        int next_count = 0;
+        int open = 0;
+        int start = x0;
+        for (int col = x0 + 1; col <= x1; col++) {
+            if (col < x1 && line[col - x] == line[start - x]) {
+                continue;
+            }
+
+            uint16_t color = line[start - x];
+            while (open < open_count && bitmap_open[open].x < start) {
+                const display_rect_t *done = &bitmap_open[open++];
+                display_lvgl_pool_rect(done->x, done->y, done->width, done->height, done->color);
+            }
+            display_rect_t *run = &bitmap_next[next_count++];
+            if (open < open_count && bitmap_open[open].x == start && bitmap_open[open].width == col - start &&
+                bitmap_open[open].color == color) {
+                *run = bitmap_open[open++];
+                run->height++;
+            } else {
+                run->x = (int16_t)start;
+                run->y = (int16_t)row;
+                run->width = (int16_t)(col - start);
+                run->height = 1;
+                run->color = color;
+            }
+            start = col;
+        }
+        while (open < open_count) {
+            const display_rect_t *done = &bitmap_open[open++];
+            display_lvgl_pool_rect(done->x, done->y, done->width, done->height, done->color);
+        }
+        memcpy(bitmap_open, bitmap_next, next_count * sizeof(display_rect_t));
+        open_count = next_count;
+    }
+    for (int i = 0; i < open_count; i++) {
+        const display_rect_t *done = &bitmap_open[i];
+        display_lvgl_pool_rect(done->x, done->y, done->width, done->height, done->color);
+    }
+}
+
+// Bitmaps become objects, many more than the rectangles they were composed of
+bool display_driver_blits_bitmaps(display_context_t *ctx) {
+    (void)ctx;
+    return false;
+}
+
+void display_driver_push_rows(display_context_t *ctx, int y, int rows, const uint16_t *pixels) {
+    display_driver_draw_bitmap(ctx, 0, y, DISPLAY_WIDTH, rows, pixels);
 }
 
 void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
@@ -302,18 +317,18 @@ void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *
         return;
     }
 
-    // Convert RGB565 to LVGL color - use reliable lv_color_hex
-    lv_color_t lv_color = lv_color_hex(color);
-    
-    // Create a label for text
-    lv_obj_t *label = lv_label_create(lv_scr_act());
-    lv_obj_set_pos(label, x, y);
-    lv_label_set_text(label, text);
-    
-    // Set text color and remove padding
-    lv_obj_set_style_text_color(label, lv_color, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(label, 0, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(label, LV_OPA_TRANSP, LV_PART_MAIN);
+    // Reuse this frame's next label, or create one
+    display_lvgl_pool_text(x, y, text, color);
+}
+
+void display_driver_draw_texts(display_context_t *ctx, const display_text_t *texts, int count) {
+    if (!ctx || !ctx->initialized || !texts) {
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        display_driver_draw_text(ctx, texts[i].x, texts[i].y, texts[i].text, texts[i].color);
+    }
 }
 
 void display_driver_swap_buffers(display_context_t *ctx) {
@@ -332,252 +347,41 @@ void display_driver_flush(display_context_t *ctx) {
     // LVGL handles refresh automatically through lv_timer_handler()
     // Manual refresh can interfere with LVGL's internal timing
     // The timer handler in main loop will trigger refreshes as needed
+
+    // The frame is complete: hide the pooled objects it did not draw with
+    display_lvgl_pool_end_frame();
+}
+
+// Runs in the SPI interrupt once a queued flush has been sent
+static void lvgl_flush_done(void *arg) {
+    lv_disp_flush_ready((lv_disp_drv_t *)arg);
 }
 
 // LVGL flush callback for ST7789 communication
 static void lvgl_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
-    if (!spi_handle || !area || !color_p) {
-        ESP_LOGE(TAG, "Flush callback: Invalid parameters (spi_handle=%p, area=%p, color_p=%p)", 
-                 spi_handle, area, color_p);
+    if (!area || !color_p) {
+        ESP_LOGE(TAG, "Flush callback: Invalid parameters (area=%p, color_p=%p)", area, color_p);
         lv_disp_flush_ready(disp_drv);
         return;
     }
 
-    // Debug: Log flush operations to verify data is being sent
+    // Debug: Log flush operations to verify data is being sent. Debug level:
+    // printing every flush over the UART costs more than the transfer.
     size_t pixel_count = lv_area_get_size(area);
-    ESP_LOGI(TAG, "FLUSH CALLED: area (%d,%d) to (%d,%d), %d pixels, first_pixel=0x%04X", 
+    ESP_LOGD(TAG, "FLUSH CALLED: area (%d,%d) to (%d,%d), %d pixels, first_pixel=0x%04X", 
              area->x1, area->y1, area->x2, area->y2, pixel_count, 
              pixel_count > 0 ? *(uint16_t*)color_p : 0);
-    
-    // Hex dump first 16 bytes of pixel data
-    if (pixel_count > 0) {
-        uint8_t *data = (uint8_t *)color_p;
-        ESP_LOGI(TAG, "SPI Data Hex: %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X %02X",
-                 data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7],
-                 data[8], data[9], data[10], data[11], data[12], data[13], data[14], data[15]);
-        
-        // Also show as 16-bit RGB565 values  
-        uint16_t *pixels = (uint16_t *)color_p;
-        ESP_LOGI(TAG, "RGB565 Values: 0x%04X 0x%04X 0x%04X 0x%04X 0x%04X 0x%04X 0x%04X 0x%04X",
-                 pixels[0], pixels[1], pixels[2], pixels[3], pixels[4], pixels[5], pixels[6], pixels[7]);
-    }
-
-    // Set window for the area to be flushed
-    display_set_window(area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area));
-
-    // Memory write (0x2C)
-    display_spi_write_cmd(0x2C);
-
-    // Send pixel data
-    size_t buf_size = pixel_count * sizeof(lv_color_t);
-    display_spi_write_data((uint8_t *)color_p, buf_size);
-    
-    ESP_LOGI(TAG, "Sent %d bytes to SPI", buf_size);
-
-    // Tell LVGL that flushing is done
-    lv_disp_flush_ready(disp_drv);
-}
-
-// Helper functions for SPI communication with proper timing
-static void display_spi_write_cmd(uint8_t cmd) {
-    if (!spi_handle) return;
-    
-    // Set DC low for command mode
-    gpio_set_level(TFT_DC_PIN, 0);
-    // Small delay to ensure DC line is stable
-    esp_rom_delay_us(1);
-    
-    spi_transaction_t trans = {
-        .length = 8,
-        .tx_buffer = &cmd,
-    };
-    
-    esp_err_t ret = spi_device_transmit(spi_handle, &trans);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "SPI command transmission failed: %s", esp_err_to_name(ret));
-    }
-    
-    // Small delay after command
-    esp_rom_delay_us(1);
-}
-
-static void display_spi_write_data(const uint8_t *data, size_t len) {
-    if (!spi_handle || !data || len == 0) return;
-    
-    // Set DC high for data mode
-    gpio_set_level(TFT_DC_PIN, 1);
-    // Small delay to ensure DC line is stable
-    esp_rom_delay_us(1);
-    
-    spi_transaction_t trans = {
-        .length = len * 8,
-        .tx_buffer = data,
-    };
-    
-    esp_err_t ret = spi_device_transmit(spi_handle, &trans);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "SPI data transmission failed: %s", esp_err_to_name(ret));
-    }
-    
-    // Small delay after data
-    esp_rom_delay_us(1);
-}
 
-static uint8_t display_spi_read_data(void) {
-    if (!spi_handle) return 0;
-
-    // Set DC high for data mode
-    gpio_set_level(TFT_DC_PIN, 1);
-    esp_rom_delay_us(1);
-
-    uint8_t rx_data = 0;
-    spi_transaction_t trans = {
-        .flags = 0,
-        .length = 8,
-        .rxlength = 8,
-        .rx_buffer = &rx_data,
-        .tx_buffer = NULL
-    };
-
-    esp_err_t ret = spi_device_transmit(spi_handle, &trans);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "SPI read transmission failed: %s", esp_err_to_name(ret));
-        return 0;
+    // Queue the window and pixel data and return, so LVGL renders into the
+    // other buffer while this one is sent. LVGL is told the flush is done
+    // from the SPI post-transaction hook.
+    if (!display_st7789_queue_area(area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area),
+                                   (const uint16_t *)color_p, lvgl_flush_done, disp_drv)) {
+        lv_disp_flush_ready(disp_drv);
+        return;
     }
-
-    esp_rom_delay_us(1);
-    return rx_data;
-}
-
-static uint8_t display_read_register(uint8_t reg) {
-    if (!spi_handle) return 0;
-
-    ESP_LOGI(TAG, "Reading ST7789 register 0x%02X", reg);
-
-    // Send read command (DC low)
-    gpio_set_level(TFT_DC_PIN, 0);
-    esp_rom_delay_us(2);
-    display_spi_write_cmd(reg);
-    esp_rom_delay_us(2);
-
-    // Set DC high for data phase
-    gpio_set_level(TFT_DC_PIN, 1);
-    esp_rom_delay_us(2);
-
-    // Read response with dummy bits
-    uint8_t result = display_spi_read_data();
-
-    ESP_LOGI(TAG, "Register 0x%02X = 0x%02X", reg, result);
-    vTaskDelay(pdMS_TO_TICKS(2)); // Datasheet recommends short delay after read
-    return result;
-}
-
-static void display_set_window(int x, int y, int width, int height) {
-    if (!spi_handle) return;
     
-    // Apply M5StickC Plus display offsets
-    uint16_t x1 = x + DISPLAY_OFFSET_X;
-    uint16_t x2 = x + width - 1 + DISPLAY_OFFSET_X;
-    uint16_t y1 = y + DISPLAY_OFFSET_Y;
-    uint16_t y2 = y + height - 1 + DISPLAY_OFFSET_Y;
-
-    ESP_LOGD(TAG, "Setting window: (%d,%d)+offset -> (%d,%d) to (%d,%d)", 
-             x, y, x1, y1, x2, y2);
-
-    // Column address set (0x2A)
-    display_spi_write_cmd(0x2A);
-    uint8_t caset_data[4] = {x1 >> 8, x1 & 0xFF, x2 >> 8, x2 & 0xFF};
-    display_spi_write_data(caset_data, 4);
-
-    // Row address set (0x2B)
-    display_spi_write_cmd(0x2B);
-    uint8_t raset_data[4] = {y1 >> 8, y1 & 0xFF, y2 >> 8, y2 & 0xFF};
-    display_spi_write_data(raset_data, 4);
-}
-
-// ST7789 display initialization sequence with proper timing
-static void display_init_st7789(void) {
-    ESP_LOGI(TAG, "Starting ST7789 initialization sequence...");
-
-    // Software reset
-    ESP_LOGI(TAG, "Sending software reset command...");
-    display_spi_write_cmd(0x01); // SWRESET
-    vTaskDelay(pdMS_TO_TICKS(130)); // 130ms per working example
-
-    // Sleep out
-    ESP_LOGI(TAG, "Sending sleep out command...");
-    display_spi_write_cmd(0x11); // SLPOUT
-    vTaskDelay(pdMS_TO_TICKS(130)); // 130ms per working example
-
-    // Porch control
-    display_spi_write_cmd(0xB2); // PORCTRL
-    uint8_t porctrl_data[] = {0x0C, 0x0C, 0x00, 0x33, 0x33};
-    display_spi_write_data(porctrl_data, sizeof(porctrl_data));
-
-    // Gate control
-    display_spi_write_cmd(0xB7); // GCTRL
-    uint8_t gctrl_data = 0x35;
-    display_spi_write_data(&gctrl_data, 1);
-
-    // VCOM setting
-    display_spi_write_cmd(0xBB); // VCOMS
-    uint8_t vcoms_data = 0x28;
-    display_spi_write_data(&vcoms_data, 1);
-
-    // LCM control
-    display_spi_write_cmd(0xC0); // LCMCTRL
-    uint8_t lcmctrl_data = 0x0C;
-    display_spi_write_data(&lcmctrl_data, 1);
-
-    // VDV and VRH command enable
-    display_spi_write_cmd(0xC2); // VDVVRHEN
-    uint8_t vdvvrhen_data[] = {0x01, 0xFF};
-    display_spi_write_data(vdvvrhen_data, 2);
-
-    // VRHS set
-    display_spi_write_cmd(0xC3); // VRHS
-    uint8_t vrhs_data = 0x10;
-    display_spi_write_data(&vrhs_data, 1);
-
-    // VDV setting
-    display_spi_write_cmd(0xC4); // VDVSET
-    uint8_t vdvset_data = 0x20;
-    display_spi_write_data(&vdvset_data, 1);
-
-    // FR Control 2
-    display_spi_write_cmd(0xC6); // FRCTR2
-    uint8_t frctr2_data = 0x0F;
-    display_spi_write_data(&frctr2_data, 1);
-
-    // Power control 1
-    display_spi_write_cmd(0xD0); // PWCTRL1
-    uint8_t pwctrl1_data[] = {0xA4, 0xA1};
-    display_spi_write_data(pwctrl1_data, 2);
-
-    // RAM control
-    display_spi_write_cmd(0xB0); // RAMCTRL
-    uint8_t ramctrl_data[] = {0x00, 0xC0};
-    display_spi_write_data(ramctrl_data, 2);
-
-    // Positive voltage gamma control
-    display_spi_write_cmd(0xE0); // PVGAMCTRL
-    uint8_t pvgamctrl_data[] = {0xD0,0x00,0x02,0x07,0x0A,0x28,0x32,0x44,0x42,0x06,0x0E,0x12,0x14,0x17};
-    display_spi_write_data(pvgamctrl_data, 14);
-
-    // Negative voltage gamma control
-    display_spi_write_cmd(0xE1); // NVGAMCTRL
-    uint8_t nvgamctrl_data[] = {0xD0,0x00,0x02,0x07,0x0A,0x28,0x31,0x54,0x47,0x0E,0x1C,0x17,0x1B,0x1E};
-    display_spi_write_data(nvgamctrl_data, 14);
-
-    // Sleep out (again, per working example)
-    display_spi_write_cmd(0x11); // SLPOUT
-    vTaskDelay(pdMS_TO_TICKS(130));
-
-    // Display on
-    display_spi_write_cmd(0x29); // DISPON
-    vTaskDelay(pdMS_TO_TICKS(10));
-
-    ESP_LOGI(TAG, "ST7789 display initialization complete");
+    ESP_LOGD(TAG, "Queued %d bytes to SPI", pixel_count * sizeof(lv_color_t));
 }
 
 // LVGL timer handler - should be called regularly in main loop
@@ -1,13 +1,18 @@
 #include "display_driver.h"
+#include "display_font.h"
 #include "esp_log.h"
+#include "sdkconfig.h"
 
 // Use M5Unified display stack
 #include <M5Unified.h>
 
 static const char *TAG = "display_driver_m5";
 
-// Use an off-screen sprite as a back buffer to avoid flicker
+// Use an off-screen sprite as a back buffer to avoid flicker. The banded
+// configuration has none: frames arrive as rows through push_rows.
 static lgfx::LGFX_Sprite* s_sprite = nullptr;
+// A push_rows DMA transfer may still be running
+static bool s_rows_pending = false;
 
 extern "C" {
 
@@ -26,17 +31,19 @@ bool display_driver_init(display_context_t *ctx) {
 
     // Set 16-bit color depth and sane defaults
     M5.Display.setColorDepth(16);
-    M5.Display.setTextSize(1);
-    // Transparent text background (single-arg variant)
-    M5.Display.setTextColor(TFT_WHITE);
+    // Bitmaps and pushed rows hold native-endian RGB565 like the color
+    // arguments; LovyanGFX otherwise reads uint16_t images as byte-swapped
+    M5.Display.setSwapBytes(true);
 
     // Clear screen
     M5.Display.fillScreen(TFT_BLACK);
 
+#ifndef CONFIG_DISPLAY_DRIVER_BANDED
     // Create sprite back buffer
     if (!s_sprite) {
         s_sprite = new lgfx::LGFX_Sprite(&M5.Display);
         s_sprite->setColorDepth(16);
+        s_sprite->setSwapBytes(true);
         if (!s_sprite->createSprite(DISPLAY_WIDTH, DISPLAY_HEIGHT)) {
             ESP_LOGE(TAG, "Failed to create sprite %dx%d", DISPLAY_WIDTH, DISPLAY_HEIGHT);
             delete s_sprite;
@@ -45,12 +52,14 @@ bool display_driver_init(display_context_t *ctx) {
             s_sprite->fillScreen(TFT_BLACK);
         }
     }
+#endif
 
     ctx->lvgl_display = nullptr;
     ctx->initialized = true;
     ctx->front_buffer = nullptr;
     ctx->back_buffer = nullptr;
     ctx->current_buffer = nullptr;
+    ctx->driver_data = nullptr;
 
     ESP_LOGI(TAG, "M5Unified display initialized (rotation=%d, %dx%d)",
              M5.Display.getRotation(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
@@ -78,20 +87,25 @@ void display_driver_clear_screen(display_context_t *ctx, uint16_t color) {
     }
 }
 
-void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color) {
-    if (!ctx || !ctx->initialized) return;
-    if (width <= 0 || height <= 0) return;
+// Clips a rectangle to the display; false if nothing is left
+static bool clip_rect(int *x, int *y, int *width, int *height) {
+    if (*width <= 0 || *height <= 0) return false;
 
     // Clip to display bounds to mirror simulator expectations
-    int x2 = x + width;
-    int y2 = y + height;
-    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT || x2 <= 0 || y2 <= 0) return;
-
-    if (x < 0) { width -= -x; x = 0; }
-    if (y < 0) { height -= -y; y = 0; }
-    if (x + width > DISPLAY_WIDTH)  width  = DISPLAY_WIDTH  - x;
-    if (y + height > DISPLAY_HEIGHT) height = DISPLAY_HEIGHT - y;
-    if (width <= 0 || height <= 0) return;
+    int x2 = *x + *width;
+    int y2 = *y + *height;
+    if (*x >= DISPLAY_WIDTH || *y >= DISPLAY_HEIGHT || x2 <= 0 || y2 <= 0) return false;
+
+    if (*x < 0) { *width -= -*x; *x = 0; }
+    if (*y < 0) { *height -= -*y; *y = 0; }
+    if (*x + *width > DISPLAY_WIDTH)  *width  = DISPLAY_WIDTH  - *x;
+    if (*y + *height > DISPLAY_HEIGHT) *height = DISPLAY_HEIGHT - *y;
+    return *width > 0 && *height > 0;
+}
+
+void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color) {
+    if (!ctx || !ctx->initialized) return;
+    if (!clip_rect(&x, &y, &width, &height)) return;
 
     if (s_sprite) {
         s_sprite->fillRect(x, y, width, height, color);
@@ -100,19 +114,107 @@ void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int wid
     }
 }
 
-void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
-    if (!ctx || !ctx->initialized || !text) return;
+void display_driver_draw_rectangles(display_context_t *ctx, const display_rect_t *rects, int count) {
+    if (!ctx || !ctx->initialized || !rects) return;
+    if (count <= 0) return;
+
+    // Drawing straight to the panel, the whole batch goes out in one SPI
+    // transaction instead of one per rectangle
+    if (!s_sprite) M5.Display.startWrite();
+    for (int i = 0; i < count; i++) {
+        int x = rects[i].x, y = rects[i].y, width = rects[i].width, height = rects[i].height;
+        if (!clip_rect(&x, &y, &width, &height)) continue;
+        if (s_sprite) {
+            s_sprite->fillRect(x, y, width, height, rects[i].color);
+        } else {
+            M5.Display.fillRect(x, y, width, height, rects[i].color);
+        }
+    }
+    if (!s_sprite) M5.Display.endWrite();
+}
+
+void display_driver_draw_bitmap(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels) {
+    if (!ctx || !ctx->initialized || !pixels) return;
+    if (width <= 0 || height <= 0) return;
+
+    // pushImage clips to the target and copies whole rows
+    if (s_sprite) {
+        s_sprite->pushImage(x, y, width, height, pixels);
+    } else {
+        M5.Display.pushImage(x, y, width, height, pixels);
+    }
+}
+
+bool display_driver_blits_bitmaps(display_context_t *ctx) {
+    (void)ctx;
+    return true;
+}
+
+void display_driver_push_rows(display_context_t *ctx, int y, int rows, const uint16_t *pixels) {
+    if (!ctx || !ctx->initialized || !pixels) return;
+    if (rows <= 0) return;
+
+    if (s_sprite) {
+        s_sprite->pushImage(0, y, DISPLAY_WIDTH, rows, pixels);
+        return;
+    }
+
+    // The transfer runs while the caller composes the next rows; starting the
+    // next one waits for this one to finish
+    if (!s_rows_pending) {
+        M5.Display.startWrite();
+        s_rows_pending = true;
+    }
+    M5.Display.pushImageDMA(0, y, DISPLAY_WIDTH, rows, pixels);
+}
+
+// Draws one glyph row span, clipped to the display
+static void fill_span(int x, int y, int width, uint16_t color) {
+    if (y < 0 || y >= DISPLAY_HEIGHT) return;
+    int x_end = x + width;
+    if (x < 0) x = 0;
+    if (x_end > DISPLAY_WIDTH) x_end = DISPLAY_WIDTH;
+    if (x >= x_end) return;
+
     if (s_sprite) {
-        // Transparent text background on sprite
-        s_sprite->setTextColor(color);
-        s_sprite->setCursor(x, y);
-        s_sprite->print(text);
+        s_sprite->drawFastHLine(x, y, x_end - x, color);
     } else {
-        // Transparent text background on display
-        M5.Display.setTextColor(color);
-        M5.Display.setCursor(x, y);
-        M5.Display.print(text);
+        M5.Display.drawFastHLine(x, y, x_end - x, color);
+    }
+}
+
+void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
+    if (!ctx || !ctx->initialized || !text) return;
+
+    // The driver's 8x8 font rather than M5GFX's, so the sprite, panel and
+    // banded builds all draw the same pixels. The background stays transparent.
+    int cursor_x = x;
+    int cursor_y = y;
+    for (; *text; text++) {
+        if (*text == '\n') {
+            cursor_x = x;
+            cursor_y += DISPLAY_FONT_HEIGHT;
+            continue;
+        }
+
+        const display_font_span_t *spans;
+        int span_count = display_font_glyph_spans(*text, &spans);
+        for (int i = 0; i < span_count; i++) {
+            fill_span(cursor_x + spans[i].x, cursor_y + spans[i].row, spans[i].width, color);
+        }
+        cursor_x += DISPLAY_FONT_WIDTH;
+    }
+}
+
+void display_driver_draw_texts(display_context_t *ctx, const display_text_t *texts, int count) {
+    if (!ctx || !ctx->initialized || !texts) return;
+    if (count <= 0) return;
+
+    if (!s_sprite) M5.Display.startWrite();
+    for (int i = 0; i < count; i++) {
+        if (texts[i].text) display_driver_draw_text(ctx, texts[i].x, texts[i].y, texts[i].text, texts[i].color);
     }
+    if (!s_sprite) M5.Display.endWrite();
 }
 
 void display_driver_swap_buffers(display_context_t *ctx) {
@@ -122,6 +224,11 @@ void display_driver_swap_buffers(display_context_t *ctx) {
 
 void display_driver_flush(display_context_t *ctx) {
     if (!ctx || !ctx->initialized) return;
+    if (s_rows_pending) {
+        M5.Display.waitDMA();
+        M5.Display.endWrite();
+        s_rows_pending = false;
+    }
     if (s_sprite) {
         // Push entire frame at once to avoid flicker
         s_sprite->pushSprite(0, 0);
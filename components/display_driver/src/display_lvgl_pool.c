@@ -0,0 +1,235 @@
+#include "display_lvgl_pool.h"
+#include "display_driver.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "display_lvgl_pool";
+
+// What an object was last set to
+typedef struct {
+    lv_obj_t *obj;
+    int16_t x;
+    int16_t y;
+    int16_t width;                     // Rectangles only
+    int16_t height;
+    uint16_t color;
+    bool fresh;                        // Just created, nothing set yet
+    bool hidden;
+} pool_slot_t;
+
+typedef struct {
+    pool_slot_t *slots;
+    int capacity;
+    int created;
+    int used;                          // Slots showing something this frame
+    int kept;                          // Slots the last cleared frame ended with
+    bool label;
+} slot_pool_t;
+
+static pool_slot_t rect_slots[DISPLAY_LVGL_POOL_RECTS];
+static pool_slot_t label_slots[DISPLAY_LVGL_POOL_LABELS];
+static slot_pool_t rects = {rect_slots, DISPLAY_LVGL_POOL_RECTS, 0, 0, 0, false};
+static slot_pool_t labels = {label_slots, DISPLAY_LVGL_POOL_LABELS, 0, 0, 0, true};
+static bool cleared = false;           // The frame started over with a cleared screen
+
+static lv_obj_t *rect_layer = NULL;
+static lv_obj_t *label_layer = NULL;
+static display_lvgl_pool_stats_t stats;
+static bool drop_logged = false;
+
+// Transparent, full-screen and inert, so only its children are drawn
+static lv_obj_t *create_layer(lv_obj_t *screen) {
+    lv_obj_t *layer = lv_obj_create(screen);
+    if (!layer) {
+        return NULL;
+    }
+    lv_obj_set_pos(layer, 0, 0);
+    lv_obj_set_size(layer, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    lv_obj_set_style_bg_opa(layer, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(layer, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(layer, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(layer, 0, LV_PART_MAIN);
+    lv_obj_clear_flag(layer, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    return layer;
+}
+
+bool display_lvgl_pool_init(lv_obj_t *screen) {
+    display_lvgl_pool_deinit();
+    if (!screen) {
+        return false;
+    }
+
+    rect_layer = create_layer(screen);
+    label_layer = create_layer(screen);
+    if (!rect_layer || !label_layer) {
+        ESP_LOGE(TAG, "Failed to create drawing layers");
+        display_lvgl_pool_deinit();
+        return false;
+    }
+    return true;
+}
+
+void display_lvgl_pool_deinit(void) {
+    // Deleting a layer deletes the objects on it
+    if (rect_layer) {
+        lv_obj_del(rect_layer);
+        rect_layer = NULL;
+    }
+    if (label_layer) {
+        lv_obj_del(label_layer);
+        label_layer = NULL;
+    }
+    rects.created = 0;
+    rects.used = 0;
+    rects.kept = 0;
+    labels.created = 0;
+    labels.used = 0;
+    labels.kept = 0;
+    cleared = false;
+    memset(&stats, 0, sizeof(stats));
+    drop_logged = false;
+}
+
+void display_lvgl_pool_begin_frame(void) {
+    rects.used = rects.kept;
+    labels.used = labels.kept;
+    cleared = false;
+}
+
+void display_lvgl_pool_clear(void) {
+    rects.used = 0;
+    labels.used = 0;
+    cleared = true;
+}
+
+static void hide_unused(slot_pool_t *pool) {
+    for (int i = pool->used; i < pool->created; i++) {
+        pool_slot_t *slot = &pool->slots[i];
+        if (!slot->hidden) {
+            lv_obj_add_flag(slot->obj, LV_OBJ_FLAG_HIDDEN);
+            slot->hidden = true;
+            stats.hidden++;
+        }
+    }
+}
+
+void display_lvgl_pool_end_frame(void) {
+    hide_unused(&rects);
+    hide_unused(&labels);
+    if (cleared) {
+        rects.kept = rects.used;
+        labels.kept = labels.used;
+    }
+    stats.frames++;
+    display_lvgl_pool_begin_frame();
+}
+
+// Next slot of the frame, created if no earlier frame needed it. NULL when the
+// pool is full or the object could not be created.
+static pool_slot_t *next_slot(slot_pool_t *pool) {
+    if (pool->used >= pool->capacity) {
+        stats.dropped++;
+        if (!drop_logged) {
+            ESP_LOGW(TAG, "More than %d %s in a frame, dropping the rest", pool->capacity,
+                     pool->label ? "strings" : "rectangles");
+            drop_logged = true;
+        }
+        return NULL;
+    }
+
+    pool_slot_t *slot = &pool->slots[pool->used];
+    if (pool->used == pool->created) {
+        lv_obj_t *obj = pool->label ? lv_label_create(label_layer) : lv_obj_create(rect_layer);
+        if (!obj) {
+            return NULL;
+        }
+        // Styles no draw changes are set once
+        lv_obj_set_style_pad_all(obj, 0, LV_PART_MAIN);
+        if (pool->label) {
+            lv_obj_set_style_bg_opa(obj, LV_OPA_TRANSP, LV_PART_MAIN);
+            stats.labels++;
+        } else {
+            lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+            lv_obj_set_style_border_width(obj, 0, LV_PART_MAIN);
+            lv_obj_set_style_radius(obj, 0, LV_PART_MAIN);
+            stats.rects++;
+        }
+        memset(slot, 0, sizeof(*slot));
+        slot->obj = obj;
+        slot->fresh = true;
+        pool->created++;
+        stats.created++;
+    } else if (slot->hidden) {
+        lv_obj_clear_flag(slot->obj, LV_OBJ_FLAG_HIDDEN);
+        slot->hidden = false;
+    }
+    pool->used++;
+    return slot;
+}
+
+static void place(pool_slot_t *slot, int x, int y) {
+    if (slot->fresh || slot->x != x || slot->y != y) {
+        lv_obj_set_pos(slot->obj, x, y);
+        slot->x = (int16_t)x;
+        slot->y = (int16_t)y;
+        stats.updates++;
+    }
+}
+
+bool display_lvgl_pool_rect(int x, int y, int width, int height, uint16_t color) {
+    if (!rect_layer) {
+        return false;
+    }
+
+    pool_slot_t *slot = next_slot(&rects);
+    if (!slot) {
+        return false;
+    }
+
+    place(slot, x, y);
+    if (slot->fresh || slot->width != width || slot->height != height) {
+        lv_obj_set_size(slot->obj, width, height);
+        slot->width = (int16_t)width;
+        slot->height = (int16_t)height;
+        stats.updates++;
+    }
+    if (slot->fresh || slot->color != color) {
+        lv_obj_set_style_bg_color(slot->obj, lv_color_hex(color), LV_PART_MAIN);
+        slot->color = color;
+        stats.updates++;
+    }
+    slot->fresh = false;
+    return true;
+}
+
+bool display_lvgl_pool_text(int x, int y, const char *text, uint16_t color) {
+    if (!label_layer || !text) {
+        return false;
+    }
+
+    pool_slot_t *slot = next_slot(&labels);
+    if (!slot) {
+        return false;
+    }
+
+    place(slot, x, y);
+    // The label keeps its own copy of the text to compare against
+    if (strcmp(lv_label_get_text(slot->obj), text) != 0) {
+        lv_label_set_text(slot->obj, text);
+        stats.updates++;
+    }
+    if (slot->fresh || slot->color != color) {
+        lv_obj_set_style_text_color(slot->obj, lv_color_hex(color), LV_PART_MAIN);
+        slot->color = color;
+        stats.updates++;
+    }
+    slot->fresh = false;
+    return true;
+}
+
+void display_lvgl_pool_get_stats(display_lvgl_pool_stats_t *out) {
+    if (!out) {
+        return;
+    }
+    *out = stats;
+}
@@ -0,0 +1,376 @@
+#include "display_st7789.h"
+#include "display_driver.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include <string.h>
+
+static const char *TAG = "display_st7789";
+
+// SPI handle for communication
+static spi_device_handle_t spi_handle = NULL;
+
+// Transaction `user` flags, read by the pre/post-transaction hooks
+#define TRANS_DATA      0x1  // DC high: parameters or pixels
+#define TRANS_AREA_DONE 0x2  // Last transaction of a queued area
+
+// Queue depth of the SPI device. Transactions are taken from a pool of the
+// same size in turn; the SPI driver holds pointers to them until they are
+// collected, oldest first.
+#define SPI_QUEUE_SIZE 7
+
+static spi_transaction_t trans_pool[SPI_QUEUE_SIZE];
+static display_st7789_done_cb_t trans_done_cb[SPI_QUEUE_SIZE];
+static void *trans_done_arg[SPI_QUEUE_SIZE];
+static int next_slot = 0;
+static int queued_count = 0;
+
+// Panel state left by earlier writes, so commands that would not change it
+// are skipped. Forgotten whenever a raw command could have changed it.
+typedef struct {
+    bool valid;
+    uint16_t x1, x2;   // Window, panel coordinates
+    uint16_t y1, y2;
+    int next_row;      // Row the memory write pointer stands at, -1 if unknown
+} window_cache_t;
+
+static window_cache_t window_cache;
+
+// One step of the init sequence: a command, its parameters and the wait after it
+typedef struct {
+    uint8_t cmd;
+    uint8_t len;
+    uint8_t data[14];
+    uint16_t delay_ms;
+} st7789_init_step_t;
+
+static const st7789_init_step_t init_sequence[] = {
+    {ST7789_SWRESET, 0, {0}, 130},                      // 130ms per working example
+    {ST7789_SLPOUT, 0, {0}, 130},
+    // Pixel format: 16-bit RGB565, which is what every pixel write sends.
+    // The panel resets to 18-bit.
+    {ST7789_COLMOD, 1, {ST7789_COLMOD_RGB565}, 0},
+    {0xB2, 5, {0x0C, 0x0C, 0x00, 0x33, 0x33}, 0},       // PORCTRL: porch control
+    {0xB7, 1, {0x35}, 0},                               // GCTRL: gate control
+    {0xBB, 1, {0x28}, 0},                               // VCOMS: VCOM setting
+    {0xC0, 1, {0x0C}, 0},                               // LCMCTRL: LCM control
+    {0xC2, 2, {0x01, 0xFF}, 0},                         // VDVVRHEN: VDV and VRH command enable
+    {0xC3, 1, {0x10}, 0},                               // VRHS: VRH set
+    {0xC4, 1, {0x20}, 0},                               // VDVSET: VDV setting
+    {0xC6, 1, {0x0F}, 0},                               // FRCTR2: frame rate control 2
+    {0xD0, 2, {0xA4, 0xA1}, 0},                         // PWCTRL1: power control 1
+    {0xB0, 2, {0x00, 0xC0}, 0},                         // RAMCTRL: RAM control
+    {0xE0, 14, {0xD0, 0x00, 0x02, 0x07, 0x0A, 0x28, 0x32, 0x44, 0x42, 0x06, 0x0E, 0x12, 0x14, 0x17}, 0}, // PVGAMCTRL
+    {0xE1, 14, {0xD0, 0x00, 0x02, 0x07, 0x0A, 0x28, 0x31, 0x54, 0x47, 0x0E, 0x1C, 0x17, 0x1B, 0x1E}, 0}, // NVGAMCTRL
+    {ST7789_SLPOUT, 0, {0}, 130},                       // Sleep out again, per working example
+    {ST7789_DISPON, 0, {0}, 10},
+};
+
+static uint8_t display_spi_read_data(void);
+static void display_init_st7789(void);
+static void spi_pre_transfer_cb(spi_transaction_t *trans);
+static void spi_post_transfer_cb(spi_transaction_t *trans);
+
+bool display_st7789_open(void) {
+    // Initialize SPI bus configuration
+    spi_bus_config_t buscfg = {
+        .mosi_io_num = TFT_MOSI_PIN,
+        .miso_io_num = TFT_MISO_PIN, // Set to actual MISO pin number
+        .sclk_io_num = TFT_CLK_PIN,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = DISPLAY_WIDTH * 64 * 2, // Match LVGL buffer size
+    };
+
+    // Initialize SPI device configuration for ST7789 compatibility
+    spi_device_interface_config_t devcfg = {
+        .clock_speed_hz = 10 * 1000 * 1000, // Reduced to 10 MHz for reliability
+        .mode = 0,  // SPI Mode 0 (CPOL=0, CPHA=0) - ST7789 standard
+        .spics_io_num = TFT_CS_PIN,
+        .queue_size = SPI_QUEUE_SIZE,
+        .flags = SPI_DEVICE_HALFDUPLEX | SPI_DEVICE_NO_DUMMY,  // Half-duplex, no dummy phase
+        .command_bits = 0,
+        .address_bits = 0,
+        .dummy_bits = 16, // ST7789 requires 16 dummy bits for reads
+        .duty_cycle_pos = 128,  // 50% duty cycle
+        .pre_cb = spi_pre_transfer_cb,   // Drives DC for each transaction
+        .post_cb = spi_post_transfer_cb, // Signals queued areas as sent
+    };
+
+    ESP_LOGI(TAG, "SPI Config: Clock=%lu Hz, Mode=%d, CS=GPIO%d, Flags=0x%08lX",
+             devcfg.clock_speed_hz, devcfg.mode, devcfg.spics_io_num, devcfg.flags);
+
+    // Initialize SPI bus (use VSPI_HOST for compatibility)
+    esp_err_t ret = spi_bus_initialize(VSPI_HOST, &buscfg, SPI_DMA_CH_AUTO);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    // Add device to SPI bus (use VSPI_HOST)
+    ret = spi_bus_add_device(VSPI_HOST, &devcfg, &spi_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
+        spi_bus_free(VSPI_HOST);
+        spi_handle = NULL;
+        return false;
+    }
+
+    // Configure DC and RST pins
+    gpio_config_t io_conf = {};
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.mode = GPIO_MODE_OUTPUT;
+    io_conf.pin_bit_mask = (1ULL << TFT_DC_PIN) | (1ULL << TFT_RST_PIN);
+    io_conf.pull_down_en = 0;
+    io_conf.pull_up_en = 1;  // Enable pull-up for more reliable signaling
+    gpio_config(&io_conf);
+
+    ESP_LOGI(TAG, "Starting display reset sequence...");
+
+    // Extended reset sequence for ST7789 reliability
+    // Start with reset high
+    gpio_set_level(TFT_RST_PIN, 1);
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    // Assert reset (low) for longer period
+    gpio_set_level(TFT_RST_PIN, 0);
+    vTaskDelay(pdMS_TO_TICKS(50));  // Increased from 10ms to 50ms
+
+    // Deassert reset and wait longer for startup
+    gpio_set_level(TFT_RST_PIN, 1);
+    vTaskDelay(pdMS_TO_TICKS(200)); // Increased from 120ms to 200ms
+
+    ESP_LOGI(TAG, "Display reset sequence complete");
+
+    // Initialize ST7789 display
+    display_init_st7789();
+    return true;
+}
+
+void display_st7789_close(void) {
+    // Remove SPI device and free bus
+    if (spi_handle) {
+        display_st7789_wait_idle();
+        spi_bus_remove_device(spi_handle);
+        spi_bus_free(VSPI_HOST);
+        spi_handle = NULL;
+    }
+    window_cache.valid = false;
+}
+
+// Collects the oldest queued transaction, waiting for it if needed
+static bool collect_trans(void) {
+    spi_transaction_t *done = NULL;
+    esp_err_t ret = spi_device_get_trans_result(spi_handle, &done, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI result failed: %s", esp_err_to_name(ret));
+        queued_count = 0;
+        return false;
+    }
+    queued_count--;
+    return true;
+}
+
+// Next pool transaction, cleared. Collects the oldest one when all are queued.
+static spi_transaction_t *take_trans(void) {
+    if (queued_count == SPI_QUEUE_SIZE) collect_trans();
+
+    spi_transaction_t *trans = &trans_pool[next_slot];
+    memset(trans, 0, sizeof(*trans));
+    trans_done_cb[next_slot] = NULL;
+    return trans;
+}
+
+static bool queue_trans(spi_transaction_t *trans) {
+    esp_err_t ret = spi_device_queue_trans(spi_handle, trans, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI queue failed: %s", esp_err_to_name(ret));
+        window_cache.valid = false;
+        return false;
+    }
+    next_slot = (next_slot + 1) % SPI_QUEUE_SIZE;
+    queued_count++;
+    return true;
+}
+
+// Queues a command and its parameters behind whatever is already queued.
+// Up to four parameter bytes are copied; longer ones must stay valid until
+// collected.
+static bool queue_command(uint8_t cmd, const uint8_t *params, size_t len) {
+    spi_transaction_t *trans = take_trans();
+    trans->flags = SPI_TRANS_USE_TXDATA;
+    trans->length = 8;
+    trans->tx_data[0] = cmd;
+    trans->user = (void *)0;
+    if (!queue_trans(trans)) return false;
+    if (!params || len == 0) return true;
+
+    trans = take_trans();
+    trans->length = len * 8;
+    trans->user = (void *)TRANS_DATA;
+    if (len <= sizeof(trans->tx_data)) {
+        trans->flags = SPI_TRANS_USE_TXDATA;
+        memcpy(trans->tx_data, params, len);
+    } else {
+        trans->tx_buffer = params;
+    }
+    return queue_trans(trans);
+}
+
+static bool queue_range(uint8_t cmd, uint16_t start, uint16_t end) {
+    uint8_t range[4] = {start >> 8, start & 0xFF, end >> 8, end & 0xFF};
+    return queue_command(cmd, range, sizeof(range));
+}
+
+void display_st7789_command(uint8_t cmd, const uint8_t *params, size_t len) {
+    if (!spi_handle) return;
+
+    // Any command may move the window or the write pointer
+    window_cache.valid = false;
+    queue_command(cmd, params, len);
+    display_st7789_wait_idle();
+}
+
+bool display_st7789_queue_area(int x, int y, int width, int height, const uint16_t *pixels,
+                               display_st7789_done_cb_t done, void *arg) {
+    if (!spi_handle || !pixels || width <= 0 || height <= 0) return false;
+
+    // Apply M5StickC Plus display offsets
+    uint16_t x1 = x + DISPLAY_OFFSET_X;
+    uint16_t x2 = x + width - 1 + DISPLAY_OFFSET_X;
+    uint16_t y1 = y + DISPLAY_OFFSET_Y;
+    uint16_t y2 = y + height - 1 + DISPLAY_OFFSET_Y;
+
+    // Rows run to the bottom of the display, so an area starting right
+    // below the previous one continues with RAMWRC and no window at all.
+    // Columns are only resent when they change.
+    window_cache_t *cache = &window_cache;
+    bool ok = true;
+    if (!cache->valid || x1 != cache->x1 || x2 != cache->x2) {
+        ok = queue_range(ST7789_CASET, x1, x2);
+        cache->x1 = x1;
+        cache->x2 = x2;
+        cache->y1 = 0;
+        cache->y2 = 0;
+        cache->next_row = -1;
+        cache->valid = ok;
+    }
+
+    uint8_t write_cmd = ST7789_RAMWR;
+    if (ok && y1 == cache->next_row && y2 <= cache->y2) {
+        write_cmd = ST7789_RAMWRC;
+    } else if (ok) {
+        uint16_t row_end = DISPLAY_HEIGHT - 1 + DISPLAY_OFFSET_Y;
+        if (y2 > row_end) row_end = y2;
+        if (y1 != cache->y1 || row_end != cache->y2) {
+            ok = queue_range(ST7789_RASET, y1, row_end);
+            cache->y1 = y1;
+            cache->y2 = row_end;
+        }
+    }
+    ok = ok && queue_command(write_cmd, NULL, 0);
+    if (!ok) {
+        cache->valid = false;
+        return false;
+    }
+
+    int slot = next_slot;
+    spi_transaction_t *trans = take_trans();
+    trans->length = (size_t)width * height * sizeof(uint16_t) * 8;
+    trans->tx_buffer = pixels;
+    trans->user = (void *)(TRANS_DATA | TRANS_AREA_DONE);
+    // Set before queueing: the post-transaction hook may run at any time after
+    trans_done_cb[slot] = done;
+    trans_done_arg[slot] = arg;
+    if (!queue_trans(trans)) return false;
+
+    // Whole rows were written; the pointer wraps to the window start past its end
+    cache->next_row = (y2 < cache->y2) ? y2 + 1 : -1;
+    return true;
+}
+
+void display_st7789_write_area(int x, int y, int width, int height, const uint16_t *pixels) {
+    if (display_st7789_queue_area(x, y, width, height, pixels, NULL, NULL)) {
+        display_st7789_wait_idle();
+    }
+}
+
+void display_st7789_wait_idle(void) {
+    while (queued_count > 0) {
+        if (!collect_trans()) return;
+    }
+}
+
+// Runs before every transaction, in interrupt context for queued ones
+static void IRAM_ATTR spi_pre_transfer_cb(spi_transaction_t *trans) {
+    gpio_set_level(TFT_DC_PIN, (uintptr_t)trans->user & TRANS_DATA);
+}
+
+static void IRAM_ATTR spi_post_transfer_cb(spi_transaction_t *trans) {
+    if (!((uintptr_t)trans->user & TRANS_AREA_DONE)) return;
+
+    int slot = trans - trans_pool;
+    if (trans_done_cb[slot]) trans_done_cb[slot](trans_done_arg[slot]);
+}
+
+static uint8_t display_spi_read_data(void) {
+    if (!spi_handle) return 0;
+
+    // DC high for data mode
+    uint8_t rx_data = 0;
+    spi_transaction_t trans = {
+        .flags = 0,
+        .length = 8,
+        .rxlength = 8,
+        .user = (void *)TRANS_DATA,
+        .rx_buffer = &rx_data,
+        .tx_buffer = NULL
+    };
+
+    esp_err_t ret = spi_device_transmit(spi_handle, &trans);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SPI read transmission failed: %s", esp_err_to_name(ret));
+        return 0;
+    }
+
+    return rx_data;
+}
+
+uint8_t display_st7789_read_register(uint8_t reg) {
+    if (!spi_handle) return 0;
+
+    ESP_LOGI(TAG, "Reading ST7789 register 0x%02X", reg);
+
+    // Send read command (DC low). The blocking read below needs an empty
+    // queue, and the command ends any memory write in progress.
+    queue_command(reg, NULL, 0);
+    display_st7789_wait_idle();
+    window_cache.next_row = -1;
+
+    // Read response with dummy bits
+    uint8_t result = display_spi_read_data();
+
+    ESP_LOGI(TAG, "Register 0x%02X = 0x%02X", reg, result);
+    vTaskDelay(pdMS_TO_TICKS(2)); // Datasheet recommends short delay after read
+    return result;
+}
+
+// ST7789 display initialization sequence with proper timing. Steps are
+// queued back to back and only collected where the panel needs a wait.
+static void display_init_st7789(void) {
+    ESP_LOGI(TAG, "Starting ST7789 initialization sequence...");
+
+    window_cache.valid = false;
+    for (size_t i = 0; i < sizeof(init_sequence) / sizeof(init_sequence[0]); i++) {
+        const st7789_init_step_t *step = &init_sequence[i];
+        if (!queue_command(step->cmd, step->data, step->len)) break;
+        if (step->delay_ms) {
+            display_st7789_wait_idle();
+            vTaskDelay(pdMS_TO_TICKS(step->delay_ms));
+        }
+    }
+    display_st7789_wait_idle();
+
+    ESP_LOGI(TAG, "ST7789 display initialization complete");
+}
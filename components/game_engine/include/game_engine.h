@@ -22,6 +22,16 @@ typedef struct {
     float difficulty_multiplier;
 } game_context_t;
 
+// Structure-of-arrays view over many game contexts for batched headless simulation.
+// Each pointer addresses `count` consecutive elements owned by the caller.
+typedef struct {
+    game_state_t* state;
+    uint32_t* score;
+    uint32_t* high_score;
+    uint32_t* frame_count;
+    float* difficulty_multiplier;
+} game_engine_batch_t;
+
 void game_engine_init(game_context_t* ctx);
 void game_engine_update(game_context_t* ctx);
 void game_engine_start_game(game_context_t* ctx);
@@ -33,6 +43,15 @@ bool game_engine_is_collision(game_context_t* ctx, int penguin_x, int penguin_y,
 bool game_engine_is_screen_edge_collision(game_context_t* ctx, int penguin_x, int penguin_y, int penguin_width, int penguin_height);
 void game_engine_update_score(game_context_t* ctx);
 float game_engine_get_difficulty_multiplier(game_context_t* ctx);
+// Number of game_engine_update() calls up to and including the next one that
+// changes the score (and with it the difficulty)
+uint32_t game_engine_frames_until_score_change(game_context_t* ctx);
+// Same result as calling game_engine_update() `frames` times
+void game_engine_advance(game_context_t* ctx, uint32_t frames);
+
+// Batched counterparts of game_engine_update() and game_engine_end_game()
+void game_engine_update_batch(const game_engine_batch_t* batch, int count);
+void game_engine_end_game_batch(const game_engine_batch_t* batch, const uint8_t* ended, int count);
 
 #ifdef __cplusplus
 }
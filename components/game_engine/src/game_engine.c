@@ -1,6 +1,9 @@
 #include "game_engine.h"
 #include <string.h>
 
+#define FRAMES_PER_SCORE_POINT 60 // Assuming 60 FPS, score = seconds survived
+#define DIFFICULTY_PER_SCORE_POINT 0.05f
+
 void game_engine_init(game_context_t* ctx) {
     if (!ctx) return;
     
@@ -79,13 +82,52 @@ void game_engine_update_score(game_context_t* ctx) {
     if (!ctx) return;
     
     // Score increases based on time survived (frame count)
-    ctx->score = ctx->frame_count / 60; // Assuming 60 FPS, score = seconds survived
+    ctx->score = ctx->frame_count / FRAMES_PER_SCORE_POINT;
     
     // Update difficulty based on score - reduced scaling for easier gameplay
-    ctx->difficulty_multiplier = 1.0f + (ctx->score * 0.05f);
+    ctx->difficulty_multiplier = 1.0f + (ctx->score * DIFFICULTY_PER_SCORE_POINT);
 }
 
 float game_engine_get_difficulty_multiplier(game_context_t* ctx) {
     if (!ctx) return 1.0f;
     return ctx->difficulty_multiplier;
-}
\ No newline at end of file
+}
+
+uint32_t game_engine_frames_until_score_change(game_context_t* ctx) {
+    if (!ctx) return 0;
+    return FRAMES_PER_SCORE_POINT - ctx->frame_count % FRAMES_PER_SCORE_POINT;
+}
+
+void game_engine_advance(game_context_t* ctx, uint32_t frames) {
+    if (!ctx || ctx->state != GAME_STATE_PLAYING) return;
+    
+    ctx->frame_count += frames;
+    game_engine_update_score(ctx);
+}
+
+void game_engine_update_batch(const game_engine_batch_t* batch, int count) {
+    if (!batch) return;
+    
+    for (int i = 0; i < count; i++) {
+        if (batch->state[i] != GAME_STATE_PLAYING) continue;
+        
+        uint32_t frame_count = batch->frame_count[i] + 1;
+        uint32_t score = frame_count / FRAMES_PER_SCORE_POINT;
+        batch->frame_count[i] = frame_count;
+        batch->score[i] = score;
+        batch->difficulty_multiplier[i] = 1.0f + (score * DIFFICULTY_PER_SCORE_POINT);
+    }
+}
+
+void game_engine_end_game_batch(const game_engine_batch_t* batch, const uint8_t* ended, int count) {
+    if (!batch || !ended) return;
+    
+    for (int i = 0; i < count; i++) {
+        if (!ended[i]) continue;
+        
+        batch->state[i] = GAME_STATE_GAME_OVER;
+        if (batch->score[i] > batch->high_score[i]) {
+            batch->high_score[i] = batch->score[i];
+        }
+    }
+}
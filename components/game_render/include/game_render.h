@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "display_driver.h"
+#include "game_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame renderer shared by the device and the simulator. Rectangles are
+// recorded into a display list instead of drawn immediately; flushing resolves
+// the final color of every pixel once per band of rows that the same commands
+// cover, and draws each visible run once, merging runs that repeat on the rows
+// below into one rectangle. Layered art
+// (outlines, fills, bevels, caps) then costs one write per pixel on any
+// display backend.
+#define GAME_RENDER_MAX_COMMANDS 192
+// Rectangles a flush hands to the display per display_driver_draw_rectangles() call
+#define GAME_RENDER_BATCH_RECTS 64
+
+// Already clipped to the screen, so a list's commands can be drawn as one batch
+typedef display_rect_t game_render_command_t;
+
+// One visible run of a row, or a stack of identical runs on consecutive rows
+typedef struct {
+    int16_t x;
+    int16_t width;
+    int16_t y;                     // First row of the stack
+    uint16_t color;
+} game_render_span_t;
+
+// Totals since game_render_list_begin(). recorded / visible is the overdraw
+// the commands would cause drawn one by one; written / visible is what the
+// flush caused.
+typedef struct {
+    uint32_t commands;
+    uint32_t recorded_pixels;      // On-screen pixels of every command
+    uint32_t visible_pixels;       // Pixels covered by any command
+    uint32_t written_pixels;       // Pixels the flushes drew
+    uint32_t output_rects;         // Rectangles the flushes drew
+} game_render_stats_t;
+
+// Working memory of game_render_list_flush(), kept apart from the list so
+// renderers that paint the recorded commands themselves do not carry it
+typedef struct {
+    int16_t edges[GAME_RENDER_MAX_COMMANDS * 2 + 1];
+    uint16_t row[DISPLAY_WIDTH];
+    bool covered[DISPLAY_WIDTH];
+    int open_count;
+    game_render_span_t open[DISPLAY_WIDTH];
+    game_render_span_t spans[DISPLAY_WIDTH];
+    int batch_count;
+    display_rect_t batch[GAME_RENDER_BATCH_RECTS];
+} game_render_flush_scratch_t;
+
+typedef struct {
+    display_context_t* display;
+    game_render_flush_scratch_t* scratch; // NULL: flushes draw the commands as recorded
+    int16_t clip_x0;               // Recorded rectangles are cut to [clip_x0, clip_x1) x [clip_y0, clip_y1)
+    int16_t clip_y0;
+    int16_t clip_x1;
+    int16_t clip_y1;
+    int count;
+    game_render_command_t commands[GAME_RENDER_MAX_COMMANDS];
+    game_render_stats_t stats;
+} game_render_list_t;
+
+// Gives a list the scratch its flushes resolve visible runs in. One scratch
+// can serve any number of lists that are not flushed at the same time.
+void game_render_list_init(game_render_list_t* list, game_render_flush_scratch_t* scratch);
+
+// Starts a new frame for `display`, clipped to the screen, and resets the statistics
+void game_render_list_begin(game_render_list_t* list, display_context_t* display);
+// Limits the rectangles recorded from now on to the given part of the screen,
+// so a scene can be recorded whole and only one region of it drawn
+void game_render_list_set_clip(game_render_list_t* list, int x, int y, int width, int height);
+// Records a rectangle with the same clipping as display_driver_draw_rectangle().
+// A full list is flushed first, which keeps the frame correct at the cost of
+// some overdraw.
+void game_render_list_rect(game_render_list_t* list, int x, int y, int width, int height, uint16_t color);
+// Draws the visible parts of the recorded commands and empties the list. A
+// list without scratch draws them the way game_render_list_flush_direct() does.
+void game_render_list_flush(game_render_list_t* list);
+// Draws every recorded command in order, as immediate drawing would, and
+// empties the list. For comparisons and benchmarks.
+void game_render_list_flush_direct(game_render_list_t* list);
+
+// Records one half of a pillar whose fill starts at (x, y). Top halves carry
+// their snow cap and icicles on the bottom edge, bottom halves on the top edge.
+// The notches are cut with `background`.
+void game_render_pillar(game_render_list_t* list, int x, int y, int height, bool top, uint16_t background);
+// Records the penguin with its body's top-left corner at (x, y)
+void game_render_penguin(game_render_list_t* list, int x, int y);
+// Records the playfield of a world: background, pillars and penguin
+void game_render_scene(game_render_list_t* list, const game_world_t* world, uint16_t background);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "game_render.h"
+#include "game_render_sprite.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame-buffer-less rendering. A frame is described as a list of objects and
+// text, then composed a band of rows at a time into one of two small buffers;
+// each band is pushed while the next one is composed. Draws the same pixels as
+// game_render_scene_sprites() followed by display_driver_draw_text(): text
+// comes from the display_font spans every display backend draws with.
+//
+// The renderer takes about 7.2 KB: 5400 bytes of band buffers and a display
+// list of about 1.9 KB. The list never flushes, so it has no flush scratch.
+#define GAME_RENDER_BAND_ROWS 10
+#define GAME_RENDER_BAND_BUFFER_BYTES (2 * DISPLAY_WIDTH * GAME_RENDER_BAND_ROWS * sizeof(uint16_t))
+#define GAME_RENDER_BAND_MAX_OBJECTS (MAX_PILLARS * 2 + 1)
+#define GAME_RENDER_BAND_MAX_TEXTS 4
+#define GAME_RENDER_BAND_TEXT_LENGTH 32
+
+typedef struct {
+    game_render_sprite_kind_t kind;
+    int16_t x;                     // Same position as game_render_sprite_draw()
+    int16_t y;
+    int16_t height;                // Pillars only
+} game_render_band_object_t;
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    uint16_t color;
+    char text[GAME_RENDER_BAND_TEXT_LENGTH];
+} game_render_band_text_t;
+
+// Drawn in order: background, objects, then text
+typedef struct {
+    uint16_t background;
+    int object_count;
+    game_render_band_object_t objects[GAME_RENDER_BAND_MAX_OBJECTS];
+    int text_count;
+    game_render_band_text_t texts[GAME_RENDER_BAND_MAX_TEXTS];
+} game_render_band_scene_t;
+
+typedef struct {
+    uint16_t bands[2][DISPLAY_WIDTH * GAME_RENDER_BAND_ROWS];
+    game_render_list_t list;       // The scene's rectangles, recorded once per frame; no scratch
+    uint32_t frames;
+    uint32_t bands_pushed;
+} game_render_band_renderer_t;
+
+void game_render_band_scene_begin(game_render_band_scene_t* scene, uint16_t background);
+bool game_render_band_scene_object(game_render_band_scene_t* scene, game_render_sprite_kind_t kind, int x, int y,
+                                   int height);
+// Adds the pillars and penguin of a world
+void game_render_band_scene_world(game_render_band_scene_t* scene, const game_world_t* world);
+// Text longer than GAME_RENDER_BAND_TEXT_LENGTH - 1 characters is cut short
+bool game_render_band_scene_text(game_render_band_scene_t* scene, int x, int y, const char* text, uint16_t color);
+
+// Records the scene's rectangles; game_render_band_compose() then fills any band
+void game_render_band_prepare(game_render_band_renderer_t* renderer, const game_render_band_scene_t* scene);
+// Writes rows y .. y + rows - 1 of the prepared frame to `pixels`, DISPLAY_WIDTH per row
+void game_render_band_compose(game_render_band_renderer_t* renderer, const game_render_band_scene_t* scene, int y,
+                              int rows, uint16_t* pixels);
+// Prepares the scene and pushes the whole frame band by band with
+// display_driver_push_rows()
+void game_render_band_present(game_render_band_renderer_t* renderer, display_context_t* ctx,
+                              const game_render_band_scene_t* scene);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "game_render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pre-rendered pillars and penguin. A pillar half looks the same wherever it
+// is, so its composition is rendered once per (orientation, height,
+// background) into RGB565 blocks and blitted afterwards. The cache evicts
+// least recently used sprites to stay within a byte budget.
+#define GAME_RENDER_SPRITE_DEFAULT_BUDGET (64 * 1024)
+#define GAME_RENDER_SPRITE_MAX_BLOCKS 32
+
+typedef enum {
+    GAME_RENDER_SPRITE_PILLAR_TOP,
+    GAME_RENDER_SPRITE_PILLAR_BOTTOM,
+    GAME_RENDER_SPRITE_PENGUIN
+} game_render_sprite_kind_t;
+
+// Opaque rectangle of a sprite; pixels outside every block are transparent
+typedef struct {
+    int16_t x;                     // Relative to the object position
+    int16_t y;
+    int16_t width;
+    int16_t height;
+    const uint16_t* pixels;        // width * height, row after row
+} game_render_sprite_block_t;
+
+typedef struct game_render_sprite {
+    struct game_render_sprite* prev;   // Towards more recently used
+    struct game_render_sprite* next;
+    game_render_sprite_kind_t kind;
+    int height;
+    uint16_t background;
+    size_t bytes;                  // Everything this sprite allocated
+    int block_count;
+    game_render_sprite_block_t blocks[];
+} game_render_sprite_t;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t sprites;              // Currently cached
+    size_t bytes;                  // Currently allocated
+    size_t peak_bytes;
+} game_render_sprite_stats_t;
+
+typedef struct {
+    size_t budget;
+    game_render_sprite_t* newest;
+    game_render_sprite_t* oldest;
+    game_render_sprite_stats_t stats;
+    game_render_list_t scratch;    // Composes new sprites and draws uncacheable ones
+} game_render_sprite_cache_t;
+
+// Returns false for a zero budget. The cache is still initialized then, holds
+// nothing, and game_render_scene_sprites() composes every object directly.
+bool game_render_sprite_cache_init(game_render_sprite_cache_t* cache, size_t budget);
+void game_render_sprite_cache_deinit(game_render_sprite_cache_t* cache);
+// Returns the sprite, rendering it on a miss. The pointer stays valid until the
+// next call, which may evict it. Returns NULL if the sprite alone exceeds the
+// budget or memory runs out.
+const game_render_sprite_t* game_render_sprite_cache_get(game_render_sprite_cache_t* cache,
+                                                         game_render_sprite_kind_t kind, int height,
+                                                         uint16_t background);
+void game_render_sprite_draw(display_context_t* ctx, const game_render_sprite_t* sprite, int x, int y);
+// Clears the screen and blits the pillars and penguin of a world. Draws the
+// same pixels as game_render_scene(). Displays that do not blit bitmaps
+// (display_driver_blits_bitmaps()) get each object's rectangles instead.
+void game_render_scene_sprites(game_render_sprite_cache_t* cache, display_context_t* ctx, const game_world_t* world,
+                               uint16_t background);
+
+#ifdef __cplusplus
+}
+#endif
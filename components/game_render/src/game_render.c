@@ -0,0 +1,293 @@
+#include "game_render.h"
+#include <string.h>
+
+void game_render_list_init(game_render_list_t* list, game_render_flush_scratch_t* scratch) {
+    if (!list) return;
+    
+    memset(list, 0, sizeof(game_render_list_t));
+    list->scratch = scratch;
+}
+
+void game_render_list_begin(game_render_list_t* list, display_context_t* display) {
+    if (!list) return;
+    
+    list->display = display;
+    list->count = 0;
+    game_render_list_set_clip(list, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    memset(&list->stats, 0, sizeof(list->stats));
+}
+
+void game_render_list_set_clip(game_render_list_t* list, int x, int y, int width, int height) {
+    if (!list) return;
+    
+    list->clip_x0 = (int16_t)((x < 0) ? 0 : x);
+    list->clip_y0 = (int16_t)((y < 0) ? 0 : y);
+    list->clip_x1 = (int16_t)((x + width > DISPLAY_WIDTH) ? DISPLAY_WIDTH : x + width);
+    list->clip_y1 = (int16_t)((y + height > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT : y + height);
+}
+
+void game_render_list_rect(game_render_list_t* list, int x, int y, int width, int height, uint16_t color) {
+    if (!list) return;
+    
+    int x_start = (x < list->clip_x0) ? list->clip_x0 : x;
+    int y_start = (y < list->clip_y0) ? list->clip_y0 : y;
+    int x_end = (x + width > list->clip_x1) ? list->clip_x1 : x + width;
+    int y_end = (y + height > list->clip_y1) ? list->clip_y1 : y + height;
+    if (x_start >= x_end || y_start >= y_end) return;
+    
+    if (list->count == GAME_RENDER_MAX_COMMANDS) {
+        game_render_list_flush(list);
+        // A list without a display cannot make room
+        if (list->count == GAME_RENDER_MAX_COMMANDS) return;
+    }
+    
+    game_render_command_t* command = &list->commands[list->count++];
+    command->x = (int16_t)x_start;
+    command->y = (int16_t)y_start;
+    command->width = (int16_t)(x_end - x_start);
+    command->height = (int16_t)(y_end - y_start);
+    command->color = color;
+    
+    list->stats.commands++;
+    list->stats.recorded_pixels += (uint32_t)(command->width * command->height);
+}
+
+static void submit_batch(game_render_list_t* list, game_render_flush_scratch_t* scratch) {
+    display_driver_draw_rectangles(list->display, scratch->batch, scratch->batch_count);
+    scratch->batch_count = 0;
+}
+
+// Emitted runs never overlap, so they can reach the display in any grouping
+static void emit_span(game_render_list_t* list, game_render_flush_scratch_t* scratch, const game_render_span_t* span,
+                      int y_end) {
+    int height = y_end - span->y;
+    if (scratch->batch_count == GAME_RENDER_BATCH_RECTS) submit_batch(list, scratch);
+    display_rect_t* rect = &scratch->batch[scratch->batch_count++];
+    rect->x = span->x;
+    rect->y = span->y;
+    rect->width = span->width;
+    rect->height = (int16_t)height;
+    rect->color = span->color;
+    list->stats.written_pixels += (uint32_t)(span->width * height);
+    list->stats.output_rects++;
+}
+
+// Paints the commands covering row `y` into the scratch row, in recording
+// order, and splits the covered pixels into runs of one color. The row stands
+// for `rows` identical rows.
+static int resolve_row(game_render_list_t* list, game_render_flush_scratch_t* scratch, int y, int rows) {
+    memset(scratch->covered, 0, sizeof(scratch->covered));
+    for (int i = 0; i < list->count; i++) {
+        const game_render_command_t* command = &list->commands[i];
+        if (y < command->y || y >= command->y + command->height) continue;
+        
+        for (int x = command->x; x < command->x + command->width; x++) {
+            scratch->row[x] = command->color;
+            scratch->covered[x] = true;
+        }
+    }
+    
+    int count = 0;
+    int x = 0;
+    while (x < DISPLAY_WIDTH) {
+        if (!scratch->covered[x]) {
+            x++;
+            continue;
+        }
+        
+        int start = x;
+        uint16_t color = scratch->row[x];
+        while (x < DISPLAY_WIDTH && scratch->covered[x] && scratch->row[x] == color) x++;
+        
+        game_render_span_t* span = &scratch->spans[count++];
+        span->x = (int16_t)start;
+        span->width = (int16_t)(x - start);
+        span->y = (int16_t)y;
+        span->color = color;
+        list->stats.visible_pixels += (uint32_t)((x - start) * rows);
+    }
+    return count;
+}
+
+// Rows where some command starts or ends, sorted and without duplicates.
+// Every row of the band between two of them is covered by the same commands.
+static int collect_band_edges(const game_render_list_t* list, game_render_flush_scratch_t* scratch) {
+    int count = 0;
+    scratch->edges[count++] = 0;
+    for (int i = 0; i < list->count; i++) {
+        scratch->edges[count++] = list->commands[i].y;
+        scratch->edges[count++] = (int16_t)(list->commands[i].y + list->commands[i].height);
+    }
+    
+    for (int i = 1; i < count; i++) {
+        int16_t edge = scratch->edges[i];
+        int at = i;
+        while (at > 0 && scratch->edges[at - 1] > edge) {
+            scratch->edges[at] = scratch->edges[at - 1];
+            at--;
+        }
+        scratch->edges[at] = edge;
+    }
+    
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (scratch->edges[i] >= DISPLAY_HEIGHT) break;
+        int16_t edge = scratch->edges[i];
+        if (unique == 0 || edge != scratch->edges[unique - 1]) scratch->edges[unique++] = edge;
+    }
+    return unique;
+}
+
+void game_render_list_flush(game_render_list_t* list) {
+    if (!list || !list->display) return;
+    
+    game_render_flush_scratch_t* scratch = list->scratch;
+    if (!scratch) {
+        game_render_list_flush_direct(list);
+        return;
+    }
+    
+    // Each band is resolved once. Runs are sorted by x in both bands, so one
+    // merge pass pairs each run with an identical run above it; stacks that
+    // do not continue are drawn.
+    int bands = collect_band_edges(list, scratch);
+    scratch->open_count = 0;
+    scratch->batch_count = 0;
+    for (int band = 0; band < bands; band++) {
+        int y = scratch->edges[band];
+        int band_end = (band + 1 < bands) ? scratch->edges[band + 1] : DISPLAY_HEIGHT;
+        int count = resolve_row(list, scratch, y, band_end - y);
+        
+        int kept = 0;
+        int next = 0;
+        for (int i = 0; i < scratch->open_count; i++) {
+            game_render_span_t* open = &scratch->open[i];
+            while (next < count && scratch->spans[next].x < open->x) next++;
+            
+            game_render_span_t* span = (next < count) ? &scratch->spans[next] : NULL;
+            if (span && span->x == open->x && span->width == open->width && span->color == open->color) {
+                // Continues: the band's run is absorbed into the stack
+                span->width = 0;
+                scratch->open[kept++] = *open;
+            } else {
+                emit_span(list, scratch, open, y);
+            }
+        }
+        
+        // Runs that did not continue a stack start new ones. Both lists are
+        // sorted by x, so merge them from the back to keep the stacks sorted.
+        int fresh = 0;
+        for (int i = 0; i < count; i++) {
+            if (scratch->spans[i].width > 0) scratch->spans[fresh++] = scratch->spans[i];
+        }
+        int stack = kept - 1;
+        int run = fresh - 1;
+        scratch->open_count = kept + fresh;
+        for (int k = scratch->open_count - 1; run >= 0; k--) {
+            if (stack >= 0 && scratch->open[stack].x > scratch->spans[run].x) {
+                scratch->open[k] = scratch->open[stack--];
+            } else {
+                scratch->open[k] = scratch->spans[run--];
+            }
+        }
+    }
+    
+    for (int i = 0; i < scratch->open_count; i++) {
+        emit_span(list, scratch, &scratch->open[i], DISPLAY_HEIGHT);
+    }
+    submit_batch(list, scratch);
+    scratch->open_count = 0;
+    list->count = 0;
+}
+
+void game_render_list_flush_direct(game_render_list_t* list) {
+    if (!list || !list->display) return;
+    
+    // Drawn in recording order, which the batch keeps
+    display_driver_draw_rectangles(list->display, list->commands, list->count);
+    for (int i = 0; i < list->count; i++) {
+        const game_render_command_t* command = &list->commands[i];
+        list->stats.written_pixels += (uint32_t)(command->width * command->height);
+        list->stats.output_rects++;
+    }
+    list->count = 0;
+}
+
+// Ice block with outline, bevels, chipped sides, a snowy cap on the gap side
+// and icicles
+void game_render_pillar(game_render_list_t* list, int x, int y, int height, bool top, uint16_t background) {
+    if (!list || height <= 0) return;
+    
+    int px = x;
+    int py = y;
+    int w = PILLAR_WIDTH;
+    int h = height;
+    
+    // Base outline
+    game_render_list_rect(list, px - 1, py - 1, w + 2, h + 2, COLOR_BLUE);
+    // Fill
+    game_render_list_rect(list, px, py, w, h, COLOR_ICE_BLUE);
+    // Bevels: top light edge and bottom dark edge
+    game_render_list_rect(list, px, py, w, 1, COLOR_CYAN);
+    game_render_list_rect(list, px, py + h - 1, w, 1, COLOR_DARK_BLUE);
+    // Vertical highlights/shadows
+    game_render_list_rect(list, px, py, 3, h, COLOR_CYAN);
+    game_render_list_rect(list, px + w - 3, py, 3, h, COLOR_DARK_BLUE);
+    
+    // Chipped side notches, cut into the sides with the background color
+    int notch_w = 3;
+    int notch_h = 6;
+    game_render_list_rect(list, px, py + h / 4, notch_w, notch_h, background);
+    game_render_list_rect(list, px, py + (h * 3) / 5, notch_w, notch_h, background);
+    game_render_list_rect(list, px + w - notch_w, py + h / 3, notch_w, notch_h, background);
+    game_render_list_rect(list, px + w - notch_w, py + (h * 4) / 5, notch_w, notch_h, background);
+    
+    if (top) {
+        // Top pillar: snowy cap on the bottom edge with icicles hanging down
+        game_render_list_rect(list, px, py + h - 3, w, 3, COLOR_WHITE);
+        game_render_list_rect(list, px + w / 6, py + h - 3, 2, 6, COLOR_WHITE);
+        game_render_list_rect(list, px + w / 2, py + h - 3, 3, 8, COLOR_WHITE);
+        game_render_list_rect(list, px + (w * 5) / 6, py + h - 3, 2, 5, COLOR_WHITE);
+    } else {
+        // Bottom pillar: snowy cap on the top edge with icicles pointing up
+        game_render_list_rect(list, px, py, w, 3, COLOR_WHITE);
+        game_render_list_rect(list, px + w / 5, py - 5, 2, 5, COLOR_WHITE);
+        game_render_list_rect(list, px + (w * 3) / 5, py - 7, 3, 7, COLOR_WHITE);
+        game_render_list_rect(list, px + (w * 4) / 5, py - 4, 2, 4, COLOR_WHITE);
+    }
+}
+
+// Outlined body, head with an eye and beak, feet
+void game_render_penguin(game_render_list_t* list, int x, int y) {
+    if (!list) return;
+    
+    int px = x;
+    int py = y;
+    int bw = PENGUIN_WIDTH;
+    int bh = PENGUIN_HEIGHT;
+    int head_h = bh / 2;
+    game_render_list_rect(list, px - 1, py - 1, bw + 2, bh + 2, COLOR_BLACK);
+    game_render_list_rect(list, px, py, bw, bh, COLOR_WHITE);
+    game_render_list_rect(list, px + bw / 4, py - head_h / 2, bw / 2, head_h, COLOR_BLACK);
+    game_render_list_rect(list, px + bw / 2, py - head_h / 2 + 2, 2, 2, COLOR_WHITE);
+    game_render_list_rect(list, px + bw / 2 + 2, py - head_h / 2 + head_h / 2, 3, 2, COLOR_YELLOW);
+    game_render_list_rect(list, px + 2, py + bh, 4, 3, COLOR_YELLOW);
+    game_render_list_rect(list, px + bw - 6, py + bh, 4, 3, COLOR_YELLOW);
+}
+
+void game_render_scene(game_render_list_t* list, const game_world_t* world, uint16_t background) {
+    if (!list || !world) return;
+    
+    game_render_list_rect(list, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, background);
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        if (!pillar->active) continue;
+        
+        int x = (int)pillar->x;
+        game_render_pillar(list, x, 0, pillar->top_height, true, background);
+        game_render_pillar(list, x, pillar->bottom_y, pillar->bottom_height, false, background);
+    }
+    
+    game_render_penguin(list, (int)world->penguin.x, (int)world->penguin.y);
+}
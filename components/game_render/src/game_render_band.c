@@ -0,0 +1,151 @@
+#include "game_render_band.h"
+#include "display_font.h"
+#include <string.h>
+
+void game_render_band_scene_begin(game_render_band_scene_t* scene, uint16_t background) {
+    if (!scene) return;
+    
+    scene->background = background;
+    scene->object_count = 0;
+    scene->text_count = 0;
+}
+
+bool game_render_band_scene_object(game_render_band_scene_t* scene, game_render_sprite_kind_t kind, int x, int y,
+                                   int height) {
+    if (!scene || scene->object_count == GAME_RENDER_BAND_MAX_OBJECTS) return false;
+    
+    game_render_band_object_t* object = &scene->objects[scene->object_count++];
+    object->kind = kind;
+    object->x = (int16_t)x;
+    object->y = (int16_t)y;
+    object->height = (int16_t)height;
+    return true;
+}
+
+void game_render_band_scene_world(game_render_band_scene_t* scene, const game_world_t* world) {
+    if (!scene || !world) return;
+    
+    // Same objects, in the same order, as game_render_scene_sprites()
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        if (!pillar->active) continue;
+        
+        int x = (int)pillar->x;
+        if (pillar->top_height > 0) {
+            game_render_band_scene_object(scene, GAME_RENDER_SPRITE_PILLAR_TOP, x, 0, pillar->top_height);
+        }
+        if (pillar->bottom_height > 0) {
+            game_render_band_scene_object(scene, GAME_RENDER_SPRITE_PILLAR_BOTTOM, x, pillar->bottom_y,
+                                          pillar->bottom_height);
+        }
+    }
+    
+    game_render_band_scene_object(scene, GAME_RENDER_SPRITE_PENGUIN, (int)world->penguin.x, (int)world->penguin.y, 0);
+}
+
+bool game_render_band_scene_text(game_render_band_scene_t* scene, int x, int y, const char* text, uint16_t color) {
+    if (!scene || !text || scene->text_count == GAME_RENDER_BAND_MAX_TEXTS) return false;
+    
+    game_render_band_text_t* entry = &scene->texts[scene->text_count++];
+    entry->x = (int16_t)x;
+    entry->y = (int16_t)y;
+    entry->color = color;
+    strncpy(entry->text, text, GAME_RENDER_BAND_TEXT_LENGTH - 1);
+    entry->text[GAME_RENDER_BAND_TEXT_LENGTH - 1] = '\0';
+    return true;
+}
+
+void game_render_band_prepare(game_render_band_renderer_t* renderer, const game_render_band_scene_t* scene) {
+    if (!renderer || !scene) return;
+    
+    // Without a display the list only records; the commands are painted band
+    // by band instead of flushed
+    game_render_list_begin(&renderer->list, NULL);
+    for (int i = 0; i < scene->object_count; i++) {
+        const game_render_band_object_t* object = &scene->objects[i];
+        if (object->kind == GAME_RENDER_SPRITE_PENGUIN) {
+            game_render_penguin(&renderer->list, object->x, object->y);
+        } else {
+            game_render_pillar(&renderer->list, object->x, object->y, object->height,
+                               object->kind == GAME_RENDER_SPRITE_PILLAR_TOP, scene->background);
+        }
+    }
+}
+
+static void fill_row(uint16_t* row, int count, uint16_t color) {
+    for (int i = 0; i < count; i++) {
+        row[i] = color;
+    }
+}
+
+// Paints the rows of a text that fall into the band, the way
+// display_driver_draw_text() does on a frame buffer
+static void compose_text(const game_render_band_text_t* text, int y, int rows, uint16_t* pixels) {
+    int cursor_x = text->x;
+    int cursor_y = text->y;
+    for (const char* ch = text->text; *ch; ch++) {
+        if (*ch == '\n') {
+            cursor_x = text->x;
+            cursor_y += DISPLAY_FONT_HEIGHT;
+            continue;
+        }
+        
+        const display_font_span_t* spans;
+        int span_count = display_font_glyph_spans(*ch, &spans);
+        for (int i = 0; i < span_count; i++) {
+            int row = cursor_y + spans[i].row;
+            if (row < y || row >= y + rows || row >= DISPLAY_HEIGHT) continue;
+            
+            int x_start = cursor_x + spans[i].x;
+            int x_end = x_start + spans[i].width;
+            if (x_start < 0) x_start = 0;
+            if (x_end > DISPLAY_WIDTH) x_end = DISPLAY_WIDTH;
+            if (x_start < x_end) fill_row(pixels + (row - y) * DISPLAY_WIDTH + x_start, x_end - x_start, text->color);
+        }
+        cursor_x += DISPLAY_FONT_WIDTH;
+    }
+}
+
+void game_render_band_compose(game_render_band_renderer_t* renderer, const game_render_band_scene_t* scene, int y,
+                              int rows, uint16_t* pixels) {
+    if (!renderer || !scene || !pixels || rows <= 0) return;
+    
+    for (int row = 0; row < rows; row++) {
+        fill_row(pixels + row * DISPLAY_WIDTH, DISPLAY_WIDTH, scene->background);
+    }
+    
+    // Commands are already clipped to the screen; only the band clips here
+    const game_render_list_t* list = &renderer->list;
+    for (int i = 0; i < list->count; i++) {
+        const game_render_command_t* command = &list->commands[i];
+        int first = (command->y > y) ? command->y : y;
+        int last = (command->y + command->height < y + rows) ? command->y + command->height : y + rows;
+        for (int row = first; row < last; row++) {
+            fill_row(pixels + (row - y) * DISPLAY_WIDTH + command->x, command->width, command->color);
+        }
+    }
+    
+    for (int i = 0; i < scene->text_count; i++) {
+        compose_text(&scene->texts[i], y, rows, pixels);
+    }
+}
+
+void game_render_band_present(game_render_band_renderer_t* renderer, display_context_t* ctx,
+                              const game_render_band_scene_t* scene) {
+    if (!renderer || !ctx || !scene) return;
+    
+    game_render_band_prepare(renderer, scene);
+    
+    // Alternate the buffers: a band is composed while the previous one is
+    // still being pushed, and pushing a band waits for the one before it, so
+    // the buffer being composed into is always free
+    int buffer = 0;
+    for (int y = 0; y < DISPLAY_HEIGHT; y += GAME_RENDER_BAND_ROWS) {
+        int rows = (y + GAME_RENDER_BAND_ROWS > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT - y : GAME_RENDER_BAND_ROWS;
+        game_render_band_compose(renderer, scene, y, rows, renderer->bands[buffer]);
+        display_driver_push_rows(ctx, y, rows, renderer->bands[buffer]);
+        renderer->bands_pushed++;
+        buffer ^= 1;
+    }
+    renderer->frames++;
+}
@@ -0,0 +1,276 @@
+#include "game_render_sprite.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Objects are composed this far from the scratch list's edges so nothing that
+// sticks out of them (outlines, icicles, the penguin's head) gets clipped
+#define SPRITE_MARGIN 8
+
+bool game_render_sprite_cache_init(game_render_sprite_cache_t* cache, size_t budget) {
+    if (!cache) return false;
+    
+    // A zero budget still leaves a usable cache that holds nothing
+    memset(cache, 0, sizeof(game_render_sprite_cache_t));
+    cache->budget = budget;
+    return budget > 0;
+}
+
+void game_render_sprite_cache_deinit(game_render_sprite_cache_t* cache) {
+    if (!cache) return;
+    
+    game_render_sprite_t* sprite = cache->newest;
+    while (sprite) {
+        game_render_sprite_t* next = sprite->next;
+        free(sprite);
+        sprite = next;
+    }
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->stats.sprites = 0;
+    cache->stats.bytes = 0;
+}
+
+static void compose(game_render_list_t* list, game_render_sprite_kind_t kind, int height, uint16_t background) {
+    game_render_list_begin(list, NULL);
+    if (kind == GAME_RENDER_SPRITE_PENGUIN) {
+        game_render_penguin(list, SPRITE_MARGIN, SPRITE_MARGIN);
+    } else {
+        game_render_pillar(list, SPRITE_MARGIN, SPRITE_MARGIN, height, kind == GAME_RENDER_SPRITE_PILLAR_TOP,
+                           background);
+    }
+}
+
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} sprite_rect_t;
+
+// Splits the covered pixels into rectangles: runs of covered pixels that
+// repeat on the following rows stack into one. Returns -1 if there are more
+// than GAME_RENDER_SPRITE_MAX_BLOCKS.
+static int find_blocks(const uint8_t* mask, int width, int height, sprite_rect_t* blocks) {
+    int count = 0;
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = mask + y * width;
+        int x = 0;
+        while (x < width) {
+            if (!row[x]) {
+                x++;
+                continue;
+            }
+            
+            int start = x;
+            while (x < width && row[x]) x++;
+            
+            int found = -1;
+            for (int i = 0; i < count && found < 0; i++) {
+                if (blocks[i].x == start && blocks[i].width == x - start && blocks[i].y + blocks[i].height == y) {
+                    found = i;
+                }
+            }
+            if (found >= 0) {
+                blocks[found].height++;
+                continue;
+            }
+            
+            if (count == GAME_RENDER_SPRITE_MAX_BLOCKS) return -1;
+            sprite_rect_t block = {start, y, x - start, 1};
+            blocks[count++] = block;
+        }
+    }
+    return count;
+}
+
+static game_render_sprite_t* build_sprite(game_render_list_t* list, game_render_sprite_kind_t kind, int height,
+                                          uint16_t background) {
+    if (kind != GAME_RENDER_SPRITE_PENGUIN && (height <= 0 || height > DISPLAY_HEIGHT - 2 * SPRITE_MARGIN)) {
+        return NULL;
+    }
+    
+    compose(list, kind, height, background);
+    if (list->count == 0) return NULL;
+    
+    int x0 = DISPLAY_WIDTH, y0 = DISPLAY_HEIGHT, x1 = 0, y1 = 0;
+    for (int i = 0; i < list->count; i++) {
+        const game_render_command_t* command = &list->commands[i];
+        if (command->x < x0) x0 = command->x;
+        if (command->y < y0) y0 = command->y;
+        if (command->x + command->width > x1) x1 = command->x + command->width;
+        if (command->y + command->height > y1) y1 = command->y + command->height;
+    }
+    int width = x1 - x0;
+    int rows = y1 - y0;
+    
+    // Paint the commands in order into a temporary canvas
+    uint16_t* canvas = malloc((size_t)width * rows * sizeof(uint16_t));
+    uint8_t* mask = calloc((size_t)width * rows, 1);
+    sprite_rect_t rects[GAME_RENDER_SPRITE_MAX_BLOCKS];
+    int block_count = -1;
+    if (canvas && mask) {
+        for (int i = 0; i < list->count; i++) {
+            const game_render_command_t* command = &list->commands[i];
+            for (int y = command->y - y0; y < command->y - y0 + command->height; y++) {
+                for (int x = command->x - x0; x < command->x - x0 + command->width; x++) {
+                    canvas[y * width + x] = command->color;
+                    mask[y * width + x] = 1;
+                }
+            }
+        }
+        block_count = find_blocks(mask, width, rows, rects);
+    }
+    
+    game_render_sprite_t* sprite = NULL;
+    if (block_count > 0) {
+        size_t pixels = 0;
+        for (int i = 0; i < block_count; i++) {
+            pixels += (size_t)rects[i].width * rects[i].height;
+        }
+        
+        // One allocation: header, block table, then every block's pixels
+        size_t header = sizeof(game_render_sprite_t) + block_count * sizeof(game_render_sprite_block_t);
+        header = (header + sizeof(uint16_t) - 1) & ~(sizeof(uint16_t) - 1);
+        size_t bytes = header + pixels * sizeof(uint16_t);
+        sprite = malloc(bytes);
+        if (sprite) {
+            memset(sprite, 0, header);
+            sprite->kind = kind;
+            sprite->height = height;
+            sprite->background = background;
+            sprite->bytes = bytes;
+            sprite->block_count = block_count;
+            
+            uint16_t* out = (uint16_t*)((uint8_t*)sprite + header);
+            for (int i = 0; i < block_count; i++) {
+                game_render_sprite_block_t* block = &sprite->blocks[i];
+                block->x = (int16_t)(x0 + rects[i].x - SPRITE_MARGIN);
+                block->y = (int16_t)(y0 + rects[i].y - SPRITE_MARGIN);
+                block->width = (int16_t)rects[i].width;
+                block->height = (int16_t)rects[i].height;
+                block->pixels = out;
+                for (int y = 0; y < rects[i].height; y++) {
+                    memcpy(out, canvas + (rects[i].y + y) * width + rects[i].x, rects[i].width * sizeof(uint16_t));
+                    out += rects[i].width;
+                }
+            }
+        }
+    }
+    
+    free(canvas);
+    free(mask);
+    return sprite;
+}
+
+static void unlink_sprite(game_render_sprite_cache_t* cache, game_render_sprite_t* sprite) {
+    if (sprite->prev) sprite->prev->next = sprite->next;
+    else cache->newest = sprite->next;
+    if (sprite->next) sprite->next->prev = sprite->prev;
+    else cache->oldest = sprite->prev;
+    sprite->prev = NULL;
+    sprite->next = NULL;
+}
+
+static void push_newest(game_render_sprite_cache_t* cache, game_render_sprite_t* sprite) {
+    sprite->prev = NULL;
+    sprite->next = cache->newest;
+    if (cache->newest) cache->newest->prev = sprite;
+    cache->newest = sprite;
+    if (!cache->oldest) cache->oldest = sprite;
+}
+
+const game_render_sprite_t* game_render_sprite_cache_get(game_render_sprite_cache_t* cache,
+                                                         game_render_sprite_kind_t kind, int height,
+                                                         uint16_t background) {
+    if (!cache) return NULL;
+    if (kind == GAME_RENDER_SPRITE_PENGUIN) height = 0;
+    
+    // Only a handful of sprites are on screen, and they sit at the front
+    for (game_render_sprite_t* sprite = cache->newest; sprite; sprite = sprite->next) {
+        if (sprite->kind == kind && sprite->height == height && sprite->background == background) {
+            cache->stats.hits++;
+            if (sprite != cache->newest) {
+                unlink_sprite(cache, sprite);
+                push_newest(cache, sprite);
+            }
+            return sprite;
+        }
+    }
+    
+    cache->stats.misses++;
+    if (cache->budget == 0) return NULL;
+    game_render_sprite_t* sprite = build_sprite(&cache->scratch, kind, height, background);
+    if (!sprite) return NULL;
+    if (sprite->bytes > cache->budget) {
+        free(sprite);
+        return NULL;
+    }
+    
+    while (cache->oldest && cache->stats.bytes + sprite->bytes > cache->budget) {
+        game_render_sprite_t* victim = cache->oldest;
+        unlink_sprite(cache, victim);
+        cache->stats.bytes -= victim->bytes;
+        cache->stats.sprites--;
+        cache->stats.evictions++;
+        free(victim);
+    }
+    
+    push_newest(cache, sprite);
+    cache->stats.bytes += sprite->bytes;
+    cache->stats.sprites++;
+    if (cache->stats.bytes > cache->stats.peak_bytes) cache->stats.peak_bytes = cache->stats.bytes;
+    return sprite;
+}
+
+void game_render_sprite_draw(display_context_t* ctx, const game_render_sprite_t* sprite, int x, int y) {
+    if (!ctx || !sprite) return;
+    
+    for (int i = 0; i < sprite->block_count; i++) {
+        const game_render_sprite_block_t* block = &sprite->blocks[i];
+        display_driver_draw_bitmap(ctx, x + block->x, y + block->y, block->width, block->height, block->pixels);
+    }
+}
+
+static void draw_object(game_render_sprite_cache_t* cache, display_context_t* ctx, bool blit,
+                        game_render_sprite_kind_t kind, int height, uint16_t background, int x, int y) {
+    const game_render_sprite_t* sprite = blit ? game_render_sprite_cache_get(cache, kind, height, background) : NULL;
+    if (sprite) {
+        game_render_sprite_draw(ctx, sprite, x, y);
+        return;
+    }
+    
+    // Does not fit the cache, or the display draws bitmaps as more rectangles
+    // than the object is made of: compose it in place
+    game_render_list_begin(&cache->scratch, ctx);
+    if (kind == GAME_RENDER_SPRITE_PENGUIN) {
+        game_render_penguin(&cache->scratch, x, y);
+    } else {
+        game_render_pillar(&cache->scratch, x, y, height, kind == GAME_RENDER_SPRITE_PILLAR_TOP, background);
+    }
+    game_render_list_flush_direct(&cache->scratch);
+}
+
+void game_render_scene_sprites(game_render_sprite_cache_t* cache, display_context_t* ctx, const game_world_t* world,
+                               uint16_t background) {
+    if (!cache || !ctx || !world) return;
+    
+    display_driver_clear_screen(ctx, background);
+    bool blit = display_driver_blits_bitmaps(ctx);
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        if (!pillar->active) continue;
+        
+        int x = (int)pillar->x;
+        if (pillar->top_height > 0) {
+            draw_object(cache, ctx, blit, GAME_RENDER_SPRITE_PILLAR_TOP, pillar->top_height, background, x, 0);
+        }
+        if (pillar->bottom_height > 0) {
+            draw_object(cache, ctx, blit, GAME_RENDER_SPRITE_PILLAR_BOTTOM, pillar->bottom_height, background, x,
+                        pillar->bottom_y);
+        }
+    }
+    
+    draw_object(cache, ctx, blit, GAME_RENDER_SPRITE_PENGUIN, 0, background, (int)world->penguin.x,
+                (int)world->penguin.y);
+}
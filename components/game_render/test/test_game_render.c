@@ -0,0 +1,77 @@
+#include "unity.h"
+#include "game_render.h"
+#include "game_render_sprite.h"
+#include "game_render_band.h"
+#include <stdint.h>
+#include <string.h>
+
+void setUp(void) {
+    // Set up code here runs before each test
+}
+
+void tearDown(void) {
+    // Clean up code here runs after each test
+}
+
+// Tests that compare drawn pixels need the simulator's frame buffers and run
+// on the host, in simulator/test_main.cpp
+static game_render_sprite_cache_t cache;
+static game_render_band_scene_t scene;
+
+// Test that the least recently used sprites are evicted to stay within budget
+void test_game_render_sprite_cache_evicts_lru(void) {
+    const size_t budget = 24 * 1024;
+    TEST_ASSERT_TRUE(game_render_sprite_cache_init(&cache, budget));
+    
+    for (int height = 40; height < 140; height += 10) {
+        TEST_ASSERT_NOT_NULL(game_render_sprite_cache_get(&cache, GAME_RENDER_SPRITE_PILLAR_TOP, height, COLOR_BLACK));
+        TEST_ASSERT_TRUE(cache.stats.bytes <= budget);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, cache.stats.misses);
+    TEST_ASSERT_TRUE(cache.stats.evictions > 0);
+    TEST_ASSERT_EQUAL_UINT32(10 - cache.stats.evictions, cache.stats.sprites);
+    
+    // The newest sprite is still cached; the oldest was evicted
+    game_render_sprite_cache_get(&cache, GAME_RENDER_SPRITE_PILLAR_TOP, 130, COLOR_BLACK);
+    TEST_ASSERT_EQUAL_UINT32(1, cache.stats.hits);
+    game_render_sprite_cache_get(&cache, GAME_RENDER_SPRITE_PILLAR_TOP, 40, COLOR_BLACK);
+    TEST_ASSERT_EQUAL_UINT32(11, cache.stats.misses);
+    
+    // Orientation and background are part of the key
+    game_render_sprite_cache_get(&cache, GAME_RENDER_SPRITE_PILLAR_BOTTOM, 40, COLOR_BLACK);
+    game_render_sprite_cache_get(&cache, GAME_RENDER_SPRITE_PILLAR_TOP, 40, COLOR_WHITE);
+    TEST_ASSERT_EQUAL_UINT32(13, cache.stats.misses);
+    
+    game_render_sprite_cache_deinit(&cache);
+    TEST_ASSERT_EQUAL_UINT32(0, cache.stats.bytes);
+}
+
+// Test that a full scene refuses more entries and long text is cut short
+void test_game_render_band_scene_limits(void) {
+    game_render_band_scene_begin(&scene, COLOR_BLACK);
+    for (int i = 0; i < GAME_RENDER_BAND_MAX_OBJECTS; i++) {
+        TEST_ASSERT_TRUE(game_render_band_scene_object(&scene, GAME_RENDER_SPRITE_PENGUIN, i, i, 0));
+    }
+    TEST_ASSERT_FALSE(game_render_band_scene_object(&scene, GAME_RENDER_SPRITE_PENGUIN, 0, 0, 0));
+    
+    char text[64];
+    memset(text, 'A', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    for (int i = 0; i < GAME_RENDER_BAND_MAX_TEXTS; i++) {
+        TEST_ASSERT_TRUE(game_render_band_scene_text(&scene, 0, 0, text, COLOR_WHITE));
+    }
+    TEST_ASSERT_FALSE(game_render_band_scene_text(&scene, 0, 0, "X", COLOR_WHITE));
+    TEST_ASSERT_EQUAL_INT(GAME_RENDER_BAND_TEXT_LENGTH - 1, (int)strlen(scene.texts[0].text));
+}
+
+void app_main(void) {
+    UNITY_BEGIN();
+    
+    // Sprite Cache Tests
+    RUN_TEST(test_game_render_sprite_cache_evicts_lru);
+    
+    // Banded Renderer Tests
+    RUN_TEST(test_game_render_band_scene_limits);
+    
+    UNITY_END();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "game_engine.h"
+#include "penguin_physics.h"
+#include "ice_pillars.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One complete headless game world
+typedef struct {
+    game_context_t game;
+    penguin_t penguin;
+    ice_pillars_context_t pillars;
+} game_world_t;
+
+// Many worlds stored as structure-of-arrays and stepped together
+typedef struct {
+    int world_count;
+    int stride;                   // Padded world count used for per-pillar arrays
+    game_engine_batch_t game;
+    penguin_batch_t penguins;
+    ice_pillars_batch_t pillars;
+    
+    // Per-step scratch
+    uint8_t* playing;
+    uint8_t* collided;
+    int* penguin_x;
+    int* penguin_y;
+    
+    void* storage;
+} game_sim_batch_t;
+
+// Initializes a world and starts playing immediately
+void game_sim_world_init(game_world_t* world);
+// Same, with the pillar generator seeded explicitly (see ice_pillars_init_seeded())
+void game_sim_world_init_seeded(game_world_t* world, uint32_t seed, ice_pillars_rng_mode_t mode);
+
+// Advances a playing world by one frame: physics, pillars, game engine, then
+// pillar passing and collision checks. Returns true while the game is still running.
+bool game_sim_world_step(game_world_t* world, bool button_pressed);
+
+// Advances a playing world by up to `max_frames` frames with the button held in
+// one state, with the same result as calling game_sim_world_step() for each
+// frame. Runs of frames in which nothing can spawn, be passed, scroll off or
+// collide are applied in one jump. Returns the number of frames advanced, which
+// is less than `max_frames` only when the game ended.
+uint32_t game_sim_world_advance(game_world_t* world, bool button_pressed, uint32_t max_frames);
+
+bool game_sim_batch_init(game_sim_batch_t* batch, int world_count);
+void game_sim_batch_deinit(game_sim_batch_t* batch);
+
+// Steps every playing world by one frame with the same results as game_sim_world_step().
+// `button_pressed` holds one 0/1 entry per world. Returns the number of worlds still playing.
+int game_sim_batch_step(game_sim_batch_t* batch, const uint8_t* button_pressed);
+
+// Puts world `index` back into the state produced by game_sim_world_init()
+void game_sim_batch_reset_world(game_sim_batch_t* batch, int index);
+
+// Copies `world` into slot `index` of the batch
+bool game_sim_batch_set_world(game_sim_batch_t* batch, int index, const game_world_t* world);
+
+// Copies world `index` out of the batch
+bool game_sim_batch_get_world(const game_sim_batch_t* batch, int index, game_world_t* world);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "game_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Decides the button state for the next frame of episode `episode`. Policies are
+// pure functions of their arguments, so an episode plays out identically on any
+// thread and can be replayed later.
+typedef bool (*game_sim_policy_fn)(const game_world_t* world, uint64_t episode);
+
+typedef struct {
+    const char* name;
+    const char* description;
+    game_sim_policy_fn decide;
+} game_sim_policy_t;
+
+// Presses on a coin flip every frame
+bool game_sim_policy_random(const game_world_t* world, uint64_t episode);
+// Holds and releases on a fixed cycle whose length depends on the episode
+bool game_sim_policy_periodic(const game_world_t* world, uint64_t episode);
+// Steers toward the gap of the nearest pillar ahead, with a per-episode aim offset
+bool game_sim_policy_autopilot(const game_world_t* world, uint64_t episode);
+
+const game_sim_policy_t* game_sim_get_policies(int* count);
+// Returns NULL when no policy has that name
+const game_sim_policy_t* game_sim_find_policy(const char* name);
+
+// Plays an initialized world until game over or `max_frames` frames (0 for no
+// limit). Returns the number of frames played.
+uint32_t game_sim_run_episode(game_world_t* world, game_sim_policy_fn policy, uint64_t episode,
+                              uint32_t max_frames);
+
+#ifdef __cplusplus
+}
+#endif
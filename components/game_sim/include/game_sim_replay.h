@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "game_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Replay file layout, all fields little-endian:
+//   0  "PDRP" magic          12  frame count
+//   4  version               16  final score
+//   5  pillar generator mode 20  payload size in bytes
+//   6  reserved (0)
+//   8  pillar seed
+// The payload that follows is the button input as alternating run lengths,
+// released first, each stored as a LEB128 varint. The first run may be 0 when
+// the button was already held on the first frame. A replay always covers one
+// complete game from game_sim_world_init_seeded() to game over.
+#define GAME_SIM_REPLAY_MAGIC "PDRP"
+#define GAME_SIM_REPLAY_VERSION 1
+#define GAME_SIM_REPLAY_HEADER_SIZE 24
+#define GAME_SIM_REPLAY_MAX_VARINT_SIZE 5
+
+typedef struct {
+    uint32_t seed;
+    ice_pillars_rng_mode_t rng_mode;
+    uint32_t frame_count;          // Frames stepped, including the one that ended the game
+    uint32_t final_score;
+    uint32_t payload_size;
+} game_sim_replay_header_t;
+
+// Records one game into a caller-owned byte ring. A frame costs a compare and
+// an increment; bytes are only written when the button changes. The ring is a
+// single-producer, single-consumer queue: the game loop records while a reader
+// drains, and nothing is ever overwritten. If the ring fills up the recording
+// is marked overflowed and stops growing.
+//
+// Only the ring positions are shared: each is written by one side with
+// release and read by the other with acquire ordering. The header and the
+// overflowed/finished flags belong to the recording thread; read them from
+// the reader only after game_sim_replay_recorder_finish() has returned there.
+typedef struct {
+    uint8_t* ring;
+    uint32_t capacity;
+    uint32_t write_pos;            // Free-running byte counters, wrapped on access. Written by
+    uint32_t read_pos;             // the recorder and the drain respectively, atomically
+    uint32_t run_length;
+    bool run_pressed;
+    bool overflowed;
+    bool finished;
+    game_sim_replay_header_t header;
+} game_sim_replay_recorder_t;
+
+// Walks the runs of a replay payload
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool next_pressed;
+} game_sim_replay_reader_t;
+
+typedef struct {
+    uint32_t frames;               // Frames re-simulated
+    uint32_t score;
+    bool game_over;
+    bool matches;                  // Game over on the last recorded frame with the recorded score
+} game_sim_replay_result_t;
+
+void game_sim_replay_write_header(const game_sim_replay_header_t* header, uint8_t out[GAME_SIM_REPLAY_HEADER_SIZE]);
+// Returns false for a short buffer, bad magic or unknown version
+bool game_sim_replay_read_header(const uint8_t* data, size_t size, game_sim_replay_header_t* header);
+
+// Writes `value` as a LEB128 varint and returns its length in bytes
+int game_sim_replay_encode_varint(uint32_t value, uint8_t out[GAME_SIM_REPLAY_MAX_VARINT_SIZE]);
+
+bool game_sim_replay_recorder_init(game_sim_replay_recorder_t* recorder, uint8_t* ring, uint32_t capacity,
+                                   uint32_t seed, ice_pillars_rng_mode_t rng_mode);
+// Call once per game_sim_world_step() with the same input
+void game_sim_replay_recorder_record(game_sim_replay_recorder_t* recorder, bool button_pressed);
+// Flushes the last run and completes the header
+void game_sim_replay_recorder_finish(game_sim_replay_recorder_t* recorder, uint32_t final_score);
+// Moves up to `max_size` recorded payload bytes out of the ring. Returns the number copied.
+uint32_t game_sim_replay_recorder_drain(game_sim_replay_recorder_t* recorder, uint8_t* out, uint32_t max_size);
+uint32_t game_sim_replay_recorder_pending(const game_sim_replay_recorder_t* recorder);
+
+void game_sim_replay_reader_init(game_sim_replay_reader_t* reader, const uint8_t* payload, size_t size);
+// Returns false at the end of the payload or on a malformed varint
+bool game_sim_replay_reader_next_run(game_sim_replay_reader_t* reader, bool* button_pressed, uint32_t* length);
+
+// Re-simulates a complete replay (header plus payload) into `world` without
+// rendering. Returns true when the replay decodes and reproduces the recorded game.
+bool game_sim_replay_play(const uint8_t* replay, size_t size, game_world_t* world, game_sim_replay_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "game_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GAME_SIM_SNAPSHOT_SIZE 128
+
+// Complete state of one game_world_t, including the pillar generator, packed
+// into two cache lines. Fields are grouped by width so the struct has no
+// padding. Pillar heights fit in 16 bits for any layout the game produces.
+typedef struct __attribute__((aligned(64))) {
+    uint32_t score;
+    uint32_t high_score;
+    uint32_t frame_count;
+    float difficulty_multiplier;
+    
+    float penguin_x;
+    float penguin_y;
+    float velocity_y;
+    float acceleration_y;
+    uint32_t button_press_duration;
+    
+    float pillar_x[MAX_PILLARS];
+    float scroll_speed;
+    uint32_t spawn_timer;
+    uint32_t spawn_interval;
+    float pillar_difficulty_multiplier;
+    uint32_t rng_seed;
+    uint32_t rng_state;
+    uint32_t rng_draw_count;
+    
+    int16_t top_height[MAX_PILLARS];
+    int16_t bottom_y[MAX_PILLARS];
+    int16_t bottom_height[MAX_PILLARS];
+    int16_t gap_size[MAX_PILLARS];
+    
+    uint8_t game_state;
+    uint8_t rng_mode;
+    uint8_t penguin_flags;          // Bit 0: button pressed, bit 1: was pressed
+    uint8_t pillar_flags;           // Bits 0-3: active, bits 4-7: passed
+    int8_t active_count;
+    uint8_t reserved[11];
+} game_sim_snapshot_t;
+
+// Both calls are allocation-free and touch only the two structs involved
+void game_sim_snapshot_save(const game_world_t* world, game_sim_snapshot_t* snapshot);
+void game_sim_snapshot_restore(const game_sim_snapshot_t* snapshot, game_world_t* world);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "game_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Offline survivability solver. The pillars of a seed do not depend on the
+// player, so the solver steps them once and tracks the set of every penguin
+// state any input sequence can reach. Velocity only ever takes a few dozen
+// exact float values; y is quantized to 1/2^subpixel_bits of a pixel. Each
+// grid row is one bitset over y, shared by the velocities that move y by the
+// same range of cells now and after any later input. A frame ORs together the
+// rows each input leads from, shifts the result and clears the cells a pillar
+// covers.
+//
+// Each cell moves into every cell its rounded y can land in, so the tracked
+// set always contains the real one: no input survives longer than the solver
+// reports. Finer cells make the bound tighter and the solver slower.
+//
+// The grid holds GAME_SIM_SOLVER_LANES games at once, one per lane of each
+// vector word, all moved by the same instructions. Lanes start and stop on
+// their own; the single-game calls use lane 0.
+//
+// The witness search gives the matching lower bound: it plays the seed with
+// the exact physics, keeping one real penguin state per velocity and cell,
+// and returns the inputs of the longest play it finds.
+#define GAME_SIM_SOLVER_LANES 4
+#define GAME_SIM_SOLVER_MAX_VELOCITIES 64
+#define GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS 3
+// Rows keep 32 spare bits past the last cell so a shift never loses state
+#define GAME_SIM_SOLVER_WORDS(cells) (((cells) + 32 + 63) / 64)
+#define GAME_SIM_SOLVER_MAX_WORDS GAME_SIM_SOLVER_WORDS(((SCREEN_HEIGHT - PENGUIN_HEIGHT) << GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS) + 1)
+#define GAME_SIM_SOLVER_DEFAULT_SUBPIXEL_BITS 0
+
+// One exact velocity together with the button state that produced it
+typedef struct {
+    float velocity;
+    bool pressed;
+    uint8_t next[2];               // Velocity reached by releasing / pressing
+    int8_t shift_min;              // Range of cells y moves by on a frame that
+    int8_t shift_max;              // ends at this velocity
+    uint8_t row;
+} game_sim_solver_velocity_t;
+
+typedef struct {
+    bool pressed;
+    int8_t shift_min;
+    int8_t shift_max;
+    uint8_t source_count;
+    uint8_t sources[GAME_SIM_SOLVER_MAX_VELOCITIES]; // Rows whose next frame lands here
+} game_sim_solver_row_t;
+
+// One word of a row in every lane, lane i in element i. Aligned to its size
+// explicitly: without AVX enabled GCC gives it only 16 bytes, which the AVX2
+// kernel's aligned loads cannot use.
+typedef uint64_t game_sim_solver_word_t
+    __attribute__((vector_size(8 * GAME_SIM_SOLVER_LANES), aligned(8 * GAME_SIM_SOLVER_LANES)));
+
+typedef struct {
+    game_context_t game;
+    ice_pillars_context_t pillars;
+    uint32_t frame;
+    bool running;                  // Started, and some state survived every frame so far
+} game_sim_solver_lane_t;
+
+typedef struct {
+    int subpixel_bits;
+    int cells;                     // y from 0 to the bottom edge inclusive
+    int words;
+    int velocity_count;
+    game_sim_solver_velocity_t velocities[GAME_SIM_SOLVER_MAX_VELOCITIES];
+    int row_count;
+    game_sim_solver_row_t rows[GAME_SIM_SOLVER_MAX_VELOCITIES];
+    uint8_t start_row;
+    uint8_t rest_row[2];           // Velocity zeroed by hitting an edge, per button state
+    uint8_t start_velocity;
+    uint8_t rest_velocity[2];
+    int penguin_x;
+    
+    game_sim_solver_lane_t lanes[GAME_SIM_SOLVER_LANES];
+    int current;
+    game_sim_solver_word_t reach[2][GAME_SIM_SOLVER_MAX_VELOCITIES * GAME_SIM_SOLVER_MAX_WORDS]; // Rows of `words` words
+} game_sim_solver_t;
+
+// A penguin state of the witness search: y and the velocity it moves with
+typedef struct {
+    float y;
+    uint8_t velocity;
+} game_sim_solver_state_t;
+
+// Frames between saved state lists; the inputs of the last stretch are
+// recovered by playing it again from the save before it
+#define GAME_SIM_SOLVER_WITNESS_STRIDE 128
+
+// The search states and pillars at the start of a saved stretch
+typedef struct {
+    uint32_t first;                // Index of its first state in `saved_states`
+    uint32_t count;
+    game_context_t game;
+    ice_pillars_context_t pillars;
+} game_sim_solver_save_t;
+
+// Working memory of the witness search, grown as a game goes on
+typedef struct {
+    game_sim_solver_state_t* states[2];
+    uint32_t state_capacity[2];
+    uint32_t* seen;                // Search frame each velocity and cell was last kept on
+    uint32_t stamp;                // Search frames run, the current one included
+    uint32_t* links;               // Per kept state: its parent's index << 1 | input
+    uint32_t link_capacity;
+    uint32_t link_starts[GAME_SIM_SOLVER_WITNESS_STRIDE]; // First link of each frame of the replayed stretch
+    game_sim_solver_state_t* saved_states;
+    uint32_t saved_capacity;
+    game_sim_solver_save_t* saves;
+    uint32_t save_capacity;
+    uint32_t save_count;
+} game_sim_solver_witness_t;
+
+// Finds the velocities by probing penguin_physics_update() and groups them into
+// rows. Returns false for an unsupported resolution or if the physics reach
+// more velocities than fit.
+bool game_sim_solver_init(game_sim_solver_t* solver, int subpixel_bits);
+// Starts a new game in lane 0 and stops the other lanes: only the penguin's
+// start state is reachable
+void game_sim_solver_reset(game_sim_solver_t* solver, uint32_t seed, ice_pillars_rng_mode_t mode);
+// Starts a new game in one lane; the others go on
+void game_sim_solver_start_lane(game_sim_solver_t* solver, int lane, uint32_t seed, ice_pillars_rng_mode_t mode);
+// Advances every running lane one frame. Returns false once no input
+// sequence survives it in lane 0.
+bool game_sim_solver_step(game_sim_solver_t* solver);
+// True when the penguin's current state lies inside lane 0's tracked set
+bool game_sim_solver_is_reachable(const game_sim_solver_t* solver, const penguin_t* penguin);
+// Upper bound on the frames any input survives the seed, capped at `max_frames`.
+// A game that ends on frame N survived N - 1 frames.
+uint32_t game_sim_solver_max_survival(game_sim_solver_t* solver, uint32_t seed, ice_pillars_rng_mode_t mode,
+                                      uint32_t max_frames);
+// game_sim_solver_max_survival() of seeds first_seed to first_seed + count - 1
+// into bounds[0..count), solved GAME_SIM_SOLVER_LANES at a time
+void game_sim_solver_max_survival_many(game_sim_solver_t* solver, uint32_t first_seed, uint32_t count,
+                                       ice_pillars_rng_mode_t mode, uint32_t max_frames, uint32_t* bounds);
+
+bool game_sim_solver_witness_init(game_sim_solver_witness_t* witness, const game_sim_solver_t* solver);
+void game_sim_solver_witness_deinit(game_sim_solver_witness_t* witness);
+// Lower bound on the frames the seed can be survived, capped at `max_frames`:
+// the longest play the search finds. inputs[0..n) gets its button states,
+// the frame it ends on included when it ends before `max_frames`, so
+// game_sim_world_step() survives them for exactly the returned frames.
+// `inputs` holds max_frames + 1 entries; NULL skips recovering them. Returns
+// 0 if memory runs out.
+uint32_t game_sim_solver_min_survival(game_sim_solver_witness_t* witness, const game_sim_solver_t* solver,
+                                      uint32_t seed, ice_pillars_rng_mode_t mode, uint32_t max_frames,
+                                      uint8_t* inputs, uint32_t* input_count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+#include "game_sim.h"
+#include <string.h>
+
+// Below this many frames, working out how far it is safe to jump costs more
+// than stepping
+#define GAME_SIM_MIN_JUMP_FRAMES 8
+
+void game_sim_world_init(game_world_t* world) {
+    game_sim_world_init_seeded(world, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_LCG);
+}
+
+void game_sim_world_init_seeded(game_world_t* world, uint32_t seed, ice_pillars_rng_mode_t mode) {
+    if (!world) return;
+    
+    memset(world, 0, sizeof(game_world_t));
+    game_engine_init(&world->game);
+    penguin_physics_init(&world->penguin);
+    ice_pillars_init_seeded(&world->pillars, seed, mode);
+    game_engine_start_game(&world->game);
+}
+
+bool game_sim_world_step(game_world_t* world, bool button_pressed) {
+    if (!world || world->game.state != GAME_STATE_PLAYING) return false;
+    
+    penguin_physics_update(&world->penguin, button_pressed);
+    ice_pillars_update(&world->pillars, game_engine_get_difficulty_multiplier(&world->game));
+    game_engine_update(&world->game);
+    
+    int penguin_x = penguin_physics_get_screen_x(&world->penguin);
+    int penguin_y = penguin_physics_get_screen_y(&world->penguin);
+    
+    ice_pillars_check_passed(&world->pillars, penguin_x);
+    
+    if (ice_pillars_check_collision(&world->pillars, penguin_x, penguin_y, PENGUIN_WIDTH, PENGUIN_HEIGHT) ||
+        game_engine_is_screen_edge_collision(&world->game, penguin_x, penguin_y, PENGUIN_WIDTH, PENGUIN_HEIGHT)) {
+        game_engine_end_game(&world->game);
+        return false;
+    }
+    
+    return true;
+}
+
+
+uint32_t game_sim_world_advance(game_world_t* world, bool button_pressed, uint32_t max_frames) {
+    if (!world) return 0;
+    
+    uint32_t frames = 0;
+    while (frames < max_frames && world->game.state == GAME_STATE_PLAYING) {
+        // The penguin never leaves the screen once it has been stepped, so
+        // only the pillars can end the game during a jump
+        uint32_t quiet = 0;
+        if (max_frames - frames >= GAME_SIM_MIN_JUMP_FRAMES &&
+            penguin_physics_is_within_screen_bounds(&world->penguin)) {
+            uint32_t limit = max_frames - frames;
+            uint32_t score_change = game_engine_frames_until_score_change(&world->game);
+            if (score_change < limit) limit = score_change;
+            
+            float min_y;
+            float max_y;
+            quiet = ice_pillars_quiet_frames(&world->pillars, game_engine_get_difficulty_multiplier(&world->game),
+                                             penguin_physics_get_screen_x(&world->penguin), PENGUIN_WIDTH,
+                                             PENGUIN_HEIGHT, limit, &min_y, &max_y);
+            if (quiet > 0) {
+                quiet = penguin_physics_advance_within(&world->penguin, button_pressed, quiet, min_y, max_y);
+            }
+        }
+        
+        if (quiet > 0) {
+            ice_pillars_advance_quiet(&world->pillars, quiet);
+            game_engine_advance(&world->game, quiet);
+            frames += quiet;
+        } else {
+            game_sim_world_step(world, button_pressed);
+            frames++;
+        }
+    }
+    return frames;
+}
\ No newline at end of file
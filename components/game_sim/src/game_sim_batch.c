@@ -0,0 +1,241 @@
+#include "game_sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Arrays are padded so every one of them starts on a 64-byte boundary
+// relative to the storage block and vector kernels never straddle two arrays
+#define BATCH_ALIGNMENT 64
+#define BATCH_WORLD_PADDING 16
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static void* carve(uint8_t** cursor, size_t bytes) {
+    void* block = *cursor;
+    *cursor += align_up(bytes, BATCH_ALIGNMENT);
+    return block;
+}
+
+static size_t batch_storage_size(int stride) {
+    size_t total = 0;
+    size_t n = (size_t)stride;
+    
+    // Game engine
+    total += align_up(n * sizeof(game_state_t), BATCH_ALIGNMENT);
+    total += align_up(n * sizeof(uint32_t), BATCH_ALIGNMENT) * 3;
+    total += align_up(n * sizeof(float), BATCH_ALIGNMENT);
+    
+    // Penguins
+    total += align_up(n * sizeof(float), BATCH_ALIGNMENT) * 4;
+    total += align_up(n * sizeof(uint8_t), BATCH_ALIGNMENT) * 2;
+    total += align_up(n * sizeof(uint32_t), BATCH_ALIGNMENT);
+    
+    // Pillars
+    size_t slots = n * MAX_PILLARS;
+    total += align_up(slots * sizeof(float), BATCH_ALIGNMENT);
+    total += align_up(slots * sizeof(int), BATCH_ALIGNMENT) * 4;
+    total += align_up(slots * sizeof(uint8_t), BATCH_ALIGNMENT) * 2;
+    total += align_up(n * sizeof(int), BATCH_ALIGNMENT);
+    total += align_up(n * sizeof(float), BATCH_ALIGNMENT) * 2;
+    total += align_up(n * sizeof(uint32_t), BATCH_ALIGNMENT) * 2;
+    total += align_up(n * sizeof(ice_pillars_rng_t), BATCH_ALIGNMENT);
+    
+    // Scratch
+    total += align_up(n * sizeof(uint8_t), BATCH_ALIGNMENT) * 2;
+    total += align_up(n * sizeof(int), BATCH_ALIGNMENT) * 2;
+    
+    return total + BATCH_ALIGNMENT;
+}
+
+bool game_sim_batch_init(game_sim_batch_t* batch, int world_count) {
+    if (!batch || world_count <= 0) return false;
+    
+    memset(batch, 0, sizeof(game_sim_batch_t));
+    
+    int stride = (int)align_up((size_t)world_count, BATCH_WORLD_PADDING);
+    size_t size = batch_storage_size(stride);
+    batch->storage = calloc(1, size);
+    if (!batch->storage) return false;
+    
+    batch->world_count = world_count;
+    batch->stride = stride;
+    
+    uint8_t* cursor = (uint8_t*)align_up((uintptr_t)batch->storage, BATCH_ALIGNMENT);
+    size_t n = (size_t)stride;
+    size_t slots = n * MAX_PILLARS;
+    
+    batch->game.state = carve(&cursor, n * sizeof(game_state_t));
+    batch->game.score = carve(&cursor, n * sizeof(uint32_t));
+    batch->game.high_score = carve(&cursor, n * sizeof(uint32_t));
+    batch->game.frame_count = carve(&cursor, n * sizeof(uint32_t));
+    batch->game.difficulty_multiplier = carve(&cursor, n * sizeof(float));
+    
+    batch->penguins.x = carve(&cursor, n * sizeof(float));
+    batch->penguins.y = carve(&cursor, n * sizeof(float));
+    batch->penguins.velocity_y = carve(&cursor, n * sizeof(float));
+    batch->penguins.acceleration_y = carve(&cursor, n * sizeof(float));
+    batch->penguins.button_pressed = carve(&cursor, n * sizeof(uint8_t));
+    batch->penguins.was_button_pressed = carve(&cursor, n * sizeof(uint8_t));
+    batch->penguins.button_press_duration = carve(&cursor, n * sizeof(uint32_t));
+    
+    batch->pillars.stride = stride;
+    batch->pillars.x = carve(&cursor, slots * sizeof(float));
+    batch->pillars.top_height = carve(&cursor, slots * sizeof(int));
+    batch->pillars.bottom_y = carve(&cursor, slots * sizeof(int));
+    batch->pillars.bottom_height = carve(&cursor, slots * sizeof(int));
+    batch->pillars.gap_size = carve(&cursor, slots * sizeof(int));
+    batch->pillars.active = carve(&cursor, slots * sizeof(uint8_t));
+    batch->pillars.passed = carve(&cursor, slots * sizeof(uint8_t));
+    batch->pillars.active_count = carve(&cursor, n * sizeof(int));
+    batch->pillars.scroll_speed = carve(&cursor, n * sizeof(float));
+    batch->pillars.difficulty_multiplier = carve(&cursor, n * sizeof(float));
+    batch->pillars.spawn_timer = carve(&cursor, n * sizeof(uint32_t));
+    batch->pillars.spawn_interval = carve(&cursor, n * sizeof(uint32_t));
+    batch->pillars.rng = carve(&cursor, n * sizeof(ice_pillars_rng_t));
+    
+    batch->playing = carve(&cursor, n * sizeof(uint8_t));
+    batch->collided = carve(&cursor, n * sizeof(uint8_t));
+    batch->penguin_x = carve(&cursor, n * sizeof(int));
+    batch->penguin_y = carve(&cursor, n * sizeof(int));
+    
+    for (int i = 0; i < world_count; i++) {
+        game_sim_batch_reset_world(batch, i);
+    }
+    
+    return true;
+}
+
+void game_sim_batch_deinit(game_sim_batch_t* batch) {
+    if (!batch) return;
+    
+    free(batch->storage);
+    memset(batch, 0, sizeof(game_sim_batch_t));
+}
+
+int game_sim_batch_step(game_sim_batch_t* batch, const uint8_t* button_pressed) {
+    if (!batch || !batch->storage || !button_pressed) return 0;
+    
+    const int count = batch->world_count;
+    
+    for (int i = 0; i < count; i++) {
+        batch->playing[i] = batch->game.state[i] == GAME_STATE_PLAYING;
+    }
+    
+    // Same stage order as game_sim_world_step()
+    penguin_physics_update_batch(&batch->penguins, button_pressed, batch->playing, count);
+    ice_pillars_update_batch(&batch->pillars, batch->game.difficulty_multiplier, batch->playing, count);
+    game_engine_update_batch(&batch->game, count);
+    
+    for (int i = 0; i < count; i++) {
+        batch->penguin_x[i] = (int)batch->penguins.x[i];
+        batch->penguin_y[i] = (int)batch->penguins.y[i];
+    }
+    
+    ice_pillars_check_passed_batch(&batch->pillars, batch->penguin_x, batch->playing, count);
+    ice_pillars_check_collision_batch(&batch->pillars, batch->penguin_x, batch->penguin_y,
+                                      PENGUIN_WIDTH, PENGUIN_HEIGHT, batch->playing, batch->collided, count);
+    
+    int still_playing = 0;
+    for (int i = 0; i < count; i++) {
+        if (!batch->playing[i]) continue;
+        
+        if (game_engine_is_screen_edge_collision(NULL, batch->penguin_x[i], batch->penguin_y[i],
+                                                 PENGUIN_WIDTH, PENGUIN_HEIGHT)) {
+            batch->collided[i] = 1;
+        }
+        if (!batch->collided[i]) {
+            still_playing++;
+        }
+    }
+    
+    game_engine_end_game_batch(&batch->game, batch->collided, count);
+    
+    return still_playing;
+}
+
+void game_sim_batch_reset_world(game_sim_batch_t* batch, int index) {
+    if (!batch || !batch->storage || index < 0 || index >= batch->world_count) return;
+    
+    game_world_t world;
+    game_sim_world_init(&world);
+    game_sim_batch_set_world(batch, index, &world);
+}
+
+bool game_sim_batch_set_world(game_sim_batch_t* batch, int index, const game_world_t* world) {
+    if (!batch || !batch->storage || !world || index < 0 || index >= batch->world_count) return false;
+    
+    batch->game.state[index] = world->game.state;
+    batch->game.score[index] = world->game.score;
+    batch->game.high_score[index] = world->game.high_score;
+    batch->game.frame_count[index] = world->game.frame_count;
+    batch->game.difficulty_multiplier[index] = world->game.difficulty_multiplier;
+    
+    batch->penguins.x[index] = world->penguin.x;
+    batch->penguins.y[index] = world->penguin.y;
+    batch->penguins.velocity_y[index] = world->penguin.velocity_y;
+    batch->penguins.acceleration_y[index] = world->penguin.acceleration_y;
+    batch->penguins.button_pressed[index] = world->penguin.button_pressed;
+    batch->penguins.was_button_pressed[index] = world->penguin.was_button_pressed;
+    batch->penguins.button_press_duration[index] = world->penguin.button_press_duration;
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        int p = i * batch->stride + index;
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        batch->pillars.x[p] = pillar->x;
+        batch->pillars.top_height[p] = pillar->top_height;
+        batch->pillars.bottom_y[p] = pillar->bottom_y;
+        batch->pillars.bottom_height[p] = pillar->bottom_height;
+        batch->pillars.gap_size[p] = pillar->gap_size;
+        batch->pillars.active[p] = pillar->active;
+        batch->pillars.passed[p] = pillar->passed;
+    }
+    batch->pillars.active_count[index] = world->pillars.active_count;
+    batch->pillars.scroll_speed[index] = world->pillars.scroll_speed;
+    batch->pillars.spawn_timer[index] = world->pillars.spawn_timer;
+    batch->pillars.spawn_interval[index] = world->pillars.spawn_interval;
+    batch->pillars.difficulty_multiplier[index] = world->pillars.difficulty_multiplier;
+    batch->pillars.rng[index] = world->pillars.rng;
+    
+    return true;
+}
+
+bool game_sim_batch_get_world(const game_sim_batch_t* batch, int index, game_world_t* world) {
+    if (!batch || !batch->storage || !world || index < 0 || index >= batch->world_count) return false;
+    
+    memset(world, 0, sizeof(game_world_t));
+    
+    world->game.state = batch->game.state[index];
+    world->game.score = batch->game.score[index];
+    world->game.high_score = batch->game.high_score[index];
+    world->game.frame_count = batch->game.frame_count[index];
+    world->game.difficulty_multiplier = batch->game.difficulty_multiplier[index];
+    
+    world->penguin.x = batch->penguins.x[index];
+    world->penguin.y = batch->penguins.y[index];
+    world->penguin.velocity_y = batch->penguins.velocity_y[index];
+    world->penguin.acceleration_y = batch->penguins.acceleration_y[index];
+    world->penguin.button_pressed = batch->penguins.button_pressed[index];
+    world->penguin.was_button_pressed = batch->penguins.was_button_pressed[index];
+    world->penguin.button_press_duration = batch->penguins.button_press_duration[index];
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        int p = i * batch->stride + index;
+        ice_pillar_t* pillar = &world->pillars.pillars[i];
+        pillar->x = batch->pillars.x[p];
+        pillar->top_height = batch->pillars.top_height[p];
+        pillar->bottom_y = batch->pillars.bottom_y[p];
+        pillar->bottom_height = batch->pillars.bottom_height[p];
+        pillar->gap_size = batch->pillars.gap_size[p];
+        pillar->active = batch->pillars.active[p];
+        pillar->passed = batch->pillars.passed[p];
+    }
+    world->pillars.active_count = batch->pillars.active_count[index];
+    world->pillars.scroll_speed = batch->pillars.scroll_speed[index];
+    world->pillars.spawn_timer = batch->pillars.spawn_timer[index];
+    world->pillars.spawn_interval = batch->pillars.spawn_interval[index];
+    world->pillars.difficulty_multiplier = batch->pillars.difficulty_multiplier[index];
+    world->pillars.rng = batch->pillars.rng[index];
+    
+    return true;
+}
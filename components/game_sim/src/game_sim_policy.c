@@ -0,0 +1,78 @@
+#include "game_sim_policy.h"
+#include <string.h>
+
+// Stateless mix of (episode, frame) so policies need no per-episode storage
+static uint32_t policy_hash(uint64_t episode, uint32_t frame) {
+    uint64_t z = episode * 0x9E3779B97F4A7C15ull + frame;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+bool game_sim_policy_random(const game_world_t* world, uint64_t episode) {
+    if (!world) return false;
+    return policy_hash(episode, world->game.frame_count) & 1;
+}
+
+bool game_sim_policy_periodic(const game_world_t* world, uint64_t episode) {
+    if (!world) return false;
+    
+    uint32_t period = 30 + policy_hash(episode, 0) % 90;
+    return (world->game.frame_count % period) < period * 2 / 5;
+}
+
+bool game_sim_policy_autopilot(const game_world_t* world, uint64_t episode) {
+    if (!world) return false;
+    
+    float target = SCREEN_HEIGHT / 2.0f;
+    float nearest_x = SCREEN_WIDTH * 2.0f;
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        if (!pillar->active || pillar->x + PILLAR_WIDTH < world->penguin.x) continue;
+        if (pillar->x < nearest_x) {
+            nearest_x = pillar->x;
+            target = pillar->top_height + pillar->gap_size / 2.0f;
+        }
+    }
+    
+    // Aim offsets between -16 and +15 pixels spread the runs out
+    int bias = (int)(policy_hash(episode, 0) % 32) - 16;
+    return world->penguin.y + PENGUIN_HEIGHT / 2.0f + bias < target;
+}
+
+static const game_sim_policy_t policies[] = {
+    {"random", "coin flip every frame", game_sim_policy_random},
+    {"periodic", "fixed hold/release cycle per episode", game_sim_policy_periodic},
+    {"autopilot", "steer toward the next gap", game_sim_policy_autopilot},
+};
+
+const game_sim_policy_t* game_sim_get_policies(int* count) {
+    if (count) {
+        *count = (int)(sizeof(policies) / sizeof(policies[0]));
+    }
+    return policies;
+}
+
+const game_sim_policy_t* game_sim_find_policy(const char* name) {
+    if (!name) return NULL;
+    
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++) {
+        if (strcmp(policies[i].name, name) == 0) {
+            return &policies[i];
+        }
+    }
+    return NULL;
+}
+
+uint32_t game_sim_run_episode(game_world_t* world, game_sim_policy_fn policy, uint64_t episode,
+                              uint32_t max_frames) {
+    if (!world || !policy) return 0;
+    
+    uint32_t frames = 0;
+    while (world->game.state == GAME_STATE_PLAYING && (max_frames == 0 || frames < max_frames)) {
+        game_sim_world_step(world, policy(world, episode));
+        frames++;
+    }
+    return frames;
+}
@@ -0,0 +1,205 @@
+#include "game_sim_replay.h"
+#include <string.h>
+
+static void put_u32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+void game_sim_replay_write_header(const game_sim_replay_header_t* header, uint8_t out[GAME_SIM_REPLAY_HEADER_SIZE]) {
+    if (!header || !out) return;
+    
+    memcpy(out, GAME_SIM_REPLAY_MAGIC, 4);
+    out[4] = GAME_SIM_REPLAY_VERSION;
+    out[5] = (uint8_t)header->rng_mode;
+    out[6] = 0;
+    out[7] = 0;
+    put_u32(out + 8, header->seed);
+    put_u32(out + 12, header->frame_count);
+    put_u32(out + 16, header->final_score);
+    put_u32(out + 20, header->payload_size);
+}
+
+bool game_sim_replay_read_header(const uint8_t* data, size_t size, game_sim_replay_header_t* header) {
+    if (!data || !header || size < GAME_SIM_REPLAY_HEADER_SIZE) return false;
+    if (memcmp(data, GAME_SIM_REPLAY_MAGIC, 4) != 0 || data[4] != GAME_SIM_REPLAY_VERSION) return false;
+    if (data[5] != ICE_PILLARS_RNG_LCG && data[5] != ICE_PILLARS_RNG_COUNTER) return false;
+    
+    header->rng_mode = (ice_pillars_rng_mode_t)data[5];
+    header->seed = get_u32(data + 8);
+    header->frame_count = get_u32(data + 12);
+    header->final_score = get_u32(data + 16);
+    header->payload_size = get_u32(data + 20);
+    return true;
+}
+
+int game_sim_replay_encode_varint(uint32_t value, uint8_t out[GAME_SIM_REPLAY_MAX_VARINT_SIZE]) {
+    int length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+bool game_sim_replay_recorder_init(game_sim_replay_recorder_t* recorder, uint8_t* ring, uint32_t capacity,
+                                   uint32_t seed, ice_pillars_rng_mode_t rng_mode) {
+    if (!recorder || !ring || capacity == 0) return false;
+    
+    memset(recorder, 0, sizeof(game_sim_replay_recorder_t));
+    recorder->ring = ring;
+    recorder->capacity = capacity;
+    recorder->header.seed = seed;
+    recorder->header.rng_mode = rng_mode;
+    return true;
+}
+
+// The ring positions are shared between the recording and the draining thread.
+// Each side owns one position and publishes it with release semantics, so the
+// bytes behind it are visible before the position that covers them.
+static inline uint32_t load_acquire(const uint32_t* pos) {
+    return __atomic_load_n(pos, __ATOMIC_ACQUIRE);
+}
+
+static inline void store_release(uint32_t* pos, uint32_t value) {
+    __atomic_store_n(pos, value, __ATOMIC_RELEASE);
+}
+
+static void recorder_emit_run(game_sim_replay_recorder_t* recorder, uint32_t length) {
+    if (recorder->overflowed) return;
+    
+    uint8_t bytes[GAME_SIM_REPLAY_MAX_VARINT_SIZE];
+    uint32_t count = (uint32_t)game_sim_replay_encode_varint(length, bytes);
+    
+    // Never overwrite bytes the reader has not drained yet
+    uint32_t write_pos = recorder->write_pos;
+    if (recorder->capacity - (write_pos - load_acquire(&recorder->read_pos)) < count) {
+        recorder->overflowed = true;
+        return;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        recorder->ring[(write_pos + i) % recorder->capacity] = bytes[i];
+    }
+    store_release(&recorder->write_pos, write_pos + count);
+    recorder->header.payload_size += count;
+}
+
+void game_sim_replay_recorder_record(game_sim_replay_recorder_t* recorder, bool button_pressed) {
+    if (!recorder || recorder->finished) return;
+    
+    recorder->header.frame_count++;
+    if (button_pressed == recorder->run_pressed) {
+        recorder->run_length++;
+        return;
+    }
+    
+    recorder_emit_run(recorder, recorder->run_length);
+    recorder->run_pressed = button_pressed;
+    recorder->run_length = 1;
+}
+
+void game_sim_replay_recorder_finish(game_sim_replay_recorder_t* recorder, uint32_t final_score) {
+    if (!recorder || recorder->finished) return;
+    
+    recorder_emit_run(recorder, recorder->run_length);
+    recorder->header.final_score = final_score;
+    recorder->finished = true;
+}
+
+uint32_t game_sim_replay_recorder_drain(game_sim_replay_recorder_t* recorder, uint8_t* out, uint32_t max_size) {
+    if (!recorder || !out) return 0;
+    
+    uint32_t read_pos = recorder->read_pos;
+    uint32_t count = load_acquire(&recorder->write_pos) - read_pos;
+    if (count > max_size) count = max_size;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = recorder->ring[(read_pos + i) % recorder->capacity];
+    }
+    store_release(&recorder->read_pos, read_pos + count);
+    return count;
+}
+
+uint32_t game_sim_replay_recorder_pending(const game_sim_replay_recorder_t* recorder) {
+    if (!recorder) return 0;
+    
+    return load_acquire(&recorder->write_pos) - load_acquire(&recorder->read_pos);
+}
+
+void game_sim_replay_reader_init(game_sim_replay_reader_t* reader, const uint8_t* payload, size_t size) {
+    if (!reader) return;
+    
+    reader->data = payload;
+    reader->size = payload ? size : 0;
+    reader->pos = 0;
+    reader->next_pressed = false;
+}
+
+bool game_sim_replay_reader_next_run(game_sim_replay_reader_t* reader, bool* button_pressed, uint32_t* length) {
+    if (!reader || !button_pressed || !length) return false;
+    
+    uint32_t value = 0;
+    size_t pos = reader->pos;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= reader->size) return false;
+        
+        uint8_t byte = reader->data[pos++];
+        // The fifth byte may only carry the top four bits of a 32-bit value
+        if (shift == 28 && byte > 0x0F) return false;
+        
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            reader->pos = pos;
+            *button_pressed = reader->next_pressed;
+            *length = value;
+            reader->next_pressed = !reader->next_pressed;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool game_sim_replay_play(const uint8_t* replay, size_t size, game_world_t* world, game_sim_replay_result_t* result) {
+    game_sim_replay_result_t local = {0};
+    game_sim_replay_header_t header;
+    
+    bool decoded = world && game_sim_replay_read_header(replay, size, &header) &&
+                   size - GAME_SIM_REPLAY_HEADER_SIZE >= header.payload_size;
+    
+    if (decoded) {
+        game_sim_world_init_seeded(world, header.seed, header.rng_mode);
+        
+        game_sim_replay_reader_t reader;
+        game_sim_replay_reader_init(&reader, replay + GAME_SIM_REPLAY_HEADER_SIZE, header.payload_size);
+        
+        bool running = true;
+        bool pressed;
+        uint32_t length;
+        uint64_t recorded_frames = 0;
+        while (running && game_sim_replay_reader_next_run(&reader, &pressed, &length)) {
+            recorded_frames += length;
+            // Input is constant for the whole run, so jump between game events
+            local.frames += game_sim_world_advance(world, pressed, length);
+            running = world->game.state == GAME_STATE_PLAYING;
+        }
+        
+        // Every byte must have decoded and the game must end exactly on the last
+        // recorded frame, not partway through the final run
+        decoded = reader.pos == reader.size;
+        local.score = world->game.score;
+        local.game_over = world->game.state == GAME_STATE_GAME_OVER;
+        local.matches = decoded && local.frames == recorded_frames && local.frames == header.frame_count &&
+                        local.game_over && local.score == header.final_score;
+    }
+    
+    if (result) *result = local;
+    return local.matches;
+}
@@ -0,0 +1,92 @@
+#include "game_sim_snapshot.h"
+
+_Static_assert(sizeof(game_sim_snapshot_t) == GAME_SIM_SNAPSHOT_SIZE, "snapshot must stay two cache lines");
+_Static_assert(MAX_PILLARS <= 4, "pillar flags hold four active and four passed bits");
+
+#define PENGUIN_FLAG_PRESSED 0x01
+#define PENGUIN_FLAG_WAS_PRESSED 0x02
+#define PILLAR_PASSED_SHIFT 4
+
+void game_sim_snapshot_save(const game_world_t* restrict world, game_sim_snapshot_t* restrict snapshot) {
+    if (!world || !snapshot) return;
+    
+    snapshot->score = world->game.score;
+    snapshot->high_score = world->game.high_score;
+    snapshot->frame_count = world->game.frame_count;
+    snapshot->difficulty_multiplier = world->game.difficulty_multiplier;
+    snapshot->game_state = (uint8_t)world->game.state;
+    
+    snapshot->penguin_x = world->penguin.x;
+    snapshot->penguin_y = world->penguin.y;
+    snapshot->velocity_y = world->penguin.velocity_y;
+    snapshot->acceleration_y = world->penguin.acceleration_y;
+    snapshot->button_press_duration = world->penguin.button_press_duration;
+    snapshot->penguin_flags = (world->penguin.button_pressed ? PENGUIN_FLAG_PRESSED : 0) |
+                              (world->penguin.was_button_pressed ? PENGUIN_FLAG_WAS_PRESSED : 0);
+    
+    uint8_t pillar_flags = 0;
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        snapshot->pillar_x[i] = pillar->x;
+        snapshot->top_height[i] = (int16_t)pillar->top_height;
+        snapshot->bottom_y[i] = (int16_t)pillar->bottom_y;
+        snapshot->bottom_height[i] = (int16_t)pillar->bottom_height;
+        snapshot->gap_size[i] = (int16_t)pillar->gap_size;
+        pillar_flags |= (pillar->active ? 1 : 0) << i;
+        pillar_flags |= (pillar->passed ? 1 : 0) << (i + PILLAR_PASSED_SHIFT);
+    }
+    snapshot->pillar_flags = pillar_flags;
+    snapshot->active_count = (int8_t)world->pillars.active_count;
+    snapshot->scroll_speed = world->pillars.scroll_speed;
+    snapshot->spawn_timer = world->pillars.spawn_timer;
+    snapshot->spawn_interval = world->pillars.spawn_interval;
+    snapshot->pillar_difficulty_multiplier = world->pillars.difficulty_multiplier;
+    
+    snapshot->rng_mode = (uint8_t)world->pillars.rng.mode;
+    snapshot->rng_seed = world->pillars.rng.seed;
+    snapshot->rng_state = world->pillars.rng.state;
+    snapshot->rng_draw_count = world->pillars.rng.draw_count;
+    
+    for (int i = 0; i < (int)sizeof(snapshot->reserved); i++) {
+        snapshot->reserved[i] = 0;
+    }
+}
+
+void game_sim_snapshot_restore(const game_sim_snapshot_t* restrict snapshot, game_world_t* restrict world) {
+    if (!snapshot || !world) return;
+    
+    world->game.score = snapshot->score;
+    world->game.high_score = snapshot->high_score;
+    world->game.frame_count = snapshot->frame_count;
+    world->game.difficulty_multiplier = snapshot->difficulty_multiplier;
+    world->game.state = (game_state_t)snapshot->game_state;
+    
+    world->penguin.x = snapshot->penguin_x;
+    world->penguin.y = snapshot->penguin_y;
+    world->penguin.velocity_y = snapshot->velocity_y;
+    world->penguin.acceleration_y = snapshot->acceleration_y;
+    world->penguin.button_press_duration = snapshot->button_press_duration;
+    world->penguin.button_pressed = (snapshot->penguin_flags & PENGUIN_FLAG_PRESSED) != 0;
+    world->penguin.was_button_pressed = (snapshot->penguin_flags & PENGUIN_FLAG_WAS_PRESSED) != 0;
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        ice_pillar_t* pillar = &world->pillars.pillars[i];
+        pillar->x = snapshot->pillar_x[i];
+        pillar->top_height = snapshot->top_height[i];
+        pillar->bottom_y = snapshot->bottom_y[i];
+        pillar->bottom_height = snapshot->bottom_height[i];
+        pillar->gap_size = snapshot->gap_size[i];
+        pillar->active = (snapshot->pillar_flags >> i) & 1;
+        pillar->passed = (snapshot->pillar_flags >> (i + PILLAR_PASSED_SHIFT)) & 1;
+    }
+    world->pillars.active_count = snapshot->active_count;
+    world->pillars.scroll_speed = snapshot->scroll_speed;
+    world->pillars.spawn_timer = snapshot->spawn_timer;
+    world->pillars.spawn_interval = snapshot->spawn_interval;
+    world->pillars.difficulty_multiplier = snapshot->pillar_difficulty_multiplier;
+    
+    world->pillars.rng.mode = (ice_pillars_rng_mode_t)snapshot->rng_mode;
+    world->pillars.rng.seed = snapshot->rng_seed;
+    world->pillars.rng.state = snapshot->rng_state;
+    world->pillars.rng.draw_count = snapshot->rng_draw_count;
+}
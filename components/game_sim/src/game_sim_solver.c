@@ -0,0 +1,644 @@
+#include "game_sim_solver.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GAME_SIM_SOLVER_X86_KERNELS 1
+#else
+#define GAME_SIM_SOLVER_X86_KERNELS 0
+#endif
+
+#define SOLVER_MAX_Y (SCREEN_HEIGHT - PENGUIN_HEIGHT)
+// Margin for the rounding of y + velocity; far more than half an ulp of y below 256
+#define SOLVER_ROUNDING_MARGIN (1.0 / 4096.0)
+
+static int find_or_add_velocity(game_sim_solver_t* solver, float velocity, bool pressed) {
+    for (int i = 0; i < solver->velocity_count; i++) {
+        game_sim_solver_velocity_t* entry = &solver->velocities[i];
+        if (entry->pressed == pressed && memcmp(&entry->velocity, &velocity, sizeof(float)) == 0) return i;
+    }
+    if (solver->velocity_count == GAME_SIM_SOLVER_MAX_VELOCITIES) return -1;
+    
+    game_sim_solver_velocity_t* entry = &solver->velocities[solver->velocity_count];
+    memset(entry, 0, sizeof(game_sim_solver_velocity_t));
+    entry->velocity = velocity;
+    entry->pressed = pressed;
+    
+    // y in [c, c + 1) cells lands in [c + v, c + 1 + v) cells before rounding.
+    // When v is a whole number of cells the lower end is exact.
+    double scale = (double)(1 << solver->subpixel_bits);
+    double cells = velocity * scale;
+    if (velocity == 0.0f) {
+        entry->shift_min = 0;
+        entry->shift_max = 0;
+    } else if (cells == floor(cells)) {
+        entry->shift_min = (int8_t)cells;
+        entry->shift_max = (int8_t)(cells + 1.0);
+    } else {
+        entry->shift_min = (int8_t)floor(cells - SOLVER_ROUNDING_MARGIN * scale);
+        entry->shift_max = (int8_t)floor(cells + SOLVER_ROUNDING_MARGIN * scale) + 1;
+    }
+    return solver->velocity_count++;
+}
+
+// Two velocities can share a row when they have the same button state and
+// shift, and both inputs lead to velocities that can share a row. Refines
+// that partition until it is stable; the grid then tracks exactly the same
+// cells with fewer rows.
+static void group_rows(game_sim_solver_t* solver) {
+    int count = solver->velocity_count;
+    int row[GAME_SIM_SOLVER_MAX_VELOCITIES];
+    int key[GAME_SIM_SOLVER_MAX_VELOCITIES][3];
+    for (int i = 0; i < count; i++) {
+        const game_sim_solver_velocity_t* entry = &solver->velocities[i];
+        key[i][0] = entry->pressed;
+        key[i][1] = entry->shift_min;
+        key[i][2] = entry->shift_max;
+    }
+    
+    int row_count = 0;
+    for (;;) {
+        int next_count = 0;
+        for (int i = 0; i < count; i++) {
+            row[i] = next_count;
+            for (int j = 0; j < i; j++) {
+                if (memcmp(key[i], key[j], sizeof(key[i])) == 0) {
+                    row[i] = row[j];
+                    break;
+                }
+            }
+            if (row[i] == next_count) next_count++;
+        }
+        if (next_count == row_count) break;
+        row_count = next_count;
+        
+        for (int i = 0; i < count; i++) {
+            key[i][1] = row[solver->velocities[i].next[0]];
+            key[i][2] = row[solver->velocities[i].next[1]];
+            key[i][0] = row[i];
+        }
+    }
+    
+    solver->row_count = row_count;
+    memset(solver->rows, 0, sizeof(solver->rows));
+    for (int i = 0; i < count; i++) {
+        game_sim_solver_velocity_t* entry = &solver->velocities[i];
+        game_sim_solver_row_t* target = &solver->rows[row[i]];
+        entry->row = (uint8_t)row[i];
+        target->pressed = entry->pressed;
+        target->shift_min = entry->shift_min;
+        target->shift_max = entry->shift_max;
+    }
+    
+    // Every velocity of a row leads to the same rows, so the first one speaks for all
+    for (int r = 0; r < row_count; r++) {
+        for (int i = 0; i < count; i++) {
+            if (row[i] != r) continue;
+            for (int pressed = 0; pressed < 2; pressed++) {
+                game_sim_solver_row_t* target = &solver->rows[row[solver->velocities[i].next[pressed]]];
+                target->sources[target->source_count++] = (uint8_t)r;
+            }
+            break;
+        }
+    }
+}
+
+bool game_sim_solver_init(game_sim_solver_t* solver, int subpixel_bits) {
+    if (!solver || subpixel_bits < 0 || subpixel_bits > GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS) return false;
+    
+    memset(solver, 0, sizeof(game_sim_solver_t));
+    solver->subpixel_bits = subpixel_bits;
+    solver->cells = (SOLVER_MAX_Y << subpixel_bits) + 1;
+    solver->words = GAME_SIM_SOLVER_WORDS(solver->cells);
+    
+    penguin_t start;
+    penguin_physics_init(&start);
+    solver->penguin_x = penguin_physics_get_screen_x(&start);
+    int start_velocity = find_or_add_velocity(solver, start.velocity_y, start.button_pressed);
+    
+    int rest[2];
+    for (int pressed = 0; pressed < 2; pressed++) {
+        rest[pressed] = find_or_add_velocity(solver, 0.0f, pressed);
+    }
+    
+    // A frame starts from the velocity and button state and nothing else, so
+    // probing each velocity once per input finds the whole closed set
+    for (int i = 0; i < solver->velocity_count; i++) {
+        for (int pressed = 0; pressed < 2; pressed++) {
+            penguin_t probe = start;
+            probe.y = SCREEN_HEIGHT / 2; // Far enough from both edges not to clamp
+            probe.velocity_y = solver->velocities[i].velocity;
+            probe.button_pressed = solver->velocities[i].pressed;
+            penguin_physics_update(&probe, pressed);
+            
+            int next = find_or_add_velocity(solver, probe.velocity_y, pressed);
+            if (next < 0) return false;
+            solver->velocities[i].next[pressed] = (uint8_t)next;
+        }
+    }
+    
+    group_rows(solver);
+    solver->start_velocity = (uint8_t)start_velocity;
+    solver->rest_velocity[0] = (uint8_t)rest[0];
+    solver->rest_velocity[1] = (uint8_t)rest[1];
+    solver->start_row = solver->velocities[start_velocity].row;
+    solver->rest_row[0] = solver->velocities[rest[0]].row;
+    solver->rest_row[1] = solver->velocities[rest[1]].row;
+    return true;
+}
+
+typedef game_sim_solver_word_t word_t;
+
+// Inputs and outputs of one frame of the grid, per lane
+typedef struct {
+    const word_t* from;
+    word_t* to;
+    word_t mask[GAME_SIM_SOLVER_MAX_WORDS]; // Cells whose pixel row clears every pillar
+    word_t top_open;               // All ones where nothing covers the top edge
+    word_t bottom_open;
+    word_t any;                    // Nonzero where some state survived
+} solver_frame_t;
+
+// dst = src moved `shift` cells up (towards the bottom of the screen). Bits
+// moved below cell 0 are dropped and flagged in `clamped`, since that y gets
+// clamped.
+static inline __attribute__((always_inline)) void shift_into(word_t* dst, const word_t* src, int words, int shift,
+                                                             word_t* clamped) {
+    if (shift == 0) {
+        for (int w = 0; w < words; w++) dst[w] = src[w];
+        return;
+    }
+    if (shift > 0) {
+        for (int w = words - 1; w > 0; w--) dst[w] = (src[w] << shift) | (src[w - 1] >> (64 - shift));
+        dst[0] = src[0] << shift;
+        return;
+    }
+    
+    int k = -shift;
+    for (int w = 0; w < words - 1; w++) dst[w] = (src[w] >> k) | (src[w + 1] << (64 - k));
+    dst[words - 1] = src[words - 1] >> k;
+    *clamped |= src[0] & ((1ull << k) - 1);
+}
+
+// One frame of the grid: every row gathers the rows that lead to it, moves
+// them by its shift range and keeps only the cells the mask allows
+static inline __attribute__((always_inline)) void propagate(const game_sim_solver_t* solver, solver_frame_t* frame,
+                                                            const int words) {
+    const int last = solver->cells - 1;
+    word_t hit_top[2] = {{0}, {0}};
+    word_t hit_bottom[2] = {{0}, {0}};
+    word_t any = {0};
+    
+    for (int t = 0; t < solver->row_count; t++) {
+        const game_sim_solver_row_t* row = &solver->rows[t];
+        word_t* dst = frame->to + t * words;
+        word_t sources[GAME_SIM_SOLVER_MAX_WORDS];
+        for (int w = 0; w < words; w++) sources[w] = (word_t){0};
+        for (int i = 0; i < row->source_count; i++) {
+            const word_t* source = frame->from + row->sources[i] * words;
+            for (int w = 0; w < words; w++) sources[w] |= source[w];
+        }
+        
+        // Spread each cell over the shift range, then move it once
+        for (int spread = row->shift_min; spread < row->shift_max; spread++) {
+            for (int w = words - 1; w > 0; w--) sources[w] |= (sources[w] << 1) | (sources[w - 1] >> 63);
+            sources[0] |= sources[0] << 1;
+        }
+        shift_into(dst, sources, words, row->shift_min, &hit_top[row->pressed]);
+        
+        // Anything at or past the bottom cell may have been clamped there with
+        // its velocity zeroed. The exact bottom edge is also a valid unclamped y.
+        word_t below = dst[last / 64] >> (last % 64);
+        for (int w = last / 64 + 1; w < words; w++) below |= dst[w];
+        hit_bottom[row->pressed] |= below;
+        
+        // Keep only the cells whose pixel row clears every pillar
+        for (int w = 0; w < words; w++) {
+            dst[w] &= frame->mask[w];
+            any |= dst[w];
+        }
+    }
+    
+    for (int pressed = 0; pressed < 2; pressed++) {
+        word_t* rest = frame->to + solver->rest_row[pressed] * words;
+        word_t top = (word_t)(hit_top[pressed] != 0) & frame->top_open & 1;
+        word_t bottom = (word_t)(hit_bottom[pressed] != 0) & frame->bottom_open & (1ull << (last % 64));
+        rest[0] |= top;
+        rest[last / 64] |= bottom;
+        any |= top | bottom;
+    }
+    frame->any = any;
+}
+
+// Fixed row sizes let the compiler unroll every word loop
+static inline __attribute__((always_inline)) void propagate_sized(const game_sim_solver_t* solver,
+                                                                  solver_frame_t* frame) {
+    switch (solver->words) {
+        case 4: propagate(solver, frame, 4); break;
+        case 8: propagate(solver, frame, 8); break;
+        case 15: propagate(solver, frame, 15); break;
+        default: propagate(solver, frame, solver->words); break;
+    }
+}
+
+static void propagate_generic(const game_sim_solver_t* solver, solver_frame_t* frame) {
+    propagate_sized(solver, frame);
+}
+
+#if GAME_SIM_SOLVER_X86_KERNELS
+// One lane per 64-bit element fills a 256-bit register exactly
+__attribute__((target("avx2")))
+static void propagate_avx2(const game_sim_solver_t* solver, solver_frame_t* frame) {
+    propagate_sized(solver, frame);
+}
+#endif
+
+typedef void (*propagate_fn_t)(const game_sim_solver_t* solver, solver_frame_t* frame);
+
+static propagate_fn_t propagate_kernel(void) {
+    static propagate_fn_t kernel = NULL;
+    if (!kernel) {
+        // Detection is idempotent, so racing first callers all pick the same kernel
+#if GAME_SIM_SOLVER_X86_KERNELS
+        kernel = __builtin_cpu_supports("avx2") ? propagate_avx2 : propagate_generic;
+#else
+        kernel = propagate_generic;
+#endif
+    }
+    return kernel;
+}
+
+static int start_cell(const game_sim_solver_t* solver, const penguin_t* start) {
+    return (int)floorf(start->y * (float)(1 << solver->subpixel_bits));
+}
+
+void game_sim_solver_start_lane(game_sim_solver_t* solver, int lane, uint32_t seed, ice_pillars_rng_mode_t mode) {
+    if (!solver || lane < 0 || lane >= GAME_SIM_SOLVER_LANES) return;
+    
+    game_sim_solver_lane_t* state = &solver->lanes[lane];
+    game_engine_init(&state->game);
+    game_engine_start_game(&state->game);
+    ice_pillars_init_seeded(&state->pillars, seed, mode);
+    state->frame = 0;
+    state->running = true;
+    
+    // Every row of the other buffer is rewritten by the next frame
+    word_t* reach = solver->reach[solver->current];
+    for (int w = 0; w < solver->row_count * solver->words; w++) reach[w][lane] = 0;
+    
+    penguin_t start;
+    penguin_physics_init(&start);
+    int cell = start_cell(solver, &start);
+    reach[solver->start_row * solver->words + cell / 64][lane] = 1ull << (cell % 64);
+}
+
+void game_sim_solver_reset(game_sim_solver_t* solver, uint32_t seed, ice_pillars_rng_mode_t mode) {
+    if (!solver) return;
+    
+    solver->current = 0;
+    memset(solver->reach, 0, sizeof(solver->reach));
+    for (int lane = 1; lane < GAME_SIM_SOLVER_LANES; lane++) solver->lanes[lane].running = false;
+    game_sim_solver_start_lane(solver, 0, seed, mode);
+}
+
+// Pixel rows [min_y, max_y] the penguin's top can be on without touching a pillar
+static void pillar_window(const game_sim_solver_t* solver, const ice_pillars_context_t* pillars,
+                          int* min_y, int* max_y) {
+    *min_y = 0;
+    *max_y = SOLVER_MAX_Y;
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &pillars->pillars[i];
+        int pillar_x = (int)pillar->x;
+        if (!pillar->active || solver->penguin_x >= pillar_x + PILLAR_WIDTH ||
+            solver->penguin_x + PENGUIN_WIDTH <= pillar_x) continue;
+        
+        if (pillar->top_height > *min_y) *min_y = pillar->top_height;
+        if (pillar->bottom_y - PENGUIN_HEIGHT < *max_y) *max_y = pillar->bottom_y - PENGUIN_HEIGHT;
+    }
+}
+
+// Advances every running lane and stops the ones nothing survives in
+static void step_lanes(game_sim_solver_t* solver) {
+    solver_frame_t frame;
+    bool running = false;
+    for (int lane = 0; lane < GAME_SIM_SOLVER_LANES; lane++) {
+        game_sim_solver_lane_t* state = &solver->lanes[lane];
+        int first = 0;
+        int end = solver->cells;
+        if (state->running) {
+            // The pillars never depend on the penguin, so step them first to
+            // know which heights survive this frame
+            ice_pillars_update(&state->pillars, game_engine_get_difficulty_multiplier(&state->game));
+            game_engine_update(&state->game);
+            state->frame++;
+            running = true;
+            
+            int min_y, max_y;
+            pillar_window(solver, &state->pillars, &min_y, &max_y);
+            first = min_y << solver->subpixel_bits;
+            end = (max_y + 1) << solver->subpixel_bits; // Exclusive
+            if (end > solver->cells) end = solver->cells;
+        }
+        
+        for (int w = 0; w < solver->words; w++) {
+            int low = w * 64;
+            uint64_t bits = ~0ull;
+            if (first > low) bits = first >= low + 64 ? 0 : bits & (~0ull << (first - low));
+            if (end < low + 64) bits = end <= low ? 0 : bits & (~0ull >> (64 - (end - low)));
+            frame.mask[w][lane] = bits;
+        }
+        frame.top_open[lane] = first == 0 ? ~0ull : 0;
+        frame.bottom_open[lane] = end == solver->cells ? ~0ull : 0;
+    }
+    if (!running) return;
+    
+    frame.from = solver->reach[solver->current];
+    frame.to = solver->reach[solver->current ^ 1];
+    propagate_kernel()(solver, &frame);
+    solver->current ^= 1;
+    
+    for (int lane = 0; lane < GAME_SIM_SOLVER_LANES; lane++) {
+        if (frame.any[lane] == 0) solver->lanes[lane].running = false;
+    }
+}
+
+bool game_sim_solver_step(game_sim_solver_t* solver) {
+    if (!solver) return false;
+    
+    step_lanes(solver);
+    return solver->lanes[0].running;
+}
+
+bool game_sim_solver_is_reachable(const game_sim_solver_t* solver, const penguin_t* penguin) {
+    if (!solver || !penguin) return false;
+    
+    int cell = (int)floorf(penguin->y * (float)(1 << solver->subpixel_bits));
+    if (cell < 0 || cell >= solver->cells) return false;
+    
+    for (int i = 0; i < solver->velocity_count; i++) {
+        const game_sim_solver_velocity_t* entry = &solver->velocities[i];
+        if (entry->pressed != penguin->button_pressed ||
+            memcmp(&entry->velocity, &penguin->velocity_y, sizeof(float)) != 0) continue;
+        const word_t* row = solver->reach[solver->current] + entry->row * solver->words;
+        return (row[cell / 64][0] >> (cell % 64)) & 1;
+    }
+    return false;
+}
+
+uint32_t game_sim_solver_max_survival(game_sim_solver_t* solver, uint32_t seed, ice_pillars_rng_mode_t mode,
+                                      uint32_t max_frames) {
+    if (!solver) return 0;
+    
+    uint32_t bound;
+    game_sim_solver_max_survival_many(solver, seed, 1, mode, max_frames, &bound);
+    return bound;
+}
+
+void game_sim_solver_max_survival_many(game_sim_solver_t* solver, uint32_t first_seed, uint32_t count,
+                                       ice_pillars_rng_mode_t mode, uint32_t max_frames, uint32_t* bounds) {
+    if (!solver || !bounds) return;
+    
+    solver->current = 0;
+    memset(solver->reach, 0, sizeof(solver->reach));
+    uint32_t seed_of[GAME_SIM_SOLVER_LANES];
+    uint32_t next = 0;
+    int running = 0;
+    for (int lane = 0; lane < GAME_SIM_SOLVER_LANES; lane++) solver->lanes[lane].running = false;
+    
+    // A lane that finishes takes the next seed, so every lane keeps working
+    // until the seeds run out
+    for (;;) {
+        for (int lane = 0; lane < GAME_SIM_SOLVER_LANES; lane++) {
+            if (solver->lanes[lane].running || next == count) continue;
+            if (max_frames == 0) {
+                bounds[next++] = 0;
+                lane--;
+                continue;
+            }
+            seed_of[lane] = next++;
+            game_sim_solver_start_lane(solver, lane, first_seed + seed_of[lane], mode);
+            running++;
+        }
+        if (running == 0) break;
+        
+        step_lanes(solver);
+        for (int lane = 0; lane < GAME_SIM_SOLVER_LANES; lane++) {
+            game_sim_solver_lane_t* state = &solver->lanes[lane];
+            if (state->frame == 0) continue;
+            if (!state->running) {
+                bounds[seed_of[lane]] = state->frame - 1;
+            } else if (state->frame == max_frames) {
+                bounds[seed_of[lane]] = state->frame;
+                state->running = false;
+            } else {
+                continue;
+            }
+            state->frame = 0; // Reported
+            running--;
+        }
+    }
+}
+
+// Grows `*buffer` to hold at least `needed` items of `size` bytes
+static bool reserve(void** buffer, uint32_t* capacity, uint64_t needed, size_t size) {
+    if (needed <= *capacity) return true;
+    if (needed > UINT32_MAX / 2) return false;
+    
+    uint32_t grown = *capacity ? *capacity : 256;
+    while (grown < needed) grown *= 2;
+    void* bigger = realloc(*buffer, (size_t)grown * size);
+    if (!bigger) return false;
+    *buffer = bigger;
+    *capacity = grown;
+    return true;
+}
+
+bool game_sim_solver_witness_init(game_sim_solver_witness_t* witness, const game_sim_solver_t* solver) {
+    if (!witness || !solver) return false;
+    
+    memset(witness, 0, sizeof(game_sim_solver_witness_t));
+    witness->seen = (uint32_t*)calloc((size_t)solver->velocity_count * solver->cells, sizeof(uint32_t));
+    return witness->seen != NULL;
+}
+
+void game_sim_solver_witness_deinit(game_sim_solver_witness_t* witness) {
+    if (!witness) return;
+    
+    free(witness->states[0]);
+    free(witness->states[1]);
+    free(witness->seen);
+    free(witness->links);
+    free(witness->saved_states);
+    free(witness->saves);
+    memset(witness, 0, sizeof(game_sim_solver_witness_t));
+}
+
+// Moves each state one frame with both inputs, the same way
+// penguin_physics_update() does, and keeps the first state of each velocity
+// and cell whose pixel row is in [min_y, max_y]. With `link_count` set, also
+// records each kept state's parent and input. Returns the number kept, or -1
+// when memory runs out.
+static int64_t witness_frame(game_sim_solver_witness_t* witness, const game_sim_solver_t* solver, int from_index,
+                             uint32_t count, int min_y, int max_y, uint32_t* link_count) {
+    int to_index = from_index ^ 1;
+    if (!reserve((void**)&witness->states[to_index], &witness->state_capacity[to_index], (uint64_t)count * 2,
+                 sizeof(game_sim_solver_state_t))) return -1;
+    if (link_count && !reserve((void**)&witness->links, &witness->link_capacity, (uint64_t)*link_count + count * 2,
+                               sizeof(uint32_t))) return -1;
+    
+    if (++witness->stamp == 0) {
+        memset(witness->seen, 0, (size_t)solver->velocity_count * solver->cells * sizeof(uint32_t));
+        witness->stamp = 1;
+    }
+    const uint32_t stamp = witness->stamp;
+    const float scale = (float)(1 << solver->subpixel_bits);
+    const game_sim_solver_state_t* from = witness->states[from_index];
+    game_sim_solver_state_t* to = witness->states[to_index];
+    uint32_t kept = 0;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        const game_sim_solver_velocity_t* entry = &solver->velocities[from[i].velocity];
+        for (int pressed = 0; pressed < 2; pressed++) {
+            int velocity = entry->next[pressed];
+            float y = from[i].y + solver->velocities[velocity].velocity;
+            if (y < 0) {
+                y = 0;
+                velocity = solver->rest_velocity[pressed];
+            } else if (y > SOLVER_MAX_Y) {
+                y = SOLVER_MAX_Y;
+                velocity = solver->rest_velocity[pressed];
+            }
+            
+            int screen_y = (int)y;
+            if (screen_y < min_y || screen_y > max_y) continue;
+            uint32_t* seen = &witness->seen[velocity * solver->cells + (int)floorf(y * scale)];
+            if (*seen == stamp) continue;
+            *seen = stamp;
+            
+            to[kept].y = y;
+            to[kept].velocity = (uint8_t)velocity;
+            if (link_count) witness->links[(*link_count)++] = i << 1 | (uint32_t)pressed;
+            kept++;
+        }
+    }
+    return kept;
+}
+
+// Steps the pillars and moves the current states one frame
+static int64_t witness_step(game_sim_solver_witness_t* witness, const game_sim_solver_t* solver,
+                            game_context_t* game, ice_pillars_context_t* pillars, int* current, uint32_t count,
+                            uint32_t* link_count) {
+    ice_pillars_update(pillars, game_engine_get_difficulty_multiplier(game));
+    game_engine_update(game);
+    
+    int min_y, max_y;
+    pillar_window(solver, pillars, &min_y, &max_y);
+    int64_t kept = witness_frame(witness, solver, *current, count, min_y, max_y, link_count);
+    if (kept > 0) *current ^= 1;
+    return kept;
+}
+
+static bool witness_save(game_sim_solver_witness_t* witness, const game_sim_solver_state_t* states, uint32_t count,
+                         const game_context_t* game, const ice_pillars_context_t* pillars) {
+    uint32_t first = 0;
+    if (witness->save_count > 0) {
+        const game_sim_solver_save_t* last = &witness->saves[witness->save_count - 1];
+        first = last->first + last->count;
+    }
+    if (!reserve((void**)&witness->saved_states, &witness->saved_capacity, (uint64_t)first + count,
+                 sizeof(game_sim_solver_state_t)) ||
+        !reserve((void**)&witness->saves, &witness->save_capacity, (uint64_t)witness->save_count + 1,
+                 sizeof(game_sim_solver_save_t))) return false;
+    
+    memcpy(witness->saved_states + first, states, count * sizeof(game_sim_solver_state_t));
+    game_sim_solver_save_t* save = &witness->saves[witness->save_count++];
+    save->first = first;
+    save->count = count;
+    save->game = *game;
+    save->pillars = *pillars;
+    return true;
+}
+
+// Puts the search back where `save` left it
+static bool witness_restore(game_sim_solver_witness_t* witness, const game_sim_solver_save_t* save,
+                            game_context_t* game, ice_pillars_context_t* pillars) {
+    if (!reserve((void**)&witness->states[0], &witness->state_capacity[0], save->count,
+                 sizeof(game_sim_solver_state_t))) return false;
+    
+    memcpy(witness->states[0], witness->saved_states + save->first, save->count * sizeof(game_sim_solver_state_t));
+    *game = save->game;
+    *pillars = save->pillars;
+    return true;
+}
+
+uint32_t game_sim_solver_min_survival(game_sim_solver_witness_t* witness, const game_sim_solver_t* solver,
+                                      uint32_t seed, ice_pillars_rng_mode_t mode, uint32_t max_frames,
+                                      uint8_t* inputs, uint32_t* input_count) {
+    if (input_count) *input_count = 0;
+    if (!witness || !witness->seen || !solver) return 0;
+    
+    const uint32_t stride = GAME_SIM_SOLVER_WITNESS_STRIDE;
+    game_context_t game;
+    ice_pillars_context_t pillars;
+    game_engine_init(&game);
+    game_engine_start_game(&game);
+    ice_pillars_init_seeded(&pillars, seed, mode);
+    
+    penguin_t start;
+    penguin_physics_init(&start);
+    if (!reserve((void**)&witness->states[0], &witness->state_capacity[0], 1, sizeof(game_sim_solver_state_t))) {
+        return 0;
+    }
+    witness->states[0][0].y = start.y;
+    witness->states[0][0].velocity = solver->start_velocity;
+    int current = 0;
+    uint32_t count = 1;
+    witness->save_count = 0;
+    
+    // Search forward, saving the states every `stride` frames
+    uint32_t frame = 0;
+    while (frame < max_frames) {
+        if (inputs && frame % stride == 0 &&
+            !witness_save(witness, witness->states[current], count, &game, &pillars)) return 0;
+        
+        int64_t kept = witness_step(witness, solver, &game, &pillars, &current, count, NULL);
+        if (kept < 0) return 0;
+        if (kept == 0) break;
+        count = (uint32_t)kept;
+        frame++;
+    }
+    if (!inputs) return frame;
+    
+    // Walk back from a surviving state one stretch at a time: play the stretch
+    // again from its save with links kept, and follow them to the save's states
+    uint32_t target = frame;
+    uint32_t index = 0;
+    while (target > 0) {
+        const game_sim_solver_save_t* save = &witness->saves[(target - 1) / stride];
+        uint32_t begin = (target - 1) / stride * stride;
+        if (!witness_restore(witness, save, &game, &pillars)) return 0;
+        current = 0;
+        count = save->count;
+        
+        uint32_t link_count = 0;
+        for (uint32_t f = 0; begin + f < target; f++) {
+            witness->link_starts[f] = link_count;
+            int64_t kept = witness_step(witness, solver, &game, &pillars, &current, count, &link_count);
+            if (kept <= 0) return 0; // Survived the first time, so only memory can fail
+            count = (uint32_t)kept;
+        }
+        for (uint32_t f = target - begin; f-- > 0;) {
+            uint32_t link = witness->links[witness->link_starts[f] + index];
+            inputs[begin + f] = (uint8_t)(link & 1);
+            index = link >> 1;
+        }
+        target = begin;
+    }
+    
+    // Nothing survives the frame after, whatever the input
+    uint32_t n = frame;
+    if (frame < max_frames) inputs[n++] = 0;
+    if (input_count) *input_count = n;
+    return frame;
+}
@@ -0,0 +1,513 @@
+#include "unity.h"
+#include "game_sim.h"
+#include "game_sim_policy.h"
+#include "game_sim_snapshot.h"
+#include "game_sim_replay.h"
+#include "game_sim_solver.h"
+#include <stdint.h>
+#include <string.h>
+
+void setUp(void) {
+    // Set up code here runs before each test
+}
+
+void tearDown(void) {
+    // Clean up code here runs after each test
+}
+
+#define BATCH_TEST_WORLDS 37 // Deliberately not a multiple of the batch padding
+#define BATCH_TEST_FRAMES 6000
+
+// Steers toward the gap of the nearest pillar ahead, offset per world so the runs diverge
+static bool autopilot(const game_world_t* world, int bias) {
+    float target = SCREEN_HEIGHT / 2.0f;
+    float nearest_x = SCREEN_WIDTH * 2.0f;
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* pillar = &world->pillars.pillars[i];
+        if (!pillar->active || pillar->x + PILLAR_WIDTH < world->penguin.x) continue;
+        if (pillar->x < nearest_x) {
+            nearest_x = pillar->x;
+            target = pillar->top_height + pillar->gap_size / 2.0f;
+        }
+    }
+    
+    return world->penguin.y + PENGUIN_HEIGHT / 2.0f + bias < target;
+}
+
+static bool input_pattern(int pattern, int world, int frame, const game_world_t* state) {
+    switch (pattern) {
+        case 0:
+            return (frame % 180) < 90;
+        case 1:
+            return ((frame * 2654435761u + world * 40503u) >> 13) & 1;
+        default:
+            return autopilot(state, (world % 9) * 3 - 12);
+    }
+}
+
+static uint8_t recorded_inputs[BATCH_TEST_FRAMES][BATCH_TEST_WORLDS];
+
+static void assert_worlds_identical(const game_world_t* expected, const game_world_t* actual) {
+    TEST_ASSERT_EQUAL(expected->game.state, actual->game.state);
+    TEST_ASSERT_EQUAL_UINT32(expected->game.score, actual->game.score);
+    TEST_ASSERT_EQUAL_UINT32(expected->game.high_score, actual->game.high_score);
+    TEST_ASSERT_EQUAL_UINT32(expected->game.frame_count, actual->game.frame_count);
+    TEST_ASSERT_EQUAL_MEMORY(&expected->game.difficulty_multiplier, &actual->game.difficulty_multiplier, sizeof(float));
+    
+    TEST_ASSERT_EQUAL_MEMORY(&expected->penguin.x, &actual->penguin.x, sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(&expected->penguin.y, &actual->penguin.y, sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(&expected->penguin.velocity_y, &actual->penguin.velocity_y, sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(&expected->penguin.acceleration_y, &actual->penguin.acceleration_y, sizeof(float));
+    TEST_ASSERT_EQUAL(expected->penguin.button_pressed, actual->penguin.button_pressed);
+    TEST_ASSERT_EQUAL(expected->penguin.was_button_pressed, actual->penguin.was_button_pressed);
+    TEST_ASSERT_EQUAL_UINT32(expected->penguin.button_press_duration, actual->penguin.button_press_duration);
+    
+    TEST_ASSERT_EQUAL(expected->pillars.active_count, actual->pillars.active_count);
+    TEST_ASSERT_EQUAL_MEMORY(&expected->pillars.scroll_speed, &actual->pillars.scroll_speed, sizeof(float));
+    TEST_ASSERT_EQUAL_UINT32(expected->pillars.spawn_timer, actual->pillars.spawn_timer);
+    TEST_ASSERT_EQUAL_UINT32(expected->pillars.spawn_interval, actual->pillars.spawn_interval);
+    TEST_ASSERT_EQUAL(expected->pillars.rng.mode, actual->pillars.rng.mode);
+    TEST_ASSERT_EQUAL_UINT32(expected->pillars.rng.seed, actual->pillars.rng.seed);
+    TEST_ASSERT_EQUAL_UINT32(expected->pillars.rng.state, actual->pillars.rng.state);
+    TEST_ASSERT_EQUAL_UINT32(expected->pillars.rng.draw_count, actual->pillars.rng.draw_count);
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* a = &expected->pillars.pillars[i];
+        const ice_pillar_t* b = &actual->pillars.pillars[i];
+        TEST_ASSERT_EQUAL(a->active, b->active);
+        TEST_ASSERT_EQUAL(a->passed, b->passed);
+        TEST_ASSERT_EQUAL_MEMORY(&a->x, &b->x, sizeof(float));
+        TEST_ASSERT_EQUAL(a->top_height, b->top_height);
+        TEST_ASSERT_EQUAL(a->bottom_y, b->bottom_y);
+        TEST_ASSERT_EQUAL(a->bottom_height, b->bottom_height);
+        TEST_ASSERT_EQUAL(a->gap_size, b->gap_size);
+    }
+}
+
+void test_game_sim_world_init_starts_playing(void) {
+    game_world_t world;
+    game_sim_world_init(&world);
+    
+    TEST_ASSERT_EQUAL(GAME_STATE_PLAYING, world.game.state);
+    TEST_ASSERT_EQUAL(0, world.game.score);
+    TEST_ASSERT_EQUAL(0, world.pillars.active_count);
+}
+
+void test_game_sim_world_step_ends_on_collision(void) {
+    game_world_t world;
+    game_sim_world_init(&world);
+    
+    // Holding the button pins the penguin to the bottom, so the first pillar ends the run
+    int frames = 0;
+    while (game_sim_world_step(&world, true) && frames < 10000) {
+        frames++;
+    }
+    
+    TEST_ASSERT_EQUAL(GAME_STATE_GAME_OVER, world.game.state);
+    TEST_ASSERT_LESS_THAN(10000, frames);
+    
+    // Finished worlds no longer advance
+    uint32_t frame_count = world.game.frame_count;
+    TEST_ASSERT_FALSE(game_sim_world_step(&world, false));
+    TEST_ASSERT_EQUAL_UINT32(frame_count, world.game.frame_count);
+}
+
+void test_game_sim_batch_matches_scalar(void) {
+    for (int pattern = 0; pattern < 3; pattern++) {
+        game_sim_batch_t batch;
+        TEST_ASSERT_TRUE(game_sim_batch_init(&batch, BATCH_TEST_WORLDS));
+        
+        // Inputs may depend on world state, so record what the batch was fed
+        for (int frame = 0; frame < BATCH_TEST_FRAMES; frame++) {
+            for (int w = 0; w < BATCH_TEST_WORLDS; w++) {
+                game_world_t state;
+                game_sim_batch_get_world(&batch, w, &state);
+                recorded_inputs[frame][w] = input_pattern(pattern, w, frame, &state);
+            }
+            game_sim_batch_step(&batch, recorded_inputs[frame]);
+        }
+        
+        for (int w = 0; w < BATCH_TEST_WORLDS; w++) {
+            game_world_t expected;
+            game_world_t actual;
+            game_sim_world_init(&expected);
+            for (int frame = 0; frame < BATCH_TEST_FRAMES; frame++) {
+                game_sim_world_step(&expected, recorded_inputs[frame][w]);
+            }
+            
+            TEST_ASSERT_TRUE(game_sim_batch_get_world(&batch, w, &actual));
+            assert_worlds_identical(&expected, &actual);
+        }
+        
+        game_sim_batch_deinit(&batch);
+    }
+}
+
+void test_game_sim_batch_reset_world(void) {
+    game_sim_batch_t batch;
+    TEST_ASSERT_TRUE(game_sim_batch_init(&batch, 4));
+    
+    uint8_t buttons[4] = {1, 1, 1, 1};
+    while (game_sim_batch_step(&batch, buttons) > 0) {
+    }
+    
+    game_sim_batch_reset_world(&batch, 2);
+    
+    game_world_t expected;
+    game_world_t actual;
+    game_sim_world_init(&expected);
+    TEST_ASSERT_TRUE(game_sim_batch_get_world(&batch, 2, &actual));
+    assert_worlds_identical(&expected, &actual);
+    
+    TEST_ASSERT_EQUAL(1, game_sim_batch_step(&batch, buttons));
+    
+    game_sim_batch_deinit(&batch);
+}
+
+void test_game_sim_batch_seeded_worlds_match_scalar(void) {
+    game_sim_batch_t batch;
+    TEST_ASSERT_TRUE(game_sim_batch_init(&batch, BATCH_TEST_WORLDS));
+    
+    for (int w = 0; w < BATCH_TEST_WORLDS; w++) {
+        game_world_t world;
+        game_sim_world_init_seeded(&world, 1000 + w, (w % 2) ? ICE_PILLARS_RNG_COUNTER : ICE_PILLARS_RNG_LCG);
+        TEST_ASSERT_TRUE(game_sim_batch_set_world(&batch, w, &world));
+    }
+    
+    for (int frame = 0; frame < BATCH_TEST_FRAMES; frame++) {
+        for (int w = 0; w < BATCH_TEST_WORLDS; w++) {
+            game_world_t state;
+            game_sim_batch_get_world(&batch, w, &state);
+            recorded_inputs[frame][w] = autopilot(&state, (w % 5) * 2 - 4);
+        }
+        game_sim_batch_step(&batch, recorded_inputs[frame]);
+    }
+    
+    for (int w = 0; w < BATCH_TEST_WORLDS; w++) {
+        game_world_t expected;
+        game_world_t actual;
+        game_sim_world_init_seeded(&expected, 1000 + w, (w % 2) ? ICE_PILLARS_RNG_COUNTER : ICE_PILLARS_RNG_LCG);
+        for (int frame = 0; frame < BATCH_TEST_FRAMES; frame++) {
+            game_sim_world_step(&expected, recorded_inputs[frame][w]);
+        }
+        
+        TEST_ASSERT_TRUE(game_sim_batch_get_world(&batch, w, &actual));
+        assert_worlds_identical(&expected, &actual);
+    }
+    
+    game_sim_batch_deinit(&batch);
+}
+
+void test_game_sim_run_episode_honours_frame_limit(void) {
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 7, ICE_PILLARS_RNG_COUNTER);
+    
+    TEST_ASSERT_EQUAL_UINT32(100, game_sim_run_episode(&world, game_sim_policy_autopilot, 0, 100));
+    TEST_ASSERT_EQUAL(GAME_STATE_PLAYING, world.game.state);
+    
+    // Unlimited runs play until game over
+    uint32_t frames = game_sim_run_episode(&world, game_sim_policy_random, 0, 0);
+    TEST_ASSERT_GREATER_THAN(0, frames);
+    TEST_ASSERT_EQUAL(GAME_STATE_GAME_OVER, world.game.state);
+    TEST_ASSERT_EQUAL_UINT32(0, game_sim_run_episode(&world, game_sim_policy_random, 0, 0));
+}
+
+void test_game_sim_snapshot_round_trip(void) {
+    TEST_ASSERT_EQUAL(GAME_SIM_SNAPSHOT_SIZE, sizeof(game_sim_snapshot_t));
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 31, ICE_PILLARS_RNG_COUNTER);
+    game_sim_run_episode(&world, game_sim_policy_autopilot, 3, 1500);
+    
+    game_sim_snapshot_t snapshot;
+    TEST_ASSERT_EQUAL(0, (uintptr_t)&snapshot % 64);
+    game_sim_snapshot_save(&world, &snapshot);
+    
+    game_world_t restored;
+    game_sim_world_init(&restored);
+    game_sim_snapshot_restore(&snapshot, &restored);
+    assert_worlds_identical(&world, &restored);
+    TEST_ASSERT_EQUAL(world.pillars.rng.mode, restored.pillars.rng.mode);
+    TEST_ASSERT_EQUAL_UINT32(world.pillars.rng.seed, restored.pillars.rng.seed);
+}
+
+void test_game_sim_snapshot_rollback_replays_identically(void) {
+    game_world_t world;
+    game_sim_world_init(&world);
+    game_sim_run_episode(&world, game_sim_policy_autopilot, 5, 400);
+    
+    game_sim_snapshot_t snapshot;
+    game_sim_snapshot_save(&world, &snapshot);
+    
+    game_world_t expected = world;
+    uint32_t frames = game_sim_run_episode(&expected, game_sim_policy_autopilot, 5, 3000);
+    
+    // Play on with different inputs, then roll back and replay the original ones
+    game_sim_run_episode(&world, game_sim_policy_random, 9, 200);
+    game_sim_snapshot_restore(&snapshot, &world);
+    TEST_ASSERT_EQUAL_UINT32(frames, game_sim_run_episode(&world, game_sim_policy_autopilot, 5, 3000));
+    assert_worlds_identical(&expected, &world);
+}
+
+void test_game_sim_world_advance_matches_stepping(void) {
+    // Hold/release cycles from short taps to the 90/90 pattern of the
+    // frame-rate consistency test, over both generators
+    const uint32_t cycles[][2] = {{90, 90}, {7, 11}, {23, 19}, {40, 25}, {3, 3}, {60, 120}};
+    
+    for (size_t c = 0; c < sizeof(cycles) / sizeof(cycles[0]); c++) {
+        for (uint32_t seed = 1; seed <= 8; seed++) {
+            ice_pillars_rng_mode_t mode = (seed & 1) ? ICE_PILLARS_RNG_LCG : ICE_PILLARS_RNG_COUNTER;
+            game_world_t stepped;
+            game_world_t advanced;
+            game_sim_world_init_seeded(&stepped, seed, mode);
+            game_sim_world_init_seeded(&advanced, seed, mode);
+            
+            bool pressed = true;
+            while (stepped.game.state == GAME_STATE_PLAYING) {
+                uint32_t span = cycles[c][pressed ? 0 : 1];
+                uint32_t frames = 0;
+                while (frames < span && game_sim_world_step(&stepped, pressed)) {
+                    frames++;
+                }
+                if (frames < span) frames++; // The frame that ended the game
+                
+                TEST_ASSERT_EQUAL_UINT32(frames, game_sim_world_advance(&advanced, pressed, span));
+                assert_worlds_identical(&stepped, &advanced);
+                pressed = !pressed;
+            }
+        }
+    }
+}
+
+#define REPLAY_TEST_CAPACITY 4096
+
+// Plays one autopilot game while recording it through a small ring that is
+// drained every frame. Stores the size of the complete replay in `replay_size`.
+static void record_game(uint32_t seed, ice_pillars_rng_mode_t mode, uint8_t* replay, size_t* replay_size,
+                        game_world_t* final_world) {
+    uint8_t ring[16];
+    game_sim_replay_recorder_t recorder;
+    TEST_ASSERT_TRUE(game_sim_replay_recorder_init(&recorder, ring, sizeof(ring), seed, mode));
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, seed, mode);
+    size_t size = GAME_SIM_REPLAY_HEADER_SIZE;
+    bool running = true;
+    while (running) {
+        bool pressed = game_sim_policy_autopilot(&world, seed);
+        game_sim_replay_recorder_record(&recorder, pressed);
+        running = game_sim_world_step(&world, pressed);
+        size += game_sim_replay_recorder_drain(&recorder, replay + size, REPLAY_TEST_CAPACITY - (uint32_t)size);
+    }
+    game_sim_replay_recorder_finish(&recorder, world.game.score);
+    size += game_sim_replay_recorder_drain(&recorder, replay + size, REPLAY_TEST_CAPACITY - (uint32_t)size);
+    
+    TEST_ASSERT_FALSE(recorder.overflowed);
+    TEST_ASSERT_EQUAL_UINT32(world.game.frame_count, recorder.header.frame_count);
+    game_sim_replay_write_header(&recorder.header, replay);
+    *final_world = world;
+    *replay_size = size;
+}
+
+void test_game_sim_replay_varint_runs_round_trip(void) {
+    const uint32_t runs[] = {0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX};
+    uint8_t payload[sizeof(runs) / sizeof(runs[0]) * GAME_SIM_REPLAY_MAX_VARINT_SIZE];
+    size_t size = 0;
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        size += game_sim_replay_encode_varint(runs[i], payload + size);
+    }
+    TEST_ASSERT_EQUAL(1 + 1 + 1 + 2 + 2 + 2 + 3 + 5, size);
+    
+    game_sim_replay_reader_t reader;
+    game_sim_replay_reader_init(&reader, payload, size);
+    bool pressed;
+    uint32_t length;
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        TEST_ASSERT_TRUE(game_sim_replay_reader_next_run(&reader, &pressed, &length));
+        TEST_ASSERT_EQUAL(i % 2 == 1, pressed);
+        TEST_ASSERT_EQUAL_UINT32(runs[i], length);
+    }
+    TEST_ASSERT_FALSE(game_sim_replay_reader_next_run(&reader, &pressed, &length));
+    
+    // A truncated varint is rejected
+    game_sim_replay_reader_init(&reader, payload, size - 1);
+    for (size_t i = 0; i + 1 < sizeof(runs) / sizeof(runs[0]); i++) {
+        TEST_ASSERT_TRUE(game_sim_replay_reader_next_run(&reader, &pressed, &length));
+    }
+    TEST_ASSERT_FALSE(game_sim_replay_reader_next_run(&reader, &pressed, &length));
+}
+
+void test_game_sim_replay_plays_back_identically(void) {
+    static uint8_t replay[REPLAY_TEST_CAPACITY];
+    const ice_pillars_rng_mode_t modes[] = {ICE_PILLARS_RNG_LCG, ICE_PILLARS_RNG_COUNTER};
+    
+    for (int m = 0; m < 2; m++) {
+        game_world_t recorded;
+        size_t size;
+        record_game(2024 + m, modes[m], replay, &size, &recorded);
+        
+        game_world_t played;
+        game_sim_replay_result_t result;
+        TEST_ASSERT_TRUE(game_sim_replay_play(replay, size, &played, &result));
+        TEST_ASSERT_TRUE(result.matches);
+        TEST_ASSERT_EQUAL_UINT32(recorded.game.frame_count, result.frames);
+        assert_worlds_identical(&recorded, &played);
+    }
+}
+
+void test_game_sim_replay_detects_bad_replays(void) {
+    static uint8_t replay[REPLAY_TEST_CAPACITY];
+    game_world_t recorded;
+    game_world_t played;
+    size_t size;
+    record_game(99, ICE_PILLARS_RNG_COUNTER, replay, &size, &recorded);
+    
+    // Wrong final score
+    replay[16] ^= 1;
+    TEST_ASSERT_FALSE(game_sim_replay_play(replay, size, &played, NULL));
+    replay[16] ^= 1;
+    
+    // Missing payload bytes
+    TEST_ASSERT_FALSE(game_sim_replay_play(replay, size - 1, &played, NULL));
+    
+    // Bad magic
+    replay[0] = 'X';
+    TEST_ASSERT_FALSE(game_sim_replay_play(replay, size, &played, NULL));
+}
+
+void test_game_sim_replay_recorder_flags_overflow(void) {
+    uint8_t ring[4];
+    game_sim_replay_recorder_t recorder;
+    TEST_ASSERT_FALSE(game_sim_replay_recorder_init(&recorder, ring, 0, 1, ICE_PILLARS_RNG_LCG));
+    TEST_ASSERT_TRUE(game_sim_replay_recorder_init(&recorder, ring, sizeof(ring), 1, ICE_PILLARS_RNG_LCG));
+    
+    // Long runs cost nothing until the button changes
+    for (int i = 0; i < 1000; i++) {
+        game_sim_replay_recorder_record(&recorder, false);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, game_sim_replay_recorder_pending(&recorder));
+    
+    // Each toggle writes one byte; the fifth does not fit and nothing is overwritten
+    for (int i = 0; i < 5; i++) {
+        game_sim_replay_recorder_record(&recorder, i % 2 == 0);
+    }
+    TEST_ASSERT_TRUE(recorder.overflowed);
+    TEST_ASSERT_EQUAL_UINT32(4, game_sim_replay_recorder_pending(&recorder));
+    TEST_ASSERT_EQUAL_UINT32(1005, recorder.header.frame_count);
+    
+    uint8_t out[4];
+    TEST_ASSERT_EQUAL_UINT32(4, game_sim_replay_recorder_drain(&recorder, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_UINT8(0xE8, out[0]); // 1000 = 0xE8 0x07
+    TEST_ASSERT_EQUAL_UINT8(0x07, out[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, out[2]);
+}
+
+// Too large for a task stack
+static game_sim_solver_t solver;
+
+void test_game_sim_solver_init_resolutions(void) {
+    for (int bits = 0; bits <= GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS; bits++) {
+        TEST_ASSERT_TRUE(game_sim_solver_init(&solver, bits));
+        TEST_ASSERT_EQUAL_INT((SCREEN_HEIGHT - PENGUIN_HEIGHT) * (1 << bits) + 1, solver.cells);
+        TEST_ASSERT_TRUE(solver.row_count > 0 && solver.row_count <= solver.velocity_count);
+    }
+    TEST_ASSERT_FALSE(game_sim_solver_init(&solver, -1));
+    TEST_ASSERT_FALSE(game_sim_solver_init(&solver, GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS + 1));
+}
+
+void test_game_sim_solver_contains_played_games(void) {
+    TEST_ASSERT_TRUE(game_sim_solver_init(&solver, GAME_SIM_SOLVER_DEFAULT_SUBPIXEL_BITS));
+    
+    for (uint32_t seed = 1; seed <= 6; seed++) {
+        game_world_t world;
+        game_sim_world_init_seeded(&world, seed, ICE_PILLARS_RNG_COUNTER);
+        game_sim_solver_reset(&solver, seed, ICE_PILLARS_RNG_COUNTER);
+        
+        // Every state the real game passes through must be in the tracked set
+        bool running = true;
+        while (running) {
+            bool pressed = (seed % 2) ? game_sim_policy_autopilot(&world, seed)
+                                      : (world.game.frame_count / (10 + seed)) % 2 == 0;
+            running = game_sim_world_step(&world, pressed);
+            bool alive = game_sim_solver_step(&solver);
+            if (running) {
+                TEST_ASSERT_TRUE(alive);
+                TEST_ASSERT_TRUE(game_sim_solver_is_reachable(&solver, &world.penguin));
+            }
+        }
+        
+        uint32_t survived = world.game.frame_count - 1;
+        TEST_ASSERT_TRUE(game_sim_solver_max_survival(&solver, seed, ICE_PILLARS_RNG_COUNTER, 100000) >= survived);
+        TEST_ASSERT_EQUAL_UINT32(100, game_sim_solver_max_survival(&solver, seed, ICE_PILLARS_RNG_COUNTER, 100));
+    }
+}
+
+void test_game_sim_solver_batch_matches_single(void) {
+    TEST_ASSERT_TRUE(game_sim_solver_init(&solver, GAME_SIM_SOLVER_DEFAULT_SUBPIXEL_BITS));
+    
+    // More seeds than lanes, so finished lanes pick up new ones mid-run
+    uint32_t bounds[GAME_SIM_SOLVER_LANES * 2 + 1];
+    const uint32_t count = sizeof(bounds) / sizeof(bounds[0]);
+    game_sim_solver_max_survival_many(&solver, 40, count, ICE_PILLARS_RNG_LCG, 3000, bounds);
+    for (uint32_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_UINT32(game_sim_solver_max_survival(&solver, 40 + i, ICE_PILLARS_RNG_LCG, 3000), bounds[i]);
+    }
+}
+
+void test_game_sim_solver_witness_replays(void) {
+    TEST_ASSERT_TRUE(game_sim_solver_init(&solver, GAME_SIM_SOLVER_DEFAULT_SUBPIXEL_BITS));
+    game_sim_solver_witness_t witness;
+    TEST_ASSERT_TRUE(game_sim_solver_witness_init(&witness, &solver));
+    
+    static uint8_t inputs[601];
+    for (uint32_t seed = 1; seed <= 3; seed++) {
+        uint32_t count;
+        uint32_t lower = game_sim_solver_min_survival(&witness, &solver, seed, ICE_PILLARS_RNG_COUNTER, 600, inputs,
+                                                      &count);
+        TEST_ASSERT_TRUE(lower > 0);
+        TEST_ASSERT_TRUE(lower <= game_sim_solver_max_survival(&solver, seed, ICE_PILLARS_RNG_COUNTER, 600));
+        
+        // The inputs survive exactly the reported frames
+        game_world_t world;
+        game_sim_world_init_seeded(&world, seed, ICE_PILLARS_RNG_COUNTER);
+        uint32_t survived = 0;
+        while (survived < count && game_sim_world_step(&world, inputs[survived])) survived++;
+        TEST_ASSERT_EQUAL_UINT32(lower, survived);
+    }
+    game_sim_solver_witness_deinit(&witness);
+}
+
+void app_main(void) {
+    UNITY_BEGIN();
+    
+    // Scalar World Tests
+    RUN_TEST(test_game_sim_world_init_starts_playing);
+    RUN_TEST(test_game_sim_world_step_ends_on_collision);
+    
+    // Batched World Tests
+    RUN_TEST(test_game_sim_batch_matches_scalar);
+    RUN_TEST(test_game_sim_batch_reset_world);
+    RUN_TEST(test_game_sim_batch_seeded_worlds_match_scalar);
+    
+    // Episode Tests
+    RUN_TEST(test_game_sim_run_episode_honours_frame_limit);
+    RUN_TEST(test_game_sim_world_advance_matches_stepping);
+    
+    // Snapshot Tests
+    RUN_TEST(test_game_sim_snapshot_round_trip);
+    RUN_TEST(test_game_sim_snapshot_rollback_replays_identically);
+    
+    // Replay Tests
+    RUN_TEST(test_game_sim_replay_varint_runs_round_trip);
+    RUN_TEST(test_game_sim_replay_plays_back_identically);
+    RUN_TEST(test_game_sim_replay_detects_bad_replays);
+    RUN_TEST(test_game_sim_replay_recorder_flags_overflow);
+    
+    // Solver Tests
+    RUN_TEST(test_game_sim_solver_init_resolutions);
+    RUN_TEST(test_game_sim_solver_contains_played_games);
+    RUN_TEST(test_game_sim_solver_batch_matches_single);
+    RUN_TEST(test_game_sim_solver_witness_replays);
+    
+    UNITY_END();
+}
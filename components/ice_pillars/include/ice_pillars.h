@@ -14,6 +14,7 @@ extern "C" {
 #define MIN_GAP_SIZE 80
 #define MAX_GAP_SIZE 100
 #define PILLAR_SPACING 80
+#define ICE_PILLARS_DEFAULT_SEED 12345
 
 typedef struct {
     float x;
@@ -25,6 +26,21 @@ typedef struct {
     bool passed;
 } ice_pillar_t;
 
+// Every spawned pillar consumes exactly this many random draws (gap size, then gap position)
+#define ICE_PILLARS_DRAWS_PER_SPAWN 2
+
+typedef enum {
+    ICE_PILLARS_RNG_LCG,        // Original sequence, sequential only
+    ICE_PILLARS_RNG_COUNTER     // Hash of (seed, draw index), can jump to any spawn in O(1)
+} ice_pillars_rng_mode_t;
+
+typedef struct {
+    ice_pillars_rng_mode_t mode;
+    uint32_t seed;
+    uint32_t state;             // LCG state, unused in counter mode
+    uint32_t draw_count;
+} ice_pillars_rng_t;
+
 typedef struct {
     ice_pillar_t pillars[MAX_PILLARS];
     int active_count;
@@ -32,9 +48,37 @@ typedef struct {
     uint32_t spawn_timer;
     uint32_t spawn_interval;
     float difficulty_multiplier;
+    ice_pillars_rng_t rng;
 } ice_pillars_context_t;
 
+// Structure-of-arrays view over the pillar fields of many worlds for batched
+// headless simulation. Per-pillar arrays are slot-major: pillar slot `i` of
+// world `w` lives at index `i * stride + w`. Per-world arrays hold `count`
+// elements. All storage is owned by the caller.
+typedef struct {
+    int stride;
+    float* x;
+    int* top_height;
+    int* bottom_y;
+    int* bottom_height;
+    int* gap_size;
+    uint8_t* active;              // Flags are stored as 0/1 bytes so loops over them vectorize
+    uint8_t* passed;
+    int* active_count;
+    float* scroll_speed;
+    uint32_t* spawn_timer;
+    uint32_t* spawn_interval;
+    float* difficulty_multiplier;
+    ice_pillars_rng_t* rng;       // One generator per world, only touched when a pillar spawns
+} ice_pillars_batch_t;
+
+// Initializes with the default seed and LCG, the sequence all existing tests expect
 void ice_pillars_init(ice_pillars_context_t* ctx);
+void ice_pillars_init_seeded(ice_pillars_context_t* ctx, uint32_t seed, ice_pillars_rng_mode_t mode);
+// Positions the generator so the next spawned pillar gets the gap of spawn number
+// `spawn_index` (counting from 0 after init). O(1) in counter mode, O(log n) for the LCG.
+void ice_pillars_seek_spawn(ice_pillars_context_t* ctx, uint32_t spawn_index);
+uint32_t ice_pillars_get_spawn_index(ice_pillars_context_t* ctx);
 void ice_pillars_update(ice_pillars_context_t* ctx, float difficulty_multiplier);
 void ice_pillars_spawn_pillar(ice_pillars_context_t* ctx);
 bool ice_pillars_check_collision(ice_pillars_context_t* ctx, int penguin_x, int penguin_y, int penguin_width, int penguin_height);
@@ -44,6 +88,30 @@ int ice_pillars_get_active_count(ice_pillars_context_t* ctx);
 ice_pillar_t* ice_pillars_get_pillar(ice_pillars_context_t* ctx, int index);
 void ice_pillars_reset(ice_pillars_context_t* ctx);
 
+// Number of the next ice_pillars_update() calls, up to `max_frames`, that spawn
+// and remove nothing and leave every pillar's overlap with the penguin column
+// and passed flag as they are. `difficulty_multiplier` is the value the next
+// update will get. [min_y, max_y) receives the penguin heights that avoid
+// every pillar overlapping the penguin now; outside it a collision is possible.
+uint32_t ice_pillars_quiet_frames(ice_pillars_context_t* ctx, float difficulty_multiplier, int penguin_x,
+                                  int penguin_width, int penguin_height, uint32_t max_frames,
+                                  float* min_y, float* max_y);
+// Applies `frames` updates with the same result as calling ice_pillars_update()
+// that many times. `frames` must not exceed what ice_pillars_quiet_frames() returned.
+void ice_pillars_advance_quiet(ice_pillars_context_t* ctx, uint32_t frames);
+
+// Batched counterparts of ice_pillars_update(), ice_pillars_check_collision() and
+// ice_pillars_check_passed(). `active` holds one 0/1 flag per world and worlds
+// whose flag is clear are left untouched. Results are bit-identical to the
+// per-context functions.
+void ice_pillars_update_batch(const ice_pillars_batch_t* batch, const float* difficulty_multiplier,
+                              const uint8_t* active, int count);
+void ice_pillars_check_collision_batch(const ice_pillars_batch_t* batch, const int* penguin_x, const int* penguin_y,
+                                       int penguin_width, int penguin_height, const uint8_t* active,
+                                       uint8_t* collided, int count);
+void ice_pillars_check_passed_batch(const ice_pillars_batch_t* batch, const int* penguin_x,
+                                    const uint8_t* active, int count);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
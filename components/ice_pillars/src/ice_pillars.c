@@ -1,30 +1,81 @@
 #include "ice_pillars.h"
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+#include <float.h>
 
 #define BASE_SCROLL_SPEED 0.8f
 // Spawn a pillar roughly every 3 seconds at 60 FPS (then scales with difficulty)
 #define BASE_SPAWN_INTERVAL 180
 
-static uint32_t pseudo_random_seed = 12345;
+#define LCG_MULTIPLIER 1103515245u
+#define LCG_INCREMENT 12345u
 
 // Simple pseudo-random number generator for deterministic testing
-static uint32_t pseudo_random(void) {
-    pseudo_random_seed = pseudo_random_seed * 1103515245 + 12345;
-    return pseudo_random_seed;
+static uint32_t lcg_next(uint32_t state) {
+    return state * LCG_MULTIPLIER + LCG_INCREMENT;
 }
 
-static int get_random_gap_size(void) {
-    return MIN_GAP_SIZE + (pseudo_random() % (MAX_GAP_SIZE - MIN_GAP_SIZE + 1));
+// Advances an LCG state by `steps` draws by squaring the affine step map
+static uint32_t lcg_skip(uint32_t state, uint32_t steps) {
+    uint32_t multiplier = LCG_MULTIPLIER;
+    uint32_t increment = LCG_INCREMENT;
+    
+    while (steps) {
+        if (steps & 1) {
+            state = state * multiplier + increment;
+        }
+        increment = increment * multiplier + increment;
+        multiplier *= multiplier;
+        steps >>= 1;
+    }
+    return state;
 }
 
-static int get_random_gap_position(int gap_size) {
+// Counter-based draw: a SplitMix64 finalizer over (seed, index)
+static uint32_t counter_draw(uint32_t seed, uint32_t index) {
+    uint64_t z = ((uint64_t)seed << 32 | index) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+static uint32_t pseudo_random(ice_pillars_rng_t* rng) {
+    uint32_t value;
+    if (rng->mode == ICE_PILLARS_RNG_COUNTER) {
+        value = counter_draw(rng->seed, rng->draw_count);
+    } else {
+        rng->state = lcg_next(rng->state);
+        value = rng->state;
+    }
+    rng->draw_count++;
+    return value;
+}
+
+static int get_random_gap_size(ice_pillars_rng_t* rng) {
+    return MIN_GAP_SIZE + (pseudo_random(rng) % (MAX_GAP_SIZE - MIN_GAP_SIZE + 1));
+}
+
+static int get_random_gap_position(ice_pillars_rng_t* rng, int gap_size) {
     int min_y = 20; // Leave some space at top
     int max_y = SCREEN_HEIGHT - gap_size - 20; // Leave some space at bottom
-    return min_y + (pseudo_random() % (max_y - min_y + 1));
+    return min_y + (pseudo_random(rng) % (max_y - min_y + 1));
+}
+
+// Rolls the gap of a freshly spawned pillar; shared by the scalar and batched paths
+static void roll_gap(ice_pillars_rng_t* rng, float difficulty_multiplier, int* gap_size, int* gap_y) {
+    int size = get_random_gap_size(rng) - (int)(difficulty_multiplier * 2); // Reduced difficulty scaling for easier gameplay
+    if (size < MIN_GAP_SIZE) size = MIN_GAP_SIZE;
+    
+    *gap_size = size;
+    *gap_y = get_random_gap_position(rng, size);
 }
 
 void ice_pillars_init(ice_pillars_context_t* ctx) {
+    ice_pillars_init_seeded(ctx, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_LCG);
+}
+
+void ice_pillars_init_seeded(ice_pillars_context_t* ctx, uint32_t seed, ice_pillars_rng_mode_t mode) {
     if (!ctx) return;
     
     memset(ctx, 0, sizeof(ice_pillars_context_t));
@@ -33,7 +84,10 @@ void ice_pillars_init(ice_pillars_context_t* ctx) {
     // Start spawn timer near the threshold so the first pillar appears sooner (~1s)
     ctx->spawn_timer = (BASE_SPAWN_INTERVAL > 60) ? (BASE_SPAWN_INTERVAL - 60) : (BASE_SPAWN_INTERVAL / 2);
     ctx->difficulty_multiplier = 1.0f;
-    pseudo_random_seed = 12345; // Reset for consistent testing
+    ctx->rng.mode = mode;
+    ctx->rng.seed = seed;
+    ctx->rng.state = seed;
+    ctx->rng.draw_count = 0;
     for (int i = 0; i < MAX_PILLARS; i++) {
         ctx->pillars[i].active = false;
         ctx->pillars[i].passed = false;
@@ -44,6 +98,21 @@ void ice_pillars_init(ice_pillars_context_t* ctx) {
     }
 }
 
+void ice_pillars_seek_spawn(ice_pillars_context_t* ctx, uint32_t spawn_index) {
+    if (!ctx) return;
+    
+    uint32_t draw_count = spawn_index * ICE_PILLARS_DRAWS_PER_SPAWN;
+    if (ctx->rng.mode == ICE_PILLARS_RNG_LCG) {
+        ctx->rng.state = lcg_skip(ctx->rng.seed, draw_count);
+    }
+    ctx->rng.draw_count = draw_count;
+}
+
+uint32_t ice_pillars_get_spawn_index(ice_pillars_context_t* ctx) {
+    if (!ctx) return 0;
+    return ctx->rng.draw_count / ICE_PILLARS_DRAWS_PER_SPAWN;
+}
+
 void ice_pillars_update(ice_pillars_context_t* ctx, float difficulty_multiplier) {
     if (!ctx) return;
     
@@ -79,11 +148,9 @@ void ice_pillars_spawn_pillar(ice_pillars_context_t* ctx) {
         if (!ctx->pillars[i].active) {
             ice_pillar_t* pillar = &ctx->pillars[i];
             
+            int gap_y;
             pillar->x = SCREEN_WIDTH;
-            pillar->gap_size = get_random_gap_size() - (int)(ctx->difficulty_multiplier * 2); // Reduced difficulty scaling for easier gameplay
-            if (pillar->gap_size < MIN_GAP_SIZE) pillar->gap_size = MIN_GAP_SIZE;
-            
-            int gap_y = get_random_gap_position(pillar->gap_size);
+            roll_gap(&ctx->rng, ctx->difficulty_multiplier, &pillar->gap_size, &gap_y);
             
             pillar->top_height = gap_y;
             pillar->bottom_y = gap_y + pillar->gap_size;
@@ -178,4 +245,206 @@ void ice_pillars_reset(ice_pillars_context_t* ctx) {
     }
     ctx->active_count = 0;
     ctx->spawn_timer = 0;
-}
\ No newline at end of file
+}
+
+// While a pillar stays inside the float binade it is in now, x - speed always
+// rounds to x - step for one fixed multiple `step` of the binade's spacing, so
+// any number of frames can be applied as one exact subtraction. `floor` is the
+// exclusive lower limit that keeps every intermediate x inside the binade.
+// Fails at x == 0 and when speed falls exactly halfway between two multiples,
+// where round-to-even would alternate.
+static bool scroll_step(float x, float speed, double* step, double* floor_x) {
+    if (x == 0.0f || !isfinite(x) || !(speed > 0.0f)) return false;
+    
+    int exponent;
+    frexpf(x, &exponent); // |x| lies in [2^(exponent - 1), 2^exponent)
+    double spacing = ldexp(1.0, exponent - FLT_MANT_DIG);
+    double multiples = speed / spacing;
+    if (multiples - floor(multiples) == 0.5) return false;
+    
+    *step = floor(multiples + 0.5) * spacing;
+    *floor_x = x > 0.0f ? ldexp(1.0, exponent - 1) : -ldexp(1.0, exponent);
+    return *step > 0.0;
+}
+
+// Largest k with (int)(x - k * step) >= n, for x - k * step exact
+static double frames_while_truncates_to_at_least(double x, double step, int n) {
+    if (n >= 1) return floor((x - n) / step);
+    return ceil((x - (n - 1)) / step) - 1.0;
+}
+
+uint32_t ice_pillars_quiet_frames(ice_pillars_context_t* ctx, float difficulty_multiplier, int penguin_x,
+                                  int penguin_width, int penguin_height, uint32_t max_frames,
+                                  float* min_y, float* max_y) {
+    if (!ctx || !min_y || !max_y) return 0;
+    
+    *min_y = -INFINITY;
+    *max_y = INFINITY;
+    
+    // The next update must use the scroll speed and spawn interval already in place
+    if (difficulty_multiplier != ctx->difficulty_multiplier) return 0;
+    
+    double frames = max_frames;
+    if (ctx->active_count < MAX_PILLARS) {
+        if (ctx->spawn_timer + 1 >= ctx->spawn_interval) return 0;
+        frames = fmin(frames, ctx->spawn_interval - ctx->spawn_timer - 1);
+    }
+    
+    // Pixel columns where a pillar starts overlapping the penguin, stops
+    // overlapping it and gets passed, in the order the pillar reaches them
+    const int overlap_start = penguin_x + penguin_width;
+    const int overlap_end = penguin_x - PILLAR_WIDTH + 1;
+    const int pass_column = penguin_x - PILLAR_WIDTH;
+    
+    for (int i = 0; i < MAX_PILLARS && frames > 0.0; i++) {
+        const ice_pillar_t* pillar = &ctx->pillars[i];
+        if (!pillar->active) continue;
+        
+        double step;
+        double floor_x;
+        if (!scroll_step(pillar->x, ctx->scroll_speed, &step, &floor_x)) return 0;
+        
+        double x = pillar->x;
+        int column = (int)pillar->x;
+        frames = fmin(frames, ceil((x - floor_x) / step) - 1.0);
+        frames = fmin(frames, floor((x + PILLAR_WIDTH) / step));
+        
+        if (column >= overlap_start) {
+            frames = fmin(frames, frames_while_truncates_to_at_least(x, step, overlap_start));
+        } else if (column >= overlap_end) {
+            frames = fmin(frames, frames_while_truncates_to_at_least(x, step, overlap_end));
+            // Collisions with this pillar now depend only on the penguin's height
+            *min_y = fmaxf(*min_y, (float)pillar->top_height);
+            *max_y = fminf(*max_y, (float)(pillar->bottom_y - penguin_height + 1));
+        } else if (!pillar->passed) {
+            if (column < pass_column) return 0; // Gets passed on the next check
+            frames = fmin(frames, frames_while_truncates_to_at_least(x, step, pass_column));
+        }
+    }
+    
+    return frames > 0.0 ? (uint32_t)frames : 0;
+}
+
+void ice_pillars_advance_quiet(ice_pillars_context_t* ctx, uint32_t frames) {
+    if (!ctx || frames == 0) return;
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        ice_pillar_t* pillar = &ctx->pillars[i];
+        double step;
+        double floor_x;
+        if (pillar->active && scroll_step(pillar->x, ctx->scroll_speed, &step, &floor_x)) {
+            pillar->x = (float)((double)pillar->x - (double)frames * step);
+        }
+    }
+    ctx->spawn_timer += frames;
+}
+
+void ice_pillars_update_batch(const ice_pillars_batch_t* batch, const float* difficulty_multiplier,
+                              const uint8_t* active, int count) {
+    if (!batch || !difficulty_multiplier || !active) return;
+    
+    const int stride = batch->stride;
+    const float* scroll_speed = batch->scroll_speed;
+    int* active_count = batch->active_count;
+    
+    // Mirrors ice_pillars_update() stage by stage: timers and spawning,
+    // scrolling, then off-screen removal. The per-slot stages are written
+    // without branches so the compiler can vectorize them across worlds.
+    for (int w = 0; w < count; w++) {
+        if (!active[w]) continue;
+        
+        float difficulty = difficulty_multiplier[w];
+        if (difficulty != batch->difficulty_multiplier[w]) {
+            // Difficulty only changes once per score point, so skip the division otherwise
+            batch->difficulty_multiplier[w] = difficulty;
+            batch->scroll_speed[w] = BASE_SCROLL_SPEED * difficulty;
+            batch->spawn_interval[w] = (uint32_t)(BASE_SPAWN_INTERVAL / difficulty);
+        }
+        batch->spawn_timer[w]++;
+        
+        if (batch->spawn_timer[w] >= batch->spawn_interval[w] && active_count[w] < MAX_PILLARS) {
+            for (int i = 0; i < MAX_PILLARS; i++) {
+                int p = i * stride + w;
+                if (batch->active[p]) continue;
+                
+                int gap_size;
+                int gap_y;
+                roll_gap(&batch->rng[w], difficulty, &gap_size, &gap_y);
+                
+                batch->x[p] = SCREEN_WIDTH;
+                batch->gap_size[p] = gap_size;
+                batch->top_height[p] = gap_y;
+                batch->bottom_y[p] = gap_y + gap_size;
+                batch->bottom_height[p] = SCREEN_HEIGHT - (gap_y + gap_size);
+                batch->active[p] = 1;
+                batch->passed[p] = 0;
+                active_count[w]++;
+                break;
+            }
+            batch->spawn_timer[w] = 0;
+        }
+    }
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        float* x = &batch->x[i * stride];
+        uint8_t* pillar_active = &batch->active[i * stride];
+        uint8_t* passed = &batch->passed[i * stride];
+        
+        for (int w = 0; w < count; w++) {
+            // Scroll speed is positive, so idle slots subtract +0.0f which
+            // leaves any float bit-for-bit unchanged
+            float moving = (float)(pillar_active[w] & active[w]);
+            x[w] -= scroll_speed[w] * moving;
+        }
+        
+        for (int w = 0; w < count; w++) {
+            uint8_t removed = pillar_active[w] & active[w] & (uint8_t)(x[w] < -PILLAR_WIDTH);
+            pillar_active[w] &= (uint8_t)~removed;
+            passed[w] &= (uint8_t)~removed;
+            active_count[w] -= removed;
+        }
+    }
+}
+
+void ice_pillars_check_collision_batch(const ice_pillars_batch_t* batch, const int* penguin_x, const int* penguin_y,
+                                       int penguin_width, int penguin_height, const uint8_t* active,
+                                       uint8_t* collided, int count) {
+    if (!batch || !penguin_x || !penguin_y || !active || !collided) return;
+    
+    const int stride = batch->stride;
+    
+    for (int w = 0; w < count; w++) {
+        collided[w] = 0;
+    }
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const float* x = &batch->x[i * stride];
+        const int* top_height = &batch->top_height[i * stride];
+        const int* bottom_y = &batch->bottom_y[i * stride];
+        const uint8_t* pillar_active = &batch->active[i * stride];
+        
+        for (int w = 0; w < count; w++) {
+            int pillar_x = (int)x[w];
+            uint8_t overlap_x = (penguin_x[w] < pillar_x + PILLAR_WIDTH) & (penguin_x[w] + penguin_width > pillar_x);
+            uint8_t overlap_y = (penguin_y[w] < top_height[w]) | (penguin_y[w] + penguin_height > bottom_y[w]);
+            collided[w] |= pillar_active[w] & active[w] & overlap_x & overlap_y;
+        }
+    }
+}
+
+void ice_pillars_check_passed_batch(const ice_pillars_batch_t* batch, const int* penguin_x,
+                                    const uint8_t* active, int count) {
+    if (!batch || !penguin_x || !active) return;
+    
+    const int stride = batch->stride;
+    
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const float* x = &batch->x[i * stride];
+        const uint8_t* pillar_active = &batch->active[i * stride];
+        uint8_t* passed = &batch->passed[i * stride];
+        
+        for (int w = 0; w < count; w++) {
+            passed[w] |= pillar_active[w] & active[w] & (penguin_x[w] > (int)x[w] + PILLAR_WIDTH);
+        }
+    }
+}
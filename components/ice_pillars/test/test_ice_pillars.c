@@ -326,6 +326,86 @@ void test_ice_pillars_update_spawning(void) {
     TEST_ASSERT_EQUAL(0, ctx.spawn_timer); // Should reset after spawn
 }
 
+// Spawns `count` pillars one at a time and records each gap
+static void spawn_gaps(ice_pillars_context_t* ctx, int count, int* gap_sizes, int* top_heights) {
+    for (int n = 0; n < count; n++) {
+        ice_pillars_spawn_pillar(ctx);
+        gap_sizes[n] = ctx->pillars[0].gap_size;
+        top_heights[n] = ctx->pillars[0].top_height;
+        ice_pillars_reset(ctx);
+    }
+}
+
+// Test Random Generator
+void test_ice_pillars_contexts_do_not_share_rng(void) {
+    ice_pillars_context_t alone;
+    ice_pillars_context_t first;
+    ice_pillars_context_t second;
+    int expected_sizes[8], expected_tops[8];
+    
+    ice_pillars_init(&alone);
+    spawn_gaps(&alone, 8, expected_sizes, expected_tops);
+    
+    // Interleave two worlds, re-initializing one midway
+    ice_pillars_init(&first);
+    ice_pillars_init(&second);
+    for (int n = 0; n < 8; n++) {
+        int size, top;
+        spawn_gaps(&first, 1, &size, &top);
+        TEST_ASSERT_EQUAL(expected_sizes[n], size);
+        TEST_ASSERT_EQUAL(expected_tops[n], top);
+        
+        if (n == 3) ice_pillars_init(&second);
+        spawn_gaps(&second, 1, &size, &top);
+    }
+}
+
+void test_ice_pillars_seek_spawn_matches_sequential(void) {
+    ice_pillars_rng_mode_t modes[] = {ICE_PILLARS_RNG_LCG, ICE_PILLARS_RNG_COUNTER};
+    
+    for (int m = 0; m < 2; m++) {
+        ice_pillars_context_t sequential;
+        int sizes[64], tops[64];
+        ice_pillars_init_seeded(&sequential, 777, modes[m]);
+        spawn_gaps(&sequential, 64, sizes, tops);
+        TEST_ASSERT_EQUAL(64, ice_pillars_get_spawn_index(&sequential));
+        
+        for (uint32_t target = 0; target < 64; target += 7) {
+            ice_pillars_context_t jumped;
+            int size, top;
+            ice_pillars_init_seeded(&jumped, 777, modes[m]);
+            ice_pillars_seek_spawn(&jumped, target);
+            TEST_ASSERT_EQUAL(target, ice_pillars_get_spawn_index(&jumped));
+            
+            spawn_gaps(&jumped, 1, &size, &top);
+            TEST_ASSERT_EQUAL(sizes[target], size);
+            TEST_ASSERT_EQUAL(tops[target], top);
+        }
+    }
+}
+
+void test_ice_pillars_counter_rng_gaps_in_range(void) {
+    ice_pillars_context_t ctx;
+    ice_pillars_context_t other_seed;
+    int sizes[200], tops[200];
+    int other_sizes[200], other_tops[200];
+    
+    ice_pillars_init_seeded(&ctx, 1, ICE_PILLARS_RNG_COUNTER);
+    ice_pillars_init_seeded(&other_seed, 2, ICE_PILLARS_RNG_COUNTER);
+    spawn_gaps(&ctx, 200, sizes, tops);
+    spawn_gaps(&other_seed, 200, other_sizes, other_tops);
+    
+    int differences = 0;
+    for (int n = 0; n < 200; n++) {
+        TEST_ASSERT_GREATER_OR_EQUAL(MIN_GAP_SIZE, sizes[n]);
+        TEST_ASSERT_LESS_OR_EQUAL(MAX_GAP_SIZE, sizes[n]);
+        TEST_ASSERT_GREATER_OR_EQUAL(20, tops[n]);
+        TEST_ASSERT_LESS_OR_EQUAL(SCREEN_HEIGHT - 20, tops[n] + sizes[n]);
+        differences += sizes[n] != other_sizes[n] || tops[n] != other_tops[n];
+    }
+    TEST_ASSERT_GREATER_THAN(150, differences);
+}
+
 void app_main(void) {
     UNITY_BEGIN();
     
@@ -362,5 +442,10 @@ void app_main(void) {
     // Update Tests
     RUN_TEST(test_ice_pillars_update_spawning);
     
+    // Random Generator Tests
+    RUN_TEST(test_ice_pillars_contexts_do_not_share_rng);
+    RUN_TEST(test_ice_pillars_seek_spawn_matches_sequential);
+    RUN_TEST(test_ice_pillars_counter_rng_gaps_in_range);
+    
     UNITY_END();
 }
\ No newline at end of file
@@ -22,8 +22,46 @@ typedef struct {
     uint32_t button_press_duration;
 } penguin_t;
 
+// Structure-of-arrays view over many penguins for batched headless simulation.
+// Each pointer addresses `count` consecutive elements owned by the caller.
+typedef struct {
+    float* x;
+    float* y;
+    float* velocity_y;
+    float* acceleration_y;
+    uint8_t* button_pressed;      // Flags are stored as 0/1 bytes so loops over them vectorize
+    uint8_t* was_button_pressed;
+    uint32_t* button_press_duration;
+} penguin_batch_t;
+
+// Implementations of penguin_physics_update_batch(). Vector kernels are only
+// available on x86 hosts with the matching instruction set.
+typedef enum {
+    PENGUIN_BATCH_KERNEL_SCALAR,
+    PENGUIN_BATCH_KERNEL_SSE2,
+    PENGUIN_BATCH_KERNEL_AVX2
+} penguin_batch_kernel_t;
+
 void penguin_physics_init(penguin_t* penguin);
 void penguin_physics_update(penguin_t* penguin, bool button_pressed);
+// Same result, bit for bit, as calling penguin_physics_update() `frames` times
+// with the same input. Long holds cost a bounded number of steps rather than
+// one per frame.
+void penguin_physics_advance(penguin_t* penguin, bool button_pressed, uint32_t frames);
+// Same, but stops before the first frame that would end with y outside
+// [min_y, max_y). Returns the number of frames advanced.
+uint32_t penguin_physics_advance_within(penguin_t* penguin, bool button_pressed, uint32_t frames,
+                                        float min_y, float max_y);
+// Steps every penguin whose `active` flag is set (all of them when `active` is NULL)
+// with exactly the same results as calling penguin_physics_update() on each one.
+// Uses the fastest kernel the CPU supports unless one was selected explicitly.
+void penguin_physics_update_batch(const penguin_batch_t* batch, const uint8_t* button_pressed,
+                                  const uint8_t* active, int count);
+bool penguin_physics_batch_kernel_supported(penguin_batch_kernel_t kernel);
+// Returns false and keeps the current kernel if `kernel` is not supported
+bool penguin_physics_set_batch_kernel(penguin_batch_kernel_t kernel);
+penguin_batch_kernel_t penguin_physics_get_batch_kernel(void);
+const char* penguin_physics_batch_kernel_name(penguin_batch_kernel_t kernel);
 void penguin_physics_apply_dive_force(penguin_t* penguin, float force);
 void penguin_physics_apply_rise_force(penguin_t* penguin);
 bool penguin_physics_is_within_screen_bounds(penguin_t* penguin);
@@ -1,10 +1,9 @@
 #include "penguin_physics.h"
+#include "penguin_physics_internal.h"
 #include <string.h>
+#include <math.h>
+#include <float.h>
 
-#define GRAVITY 0.12f
-#define DIVE_FORCE 6.0f
-#define RISE_FORCE 1.5f
-#define MAX_VELOCITY 3.5f
 #define PENGUIN_START_X (SCREEN_WIDTH / 6.0f)
 #define PENGUIN_START_Y (SCREEN_HEIGHT / 2.0f)
 
@@ -42,7 +41,7 @@ void penguin_physics_update(penguin_t* penguin, bool button_pressed) {
     // Apply physics
     penguin->velocity_y += penguin->acceleration_y;
     // Add velocity damping for more control
-    penguin->velocity_y *= 0.92f;
+    penguin->velocity_y *= VELOCITY_DAMPING;
     
     // Clamp velocity
     if (penguin->velocity_y > MAX_VELOCITY) {
@@ -58,15 +57,152 @@ void penguin_physics_update(penguin_t* penguin, bool button_pressed) {
     penguin_physics_constrain_to_screen(penguin);
 }
 
+// Number of the next `frames` frames that can be taken as one add while the
+// penguin moves at a constant `velocity` from `y` and stays in [min_y, max_y).
+// Each frame adds the velocity and rounds, so the jump is only taken where every
+// one of those adds is exact: both values must be multiples of the spacing of
+// floats around y, and the sum must not grow into the next binade, where the
+// spacing doubles.
+static uint32_t penguin_physics_cruise_frames(float y, float velocity, uint32_t frames, float min_y, float max_y) {
+    if (velocity == 0.0f || !(y > 0.0f)) return 0;
+    
+    int exponent;
+    frexpf(y, &exponent); // y lies in [2^(exponent - 1), 2^exponent)
+    double spacing = ldexp(1.0, exponent - FLT_MANT_DIG);
+    if (fmod(velocity, spacing) != 0.0) return 0;
+    
+    // The quotients below are of exact values small enough that double
+    // division never rounds a fraction onto a whole number
+    double jump;
+    if (velocity > 0.0f) {
+        double binade_frames = ceil((ldexp(1.0, exponent) - y) / velocity) - 1.0;
+        double edge_frames = floor((PENGUIN_MAX_Y - y) / velocity);
+        double band_frames = ceil((max_y - y) / velocity) - 1.0;
+        jump = fmin(fmin(binade_frames, edge_frames), band_frames);
+    } else {
+        // Smaller binades only have finer spacing, so sums stay exact down to the top edge
+        double edge_frames = floor(y / -velocity);
+        double band_frames = floor((y - min_y) / -velocity);
+        jump = fmin(edge_frames, band_frames);
+    }
+    
+    if (jump <= 0.0) return 0;
+    return jump < frames ? (uint32_t)jump : frames;
+}
+
+void penguin_physics_advance(penguin_t* penguin, bool button_pressed, uint32_t frames) {
+    penguin_physics_advance_within(penguin, button_pressed, frames, -INFINITY, INFINITY);
+}
+
+uint32_t penguin_physics_advance_within(penguin_t* penguin, bool button_pressed, uint32_t frames,
+                                        float min_y, float max_y) {
+    if (!penguin) return 0;
+    
+    // Once the button state has been the same for two frames, every frame
+    // applies the same map to (y, velocity). That map is stepped exactly, since
+    // the geometric-series form of the damped velocity rounds differently from
+    // the per-frame float ops. Under either input the velocity saturates at the
+    // clamp within a few dozen frames, after which only the position changes,
+    // by a constant each frame.
+    uint32_t advanced = 0;
+    while (advanced < frames) {
+        penguin_t next = *penguin;
+        penguin_physics_update(&next, button_pressed);
+        if (next.y < min_y || next.y >= max_y) break;
+        
+        bool settled = penguin->button_pressed == button_pressed && penguin->was_button_pressed == button_pressed;
+        bool same_velocity = next.velocity_y == penguin->velocity_y;
+        bool same_y = next.y == penguin->y;
+        *penguin = next;
+        advanced++;
+        
+        // Still converging, or held at an edge with the velocity reset
+        if (!settled || !same_velocity) continue;
+        
+        if (same_y) {
+            // Fixed point: the remaining frames only count the press
+            if (button_pressed) penguin->button_press_duration += frames - advanced;
+            return frames;
+        }
+        
+        uint32_t jump = penguin_physics_cruise_frames(penguin->y, penguin->velocity_y, frames - advanced, min_y, max_y);
+        if (jump > 0) {
+            penguin->y = (float)((double)penguin->y + (double)jump * penguin->velocity_y);
+            if (button_pressed) penguin->button_press_duration += jump;
+            advanced += jump;
+        }
+    }
+    return advanced;
+}
+
+void penguin_physics_update_batch_scalar(const penguin_batch_t* batch, const uint8_t* button_pressed,
+                                         const uint8_t* active, int begin, int end) {
+    // Same arithmetic, in the same order, as penguin_physics_update() so that
+    // batched and per-penguin stepping produce bit-identical floats
+    for (int i = begin; i < end; i++) {
+        if (active && !active[i]) continue;
+        
+        bool pressed = button_pressed[i];
+        bool was_pressed = batch->button_pressed[i];
+        batch->was_button_pressed[i] = was_pressed;
+        batch->button_pressed[i] = pressed;
+        batch->button_press_duration[i] = pressed ? batch->button_press_duration[i] + 1 : 0;
+        
+        float velocity = batch->velocity_y[i];
+        float acceleration;
+        if (pressed) {
+            acceleration = DIVE_ACCELERATION;
+            if (!was_pressed) {
+                velocity += DIVE_IMPULSE;
+            }
+        } else {
+            acceleration = RISE_ACCELERATION;
+            if (was_pressed) {
+                velocity -= RISE_IMPULSE;
+            }
+        }
+        
+        velocity += acceleration;
+        velocity *= VELOCITY_DAMPING;
+        
+        if (velocity > MAX_VELOCITY) {
+            velocity = MAX_VELOCITY;
+        } else if (velocity < -MAX_VELOCITY) {
+            velocity = -MAX_VELOCITY;
+        }
+        
+        float y = batch->y[i] + velocity;
+        if (y < 0) {
+            y = 0;
+            velocity = 0;
+        } else if (y > PENGUIN_MAX_Y) {
+            y = PENGUIN_MAX_Y;
+            velocity = 0;
+        }
+        
+        float x = batch->x[i];
+        if (x < 0) {
+            x = 0;
+        } else if (x > PENGUIN_MAX_X) {
+            x = PENGUIN_MAX_X;
+        }
+        
+        batch->x[i] = x;
+        batch->y[i] = y;
+        batch->velocity_y[i] = velocity;
+        batch->acceleration_y[i] = acceleration;
+    }
+}
+
 void penguin_physics_apply_dive_force(penguin_t* penguin, float force) {
     if (!penguin) return;
     
     // Diving force pulls penguin down - even less strong for easier control
-    penguin->acceleration_y = GRAVITY + (force * 0.05f);
+    penguin->acceleration_y = GRAVITY + (force * DIVE_ACCELERATION_SCALE);
     
     // Immediate velocity boost for responsive controls - less strong
     if (!penguin->was_button_pressed && penguin->button_pressed) {
-        penguin->velocity_y += force * 0.5f;
+        penguin->velocity_y += force * DIVE_IMPULSE_SCALE;
     }
 }
 
@@ -78,7 +214,7 @@ void penguin_physics_apply_rise_force(penguin_t* penguin) {
     
     // Much stronger upward velocity when button released for better control
     if (penguin->was_button_pressed && !penguin->button_pressed) {
-        penguin->velocity_y -= RISE_FORCE * 4.0f;
+        penguin->velocity_y -= RISE_FORCE * RISE_IMPULSE_SCALE;
     }
 }
 
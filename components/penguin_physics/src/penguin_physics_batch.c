@@ -0,0 +1,281 @@
+#include "penguin_physics.h"
+#include "penguin_physics_internal.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PENGUIN_PHYSICS_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define PENGUIN_PHYSICS_X86_KERNELS 0
+#endif
+
+// The vector kernels replace every branch of penguin_physics_update() with a
+// compare mask and a select, but keep each float operation and its order, so
+// they produce exactly the same bits as the scalar code. Selects are used
+// instead of min/max so NaN and signed zero propagate the way the scalar
+// comparisons do. Penguins whose `active` flag is clear keep their old values.
+
+#if PENGUIN_PHYSICS_X86_KERNELS
+
+#define SSE2_LANES 4
+#define AVX2_LANES 8
+
+__attribute__((target("sse2")))
+static inline __m128 select_ps_sse2(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+static inline __m128i select_si_sse2(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Widens four flag bytes to 32-bit lanes
+__attribute__((target("sse2")))
+static inline __m128i load_flags_sse2(const uint8_t* flags) {
+    int32_t bytes;
+    memcpy(&bytes, flags, sizeof(bytes));
+    __m128i zero = _mm_setzero_si128();
+    __m128i wide = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+    return _mm_unpacklo_epi16(wide, zero);
+}
+
+// Narrows four 32-bit lanes holding byte values back to flag bytes
+__attribute__((target("sse2")))
+static inline void store_flags_sse2(uint8_t* flags, __m128i lanes) {
+    __m128i words = _mm_packs_epi32(lanes, lanes);
+    int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    memcpy(flags, &bytes, sizeof(bytes));
+}
+
+__attribute__((target("sse2")))
+static void update_batch_sse2(const penguin_batch_t* batch, const uint8_t* button_pressed,
+                              const uint8_t* active, int count) {
+    const __m128i zero_i = _mm_setzero_si128();
+    const __m128i all_ones = _mm_cmpeq_epi32(zero_i, zero_i);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128 zero = _mm_setzero_ps();
+    
+    int i = 0;
+    for (; i + SSE2_LANES <= count; i += SSE2_LANES) {
+        __m128i live = all_ones;
+        if (active) {
+            live = _mm_andnot_si128(_mm_cmpeq_epi32(load_flags_sse2(&active[i]), zero_i), all_ones);
+        }
+        
+        // Button tracking
+        __m128i old_pressed_raw = load_flags_sse2(&batch->button_pressed[i]);
+        __m128i old_was_raw = load_flags_sse2(&batch->was_button_pressed[i]);
+        __m128i pressed = _mm_andnot_si128(_mm_cmpeq_epi32(load_flags_sse2(&button_pressed[i]), zero_i), all_ones);
+        __m128i was = _mm_andnot_si128(_mm_cmpeq_epi32(old_pressed_raw, zero_i), all_ones);
+        store_flags_sse2(&batch->was_button_pressed[i],
+                         select_si_sse2(live, _mm_and_si128(was, one), old_was_raw));
+        store_flags_sse2(&batch->button_pressed[i],
+                         select_si_sse2(live, _mm_and_si128(pressed, one), old_pressed_raw));
+        
+        __m128i duration = _mm_loadu_si128((const __m128i*)&batch->button_press_duration[i]);
+        __m128i new_duration = _mm_and_si128(pressed, _mm_add_epi32(duration, one));
+        _mm_storeu_si128((__m128i*)&batch->button_press_duration[i], select_si_sse2(live, new_duration, duration));
+        
+        // Forces and press/release impulses
+        __m128 pressed_ps = _mm_castsi128_ps(pressed);
+        __m128 was_ps = _mm_castsi128_ps(was);
+        __m128 old_velocity = _mm_loadu_ps(&batch->velocity_y[i]);
+        __m128 velocity = old_velocity;
+        velocity = select_ps_sse2(_mm_andnot_ps(was_ps, pressed_ps),
+                                  _mm_add_ps(velocity, _mm_set1_ps(DIVE_IMPULSE)), velocity);
+        velocity = select_ps_sse2(_mm_andnot_ps(pressed_ps, was_ps),
+                                  _mm_sub_ps(velocity, _mm_set1_ps(RISE_IMPULSE)), velocity);
+        __m128 acceleration = select_ps_sse2(pressed_ps, _mm_set1_ps(DIVE_ACCELERATION),
+                                             _mm_set1_ps(RISE_ACCELERATION));
+        
+        velocity = _mm_add_ps(velocity, acceleration);
+        velocity = _mm_mul_ps(velocity, _mm_set1_ps(VELOCITY_DAMPING));
+        
+        velocity = select_ps_sse2(_mm_cmpgt_ps(velocity, _mm_set1_ps(MAX_VELOCITY)),
+                                  _mm_set1_ps(MAX_VELOCITY), velocity);
+        velocity = select_ps_sse2(_mm_cmplt_ps(velocity, _mm_set1_ps(-MAX_VELOCITY)),
+                                  _mm_set1_ps(-MAX_VELOCITY), velocity);
+        
+        // Screen bounds
+        __m128 old_y = _mm_loadu_ps(&batch->y[i]);
+        __m128 y = _mm_add_ps(old_y, velocity);
+        __m128 y_low = _mm_cmplt_ps(y, zero);
+        __m128 y_high = _mm_cmpgt_ps(y, _mm_set1_ps(PENGUIN_MAX_Y));
+        y = select_ps_sse2(y_low, zero, y);
+        y = select_ps_sse2(y_high, _mm_set1_ps(PENGUIN_MAX_Y), y);
+        velocity = select_ps_sse2(_mm_or_ps(y_low, y_high), zero, velocity);
+        
+        __m128 old_x = _mm_loadu_ps(&batch->x[i]);
+        __m128 x = old_x;
+        x = select_ps_sse2(_mm_cmplt_ps(old_x, zero), zero, x);
+        x = select_ps_sse2(_mm_cmpgt_ps(old_x, _mm_set1_ps(PENGUIN_MAX_X)), _mm_set1_ps(PENGUIN_MAX_X), x);
+        
+        __m128 live_ps = _mm_castsi128_ps(live);
+        _mm_storeu_ps(&batch->x[i], select_ps_sse2(live_ps, x, old_x));
+        _mm_storeu_ps(&batch->y[i], select_ps_sse2(live_ps, y, old_y));
+        _mm_storeu_ps(&batch->velocity_y[i], select_ps_sse2(live_ps, velocity, old_velocity));
+        _mm_storeu_ps(&batch->acceleration_y[i],
+                      select_ps_sse2(live_ps, acceleration, _mm_loadu_ps(&batch->acceleration_y[i])));
+    }
+    
+    penguin_physics_update_batch_scalar(batch, button_pressed, active, i, count);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i load_flags_avx2(const uint8_t* flags) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)flags));
+}
+
+__attribute__((target("avx2")))
+static inline void store_flags_avx2(uint8_t* flags, __m256i lanes) {
+    __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    _mm_storel_epi64((__m128i*)flags, _mm_packus_epi16(words, words));
+}
+
+__attribute__((target("avx2")))
+static void update_batch_avx2(const penguin_batch_t* batch, const uint8_t* button_pressed,
+                              const uint8_t* active, int count) {
+    const __m256i zero_i = _mm256_setzero_si256();
+    const __m256i all_ones = _mm256_cmpeq_epi32(zero_i, zero_i);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 zero = _mm256_setzero_ps();
+    
+    int i = 0;
+    for (; i + AVX2_LANES <= count; i += AVX2_LANES) {
+        __m256i live = all_ones;
+        if (active) {
+            live = _mm256_andnot_si256(_mm256_cmpeq_epi32(load_flags_avx2(&active[i]), zero_i), all_ones);
+        }
+        
+        // Button tracking
+        __m256i old_pressed_raw = load_flags_avx2(&batch->button_pressed[i]);
+        __m256i old_was_raw = load_flags_avx2(&batch->was_button_pressed[i]);
+        __m256i pressed = _mm256_andnot_si256(_mm256_cmpeq_epi32(load_flags_avx2(&button_pressed[i]), zero_i), all_ones);
+        __m256i was = _mm256_andnot_si256(_mm256_cmpeq_epi32(old_pressed_raw, zero_i), all_ones);
+        store_flags_avx2(&batch->was_button_pressed[i],
+                         _mm256_blendv_epi8(old_was_raw, _mm256_and_si256(was, one), live));
+        store_flags_avx2(&batch->button_pressed[i],
+                         _mm256_blendv_epi8(old_pressed_raw, _mm256_and_si256(pressed, one), live));
+        
+        __m256i duration = _mm256_loadu_si256((const __m256i*)&batch->button_press_duration[i]);
+        __m256i new_duration = _mm256_and_si256(pressed, _mm256_add_epi32(duration, one));
+        _mm256_storeu_si256((__m256i*)&batch->button_press_duration[i],
+                            _mm256_blendv_epi8(duration, new_duration, live));
+        
+        // Forces and press/release impulses
+        __m256 pressed_ps = _mm256_castsi256_ps(pressed);
+        __m256 was_ps = _mm256_castsi256_ps(was);
+        __m256 old_velocity = _mm256_loadu_ps(&batch->velocity_y[i]);
+        __m256 velocity = old_velocity;
+        velocity = _mm256_blendv_ps(velocity, _mm256_add_ps(velocity, _mm256_set1_ps(DIVE_IMPULSE)),
+                                    _mm256_andnot_ps(was_ps, pressed_ps));
+        velocity = _mm256_blendv_ps(velocity, _mm256_sub_ps(velocity, _mm256_set1_ps(RISE_IMPULSE)),
+                                    _mm256_andnot_ps(pressed_ps, was_ps));
+        __m256 acceleration = _mm256_blendv_ps(_mm256_set1_ps(RISE_ACCELERATION),
+                                               _mm256_set1_ps(DIVE_ACCELERATION), pressed_ps);
+        
+        velocity = _mm256_add_ps(velocity, acceleration);
+        velocity = _mm256_mul_ps(velocity, _mm256_set1_ps(VELOCITY_DAMPING));
+        
+        velocity = _mm256_blendv_ps(velocity, _mm256_set1_ps(MAX_VELOCITY),
+                                    _mm256_cmp_ps(velocity, _mm256_set1_ps(MAX_VELOCITY), _CMP_GT_OQ));
+        velocity = _mm256_blendv_ps(velocity, _mm256_set1_ps(-MAX_VELOCITY),
+                                    _mm256_cmp_ps(velocity, _mm256_set1_ps(-MAX_VELOCITY), _CMP_LT_OQ));
+        
+        // Screen bounds
+        __m256 old_y = _mm256_loadu_ps(&batch->y[i]);
+        __m256 y = _mm256_add_ps(old_y, velocity);
+        __m256 y_low = _mm256_cmp_ps(y, zero, _CMP_LT_OQ);
+        __m256 y_high = _mm256_cmp_ps(y, _mm256_set1_ps(PENGUIN_MAX_Y), _CMP_GT_OQ);
+        y = _mm256_blendv_ps(y, zero, y_low);
+        y = _mm256_blendv_ps(y, _mm256_set1_ps(PENGUIN_MAX_Y), y_high);
+        velocity = _mm256_blendv_ps(velocity, zero, _mm256_or_ps(y_low, y_high));
+        
+        __m256 old_x = _mm256_loadu_ps(&batch->x[i]);
+        __m256 x = old_x;
+        x = _mm256_blendv_ps(x, zero, _mm256_cmp_ps(old_x, zero, _CMP_LT_OQ));
+        x = _mm256_blendv_ps(x, _mm256_set1_ps(PENGUIN_MAX_X),
+                             _mm256_cmp_ps(old_x, _mm256_set1_ps(PENGUIN_MAX_X), _CMP_GT_OQ));
+        
+        __m256 live_ps = _mm256_castsi256_ps(live);
+        _mm256_storeu_ps(&batch->x[i], _mm256_blendv_ps(old_x, x, live_ps));
+        _mm256_storeu_ps(&batch->y[i], _mm256_blendv_ps(old_y, y, live_ps));
+        _mm256_storeu_ps(&batch->velocity_y[i], _mm256_blendv_ps(old_velocity, velocity, live_ps));
+        _mm256_storeu_ps(&batch->acceleration_y[i],
+                         _mm256_blendv_ps(_mm256_loadu_ps(&batch->acceleration_y[i]), acceleration, live_ps));
+    }
+    
+    penguin_physics_update_batch_scalar(batch, button_pressed, active, i, count);
+}
+
+#endif // PENGUIN_PHYSICS_X86_KERNELS
+
+static penguin_batch_kernel_t batch_kernel;
+static bool batch_kernel_selected = false;
+
+bool penguin_physics_batch_kernel_supported(penguin_batch_kernel_t kernel) {
+    switch (kernel) {
+        case PENGUIN_BATCH_KERNEL_SCALAR:
+            return true;
+#if PENGUIN_PHYSICS_X86_KERNELS
+        case PENGUIN_BATCH_KERNEL_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case PENGUIN_BATCH_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+bool penguin_physics_set_batch_kernel(penguin_batch_kernel_t kernel) {
+    if (!penguin_physics_batch_kernel_supported(kernel)) return false;
+    
+    batch_kernel = kernel;
+    batch_kernel_selected = true;
+    return true;
+}
+
+penguin_batch_kernel_t penguin_physics_get_batch_kernel(void) {
+    if (!batch_kernel_selected) {
+        // Detection is idempotent, so racing first callers all pick the same kernel
+        if (penguin_physics_batch_kernel_supported(PENGUIN_BATCH_KERNEL_AVX2)) {
+            batch_kernel = PENGUIN_BATCH_KERNEL_AVX2;
+        } else if (penguin_physics_batch_kernel_supported(PENGUIN_BATCH_KERNEL_SSE2)) {
+            batch_kernel = PENGUIN_BATCH_KERNEL_SSE2;
+        } else {
+            batch_kernel = PENGUIN_BATCH_KERNEL_SCALAR;
+        }
+        batch_kernel_selected = true;
+    }
+    return batch_kernel;
+}
+
+const char* penguin_physics_batch_kernel_name(penguin_batch_kernel_t kernel) {
+    switch (kernel) {
+        case PENGUIN_BATCH_KERNEL_SCALAR: return "scalar";
+        case PENGUIN_BATCH_KERNEL_SSE2: return "sse2";
+        case PENGUIN_BATCH_KERNEL_AVX2: return "avx2";
+        default: return "unknown";
+    }
+}
+
+void penguin_physics_update_batch(const penguin_batch_t* batch, const uint8_t* button_pressed,
+                                  const uint8_t* active, int count) {
+    if (!batch || !button_pressed) return;
+    
+    switch (penguin_physics_get_batch_kernel()) {
+#if PENGUIN_PHYSICS_X86_KERNELS
+        case PENGUIN_BATCH_KERNEL_AVX2:
+            update_batch_avx2(batch, button_pressed, active, count);
+            break;
+        case PENGUIN_BATCH_KERNEL_SSE2:
+            update_batch_sse2(batch, button_pressed, active, count);
+            break;
+#endif
+        default:
+            penguin_physics_update_batch_scalar(batch, button_pressed, active, 0, count);
+            break;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "penguin_physics.h"
+
+#define GRAVITY 0.12f
+#define DIVE_FORCE 6.0f
+#define RISE_FORCE 1.5f
+#define MAX_VELOCITY 3.5f
+#define VELOCITY_DAMPING 0.92f
+#define DIVE_ACCELERATION_SCALE 0.05f
+#define DIVE_IMPULSE_SCALE 0.5f
+#define RISE_IMPULSE_SCALE 4.0f
+
+// Per-frame values of the forces applied by penguin_physics_update(), shared
+// with the batch kernels so every path folds the same float constants
+#define DIVE_ACCELERATION (GRAVITY + (DIVE_FORCE * DIVE_ACCELERATION_SCALE))
+#define RISE_ACCELERATION (-(RISE_FORCE - GRAVITY))
+#define DIVE_IMPULSE (DIVE_FORCE * DIVE_IMPULSE_SCALE)
+#define RISE_IMPULSE (RISE_FORCE * RISE_IMPULSE_SCALE)
+
+#define PENGUIN_MAX_X (SCREEN_WIDTH - PENGUIN_WIDTH)
+#define PENGUIN_MAX_Y (SCREEN_HEIGHT - PENGUIN_HEIGHT)
+
+// Reference batch kernel over penguins [begin, end). The vector kernels use it
+// for the tail that does not fill a whole vector.
+void penguin_physics_update_batch_scalar(const penguin_batch_t* batch, const uint8_t* button_pressed,
+                                         const uint8_t* active, int begin, int end);
@@ -1,5 +1,7 @@
 #include "unity.h"
 #include "penguin_physics.h"
+#include <math.h>
+#include <string.h>
 
 void setUp(void) {
     // Set up code here runs before each test
@@ -285,6 +287,134 @@ void test_penguin_physics_button_state_tracking(void) {
     TEST_ASSERT_TRUE(penguin.was_button_pressed);
 }
 
+#define KERNEL_TEST_PENGUINS 37
+#define KERNEL_TEST_FRAMES 2000
+
+static uint32_t kernel_test_random(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+// Starting states include the values where mask-and-select code most easily
+// diverges from branches: NaN, infinities, signed zeros and exact bounds
+static float kernel_test_start_value(uint32_t* state, float low, float high) {
+    static const float special[] = {0.0f, -0.0f, 3.5f, -3.5f, 220.0f, 115.0f, INFINITY, -INFINITY, NAN};
+    uint32_t pick = kernel_test_random(state);
+    if (pick % 4 == 0) {
+        return special[(pick / 4) % (sizeof(special) / sizeof(special[0]))];
+    }
+    return low + (high - low) * (float)(kernel_test_random(state) % 10000) / 10000.0f;
+}
+
+void test_penguin_physics_batch_kernels_match_scalar(void) {
+    penguin_batch_kernel_t kernels[] = {
+        PENGUIN_BATCH_KERNEL_SCALAR, PENGUIN_BATCH_KERNEL_SSE2, PENGUIN_BATCH_KERNEL_AVX2
+    };
+    penguin_batch_kernel_t default_kernel = penguin_physics_get_batch_kernel();
+    
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!penguin_physics_set_batch_kernel(kernels[k])) continue;
+        
+        uint32_t rng = 99 + (uint32_t)k;
+        penguin_t expected[KERNEL_TEST_PENGUINS];
+        float x[KERNEL_TEST_PENGUINS], y[KERNEL_TEST_PENGUINS];
+        float velocity[KERNEL_TEST_PENGUINS], acceleration[KERNEL_TEST_PENGUINS];
+        uint8_t pressed[KERNEL_TEST_PENGUINS], was_pressed[KERNEL_TEST_PENGUINS];
+        uint32_t duration[KERNEL_TEST_PENGUINS];
+        penguin_batch_t batch = {x, y, velocity, acceleration, pressed, was_pressed, duration};
+        
+        for (int i = 0; i < KERNEL_TEST_PENGUINS; i++) {
+            penguin_physics_init(&expected[i]);
+            expected[i].x = kernel_test_start_value(&rng, -20.0f, 150.0f);
+            expected[i].y = kernel_test_start_value(&rng, -20.0f, 260.0f);
+            expected[i].velocity_y = kernel_test_start_value(&rng, -6.0f, 6.0f);
+            x[i] = expected[i].x;
+            y[i] = expected[i].y;
+            velocity[i] = expected[i].velocity_y;
+            acceleration[i] = expected[i].acceleration_y;
+            pressed[i] = expected[i].button_pressed;
+            was_pressed[i] = expected[i].was_button_pressed;
+            duration[i] = expected[i].button_press_duration;
+        }
+        
+        for (int frame = 0; frame < KERNEL_TEST_FRAMES; frame++) {
+            uint8_t buttons[KERNEL_TEST_PENGUINS];
+            uint8_t active[KERNEL_TEST_PENGUINS];
+            for (int i = 0; i < KERNEL_TEST_PENGUINS; i++) {
+                uint32_t bits = kernel_test_random(&rng);
+                // Mostly held presses with occasional edges, and a few paused penguins
+                buttons[i] = ((bits >> 4) % 5 < 2) ? (uint8_t)(1 + bits % 3) : 0;
+                active[i] = (bits >> 12) % 8 != 0;
+                if (active[i]) {
+                    penguin_physics_update(&expected[i], buttons[i] != 0);
+                }
+            }
+            penguin_physics_update_batch(&batch, buttons, active, KERNEL_TEST_PENGUINS);
+            
+            for (int i = 0; i < KERNEL_TEST_PENGUINS; i++) {
+                TEST_ASSERT_EQUAL_MEMORY(&expected[i].x, &x[i], sizeof(float));
+                TEST_ASSERT_EQUAL_MEMORY(&expected[i].y, &y[i], sizeof(float));
+                TEST_ASSERT_EQUAL_MEMORY(&expected[i].velocity_y, &velocity[i], sizeof(float));
+                TEST_ASSERT_EQUAL_MEMORY(&expected[i].acceleration_y, &acceleration[i], sizeof(float));
+                TEST_ASSERT_EQUAL(expected[i].button_pressed, pressed[i]);
+                TEST_ASSERT_EQUAL(expected[i].was_button_pressed, was_pressed[i]);
+                TEST_ASSERT_EQUAL(expected[i].button_press_duration, duration[i]);
+            }
+        }
+    }
+    
+    penguin_physics_set_batch_kernel(default_kernel);
+}
+
+void test_penguin_physics_batch_kernel_selection(void) {
+    penguin_batch_kernel_t default_kernel = penguin_physics_get_batch_kernel();
+    TEST_ASSERT_TRUE(penguin_physics_batch_kernel_supported(default_kernel));
+    TEST_ASSERT_TRUE(penguin_physics_batch_kernel_supported(PENGUIN_BATCH_KERNEL_SCALAR));
+    
+    TEST_ASSERT_TRUE(penguin_physics_set_batch_kernel(PENGUIN_BATCH_KERNEL_SCALAR));
+    TEST_ASSERT_EQUAL(PENGUIN_BATCH_KERNEL_SCALAR, penguin_physics_get_batch_kernel());
+    TEST_ASSERT_FALSE(penguin_physics_set_batch_kernel((penguin_batch_kernel_t)42));
+    TEST_ASSERT_EQUAL(PENGUIN_BATCH_KERNEL_SCALAR, penguin_physics_get_batch_kernel());
+    
+    penguin_physics_set_batch_kernel(default_kernel);
+}
+
+#define ADVANCE_TEST_STATES 200
+
+void test_penguin_physics_advance_matches_stepping(void) {
+    const uint32_t spans[] = {0, 1, 2, 3, 7, 25, 64, 150, 1000, 20000};
+    uint32_t rng = 4242;
+    
+    for (int s = 0; s < ADVANCE_TEST_STATES; s++) {
+        penguin_t start;
+        penguin_physics_init(&start);
+        start.x = kernel_test_start_value(&rng, -20.0f, 150.0f);
+        start.y = kernel_test_start_value(&rng, -20.0f, 260.0f);
+        start.velocity_y = kernel_test_start_value(&rng, -6.0f, 6.0f);
+        start.button_pressed = kernel_test_random(&rng) & 1;
+        start.was_button_pressed = kernel_test_random(&rng) & 1;
+        start.button_press_duration = kernel_test_random(&rng) % 100;
+        bool pressed = kernel_test_random(&rng) & 1;
+        
+        for (size_t i = 0; i < sizeof(spans) / sizeof(spans[0]); i++) {
+            penguin_t expected = start;
+            for (uint32_t f = 0; f < spans[i]; f++) {
+                penguin_physics_update(&expected, pressed);
+            }
+            penguin_t actual = start;
+            penguin_physics_advance(&actual, pressed, spans[i]);
+            
+            TEST_ASSERT_EQUAL_MEMORY(&expected.x, &actual.x, sizeof(float));
+            TEST_ASSERT_EQUAL_MEMORY(&expected.y, &actual.y, sizeof(float));
+            TEST_ASSERT_EQUAL_MEMORY(&expected.velocity_y, &actual.velocity_y, sizeof(float));
+            TEST_ASSERT_EQUAL_MEMORY(&expected.acceleration_y, &actual.acceleration_y, sizeof(float));
+            TEST_ASSERT_EQUAL(expected.button_pressed, actual.button_pressed);
+            TEST_ASSERT_EQUAL(expected.was_button_pressed, actual.was_button_pressed);
+            TEST_ASSERT_EQUAL_UINT32(expected.button_press_duration, actual.button_press_duration);
+        }
+    }
+}
+
 void app_main(void) {
     UNITY_BEGIN();
     
@@ -320,5 +450,12 @@ void app_main(void) {
     // Button State Tests
     RUN_TEST(test_penguin_physics_button_state_tracking);
     
+    // Batch Kernel Tests
+    RUN_TEST(test_penguin_physics_batch_kernels_match_scalar);
+    RUN_TEST(test_penguin_physics_batch_kernel_selection);
+    
+    // Fast-forward Tests
+    RUN_TEST(test_penguin_physics_advance_matches_stepping);
+    
     UNITY_END();
 }
\ No newline at end of file
@@ -2,14 +2,57 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "sdkconfig.h"
 #include "display_driver.h"
 #include "input.h"
 #include "game_engine.h"
 #include "penguin_physics.h"
 #include "ice_pillars.h"
+#include "game_sim.h"
+#include "game_sim_replay.h"
+#include "game_render_sprite.h"
+#include "game_render_band.h"
 
 static const char *TAG = "display_driver_demo";
 
+// Input of the current game, run-length coded into RAM. Several minutes of
+// typical play fit; longer games are marked overflowed.
+#define REPLAY_RING_SIZE 4096
+static uint8_t replay_ring[REPLAY_RING_SIZE];
+
+#ifdef CONFIG_DISPLAY_DRIVER_BANDED
+// Two band buffers instead of a full frame; still too big for the main task stack
+static game_render_band_renderer_t band_renderer;
+static game_render_band_scene_t band_scene;
+#else
+// Frames between sprite cache statistics in the log
+#define RENDER_STATS_FRAMES 600
+// Sized for the device: the back buffer already takes 64 KB of internal RAM
+#ifdef CONFIG_GAME_RENDER_SPRITE_BUDGET_KB
+#define SPRITE_CACHE_BUDGET (CONFIG_GAME_RENDER_SPRITE_BUDGET_KB * 1024)
+#else
+#define SPRITE_CACHE_BUDGET (24 * 1024)
+#endif
+// The cache's scratch display list is several KB, too much for the main task stack
+static game_render_sprite_cache_t sprite_cache;
+#endif
+
+// Logs the finished replay; the hex dump is visible at debug log level
+static void log_replay(game_sim_replay_recorder_t* recorder) {
+    ESP_LOGI(TAG, "Replay: %lu frames, %lu bytes%s",
+             (unsigned long)recorder->header.frame_count,
+             (unsigned long)(GAME_SIM_REPLAY_HEADER_SIZE + recorder->header.payload_size),
+             recorder->overflowed ? " (overflowed)" : "");
+
+    uint8_t chunk[64];
+    game_sim_replay_write_header(&recorder->header, chunk);
+    ESP_LOG_BUFFER_HEX_LEVEL(TAG, chunk, GAME_SIM_REPLAY_HEADER_SIZE, ESP_LOG_DEBUG);
+    uint32_t count;
+    while ((count = game_sim_replay_recorder_drain(recorder, chunk, sizeof(chunk))) > 0) {
+        ESP_LOG_BUFFER_HEX_LEVEL(TAG, chunk, count, ESP_LOG_DEBUG);
+    }
+}
+
 extern "C" {
 void app_main(void) {
     ESP_LOGI(TAG, "Starting Penguin Dive...");
@@ -19,25 +62,50 @@ void app_main(void) {
         ESP_LOGE(TAG, "display_driver_init failed");
         return;
     }
+#ifndef CONFIG_DISPLAY_DRIVER_BANDED
+    if (!game_render_sprite_cache_init(&sprite_cache, SPRITE_CACHE_BUDGET)) {
+        // The empty cache composes every object directly
+        ESP_LOGW(TAG, "Sprite cache disabled, drawing pillars and penguin directly");
+    }
+#endif
 
     // Init input and game systems
     input_init();
-    game_context_t game{};
-    penguin_t penguin{};
-    ice_pillars_context_t pillars{};
+    game_world_t world{};
+    game_sim_replay_recorder_t recorder{};
+    game_context_t& game = world.game;
+    penguin_t& penguin = world.penguin;
+    ice_pillars_context_t& pillars = world.pillars;
 
     game_engine_init(&game);
     penguin_physics_init(&penguin);
     ice_pillars_init(&pillars);
 
+    // Every game starts from the default pillar seed and is recorded from its first frame
+    auto start_recorded_game = [&]() {
+        uint32_t high_score = game.high_score;
+        game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_LCG);
+        game.high_score = high_score;
+        game_sim_replay_recorder_init(&recorder, replay_ring, sizeof(replay_ring),
+                                      ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_LCG);
+    };
+
     // Simple splash
     display_driver_clear_screen(&ctx, COLOR_DARK_BLUE);
-    display_driver_draw_text(&ctx, 10, 40, "Penguin Dive", COLOR_ICE_BLUE);
-    display_driver_draw_text(&ctx, 10, 70, "Press BtnA to start", COLOR_WHITE);
+    static const display_text_t splash_texts[] = {
+        {10, 40, COLOR_ICE_BLUE, "Penguin Dive"},
+        {10, 70, COLOR_WHITE, "Press BtnA to start"},
+    };
+    static const display_text_t game_over_texts[] = {
+        {10, 100, COLOR_WHITE, "Game Over"},
+        {10, 130, COLOR_WHITE, "Press to restart"},
+    };
+    display_driver_draw_texts(&ctx, splash_texts, 2);
     display_driver_flush(&ctx);
 
     const TickType_t frame_delay = pdMS_TO_TICKS(16); // ~60 FPS
     char textbuf[32];
+    uint32_t shown_score = UINT32_MAX; // Score currently formatted in textbuf
 
     while (true) {
         input_poll();
@@ -46,129 +114,52 @@ void app_main(void) {
         switch (game.state) {
             case GAME_STATE_START:
                 if (pressed) {
-                    game_engine_start_game(&game);
-                    penguin_physics_init(&penguin);
-                    ice_pillars_init(&pillars);
+                    start_recorded_game();
                 }
                 break;
 
             case GAME_STATE_PLAYING: {
-                // Update physics and game systems
-                penguin_physics_update(&penguin, pressed);
-                game_engine_update(&game);
-                ice_pillars_update(&pillars, game_engine_get_difficulty_multiplier(&game));
-
-                // Collision checks
-                if (ice_pillars_check_collision(&pillars,
-                        penguin_physics_get_screen_x(&penguin),
-                        penguin_physics_get_screen_y(&penguin),
-                        PENGUIN_WIDTH, PENGUIN_HEIGHT) ||
-                    game_engine_is_screen_edge_collision(&game,
-                        penguin_physics_get_screen_x(&penguin),
-                        penguin_physics_get_screen_y(&penguin),
-                        PENGUIN_WIDTH, PENGUIN_HEIGHT)) {
-                    game_engine_end_game(&game);
+                // Same frame update as the headless simulation, so the recording replays exactly
+                game_sim_replay_recorder_record(&recorder, pressed);
+                if (!game_sim_world_step(&world, pressed)) {
+                    game_sim_replay_recorder_finish(&recorder, game.score);
+                    log_replay(&recorder);
                 }
 
-                // Render
-                display_driver_clear_screen(&ctx, COLOR_DARK_BLUE);
-
-                // Draw pillars with simple shading and outline (using rectangles only)
-                for (int i = 0; i < MAX_PILLARS; ++i) {
-                    ice_pillar_t* p = ice_pillars_get_pillar(&pillars, i);
-                    if (!p || !p->active) continue;
-                    int x = (int)p->x;
-
-                    auto draw_pillar = [&](int px, int py, int w, int h) {
-                        if (h <= 0 || w <= 0) return;
-                        // Base outline
-                        display_driver_draw_rectangle(&ctx, px - 1, py - 1, w + 2, h + 2, COLOR_BLUE);
-                        // Fill
-                        display_driver_draw_rectangle(&ctx, px, py, w, h, COLOR_ICE_BLUE);
-                        // Bevels: top light edge and bottom dark edge
-                        display_driver_draw_rectangle(&ctx, px, py, w, 1, COLOR_CYAN);
-                        display_driver_draw_rectangle(&ctx, px, py + h - 1, w, 1, COLOR_DARK_BLUE);
-                        // Vertical highlights/shadows
-                        display_driver_draw_rectangle(&ctx, px, py, 3, h, COLOR_CYAN);
-                        display_driver_draw_rectangle(&ctx, px + w - 3, py, 3, h, COLOR_DARK_BLUE);
-                        
-                        // Chipped side notches (cut into the sides using background color)
-                        int notch_w = 3;
-                        int notch_h = 6;
-                        // Left side notches
-                        display_driver_draw_rectangle(&ctx, px, py + h/4, notch_w, notch_h, COLOR_DARK_BLUE);
-                        display_driver_draw_rectangle(&ctx, px, py + (h*3)/5, notch_w, notch_h, COLOR_DARK_BLUE);
-                        // Right side notches
-                        display_driver_draw_rectangle(&ctx, px + w - notch_w, py + h/3, notch_w, notch_h, COLOR_DARK_BLUE);
-                        display_driver_draw_rectangle(&ctx, px + w - notch_w, py + (h*4)/5, notch_w, notch_h, COLOR_DARK_BLUE);
-
-                        // Snowy caps and icicles
-                        // If this is a top pillar (origin at top of screen), add icicles at bottom edge
-                        if (py == 0) {
-                            // Bottom cap
-                            display_driver_draw_rectangle(&ctx, px, py + h - 3, w, 3, COLOR_WHITE);
-                            // Icicles hanging down
-                            display_driver_draw_rectangle(&ctx, px + w/6, py + h - 3, 2, 6, COLOR_WHITE);
-                            display_driver_draw_rectangle(&ctx, px + w/2, py + h - 3, 3, 8, COLOR_WHITE);
-                            display_driver_draw_rectangle(&ctx, px + (w*5)/6, py + h - 3, 2, 5, COLOR_WHITE);
-                        } else {
-                            // Bottom pillar: add snowy cap at top edge and upward icicles
-                            display_driver_draw_rectangle(&ctx, px, py, w, 3, COLOR_WHITE);
-                            display_driver_draw_rectangle(&ctx, px + w/5, py - 5, 2, 5, COLOR_WHITE);
-                            display_driver_draw_rectangle(&ctx, px + (w*3)/5, py - 7, 3, 7, COLOR_WHITE);
-                            display_driver_draw_rectangle(&ctx, px + (w*4)/5, py - 4, 2, 4, COLOR_WHITE);
-                        }
-                    };
-
-                    // Top pillar
-                    if (p->top_height > 0) {
-                        draw_pillar(x, 0, PILLAR_WIDTH, p->top_height);
-                    }
-
-                    // Bottom pillar
-                    int bottom_h = p->bottom_height;
-                    if (bottom_h > 0) {
-                        draw_pillar(x, p->bottom_y, PILLAR_WIDTH, bottom_h);
-                    }
+                if (game.score != shown_score) {
+                    snprintf(textbuf, sizeof(textbuf), "Score: %lu", (unsigned long)game.score);
+                    shown_score = game.score;
+                }
+#ifdef CONFIG_DISPLAY_DRIVER_BANDED
+                // Compose the frame band by band; each band is sent while the next is composed
+                game_render_band_scene_begin(&band_scene, COLOR_DARK_BLUE);
+                game_render_band_scene_world(&band_scene, &world);
+                game_render_band_scene_text(&band_scene, 4, 4, textbuf, COLOR_WHITE);
+                game_render_band_present(&band_renderer, &ctx, &band_scene);
+#else
+                // Blit pillars and penguin from pre-rendered sprites
+                game_render_scene_sprites(&sprite_cache, &ctx, &world, COLOR_DARK_BLUE);
+                if (game.frame_count % RENDER_STATS_FRAMES == 0) {
+                    const game_render_sprite_stats_t* stats = &sprite_cache.stats;
+                    ESP_LOGI(TAG, "Sprite cache: %lu hits, %lu misses, %lu evictions, %lu sprites in %lu bytes (peak %lu)",
+                             (unsigned long)stats->hits, (unsigned long)stats->misses, (unsigned long)stats->evictions,
+                             (unsigned long)stats->sprites, (unsigned long)stats->bytes,
+                             (unsigned long)stats->peak_bytes);
                 }
-
-                // Draw a simple penguin sprite (rectangles composition)
-                int px = penguin_physics_get_screen_x(&penguin);
-                int py = penguin_physics_get_screen_y(&penguin);
-                int bw = PENGUIN_WIDTH;
-                int bh = PENGUIN_HEIGHT;
-
-                // Body outline
-                display_driver_draw_rectangle(&ctx, px - 1, py - 1, bw + 2, bh + 2, COLOR_BLACK);
-                // Body fill
-                display_driver_draw_rectangle(&ctx, px, py, bw, bh, COLOR_WHITE);
-                // Head (top portion)
-                int head_h = bh / 2;
-                display_driver_draw_rectangle(&ctx, px + bw/4, py - head_h/2, bw/2, head_h, COLOR_BLACK);
-                // Eye
-                display_driver_draw_rectangle(&ctx, px + bw/2, py - head_h/2 + 2, 2, 2, COLOR_WHITE);
-                // Beak
-                display_driver_draw_rectangle(&ctx, px + bw/2 + 2, py - head_h/2 + head_h/2, 3, 2, COLOR_YELLOW);
-                // Feet
-                display_driver_draw_rectangle(&ctx, px + 2, py + bh, 4, 3, COLOR_YELLOW);
-                display_driver_draw_rectangle(&ctx, px + bw - 6, py + bh, 4, 3, COLOR_YELLOW);
 
                 // Draw score (time-based for now)
-                snprintf(textbuf, sizeof(textbuf), "Score: %lu", (unsigned long)game.score);
                 display_driver_draw_text(&ctx, 4, 4, textbuf, COLOR_WHITE);
+#endif
                 // Push composed frame once per loop
                 display_driver_flush(&ctx);
                 }
                 break;
 
             case GAME_STATE_GAME_OVER:
-                display_driver_draw_text(&ctx, 10, 100, "Game Over", COLOR_WHITE);
-                display_driver_draw_text(&ctx, 10, 130, "Press to restart", COLOR_WHITE);
+                display_driver_draw_texts(&ctx, game_over_texts, 2);
                 display_driver_flush(&ctx);
                 if (pressed) {
-                    game_engine_restart_game(&game);
-                    penguin_physics_init(&penguin);
-                    ice_pillars_init(&pillars);
+                    start_recorded_game();
                 }
                 break;
 
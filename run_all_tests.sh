@@ -101,11 +101,17 @@ run_component_tests() {
     local test_project_dir="build_tests/$component"
     mkdir -p "$test_project_dir"
     
+    # Components built on the game core need it on the component path too
+    local dependency_dirs=""
+    case "$component" in
+        game_sim) dependency_dirs="../../components/game_engine ../../components/penguin_physics ../../components/ice_pillars" ;;
+    esac
+    
     # Create CMakeLists.txt for component test
     cat > "$test_project_dir/CMakeLists.txt" << EOF
 cmake_minimum_required(VERSION 3.16)
 include(\$ENV{IDF_PATH}/tools/cmake/project.cmake)
-set(EXTRA_COMPONENT_DIRS ../../components/$component)
+set(EXTRA_COMPONENT_DIRS ../../components/$component $dependency_dirs)
 project(test_$component)
 EOF
     
@@ -137,7 +143,7 @@ EOF
 run_all_component_tests() {
     print_status "Running All Component Unit Tests..."
     
-    local components=("game_engine" "penguin_physics" "ice_pillars" "display_driver")
+    local components=("game_engine" "penguin_physics" "ice_pillars" "game_sim" "display_driver")
     local failed_tests=()
     
     for component in "${components[@]}"; do
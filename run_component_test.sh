@@ -8,7 +8,7 @@ set -e
 
 if [ $# -eq 0 ]; then
     echo "Usage: $0 <component_name>"
-    echo "Available components: game_engine, penguin_physics, ice_pillars, display_driver"
+    echo "Available components: game_engine, penguin_physics, ice_pillars, game_sim, display_driver, game_render"
     exit 1
 fi
 
@@ -55,11 +55,18 @@ if [ -d "$TEST_DIR" ]; then
 fi
 mkdir "$TEST_DIR"
 
+# Components built on the game core need it on the component path too
+case "$COMPONENT" in
+    game_sim) DEPENDENCY_DIRS="../components/game_engine ../components/penguin_physics ../components/ice_pillars" ;;
+    game_render) DEPENDENCY_DIRS="../components/display_driver ../components/game_sim ../components/game_engine ../components/penguin_physics ../components/ice_pillars" ;;
+    *) DEPENDENCY_DIRS="" ;;
+esac
+
 # Create CMakeLists.txt
 cat > "$TEST_DIR/CMakeLists.txt" << EOF
 cmake_minimum_required(VERSION 3.16)
 include(\$ENV{IDF_PATH}/tools/cmake/project.cmake)
-set(EXTRA_COMPONENT_DIRS ../components/$COMPONENT)
+set(EXTRA_COMPONENT_DIRS ../components/$COMPONENT $DEPENDENCY_DIRS)
 project(test_$COMPONENT)
 EOF
 
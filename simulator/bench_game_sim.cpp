@@ -0,0 +1,368 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+extern "C" {
+#include "game_sim.h"
+#include "game_sim_policy.h"
+#include "game_sim_snapshot.h"
+#include "game_sim_replay.h"
+}
+
+// Headless throughput benchmark: steps many worlds for a fixed number of frames,
+// once through the batched structure-of-arrays engine and once world by world.
+// Finished worlds are reset in place so every frame steps the full population.
+
+#define DEFAULT_FRAMES 2000
+
+static bool bench_input(int world, int frame) {
+    return ((frame * 2654435761u + world * 40503u) >> 13) & 1;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double bench_batch(int world_count, int frames) {
+    game_sim_batch_t batch;
+    if (!game_sim_batch_init(&batch, world_count)) {
+        printf("Failed to allocate batch of %d worlds\n", world_count);
+        return 0.0;
+    }
+    
+    std::unique_ptr<uint8_t[]> buttons(new uint8_t[world_count]);
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int frame = 0; frame < frames; frame++) {
+        for (int w = 0; w < world_count; w++) {
+            buttons[w] = bench_input(w, frame);
+        }
+        game_sim_batch_step(&batch, buttons.get());
+        for (int w = 0; w < world_count; w++) {
+            if (batch.game.state[w] != GAME_STATE_PLAYING) {
+                game_sim_batch_reset_world(&batch, w);
+            }
+        }
+    }
+    
+    double elapsed = seconds_since(start);
+    game_sim_batch_deinit(&batch);
+    return (double)world_count * frames / elapsed;
+}
+
+static double bench_scalar(int world_count, int frames) {
+    std::vector<game_world_t> worlds(world_count);
+    for (int w = 0; w < world_count; w++) {
+        game_sim_world_init(&worlds[w]);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int frame = 0; frame < frames; frame++) {
+        for (int w = 0; w < world_count; w++) {
+            if (!game_sim_world_step(&worlds[w], bench_input(w, frame))) {
+                game_sim_world_init(&worlds[w]);
+            }
+        }
+    }
+    
+    return (double)world_count * frames / seconds_since(start);
+}
+
+#define PHYSICS_BENCH_PENGUINS 4096
+#define PHYSICS_BENCH_PATTERN_FRAMES 64
+
+// Steps penguin physics alone; inputs come from a precomputed table so the
+// timing covers only the kernel
+static double bench_physics_kernel(penguin_batch_kernel_t kernel, int frames) {
+    const int count = PHYSICS_BENCH_PENGUINS;
+    std::vector<float> x(count), y(count), velocity(count), acceleration(count);
+    std::vector<uint8_t> pressed(count), was_pressed(count);
+    std::vector<uint32_t> duration(count);
+    std::vector<uint8_t> buttons((size_t)count * PHYSICS_BENCH_PATTERN_FRAMES);
+    
+    for (int i = 0; i < count; i++) {
+        penguin_t penguin;
+        penguin_physics_init(&penguin);
+        x[i] = penguin.x;
+        y[i] = penguin.y;
+        velocity[i] = penguin.velocity_y;
+        acceleration[i] = penguin.acceleration_y;
+        pressed[i] = penguin.button_pressed;
+        was_pressed[i] = penguin.was_button_pressed;
+        duration[i] = penguin.button_press_duration;
+    }
+    for (int frame = 0; frame < PHYSICS_BENCH_PATTERN_FRAMES; frame++) {
+        for (int i = 0; i < count; i++) {
+            buttons[(size_t)frame * count + i] = bench_input(i, frame);
+        }
+    }
+    
+    penguin_batch_t batch = {x.data(), y.data(), velocity.data(), acceleration.data(),
+                             pressed.data(), was_pressed.data(), duration.data()};
+    penguin_physics_set_batch_kernel(kernel);
+    auto start = std::chrono::steady_clock::now();
+    
+    for (int frame = 0; frame < frames; frame++) {
+        const uint8_t* frame_buttons = &buttons[(size_t)(frame % PHYSICS_BENCH_PATTERN_FRAMES) * count];
+        penguin_physics_update_batch(&batch, frame_buttons, NULL, count);
+    }
+    
+    return (double)count * frames / seconds_since(start);
+}
+
+static void bench_physics(int frames) {
+    const penguin_batch_kernel_t kernels[] = {
+        PENGUIN_BATCH_KERNEL_SCALAR, PENGUIN_BATCH_KERNEL_SSE2, PENGUIN_BATCH_KERNEL_AVX2
+    };
+    penguin_batch_kernel_t default_kernel = penguin_physics_get_batch_kernel();
+    double scalar_rate = 0.0;
+    
+    printf("\nPenguin physics kernels, %d penguins, %d frames (default: %s)\n",
+           PHYSICS_BENCH_PENGUINS, frames, penguin_physics_batch_kernel_name(default_kernel));
+    printf("%10s %20s %8s\n", "kernel", "penguin steps/s", "speedup");
+    
+    for (penguin_batch_kernel_t kernel : kernels) {
+        if (!penguin_physics_batch_kernel_supported(kernel)) {
+            printf("%10s %20s\n", penguin_physics_batch_kernel_name(kernel), "unsupported");
+            continue;
+        }
+        double rate = bench_physics_kernel(kernel, frames);
+        if (kernel == PENGUIN_BATCH_KERNEL_SCALAR) {
+            scalar_rate = rate;
+        }
+        printf("%10s %20.0f %7.2fx\n", penguin_physics_batch_kernel_name(kernel), rate,
+               scalar_rate > 0.0 ? rate / scalar_rate : 0.0);
+    }
+    
+    penguin_physics_set_batch_kernel(default_kernel);
+}
+
+#define ADVANCE_BENCH_STATES 1024
+
+// Constant-input spans: penguin_physics_advance() against one update per frame
+static void bench_physics_advance() {
+    const uint32_t spans[] = {16, 64, 256, 4096};
+    std::vector<penguin_t> starts(ADVANCE_BENCH_STATES);
+    for (int i = 0; i < ADVANCE_BENCH_STATES; i++) {
+        penguin_physics_init(&starts[i]);
+        starts[i].y = (float)(i % 221) + (float)i / ADVANCE_BENCH_STATES;
+        starts[i].velocity_y = (float)(i % 7) - 3.0f;
+    }
+    
+    printf("\nConstant-input spans, %d penguins\n", ADVANCE_BENCH_STATES);
+    printf("%10s %16s %16s %8s\n", "frames", "step ns/span", "advance ns/span", "speedup");
+    
+    for (uint32_t span : spans) {
+        std::vector<float> stepped(ADVANCE_BENCH_STATES);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ADVANCE_BENCH_STATES; i++) {
+            penguin_t penguin = starts[i];
+            for (uint32_t f = 0; f < span; f++) {
+                penguin_physics_update(&penguin, i & 1);
+            }
+            stepped[i] = penguin.y;
+        }
+        double step_ns = seconds_since(start) * 1e9 / ADVANCE_BENCH_STATES;
+        
+        std::vector<float> advanced(ADVANCE_BENCH_STATES);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ADVANCE_BENCH_STATES; i++) {
+            penguin_t penguin = starts[i];
+            penguin_physics_advance(&penguin, i & 1, span);
+            advanced[i] = penguin.y;
+        }
+        double advance_ns = seconds_since(start) * 1e9 / ADVANCE_BENCH_STATES;
+        
+        bool identical = memcmp(stepped.data(), advanced.data(), stepped.size() * sizeof(float)) == 0;
+        printf("%10u %16.1f %16.1f %7.2fx%s\n", span, step_ns, advance_ns, step_ns / advance_ns,
+               identical ? "" : "  MISMATCH");
+    }
+}
+
+#define SNAPSHOT_BENCH_WORLDS 256
+#define SNAPSHOT_BENCH_ITERATIONS 20000000
+
+// Save and restore latency over a pool of worlds at different points of play
+static void bench_snapshots() {
+    std::vector<game_world_t> worlds(SNAPSHOT_BENCH_WORLDS);
+    std::vector<game_sim_snapshot_t> snapshots(SNAPSHOT_BENCH_WORLDS);
+    for (int w = 0; w < SNAPSHOT_BENCH_WORLDS; w++) {
+        game_sim_world_init_seeded(&worlds[w], w, ICE_PILLARS_RNG_COUNTER);
+        game_sim_run_episode(&worlds[w], game_sim_policy_autopilot, w, 10 * w);
+    }
+    
+    const int iterations = SNAPSHOT_BENCH_ITERATIONS;
+    const int mask = SNAPSHOT_BENCH_WORLDS - 1;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        game_sim_snapshot_save(&worlds[i & mask], &snapshots[i & mask]);
+    }
+    double save_ns = seconds_since(start) * 1e9 / iterations;
+    
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        game_sim_snapshot_restore(&snapshots[i & mask], &worlds[i & mask]);
+    }
+    double restore_ns = seconds_since(start) * 1e9 / iterations;
+    
+    // Clone: snapshot one world and materialize it into another
+    game_sim_snapshot_t scratch;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        game_sim_snapshot_save(&worlds[i & mask], &scratch);
+        game_sim_snapshot_restore(&scratch, &worlds[(i + 1) & mask]);
+    }
+    double clone_ns = seconds_since(start) * 1e9 / iterations;
+    
+    printf("\nSnapshots: %zu bytes, %d worlds, %d iterations\n", sizeof(game_sim_snapshot_t),
+           SNAPSHOT_BENCH_WORLDS, iterations);
+    printf("%10s %12s %16s\n", "operation", "ns/op", "ops/s");
+    printf("%10s %12.2f %16.0f\n", "save", save_ns, 1e9 / save_ns);
+    printf("%10s %12.2f %16.0f\n", "restore", restore_ns, 1e9 / restore_ns);
+    printf("%10s %12.2f %16.0f\n", "clone", clone_ns, 1e9 / clone_ns);
+}
+
+#define REPLAY_BENCH_GAMES 200
+#define REPLAY_BENCH_RING_SIZE 4096
+
+// Recording overhead per frame and headless playback speed over autopilot games
+static void bench_replays() {
+    std::vector<std::vector<uint8_t>> replays(REPLAY_BENCH_GAMES);
+    std::vector<uint8_t> ring(REPLAY_BENCH_RING_SIZE);
+    uint64_t frames = 0;
+    uint64_t payload_bytes = 0;
+    double record_seconds = 0.0;
+    
+    for (int g = 0; g < REPLAY_BENCH_GAMES; g++) {
+        game_world_t world;
+        game_sim_replay_recorder_t recorder;
+        game_sim_world_init_seeded(&world, g, ICE_PILLARS_RNG_COUNTER);
+        game_sim_replay_recorder_init(&recorder, ring.data(), (uint32_t)ring.size(), g, ICE_PILLARS_RNG_COUNTER);
+        
+        std::vector<uint8_t> inputs;
+        bool running = true;
+        while (running) {
+            bool pressed = game_sim_policy_autopilot(&world, g);
+            inputs.push_back(pressed);
+            running = game_sim_world_step(&world, pressed);
+        }
+        
+        // Time only the recorder, fed the inputs captured above
+        auto start = std::chrono::steady_clock::now();
+        for (uint8_t pressed : inputs) {
+            game_sim_replay_recorder_record(&recorder, pressed);
+        }
+        game_sim_replay_recorder_finish(&recorder, world.game.score);
+        record_seconds += seconds_since(start);
+        
+        std::vector<uint8_t>& replay = replays[g];
+        replay.resize(GAME_SIM_REPLAY_HEADER_SIZE + game_sim_replay_recorder_pending(&recorder));
+        game_sim_replay_write_header(&recorder.header, replay.data());
+        game_sim_replay_recorder_drain(&recorder, replay.data() + GAME_SIM_REPLAY_HEADER_SIZE,
+                                       (uint32_t)(replay.size() - GAME_SIM_REPLAY_HEADER_SIZE));
+        frames += inputs.size();
+        payload_bytes += recorder.header.payload_size;
+    }
+    
+    int mismatches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::vector<uint8_t>& replay : replays) {
+        game_world_t world;
+        mismatches += !game_sim_replay_play(replay.data(), replay.size(), &world, NULL);
+    }
+    double play_seconds = seconds_since(start);
+    
+    printf("\nReplays: %d autopilot games, %llu frames, %.3f payload bits per frame\n", REPLAY_BENCH_GAMES,
+           (unsigned long long)frames, 8.0 * payload_bytes / frames);
+    printf("Recording %.2f ns/frame, playback %.0f frames/s, %d mismatches\n",
+           record_seconds * 1e9 / frames, frames / play_seconds, mismatches);
+}
+
+#define EVENT_BENCH_GAMES 200
+
+// Whole games under held input, frame by frame and jumping between events.
+// Hold times follow the frame-rate consistency test (90 frames on, 90 off) and
+// a few shorter cycles.
+static void bench_event_driven() {
+    const uint32_t holds[] = {90, 30, 8};
+    
+    printf("\nEvent-driven games, %d per cycle\n", EVENT_BENCH_GAMES);
+    printf("%10s %14s %16s %16s %8s\n", "hold", "frames/game", "step frames/s", "event frames/s", "speedup");
+    
+    for (uint32_t hold : holds) {
+        std::vector<game_world_t> stepped(EVENT_BENCH_GAMES);
+        uint64_t frames = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int g = 0; g < EVENT_BENCH_GAMES; g++) {
+            game_world_t* world = &stepped[g];
+            game_sim_world_init_seeded(world, g, ICE_PILLARS_RNG_COUNTER);
+            bool running = true;
+            while (running) {
+                running = game_sim_world_step(world, (world->game.frame_count / hold) % 2 == 0);
+            }
+            frames += world->game.frame_count;
+        }
+        double step_seconds = seconds_since(start);
+        
+        std::vector<game_world_t> advanced(EVENT_BENCH_GAMES);
+        start = std::chrono::steady_clock::now();
+        for (int g = 0; g < EVENT_BENCH_GAMES; g++) {
+            game_world_t* world = &advanced[g];
+            game_sim_world_init_seeded(world, g, ICE_PILLARS_RNG_COUNTER);
+            while (world->game.state == GAME_STATE_PLAYING) {
+                uint32_t frame = world->game.frame_count;
+                game_sim_world_advance(world, (frame / hold) % 2 == 0, hold - frame % hold);
+            }
+        }
+        double event_seconds = seconds_since(start);
+        
+        int mismatches = 0;
+        for (int g = 0; g < EVENT_BENCH_GAMES; g++) {
+            game_sim_snapshot_t expected;
+            game_sim_snapshot_t actual;
+            game_sim_snapshot_save(&stepped[g], &expected);
+            game_sim_snapshot_save(&advanced[g], &actual);
+            mismatches += memcmp(&expected, &actual, sizeof(expected)) != 0;
+        }
+        
+        printf("%10u %14.1f %16.0f %16.0f %7.2fx%s\n", hold, (double)frames / EVENT_BENCH_GAMES,
+               frames / step_seconds, frames / event_seconds, step_seconds / event_seconds,
+               mismatches ? "  MISMATCH" : "");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+    
+    const int world_counts[] = {1, 16, 256, 4096, 65536};
+    
+    printf("Headless world stepping, %d frames per run\n", frames);
+    printf("%10s %20s %20s %8s\n", "worlds", "batch wf/s", "scalar wf/s", "speedup");
+    
+    for (int world_count : world_counts) {
+        int run_frames = frames;
+        // Keep the largest populations to a similar amount of total work
+        while (run_frames > 10 && (double)run_frames * world_count > 5e7) {
+            run_frames /= 2;
+        }
+        
+        double batch_rate = bench_batch(world_count, run_frames);
+        double scalar_rate = bench_scalar(world_count, run_frames);
+        printf("%10d %20.0f %20.0f %7.2fx\n", world_count, batch_rate, scalar_rate,
+               scalar_rate > 0.0 ? batch_rate / scalar_rate : 0.0);
+    }
+    
+    bench_physics(frames);
+    bench_physics_advance();
+    bench_snapshots();
+    bench_replays();
+    bench_event_driven();
+    
+    return 0;
+}
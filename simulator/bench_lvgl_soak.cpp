@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+extern "C" {
+#include "lvgl.h"
+#include "lvgl_emulator.h"
+#include "st7789_emulator.h"
+#include "display_driver.h"
+#include "display_lvgl_pool.h"
+#include "ice_pillars.h"
+#include "game_render.h"
+#include "game_render_sprite.h"
+#include "game_sim.h"
+#include "game_sim_policy.h"
+}
+
+// Soak test of the LVGL backend's drawing objects, run against the LVGL and
+// ST7789 bus emulators. Autopilot play is drawn every frame and refreshed:
+// once creating new objects for every rectangle and string, as the driver
+// used to, and once through display_driver.c itself, the way main.cpp draws:
+// the sprite scene and score while playing, and the game over texts over the
+// last frame, without a clear, when a game ends. Samples show objects, LVGL
+// heap and frame cost over the run; they must stay flat for the driver, no
+// drawing may be dropped, and game over frames must leave the panel showing
+// the last frame. Exits nonzero otherwise.
+
+#define DEFAULT_FRAMES 100000
+#define SAMPLES 10
+// The autopilot rarely loses, so after this many frames of a game it stops
+// flapping and the game ends
+#define GAME_FRAMES 300
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// What display_driver_draw_rectangle() did before the pool
+static bool create_rect(int x, int y, int width, int height, uint16_t color) {
+    lv_obj_t* rect = lv_obj_create(lv_scr_act());
+    if (!rect) return false;
+    lv_obj_set_pos(rect, x, y);
+    lv_obj_set_size(rect, width, height);
+    lv_obj_set_style_bg_color(rect, lv_color_hex(color), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(rect, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_width(rect, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(rect, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(rect, 0, LV_PART_MAIN);
+    return true;
+}
+
+// What display_driver_draw_text() did before the pool
+static bool create_text(int x, int y, const char* text, uint16_t color) {
+    lv_obj_t* label = lv_label_create(lv_scr_act());
+    if (!label) return false;
+    lv_obj_set_pos(label, x, y);
+    lv_label_set_text(label, text);
+    lv_obj_set_style_text_color(label, lv_color_hex(color), LV_PART_MAIN);
+    lv_obj_set_style_pad_all(label, 0, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(label, LV_OPA_TRANSP, LV_PART_MAIN);
+    return true;
+}
+
+typedef struct {
+    int frame;                     // Frames drawn when the sample was taken
+    uint32_t objects;
+    uint32_t heap_used;
+    uint32_t heap_max_used;
+    double frame_us;               // Drawing and refresh, host time, since the last sample
+    double writes;                 // Property writes per frame since the last sample
+    double walked;                 // Objects visited by refreshes per frame since the last sample
+} sample_t;
+
+static void print_sample(const sample_t* sample) {
+    printf("%10d %10u %10.1f %10.1f %10.2f %10.1f %10.1f\n", sample->frame, (unsigned)sample->objects,
+           sample->heap_used / 1024.0, sample->heap_max_used / 1024.0, sample->frame_us, sample->writes,
+           sample->walked);
+}
+
+// Takes a sample once `drawn` reaches the next tenth of the run, or `last`
+typedef struct {
+    sample_t* samples;
+    int frames;
+    int taken;
+    int sampled_at;
+    double busy;                   // Host seconds spent drawing since the last sample
+    uint64_t flushes;              // Over the whole run
+    uint64_t flushed_pixels;
+    uint64_t flush_stalls;
+} sampler_t;
+
+static void sample_if_due(sampler_t* sampler, int drawn, bool last) {
+    if (sampler->taken == SAMPLES) return;
+    if (drawn != (sampler->taken + 1) * (sampler->frames / SAMPLES) && !last) return;
+    
+    lvgl_emulator_stats_t stats;
+    lvgl_emulator_get_stats(&stats);
+    lvgl_emulator_clear_stats();
+    sampler->flushes += stats.flushes;
+    sampler->flushed_pixels += stats.flushed_pixels;
+    sampler->flush_stalls += stats.flush_stalls;
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    
+    int window = drawn - sampler->sampled_at;
+    sample_t* s = &sampler->samples[sampler->taken++];
+    s->frame = drawn;
+    s->objects = stats.objects;
+    s->heap_used = mem.total_size - mem.free_size;
+    s->heap_max_used = mem.max_used;
+    s->frame_us = sampler->busy * 1e6 / window;
+    s->writes = (double)stats.property_writes / window;
+    s->walked = (double)stats.objects_walked / window;
+    print_sample(s);
+    sampler->sampled_at = drawn;
+    sampler->busy = 0.0;
+}
+
+// Draws `frames` frames creating objects as the driver used to; returns the
+// frames drawn before LVGL ran out of heap
+static int soak_objects(int frames, sample_t* samples) {
+    static game_render_list_t list;
+    lv_init();
+    lv_timer_handler();
+    lvgl_emulator_clear_stats();
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_COUNTER);
+    char text[32];
+    sampler_t sampler = {samples, frames, 0, 0, 0.0, 0, 0, 0};
+    int drawn = 0;
+    bool out_of_memory = false;
+    
+    while (drawn < frames && !out_of_memory) {
+        if (!game_sim_world_step(&world, game_sim_policy_autopilot(&world, 0))) {
+            game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED + drawn, ICE_PILLARS_RNG_COUNTER);
+        }
+        game_render_list_begin(&list, NULL);
+        game_render_scene(&list, &world, COLOR_DARK_BLUE);
+        snprintf(text, sizeof(text), "Score: %lu", (unsigned long)world.game.score);
+        
+        // Only the driver's side is timed, not the game or the scene
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < list.count && !out_of_memory; i++) {
+            const game_render_command_t* command = &list.commands[i];
+            out_of_memory = !create_rect(command->x, command->y, command->width, command->height, command->color);
+        }
+        if (!out_of_memory && !create_text(4, 4, text, COLOR_WHITE)) {
+            out_of_memory = true;
+        }
+        lv_timer_handler();
+        sampler.busy += seconds_since(start);
+        drawn++;
+        sample_if_due(&sampler, drawn, drawn == frames || out_of_memory);
+    }
+    return out_of_memory ? drawn - 1 : drawn;
+}
+
+// The SPI transfer of a flush completes, calling back into LVGL
+static bool finish_flush(void) {
+    return st7789_emulator_run_next();
+}
+
+// Lets every queued flush reach the panel
+static void drain_bus(void) {
+    while (st7789_emulator_run_next()) {
+    }
+}
+
+typedef struct {
+    int frames;                    // Drawn before the driver failed, or all
+    int game_overs;
+    int game_overs_changed;        // Game over frames that changed the panel
+    display_lvgl_pool_stats_t pool;
+    uint64_t flushes;
+    uint64_t flushed_pixels;
+    uint64_t flush_stalls;
+} driver_soak_t;
+
+// Draws `frames` frames through display_driver.c as main.cpp does
+static void soak_driver(int frames, sample_t* samples, driver_soak_t* result) {
+    static display_context_t display;
+    static game_render_sprite_cache_t cache;
+    static uint16_t last_frame[ST7789_EMULATOR_GRAM_WIDTH * ST7789_EMULATOR_GRAM_HEIGHT];
+    static const display_text_t game_over_texts[] = {
+        {10, 100, COLOR_WHITE, "Game Over"},
+        {10, 130, COLOR_WHITE, "Press to restart"},
+    };
+    memset(result, 0, sizeof(*result));
+    
+    st7789_emulator_reset(NULL);
+    lvgl_emulator_set_flush_wait(finish_flush);
+    if (!display_driver_init(&display)) return;
+    game_render_sprite_cache_init(&cache, GAME_RENDER_SPRITE_DEFAULT_BUDGET);
+    display_driver_task_handler();
+    lvgl_emulator_clear_stats();
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_COUNTER);
+    char text[32];
+    sampler_t sampler = {samples, frames, 0, 0, 0.0, 0, 0, 0};
+    int drawn = 0;
+    
+    int game_start = 0;
+    while (drawn < frames) {
+        bool flap = drawn - game_start < GAME_FRAMES && game_sim_policy_autopilot(&world, 0);
+        bool game_over = !game_sim_world_step(&world, flap);
+        if (game_over) {
+            // Compared against the panel after the game over frame
+            drain_bus();
+            for (int y = 0; y < ST7789_EMULATOR_GRAM_HEIGHT; y++) {
+                for (int x = 0; x < ST7789_EMULATOR_GRAM_WIDTH; x++) {
+                    last_frame[y * ST7789_EMULATOR_GRAM_WIDTH + x] = st7789_emulator_gram_pixel(x, y);
+                }
+            }
+        }
+        snprintf(text, sizeof(text), "Score: %lu", (unsigned long)world.game.score);
+        
+        // Only the driver's side is timed, not the game
+        auto start = std::chrono::steady_clock::now();
+        if (game_over) {
+            display_driver_draw_texts(&display, game_over_texts, 2);
+        } else {
+            game_render_scene_sprites(&cache, &display, &world, COLOR_DARK_BLUE);
+            display_driver_draw_text(&display, 4, 4, text, COLOR_WHITE);
+        }
+        display_driver_flush(&display);
+        display_driver_task_handler();
+        sampler.busy += seconds_since(start);
+        drawn++;
+        
+        if (game_over) {
+            // The emulator does not render label text, so the panel still
+            // shows the last frame exactly unless its rectangles went away
+            drain_bus();
+            bool changed = false;
+            for (int y = 0; y < ST7789_EMULATOR_GRAM_HEIGHT && !changed; y++) {
+                for (int x = 0; x < ST7789_EMULATOR_GRAM_WIDTH; x++) {
+                    if (st7789_emulator_gram_pixel(x, y) != last_frame[y * ST7789_EMULATOR_GRAM_WIDTH + x]) {
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+            result->game_overs++;
+            if (changed) result->game_overs_changed++;
+            game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED + drawn, ICE_PILLARS_RNG_COUNTER);
+            game_start = drawn;
+        }
+        
+        sample_if_due(&sampler, drawn, drawn == frames);
+    }
+    
+    drain_bus();
+    result->frames = drawn;
+    result->flushes = sampler.flushes;
+    result->flushed_pixels = sampler.flushed_pixels;
+    result->flush_stalls = sampler.flush_stalls;
+    display_lvgl_pool_get_stats(&result->pool);
+    game_render_sprite_cache_deinit(&cache);
+    display_driver_deinit(&display);
+    lvgl_emulator_set_flush_wait(NULL);
+}
+
+static void print_header(void) {
+    printf("%10s %10s %10s %10s %10s %10s %10s\n", "frame", "objects", "heap KB", "peak KB", "us/frame",
+           "writes", "walked");
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames < SAMPLES * 2) frames = DEFAULT_FRAMES;
+    static sample_t samples[SAMPLES];
+    
+    printf("LVGL objects over %d frames of autopilot play, %u KB LVGL heap\n", frames, LV_MEM_SIZE / 1024);
+    
+    printf("\nObject per call, as before\n");
+    print_header();
+    int lasted = soak_objects(frames, samples);
+    if (lasted < frames) {
+        printf("LVGL heap exhausted after %d frames\n", lasted);
+    }
+    
+    printf("\nLVGL display driver, pooled objects\n");
+    print_header();
+    driver_soak_t result;
+    soak_driver(frames, samples, &result);
+    if (result.frames < frames) {
+        printf("display_driver_init failed\n");
+        return 1;
+    }
+    
+    // Flat: the second half of the run creates and allocates nothing. Host
+    // frame time is too noisy to check, so it is only shown.
+    const sample_t* half = &samples[SAMPLES / 2 - 1];
+    bool flat = true;
+    for (int i = SAMPLES / 2; i < SAMPLES; i++) {
+        if (samples[i].objects != half->objects || samples[i].heap_max_used != half->heap_max_used) {
+            flat = false;
+        }
+    }
+    printf("%s: %u objects, %.1f KB of LVGL heap at the end\n", flat ? "flat" : "GROWING",
+           (unsigned)samples[SAMPLES - 1].objects, samples[SAMPLES - 1].heap_used / 1024.0);
+    printf("%u rectangle and %u label objects, %lu drawing calls dropped\n", (unsigned)result.pool.rects,
+           (unsigned)result.pool.labels, (unsigned long)result.pool.dropped);
+    printf("%.1f flushes and %.0f pixels flushed per frame, %lu flushes stalled\n",
+           (double)result.flushes / frames, (double)result.flushed_pixels / frames,
+           (unsigned long)result.flush_stalls);
+    printf("%d game over frames, %d of them changed the panel\n", result.game_overs, result.game_overs_changed);
+    
+    bool ok = flat && result.pool.dropped == 0 && result.flush_stalls == 0 && result.game_overs > 0 &&
+              result.game_overs_changed == 0;
+    return ok ? 0 : 1;
+}
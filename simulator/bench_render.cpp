@@ -0,0 +1,395 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+extern "C" {
+#include "display_driver.h"
+#include "display_driver_sim.h"
+#include "display_backend.h"
+#include "ice_pillars.h"
+#include "penguin_physics.h"
+#include "game_render.h"
+#include "game_render_sprite.h"
+#include "game_render_band.h"
+#include "game_render_scroll.h"
+#include "display_font.h"
+#include "game_sim.h"
+#include "game_sim_policy.h"
+}
+
+// Headless rendering benchmark: fill rate of the simulator display driver,
+// which bounds how fast frame dumps can be produced for validated replays.
+// Every kernel draws the same shapes; rates are in pixels written per second.
+
+#define DEFAULT_ITERATIONS 20000
+#define SCENE_BENCH_FRAMES 2000
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double bench_clears(display_context_t* ctx, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        display_driver_clear_screen(ctx, (uint16_t)i);
+    }
+    return (double)DISPLAY_WIDTH * DISPLAY_HEIGHT * iterations / seconds_since(start);
+}
+
+// Rectangles of one size at shifting positions, so every start alignment is hit
+static double bench_rectangles(display_context_t* ctx, int width, int height, int iterations) {
+    const int count = 64;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (int r = 0; r < count; r++) {
+            int x = (i + r * 7) % (DISPLAY_WIDTH - width + 1);
+            int y = (i * 3 + r * 11) % (DISPLAY_HEIGHT - height + 1);
+            display_driver_draw_rectangle(ctx, x, y, width, height, (uint16_t)r);
+        }
+    }
+    return (double)width * height * count * iterations / seconds_since(start);
+}
+
+static void bench_fill_kernels(int iterations) {
+    const display_fill_kernel_t kernels[] = {
+        DISPLAY_FILL_KERNEL_SCALAR, DISPLAY_FILL_KERNEL_SWAR, DISPLAY_FILL_KERNEL_SSE2, DISPLAY_FILL_KERNEL_AVX2
+    };
+    display_fill_kernel_t default_kernel = display_driver_sim_get_fill_kernel();
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    printf("\nSpan fill kernels, %d iterations (default: %s), pixels/s\n", iterations,
+           display_driver_sim_fill_kernel_name(default_kernel));
+    printf("%10s %16s %16s %16s %16s %8s\n", "kernel", "clear", "pillar 30x100", "penguin 20x20", "span 7x1",
+           "speedup");
+    
+    double scalar_rate = 0.0;
+    for (display_fill_kernel_t kernel : kernels) {
+        if (!display_driver_sim_set_fill_kernel(kernel)) {
+            printf("%10s %16s\n", display_driver_sim_fill_kernel_name(kernel), "unsupported");
+            continue;
+        }
+        
+        double clear_rate = bench_clears(&ctx, iterations);
+        double pillar_rate = bench_rectangles(&ctx, PILLAR_WIDTH, 100, iterations / 16);
+        double penguin_rate = bench_rectangles(&ctx, PENGUIN_WIDTH, PENGUIN_HEIGHT, iterations / 4);
+        double span_rate = bench_rectangles(&ctx, 7, 1, iterations);
+        if (kernel == DISPLAY_FILL_KERNEL_SCALAR) {
+            scalar_rate = clear_rate;
+        }
+        printf("%10s %16.3g %16.3g %16.3g %16.3g %7.2fx\n", display_driver_sim_fill_kernel_name(kernel), clear_rate,
+               pillar_rate, penguin_rate, span_rate, scalar_rate > 0.0 ? clear_rate / scalar_rate : 0.0);
+    }
+    
+    display_driver_sim_set_fill_kernel(default_kernel);
+    display_driver_deinit(&ctx);
+}
+
+// Renders the playfield of an autopilot game every frame, once drawing each
+// command as recorded and once through the resolved display list
+static game_world_t worlds[SCENE_BENCH_FRAMES];
+
+// Precomputes the frames so the scene benchmarks time only rendering
+static void prepare_worlds(void) {
+    game_world_t world;
+    game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_COUNTER);
+    for (int f = 0; f < SCENE_BENCH_FRAMES; f++) {
+        if (!game_sim_world_step(&world, game_sim_policy_autopilot(&world, 0))) {
+            game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED + f, ICE_PILLARS_RNG_COUNTER);
+        }
+        worlds[f] = world;
+    }
+}
+
+static void bench_display_list(int frames) {
+    static game_render_list_t list;
+    static game_render_flush_scratch_t scratch;
+    game_render_list_init(&list, &scratch);
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    printf("\nDisplay list, %d frames of autopilot play\n", frames);
+    printf("%10s %14s %12s %12s %14s %10s\n", "mode", "frames/s", "commands", "overdraw", "pixels/frame",
+           "rects");
+    
+    for (int resolved = 0; resolved < 2; resolved++) {
+        uint64_t commands = 0, visible = 0, written = 0, rects = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            game_render_list_begin(&list, &ctx);
+            game_render_scene(&list, &worlds[f % SCENE_BENCH_FRAMES], COLOR_DARK_BLUE);
+            if (resolved) {
+                game_render_list_flush(&list);
+            } else {
+                game_render_list_flush_direct(&list);
+            }
+            commands += list.stats.commands;
+            written += list.stats.written_pixels;
+            rects += list.stats.output_rects;
+            // Visible pixels are only counted by the resolving flush; every
+            // scene covers the whole screen
+            visible += DISPLAY_WIDTH * DISPLAY_HEIGHT;
+        }
+        double rate = frames / seconds_since(start);
+        printf("%10s %14.0f %12.1f %11.2fx %14.0f %10.1f\n", resolved ? "resolved" : "direct", rate,
+               (double)commands / frames, (double)written / visible, (double)written / frames,
+               (double)rects / frames);
+    }
+    
+    display_driver_deinit(&ctx);
+}
+
+// Draws each frame's recorded rectangles one call at a time and as one batch
+static void bench_batches(int frames) {
+    static game_render_list_t list;
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    printf("\nRectangle submission, %d frames of autopilot play\n", frames);
+    printf("%10s %14s %12s\n", "mode", "frames/s", "rects");
+    
+    for (int batched = 0; batched < 2; batched++) {
+        uint64_t rects = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            game_render_list_begin(&list, NULL);
+            game_render_scene(&list, &worlds[f % SCENE_BENCH_FRAMES], COLOR_DARK_BLUE);
+            if (batched) {
+                display_driver_draw_rectangles(&ctx, list.commands, list.count);
+            } else {
+                for (int i = 0; i < list.count; i++) {
+                    const game_render_command_t* command = &list.commands[i];
+                    display_driver_draw_rectangle(&ctx, command->x, command->y, command->width, command->height,
+                                                  command->color);
+                }
+            }
+            rects += list.count;
+        }
+        double rate = frames / seconds_since(start);
+        printf("%10s %14.0f %12.1f\n", batched ? "batch" : "single", rate, (double)rects / frames);
+    }
+    
+    display_driver_deinit(&ctx);
+}
+
+// Renders the same frames by blitting cached sprites, with the default budget
+// and with one too small for the sprites on screen
+static void bench_sprites(int frames) {
+    static game_render_sprite_cache_t cache;
+    const size_t budgets[] = {GAME_RENDER_SPRITE_DEFAULT_BUDGET, 8 * 1024};
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    printf("\nSprite cache, %d frames of autopilot play\n", frames);
+    printf("%10s %14s %12s %12s %12s %12s\n", "budget", "frames/s", "hit rate", "evictions", "sprites", "peak KB");
+    
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+        if (!game_render_sprite_cache_init(&cache, budgets[b])) continue;
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            game_render_scene_sprites(&cache, &ctx, &worlds[f % SCENE_BENCH_FRAMES], COLOR_DARK_BLUE);
+        }
+        double rate = frames / seconds_since(start);
+        
+        const game_render_sprite_stats_t* stats = &cache.stats;
+        printf("%9zuK %14.0f %11.1f%% %12lu %12lu %12.1f\n", budgets[b] / 1024, rate,
+               100.0 * stats->hits / (stats->hits + stats->misses), (unsigned long)stats->evictions,
+               (unsigned long)stats->sprites, stats->peak_bytes / 1024.0);
+        game_render_sprite_cache_deinit(&cache);
+    }
+    
+    display_driver_deinit(&ctx);
+}
+
+// Renders the same frames band by band, the way the frame-buffer-less device
+// backend does; the host driver copies each band into its frame buffer
+static void bench_bands(int frames) {
+    static game_render_band_renderer_t renderer;
+    static game_render_band_scene_t scene;
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++) {
+        game_render_band_scene_begin(&scene, COLOR_DARK_BLUE);
+        game_render_band_scene_world(&scene, &worlds[f % SCENE_BENCH_FRAMES]);
+        game_render_band_scene_text(&scene, 4, 4, "Score: 12345", COLOR_WHITE);
+        game_render_band_present(&renderer, &ctx, &scene);
+    }
+    double rate = frames / seconds_since(start);
+    
+    printf("\nBanded renderer, %d frames of autopilot play\n", frames);
+    printf("%14s %12s %14s\n", "frames/s", "bands/frame", "buffer bytes");
+    printf("%14.0f %12.1f %14zu\n", rate, (double)renderer.bands_pushed / renderer.frames,
+           (size_t)GAME_RENDER_BAND_BUFFER_BYTES);
+    
+    display_driver_deinit(&ctx);
+}
+
+// Plays the same game with the frame drawn by each backend, and not drawn at
+// all, so game logic and rendering cost show side by side
+static void bench_backends(int frames) {
+    static game_render_sprite_cache_t cache;
+    const display_backend_t* backends[] = {NULL, &display_backend_null, &display_backend_sim};
+    
+    printf("\nGame loop by display backend, %d frames of autopilot play\n", frames);
+    printf("%10s %14s %14s\n", "backend", "frames/s", "ns/frame");
+    
+    for (const display_backend_t* backend : backends) {
+        display_context_t ctx;
+        if (backend && !display_driver_init_backend(&ctx, backend)) continue;
+        game_render_sprite_cache_init(&cache, GAME_RENDER_SPRITE_DEFAULT_BUDGET);
+        
+        game_world_t world;
+        game_sim_world_init_seeded(&world, 7, ICE_PILLARS_RNG_COUNTER);
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            if (!game_sim_world_step(&world, game_sim_policy_autopilot(&world, 0))) {
+                game_sim_world_init_seeded(&world, 7 + f, ICE_PILLARS_RNG_COUNTER);
+            }
+            if (!backend) continue;
+            
+            game_render_scene_sprites(&cache, &ctx, &world, COLOR_DARK_BLUE);
+            display_driver_draw_text(&ctx, 4, 4, "Score: 12345", COLOR_WHITE);
+            display_driver_swap_buffers(&ctx);
+        }
+        double elapsed = seconds_since(start);
+        printf("%10s %14.0f %14.0f\n", backend ? backend->name : "none", frames / elapsed, elapsed * 1e9 / frames);
+        
+        game_render_sprite_cache_deinit(&cache);
+        if (backend) display_driver_deinit(&ctx);
+    }
+}
+
+// Text drawing the way the driver did before glyph spans: every bit of every
+// glyph is tested and bounds-checked
+static void draw_text_bits(display_context_t* ctx, int x, int y, const char* text, uint16_t color) {
+    uint16_t* buffer = (uint16_t*)ctx->current_buffer;
+    for (int cursor_x = x; *text; text++, cursor_x += DISPLAY_FONT_WIDTH) {
+        const uint8_t* glyph = display_font_glyph(*text);
+        if (!glyph) continue;
+        for (int row = 0; row < DISPLAY_FONT_HEIGHT; row++) {
+            if (y + row < 0 || y + row >= DISPLAY_HEIGHT) continue;
+            for (int col = 0; col < DISPLAY_FONT_WIDTH; col++) {
+                if (cursor_x + col < 0 || cursor_x + col >= DISPLAY_WIDTH) continue;
+                if (glyph[row] & (1 << col)) buffer[(y + row) * DISPLAY_WIDTH + cursor_x + col] = color;
+            }
+        }
+    }
+}
+
+// Score labels, each drawn the way the old driver did, then through the
+// driver's text runs with a new string every draw (all misses) and with the
+// score changing once a second of frames (almost all hits); rates are in
+// characters per second
+static void bench_text(int iterations) {
+    const int labels = 16;
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    printf("\nText, %d labels of \"Score: N\", characters/s\n", iterations * labels);
+    printf("%18s %16s %12s\n", "mode", "chars/s", "speedup");
+    
+    const char* names[] = {"per-bit glyphs", "runs, new text", "runs, unchanged"};
+    char text[32];
+    double bits_rate = 0.0;
+    for (int mode = 0; mode < 3; mode++) {
+        uint64_t chars = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            for (int l = 0; l < labels; l++) {
+                int score = (mode == 1) ? i * labels + l : i / 60;
+                snprintf(text, sizeof(text), "Score: %d", score);
+                int y = (l * 15) % (DISPLAY_HEIGHT - DISPLAY_FONT_HEIGHT);
+                if (mode == 0) {
+                    draw_text_bits(&ctx, 4, y, text, COLOR_WHITE);
+                } else {
+                    display_driver_draw_text(&ctx, 4, y, text, COLOR_WHITE);
+                }
+                chars += strlen(text);
+            }
+        }
+        double rate = chars / seconds_since(start);
+        if (mode == 0) bits_rate = rate;
+        printf("%18s %16.3g %11.2fx\n", names[mode], rate, rate / bits_rate);
+    }
+    
+    display_text_stats_t stats;
+    display_driver_sim_get_text_stats(&ctx, &stats);
+    printf("text runs: %llu hits, %llu misses\n", (unsigned long long)stats.hits, (unsigned long long)stats.misses);
+    
+    display_driver_deinit(&ctx);
+}
+
+// Pixels sent per frame when the panel scrolls the pillar field itself, for
+// the portrait ST7789 and for a panel whose scan lines run along x
+static void bench_scroll(void) {
+    static game_render_list_t list;
+    static game_render_flush_scratch_t scratch;
+    game_render_list_init(&list, &scratch);
+    const game_render_scroll_axis_t axes[] = {GAME_RENDER_SCROLL_AXIS_Y, GAME_RENDER_SCROLL_AXIS_X};
+    const char* names[] = {"portrait", "x-scan"};
+    
+    display_context_t ctx;
+    if (!display_driver_init(&ctx)) return;
+    
+    printf("\nHardware scroll plans, %d frames of autopilot play\n", SCENE_BENCH_FRAMES - 1);
+    printf("%10s %10s %10s %10s %10s %14s %10s %12s\n", "scan axis", "scrolled", "still", "wrong axis", "uneven",
+           "pixels/frame", "reduction", "frames/s");
+    
+    for (int a = 0; a < 2; a++) {
+        int counts[5] = {0};
+        int scrolled = 0;
+        uint64_t pixels = 0;
+        auto start = std::chrono::steady_clock::now();
+        // The score label as the device draws it
+        char texts[2][32];
+        display_text_t labels[2] = {{4, 4, COLOR_WHITE, texts[0]}, {4, 4, COLOR_WHITE, texts[1]}};
+        snprintf(texts[0], sizeof(texts[0]), "Score: %lu", (unsigned long)worlds[0].game.score);
+        for (int f = 1; f < SCENE_BENCH_FRAMES; f++) {
+            const display_text_t* previous = &labels[(f - 1) % 2];
+            const display_text_t* current = &labels[f % 2];
+            snprintf(texts[f % 2], sizeof(texts[0]), "Score: %lu", (unsigned long)worlds[f].game.score);
+            game_render_scroll_plan_t plan;
+            game_render_scroll_plan(&plan, &worlds[f - 1], previous, &worlds[f], current, axes[a]);
+            game_render_scroll_draw(&list, &ctx, &plan, &worlds[f], current, COLOR_DARK_BLUE);
+            counts[plan.result]++;
+            scrolled += plan.result == GAME_RENDER_SCROLL_OK && plan.shift > 0;
+            pixels += game_render_scroll_plan_pixels(&plan);
+        }
+        double elapsed = seconds_since(start);
+        int frames = SCENE_BENCH_FRAMES - 1;
+        double per_frame = (double)pixels / frames;
+        printf("%10s %10d %10d %10d %10d %14.0f %9.1f%% %12.0f\n", names[a], scrolled,
+               counts[GAME_RENDER_SCROLL_OK] - scrolled, counts[GAME_RENDER_SCROLL_WRONG_AXIS],
+               counts[GAME_RENDER_SCROLL_UNEVEN], per_frame,
+               100.0 * (1.0 - per_frame / (DISPLAY_WIDTH * DISPLAY_HEIGHT)), frames / elapsed);
+    }
+    
+    display_driver_deinit(&ctx);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations < 16) iterations = DEFAULT_ITERATIONS;
+    
+    bench_fill_kernels(iterations);
+    prepare_worlds();
+    bench_display_list(iterations);
+    bench_batches(iterations);
+    bench_sprites(iterations);
+    bench_bands(iterations);
+    bench_text(iterations);
+    bench_backends(iterations);
+    bench_scroll();
+    
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+extern "C" {
+#include "display_driver.h"
+#include "display_st7789.h"
+#include "st7789_emulator.h"
+}
+
+// SPI bus cost of the LVGL backend's panel traffic, measured by running
+// display_st7789.c against the ST7789 bus emulator. Reports transactions,
+// bytes and modeled bus time for the init sequence and for full-frame
+// flushes, at several SPI clocks with a fixed per-transaction overhead.
+//
+// The flush pipeline section models LVGL's two draw buffers: rendering a
+// chunk takes a fixed CPU time, then the chunk is flushed either blocking or
+// queued. Overlap is the share of bus time hidden behind rendering.
+
+#define DEFAULT_OVERHEAD_NS 10000
+#define MAX_TRANSFER_ROWS 64   // max_transfer_sz of the bus
+#define LVGL_BUFFER_ROWS 24    // A tenth of the screen, as display_driver.c allocates
+#define PIPELINE_CLOCK_HZ 40000000
+
+static const uint32_t clocks_hz[] = {10000000, 40000000, 80000000};
+
+static void print_stats(const char* name, const st7789_emulator_stats_t* stats, int repeats) {
+    double transactions = (double)stats->transactions / repeats;
+    double bytes = (double)(stats->command_bytes + stats->parameter_bytes + stats->pixel_bytes + stats->read_bytes) /
+                   repeats;
+    double bus_us = stats->bus_ns / 1000.0 / repeats;
+    printf("  %-24s %12.0f %12.0f %12.1f %10.1f\n", name, transactions, bytes, bus_us,
+           bus_us > 0 ? 1000000.0 / bus_us : 0.0);
+}
+
+// One frame written as the LVGL flush callback does, `rows` rows per area
+static void flush_frame(const uint16_t* frame, int rows) {
+    for (int y = 0; y < DISPLAY_HEIGHT; y += rows) {
+        int height = (y + rows <= DISPLAY_HEIGHT) ? rows : DISPLAY_HEIGHT - y;
+        display_st7789_write_area(0, y, DISPLAY_WIDTH, height, &frame[y * DISPLAY_WIDTH]);
+    }
+}
+
+static void bench_clock(uint32_t clock_hz, uint32_t overhead_ns, const uint16_t* frame, int frames) {
+    st7789_emulator_config_t config = {clock_hz, overhead_ns};
+    st7789_emulator_reset(&config);
+    
+    printf("\n%u MHz, %u ns per transaction\n", clock_hz / 1000000, overhead_ns);
+    printf("  %-24s %12s %12s %12s %10s\n", "", "transactions", "bytes", "bus us", "per second");
+    
+    if (!display_st7789_open()) {
+        printf("  panel open failed\n");
+        return;
+    }
+    st7789_emulator_stats_t stats;
+    st7789_emulator_get_stats(&stats);
+    print_stats("init", &stats, 1);
+    printf("  %-24s %12s %12s %12.1f\n", "init delays", "", "", stats.delay_ns / 1000.0);
+    
+    const int row_counts[] = {MAX_TRANSFER_ROWS, LVGL_BUFFER_ROWS, 1};
+    for (int rows : row_counts) {
+        st7789_emulator_clear_stats();
+        for (int i = 0; i < frames; i++) {
+            flush_frame(frame, rows);
+        }
+        st7789_emulator_get_stats(&stats);
+        char name[32];
+        snprintf(name, sizeof(name), "frame, %d-row areas", rows);
+        print_stats(name, &stats, frames);
+        if (stats.errors) printf("  %u rejected transactions\n", (unsigned)stats.errors);
+    }
+    
+    display_st7789_close();
+}
+
+static void count_flush(void* arg) {
+    (*(int*)arg)++;
+}
+
+// Renders each LVGL chunk for `render_ns` of modeled time, then flushes it.
+// Returns modeled time per frame; bus time per frame is left in `bus_ns`.
+static double pipeline_frame_ns(const uint16_t* frame, int frames, uint64_t render_ns, bool queued,
+                                double* bus_ns) {
+    int flushed = 0;
+    int queued_chunks = 0;
+    st7789_emulator_clear_stats();
+    uint64_t start = st7789_emulator_now_ns();
+    for (int i = 0; i < frames; i++) {
+        for (int y = 0; y < DISPLAY_HEIGHT; y += LVGL_BUFFER_ROWS) {
+            int height = (y + LVGL_BUFFER_ROWS <= DISPLAY_HEIGHT) ? LVGL_BUFFER_ROWS : DISPLAY_HEIGHT - y;
+            st7789_emulator_advance(render_ns);
+            const uint16_t* chunk = &frame[y * DISPLAY_WIDTH];
+            if (queued) {
+                // LVGL flushes a buffer only once the previous flush is done
+                while (flushed < queued_chunks && st7789_emulator_run_next()) {
+                }
+                display_st7789_queue_area(0, y, DISPLAY_WIDTH, height, chunk, count_flush, &flushed);
+                queued_chunks++;
+            } else {
+                display_st7789_write_area(0, y, DISPLAY_WIDTH, height, chunk);
+            }
+        }
+    }
+    display_st7789_wait_idle();
+    
+    st7789_emulator_stats_t stats;
+    st7789_emulator_get_stats(&stats);
+    *bus_ns = (double)stats.bus_ns / frames;
+    return (double)(st7789_emulator_now_ns() - start) / frames;
+}
+
+static void bench_pipeline(uint32_t overhead_ns, const uint16_t* frame, int frames) {
+    st7789_emulator_config_t config = {PIPELINE_CLOCK_HZ, overhead_ns};
+    st7789_emulator_reset(&config);
+    if (!display_st7789_open()) return;
+    
+    const int chunks = (DISPLAY_HEIGHT + LVGL_BUFFER_ROWS - 1) / LVGL_BUFFER_ROWS;
+    printf("\nFlush pipeline, %u MHz, %d-row LVGL chunks, render time per chunk modeled\n",
+           PIPELINE_CLOCK_HZ / 1000000, LVGL_BUFFER_ROWS);
+    printf("  %-10s %-9s %12s %12s %12s %10s %8s\n", "chunk us", "flush", "render us", "bus us", "frame us",
+           "per second", "overlap");
+    
+    const uint64_t render_us[] = {500, 1300, 3000};
+    for (uint64_t us : render_us) {
+        for (int queued = 0; queued < 2; queued++) {
+            double bus_ns;
+            double frame_ns = pipeline_frame_ns(frame, frames, us * 1000, queued, &bus_ns);
+            double render_frame_ns = (double)us * 1000 * chunks;
+            double overlap = (render_frame_ns + bus_ns - frame_ns) / bus_ns * 100.0;
+            printf("  %-10u %-9s %12.1f %12.1f %12.1f %10.1f %7.1f%%\n", (unsigned)us, queued ? "queued" : "blocking",
+                   render_frame_ns / 1000.0, bus_ns / 1000.0, frame_ns / 1000.0, 1e9 / frame_ns, overlap);
+        }
+    }
+    
+    display_st7789_close();
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? atoi(argv[1]) : 10;
+    uint32_t overhead_ns = (argc > 2) ? (uint32_t)atoi(argv[2]) : DEFAULT_OVERHEAD_NS;
+    if (frames < 1) frames = 10;
+    
+    // Frame already in panel byte order, as the flush callback passes it
+    std::vector<uint16_t> frame(DISPLAY_WIDTH * DISPLAY_HEIGHT);
+    for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
+        uint16_t color = (uint16_t)(i * 37);
+        frame[i] = (uint16_t)((color >> 8) | (color << 8));
+    }
+    
+    printf("ST7789 bus cost, %dx%d frame, %d frames per measurement\n", DISPLAY_WIDTH, DISPLAY_HEIGHT, frames);
+    for (uint32_t clock_hz : clocks_hz) {
+        bench_clock(clock_hz, overhead_ns, frame.data(), frames);
+    }
+    bench_pipeline(overhead_ns, frame.data(), frames);
+    return 0;
+}
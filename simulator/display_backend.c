@@ -0,0 +1,364 @@
+#include "display_backend.h"
+#include <stdlib.h>
+#include <string.h>
+
+// display_driver.h entry points: forward to the context's backend
+
+static const display_backend_t *backend_of(const display_context_t *ctx) {
+    return (ctx && ctx->initialized) ? ctx->backend : NULL;
+}
+
+bool display_driver_init_backend(display_context_t *ctx, const display_backend_t *backend) {
+    if (!ctx || !backend) return false;
+
+    ctx->initialized = false;
+    ctx->front_buffer = NULL;
+    ctx->back_buffer = NULL;
+    ctx->current_buffer = NULL;
+    ctx->driver_data = NULL;
+    ctx->backend = backend;
+    return backend->init(ctx);
+}
+
+const display_backend_t *display_driver_get_backend(const display_context_t *ctx) {
+    return backend_of(ctx);
+}
+
+bool display_driver_init(display_context_t *ctx) {
+    return display_driver_init_backend(ctx, &display_backend_sim);
+}
+
+void display_driver_deinit(display_context_t *ctx) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->deinit(ctx);
+}
+
+void display_driver_clear_screen(display_context_t *ctx, uint16_t color) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->clear_screen(ctx, color);
+}
+
+void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->draw_rectangle(ctx, x, y, width, height, color);
+}
+
+void display_driver_draw_rectangles(display_context_t *ctx, const display_rect_t *rects, int count) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->draw_rectangles(ctx, rects, count);
+}
+
+void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->draw_text(ctx, x, y, text, color);
+}
+
+void display_driver_draw_texts(display_context_t *ctx, const display_text_t *texts, int count) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->draw_texts(ctx, texts, count);
+}
+
+void display_driver_draw_bitmap(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->draw_bitmap(ctx, x, y, width, height, pixels);
+}
+
+bool display_driver_blits_bitmaps(display_context_t *ctx) {
+    const display_backend_t *backend = backend_of(ctx);
+    return backend ? backend->blits_bitmaps(ctx) : false;
+}
+
+void display_driver_push_rows(display_context_t *ctx, int y, int rows, const uint16_t *pixels) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->push_rows(ctx, y, rows, pixels);
+}
+
+void display_driver_swap_buffers(display_context_t *ctx) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->swap_buffers(ctx);
+}
+
+void display_driver_flush(display_context_t *ctx) {
+    const display_backend_t *backend = backend_of(ctx);
+    if (backend) backend->flush(ctx);
+}
+
+void display_driver_task_handler(void) {
+    // For desktop simulator, this is a no-op
+    // No LVGL task handling needed
+}
+
+uint16_t display_driver_get_pixel(display_context_t *ctx, int x, int y) {
+    const display_backend_t *backend = backend_of(ctx);
+    return backend ? backend->get_pixel(ctx, x, y) : 0;
+}
+
+// Null and recording backends share their state: the recording storage is
+// only allocated for the latter
+
+typedef struct {
+    display_call_counts_t counts;
+    bool recording;
+    int op_count;
+    uint32_t pixel_count;
+    uint32_t dropped;
+    display_op_t *ops;
+    uint16_t *pixels;
+} counting_state_t;
+
+static counting_state_t *counting_state(const display_context_t *ctx) {
+    if (ctx->backend != &display_backend_null && ctx->backend != &display_backend_record) return NULL;
+    return (counting_state_t *)ctx->driver_data;
+}
+
+static bool counting_init(display_context_t *ctx, bool recording) {
+    counting_state_t *state = calloc(1, sizeof(counting_state_t));
+    if (!state) return false;
+
+    if (recording) {
+        state->recording = true;
+        state->ops = malloc(DISPLAY_RECORD_MAX_OPS * sizeof(display_op_t));
+        state->pixels = malloc(DISPLAY_RECORD_MAX_PIXELS * sizeof(uint16_t));
+        if (!state->ops || !state->pixels) {
+            free(state->ops);
+            free(state->pixels);
+            free(state);
+            return false;
+        }
+    }
+
+    ctx->driver_data = state;
+    ctx->initialized = true;
+    return true;
+}
+
+static bool null_init(display_context_t *ctx) {
+    return counting_init(ctx, false);
+}
+
+static bool record_init(display_context_t *ctx) {
+    return counting_init(ctx, true);
+}
+
+static void counting_deinit(display_context_t *ctx) {
+    counting_state_t *state = counting_state(ctx);
+    if (state) {
+        free(state->ops);
+        free(state->pixels);
+        free(state);
+    }
+    ctx->driver_data = NULL;
+    ctx->initialized = false;
+}
+
+// Next op slot, or NULL when not recording or out of room
+static display_op_t *record_op(counting_state_t *state, display_op_kind_t kind) {
+    if (!state->recording) return NULL;
+    if (state->op_count == DISPLAY_RECORD_MAX_OPS) {
+        state->dropped++;
+        return NULL;
+    }
+
+    display_op_t *op = &state->ops[state->op_count++];
+    memset(op, 0, sizeof(display_op_t));
+    op->kind = kind;
+    return op;
+}
+
+static void counting_clear_screen(display_context_t *ctx, uint16_t color) {
+    counting_state_t *state = counting_state(ctx);
+    state->counts.clears++;
+
+    display_op_t *op = record_op(state, DISPLAY_OP_CLEAR);
+    if (op) op->rect.color = color;
+}
+
+static void counting_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color) {
+    counting_state_t *state = counting_state(ctx);
+    state->counts.rectangles++;
+
+    display_op_t *op = record_op(state, DISPLAY_OP_RECTANGLE);
+    if (op) {
+        display_rect_t rect = {(int16_t)x, (int16_t)y, (int16_t)width, (int16_t)height, color};
+        op->rect = rect;
+    }
+}
+
+static void counting_draw_rectangles(display_context_t *ctx, const display_rect_t *rects, int count) {
+    if (!rects) return;
+
+    for (int i = 0; i < count; i++) {
+        counting_draw_rectangle(ctx, rects[i].x, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
+    }
+}
+
+static void counting_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
+    if (!text) return;
+
+    counting_state_t *state = counting_state(ctx);
+    state->counts.texts++;
+
+    display_op_t *op = record_op(state, DISPLAY_OP_TEXT);
+    if (op) {
+        display_rect_t rect = {(int16_t)x, (int16_t)y, 0, 0, color};
+        op->rect = rect;
+        strncpy(op->text, text, DISPLAY_RECORD_TEXT_LENGTH - 1);
+    }
+}
+
+static void counting_draw_texts(display_context_t *ctx, const display_text_t *texts, int count) {
+    if (!texts) return;
+
+    for (int i = 0; i < count; i++) {
+        counting_draw_text(ctx, texts[i].x, texts[i].y, texts[i].text, texts[i].color);
+    }
+}
+
+static void counting_draw_bitmap(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels) {
+    if (!pixels || width <= 0 || height <= 0) return;
+
+    counting_state_t *state = counting_state(ctx);
+    state->counts.bitmaps++;
+    if (!state->recording) return;
+
+    uint32_t size = (uint32_t)width * (uint32_t)height;
+    if (size > DISPLAY_RECORD_MAX_PIXELS - state->pixel_count) {
+        state->dropped++;
+        return;
+    }
+
+    display_op_t *op = record_op(state, DISPLAY_OP_BITMAP);
+    if (op) {
+        display_rect_t rect = {(int16_t)x, (int16_t)y, (int16_t)width, (int16_t)height, 0};
+        op->rect = rect;
+        op->pixels = state->pixel_count;
+        memcpy(state->pixels + state->pixel_count, pixels, size * sizeof(uint16_t));
+        state->pixel_count += size;
+    }
+}
+
+// A bitmap is one counted, or recorded, call
+static bool counting_blits_bitmaps(display_context_t *ctx) {
+    (void)ctx;
+    return true;
+}
+
+static void counting_push_rows(display_context_t *ctx, int y, int rows, const uint16_t *pixels) {
+    counting_draw_bitmap(ctx, 0, y, DISPLAY_WIDTH, rows, pixels);
+}
+
+static void counting_swap_buffers(display_context_t *ctx) {
+    counting_state_t *state = counting_state(ctx);
+    state->counts.swaps++;
+    record_op(state, DISPLAY_OP_SWAP);
+}
+
+static void counting_flush(display_context_t *ctx) {
+    counting_state_t *state = counting_state(ctx);
+    state->counts.flushes++;
+    record_op(state, DISPLAY_OP_FLUSH);
+}
+
+static uint16_t counting_get_pixel(display_context_t *ctx, int x, int y) {
+    (void)ctx; (void)x; (void)y;
+    return 0;
+}
+
+const display_backend_t display_backend_null = {
+    "null",
+    null_init,
+    counting_deinit,
+    counting_clear_screen,
+    counting_draw_rectangle,
+    counting_draw_rectangles,
+    counting_draw_text,
+    counting_draw_texts,
+    counting_draw_bitmap,
+    counting_blits_bitmaps,
+    counting_push_rows,
+    counting_swap_buffers,
+    counting_flush,
+    counting_get_pixel,
+};
+
+const display_backend_t display_backend_record = {
+    "record",
+    record_init,
+    counting_deinit,
+    counting_clear_screen,
+    counting_draw_rectangle,
+    counting_draw_rectangles,
+    counting_draw_text,
+    counting_draw_texts,
+    counting_draw_bitmap,
+    counting_blits_bitmaps,
+    counting_push_rows,
+    counting_swap_buffers,
+    counting_flush,
+    counting_get_pixel,
+};
+
+bool display_backend_get_counts(const display_context_t *ctx, display_call_counts_t *counts) {
+    if (!counts) return false;
+
+    counting_state_t *state = backend_of(ctx) ? counting_state(ctx) : NULL;
+    if (!state) {
+        memset(counts, 0, sizeof(display_call_counts_t));
+        return false;
+    }
+    *counts = state->counts;
+    return true;
+}
+
+bool display_backend_get_recording(const display_context_t *ctx, display_recording_t *recording) {
+    if (!recording) return false;
+
+    memset(recording, 0, sizeof(display_recording_t));
+    counting_state_t *state = backend_of(ctx) ? counting_state(ctx) : NULL;
+    if (!state || !state->recording) return false;
+
+    recording->count = state->op_count;
+    recording->ops = state->ops;
+    recording->pixels = state->pixels;
+    recording->dropped = state->dropped;
+    return true;
+}
+
+void display_backend_clear_recording(display_context_t *ctx) {
+    counting_state_t *state = backend_of(ctx) ? counting_state(ctx) : NULL;
+    if (!state) return;
+
+    state->op_count = 0;
+    state->pixel_count = 0;
+    state->dropped = 0;
+}
+
+void display_backend_replay(const display_recording_t *recording, display_context_t *ctx) {
+    if (!recording || !ctx) return;
+
+    for (int i = 0; i < recording->count; i++) {
+        const display_op_t *op = &recording->ops[i];
+        const display_rect_t *rect = &op->rect;
+        switch (op->kind) {
+            case DISPLAY_OP_CLEAR:
+                display_driver_clear_screen(ctx, rect->color);
+                break;
+            case DISPLAY_OP_RECTANGLE:
+                display_driver_draw_rectangle(ctx, rect->x, rect->y, rect->width, rect->height, rect->color);
+                break;
+            case DISPLAY_OP_TEXT:
+                display_driver_draw_text(ctx, rect->x, rect->y, op->text, rect->color);
+                break;
+            case DISPLAY_OP_BITMAP:
+                display_driver_draw_bitmap(ctx, rect->x, rect->y, rect->width, rect->height,
+                                           recording->pixels + op->pixels);
+                break;
+            case DISPLAY_OP_SWAP:
+                display_driver_swap_buffers(ctx);
+                break;
+            case DISPLAY_OP_FLUSH:
+                display_driver_flush(ctx);
+                break;
+        }
+    }
+}
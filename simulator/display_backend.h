@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "display_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Display backends selectable at run time on the host. The display_driver_*
+// calls dispatch through the backend a context was initialized with, so one
+// process can render into the simulator's frame buffers, discard everything,
+// or record the calls. display_driver_init() picks the simulator backend.
+typedef struct display_backend {
+    const char *name;
+    bool (*init)(display_context_t *ctx);
+    void (*deinit)(display_context_t *ctx);
+    void (*clear_screen)(display_context_t *ctx, uint16_t color);
+    void (*draw_rectangle)(display_context_t *ctx, int x, int y, int width, int height, uint16_t color);
+    void (*draw_rectangles)(display_context_t *ctx, const display_rect_t *rects, int count);
+    void (*draw_text)(display_context_t *ctx, int x, int y, const char *text, uint16_t color);
+    void (*draw_texts)(display_context_t *ctx, const display_text_t *texts, int count);
+    void (*draw_bitmap)(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels);
+    bool (*blits_bitmaps)(display_context_t *ctx);
+    void (*push_rows)(display_context_t *ctx, int y, int rows, const uint16_t *pixels);
+    void (*swap_buffers)(display_context_t *ctx);
+    void (*flush)(display_context_t *ctx);
+    uint16_t (*get_pixel)(display_context_t *ctx, int x, int y);
+} display_backend_t;
+
+// Frame buffers in memory (display_driver_sim.c)
+extern const display_backend_t display_backend_sim;
+// Draws nothing and only counts calls; get_pixel() returns 0
+extern const display_backend_t display_backend_null;
+// Counts calls and records them, with copies of their text and pixels, for
+// display_backend_replay(); draws nothing
+extern const display_backend_t display_backend_record;
+
+bool display_driver_init_backend(display_context_t *ctx, const display_backend_t *backend);
+// NULL before init
+const display_backend_t *display_driver_get_backend(const display_context_t *ctx);
+
+// Calls made since init; batches count each of their entries
+typedef struct {
+    uint64_t clears;
+    uint64_t rectangles;
+    uint64_t texts;
+    uint64_t bitmaps;                  // push_rows() included
+    uint64_t swaps;
+    uint64_t flushes;
+} display_call_counts_t;
+
+// Null and recording backends only; false and zeroes for any other
+bool display_backend_get_counts(const display_context_t *ctx, display_call_counts_t *counts);
+
+// Recording. Calls that no longer fit the op or pixel storage are dropped and
+// counted; a recording is only faithful while `dropped` is 0.
+#define DISPLAY_RECORD_MAX_OPS 4096
+#define DISPLAY_RECORD_MAX_PIXELS (2 * DISPLAY_WIDTH * DISPLAY_HEIGHT)
+#define DISPLAY_RECORD_TEXT_LENGTH 32
+
+typedef enum {
+    DISPLAY_OP_CLEAR,
+    DISPLAY_OP_RECTANGLE,
+    DISPLAY_OP_TEXT,
+    DISPLAY_OP_BITMAP,
+    DISPLAY_OP_SWAP,
+    DISPLAY_OP_FLUSH
+} display_op_kind_t;
+
+typedef struct {
+    display_op_kind_t kind;
+    display_rect_t rect;               // Clear: color only. Text: x, y and color.
+                                       // Coordinates are kept as int16_t.
+    uint32_t pixels;                   // Bitmap: offset of its pixels in the recording
+    char text[DISPLAY_RECORD_TEXT_LENGTH]; // Longer text is cut short
+} display_op_t;
+
+typedef struct {
+    int count;
+    const display_op_t *ops;
+    const uint16_t *pixels;
+    uint32_t dropped;
+} display_recording_t;
+
+// Recording backend only; false and an empty recording for any other
+bool display_backend_get_recording(const display_context_t *ctx, display_recording_t *recording);
+// Forgets the recorded calls; the counts keep running
+void display_backend_clear_recording(display_context_t *ctx);
+// Issues the recorded calls, in order, to another context
+void display_backend_replay(const display_recording_t *recording, display_context_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
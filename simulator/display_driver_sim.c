@@ -1,74 +1,442 @@
 #include "display_driver.h"
+#include "display_driver_sim.h"
+#include "display_backend.h"
+#include "display_font.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DISPLAY_SIM_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define DISPLAY_SIM_X86_KERNELS 0
+#endif
+
 // Desktop simulator version - stub implementation that maintains API compatibility
 
-// Simple 8x8 font bitmap (basic characters 32-90 ' ' .. 'Z')
-static const uint8_t font_8x8[][8] = {
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
-    {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00}, // '!'
-    {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
-    {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00}, // '#'
-    {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00}, // '$'
-    {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00}, // '%'
-    {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00}, // '&'
-    {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
-    {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00}, // '('
-    {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00}, // ')'
-    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00}, // '*'
-    {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00}, // '+'
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x06, 0x00}, // ','
-    {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00}, // '-'
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // '.'
-    {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00}, // '/'
-    {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00}, // '0'
-    {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00}, // '1'
-    {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00}, // '2'
-    {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00}, // '3'
-    {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00}, // '4'
-    {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00}, // '5'
-    {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00}, // '6'
-    {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00}, // '7'
-    {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00}, // '8'
-    {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00}, // '9'
-    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // ':'
-    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x06, 0x00}, // ';'
-    {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00}, // '<'
-    {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00}, // '='
-    {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00}, // '>'
-    {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00}, // '?'
-    {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00}, // '@'
-    {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00}, // 'A'
-    {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00}, // 'B'
-    {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00}, // 'C'
-    {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00}, // 'D'
-    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00}, // 'E'
-    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00}, // 'F'
-    {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00}, // 'G'
-    {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00}, // 'H'
-    {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'I'
-    {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00}, // 'J'
-    {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00}, // 'K'
-    {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00}, // 'L'
-    {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00}, // 'M'
-    {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00}, // 'N'
-    {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00}, // 'O'
-    {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00}, // 'P'
-    {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00}, // 'Q'
-    {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00}, // 'R'
-    {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00}, // 'S'
-    {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'T'
-    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00}, // 'U'
-    {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // 'V'
-    {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00}, // 'W'
-    {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00}, // 'X'
-    {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00}, // 'Y'
-    {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00}, // 'Z'
-};
+// Span fill kernels. Each one writes exactly `count` pixels and nothing
+// outside them; the wide kernels store whole aligned words through the
+// middle of the span and finish the unaligned ends separately.
+
+typedef void (*fill_span_fn_t)(uint16_t *dst, uint32_t count, uint16_t color);
+
+static void fill_span_scalar(uint16_t *dst, uint32_t count, uint16_t color) {
+    for (uint32_t i = 0; i < count; i++) {
+        dst[i] = color;
+    }
+}
+
+// Native word of the host: 32 or 64 bits
+typedef uintptr_t fill_word_t;
+#define FILL_WORD_PIXELS ((uint32_t)(sizeof(fill_word_t) / sizeof(uint16_t)))
+
+static void fill_span_swar(uint16_t *dst, uint32_t count, uint16_t color) {
+    // 0x0001...0001 times the color copies it into every 16-bit lane
+    const fill_word_t pattern = ((fill_word_t)-1 / 0xFFFF) * color;
+    
+    while (count > 0 && ((uintptr_t)dst & (sizeof(fill_word_t) - 1))) {
+        *dst++ = color;
+        count--;
+    }
+    
+    // memcpy of one aligned word compiles to a single store and keeps the
+    // uint16_t frame buffer free of aliasing problems
+    for (; count >= 4 * FILL_WORD_PIXELS; count -= 4 * FILL_WORD_PIXELS) {
+        memcpy(dst, &pattern, sizeof(pattern));
+        memcpy(dst + FILL_WORD_PIXELS, &pattern, sizeof(pattern));
+        memcpy(dst + 2 * FILL_WORD_PIXELS, &pattern, sizeof(pattern));
+        memcpy(dst + 3 * FILL_WORD_PIXELS, &pattern, sizeof(pattern));
+        dst += 4 * FILL_WORD_PIXELS;
+    }
+    for (; count >= FILL_WORD_PIXELS; count -= FILL_WORD_PIXELS) {
+        memcpy(dst, &pattern, sizeof(pattern));
+        dst += FILL_WORD_PIXELS;
+    }
+    
+    while (count > 0) {
+        *dst++ = color;
+        count--;
+    }
+}
+
+#if DISPLAY_SIM_X86_KERNELS
+
+// Spans shorter than a vector: two overlapping stores of the widest size that
+// fits cover any length without a per-pixel loop
+static inline void fill_span_short(uint16_t *dst, uint32_t count, uint16_t color) {
+    uint32_t pair = color * 0x00010001u;
+    uint64_t quad = pair * 0x0000000100000001ull;
+    if (count >= 4) {
+        memcpy(dst, &quad, sizeof(quad));
+        memcpy(dst + count - 4, &quad, sizeof(quad));
+    } else if (count >= 2) {
+        memcpy(dst, &pair, sizeof(pair));
+        memcpy(dst + count - 2, &pair, sizeof(pair));
+    } else if (count == 1) {
+        *dst = color;
+    }
+}
+
+#define SSE2_PIXELS 8
+#define AVX2_PIXELS 16
+
+// Spans of at least one vector cover their unaligned head and tail with a
+// single unaligned store each, overlapping the aligned body, instead of
+// looping over pixels
+__attribute__((target("sse2")))
+static void fill_span_sse2(uint16_t *dst, uint32_t count, uint16_t color) {
+    if (count < SSE2_PIXELS) {
+        fill_span_short(dst, count, color);
+        return;
+    }
+    
+    const __m128i pattern = _mm_set1_epi16((short)color);
+    uint16_t *end = dst + count;
+    
+    _mm_storeu_si128((__m128i *)dst, pattern);
+    dst = (uint16_t *)(((uintptr_t)dst + 16) & ~(uintptr_t)15);
+    
+    for (; dst + 4 * SSE2_PIXELS <= end; dst += 4 * SSE2_PIXELS) {
+        _mm_store_si128((__m128i *)dst, pattern);
+        _mm_store_si128((__m128i *)(dst + SSE2_PIXELS), pattern);
+        _mm_store_si128((__m128i *)(dst + 2 * SSE2_PIXELS), pattern);
+        _mm_store_si128((__m128i *)(dst + 3 * SSE2_PIXELS), pattern);
+    }
+    for (; dst + SSE2_PIXELS <= end; dst += SSE2_PIXELS) {
+        _mm_store_si128((__m128i *)dst, pattern);
+    }
+    
+    if (dst < end) {
+        _mm_storeu_si128((__m128i *)(end - SSE2_PIXELS), pattern);
+    }
+}
+
+__attribute__((target("avx2")))
+static void fill_span_avx2(uint16_t *dst, uint32_t count, uint16_t color) {
+    if (count < SSE2_PIXELS) {
+        fill_span_short(dst, count, color);
+        return;
+    }
+    if (count < AVX2_PIXELS) {
+        const __m128i half = _mm_set1_epi16((short)color);
+        _mm_storeu_si128((__m128i *)dst, half);
+        _mm_storeu_si128((__m128i *)(dst + count - SSE2_PIXELS), half);
+        return;
+    }
+    
+    const __m256i pattern = _mm256_set1_epi16((short)color);
+    uint16_t *end = dst + count;
+    
+    _mm256_storeu_si256((__m256i *)dst, pattern);
+    dst = (uint16_t *)(((uintptr_t)dst + 32) & ~(uintptr_t)31);
+    
+    for (; dst + 4 * AVX2_PIXELS <= end; dst += 4 * AVX2_PIXELS) {
+        _mm256_store_si256((__m256i *)dst, pattern);
+        _mm256_store_si256((__m256i *)(dst + AVX2_PIXELS), pattern);
+        _mm256_store_si256((__m256i *)(dst + 2 * AVX2_PIXELS), pattern);
+        _mm256_store_si256((__m256i *)(dst + 3 * AVX2_PIXELS), pattern);
+    }
+    for (; dst + AVX2_PIXELS <= end; dst += AVX2_PIXELS) {
+        _mm256_store_si256((__m256i *)dst, pattern);
+    }
+    
+    if (dst < end) {
+        _mm256_storeu_si256((__m256i *)(end - AVX2_PIXELS), pattern);
+    }
+}
+
+#endif // DISPLAY_SIM_X86_KERNELS
+
+static display_fill_kernel_t fill_kernel;
+static fill_span_fn_t fill_span = NULL;
+
+static fill_span_fn_t fill_span_for(display_fill_kernel_t kernel) {
+    switch (kernel) {
+        case DISPLAY_FILL_KERNEL_SWAR: return fill_span_swar;
+#if DISPLAY_SIM_X86_KERNELS
+        case DISPLAY_FILL_KERNEL_SSE2: return fill_span_sse2;
+        case DISPLAY_FILL_KERNEL_AVX2: return fill_span_avx2;
+#endif
+        default: return fill_span_scalar;
+    }
+}
+
+bool display_driver_sim_fill_kernel_supported(display_fill_kernel_t kernel) {
+    switch (kernel) {
+        case DISPLAY_FILL_KERNEL_SCALAR:
+        case DISPLAY_FILL_KERNEL_SWAR:
+            return true;
+#if DISPLAY_SIM_X86_KERNELS
+        case DISPLAY_FILL_KERNEL_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case DISPLAY_FILL_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+bool display_driver_sim_set_fill_kernel(display_fill_kernel_t kernel) {
+    if (!display_driver_sim_fill_kernel_supported(kernel)) return false;
+    
+    fill_kernel = kernel;
+    fill_span = fill_span_for(kernel);
+    return true;
+}
+
+display_fill_kernel_t display_driver_sim_get_fill_kernel(void) {
+    if (!fill_span) {
+        // Detection is idempotent, so racing first callers all pick the same kernel
+        if (display_driver_sim_fill_kernel_supported(DISPLAY_FILL_KERNEL_AVX2)) {
+            fill_kernel = DISPLAY_FILL_KERNEL_AVX2;
+        } else if (display_driver_sim_fill_kernel_supported(DISPLAY_FILL_KERNEL_SSE2)) {
+            fill_kernel = DISPLAY_FILL_KERNEL_SSE2;
+        } else {
+            fill_kernel = DISPLAY_FILL_KERNEL_SWAR;
+        }
+        fill_span = fill_span_for(fill_kernel);
+    }
+    return fill_kernel;
+}
+
+const char *display_driver_sim_fill_kernel_name(display_fill_kernel_t kernel) {
+    switch (kernel) {
+        case DISPLAY_FILL_KERNEL_SCALAR: return "scalar";
+        case DISPLAY_FILL_KERNEL_SWAR: return "swar";
+        case DISPLAY_FILL_KERNEL_SSE2: return "sse2";
+        case DISPLAY_FILL_KERNEL_AVX2: return "avx2";
+        default: return "unknown";
+    }
+}
+
+static fill_span_fn_t get_fill_span(void) {
+    display_driver_sim_get_fill_kernel();
+    return fill_span;
+}
+
+void display_driver_sim_fill_span(uint16_t *dst, uint32_t count, uint16_t color) {
+    if (!dst) return;
+    
+    get_fill_span()(dst, count, color);
+}
+
+// A string laid out once into spans relative to the text position
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t width;
+} text_span_t;
+
+typedef struct {
+    char text[DISPLAY_SIM_TEXT_MAX_LENGTH];
+    uint32_t last_used;                // 0 for an empty slot
+    int width;                         // Bounding box from the text position
+    int height;
+    int span_count;
+    text_span_t spans[DISPLAY_SIM_TEXT_MAX_SPANS];
+} text_run_t;
+
+// Per-display state kept behind display_context_t::driver_data
+typedef struct {
+    bool dirty_tracking;
+    bool dirty_all;                    // Next swap marks the whole screen
+    int dirty_count;
+    display_area_t dirty[DISPLAY_SIM_MAX_DIRTY_AREAS];
+    display_dirty_stats_t stats;
+    
+    uint32_t text_clock;
+    text_run_t text_runs[DISPLAY_SIM_TEXT_RUNS];
+    display_text_stats_t text_stats;
+    
+    display_target_t target;           // lock is NULL when drawing into our own buffers
+    bool target_locked;
+    void *own_front;                   // Our buffers while a target is in use
+    void *own_back;
+    int stride;                        // Row pitch of current_buffer in pixels
+} sim_display_state_t;
+
+// NULL for contexts running another backend
+static sim_display_state_t *get_state(const display_context_t *ctx) {
+    if (ctx->backend != &display_backend_sim) return NULL;
+    return (sim_display_state_t *)ctx->driver_data;
+}
+
+// Frame being composed and its row pitch in pixels, or NULL. A host target is
+// locked by the first drawing call of each frame.
+static uint16_t *draw_buffer(display_context_t *ctx, int *stride) {
+    if (!ctx || !ctx->initialized) return NULL;
+    
+    sim_display_state_t *state = get_state(ctx);
+    if (state->target.lock && !state->target_locked) {
+        void *pixels = NULL;
+        int pitch = 0;
+        if (!state->target.lock(state->target.user, &pixels, &pitch) || !pixels) return NULL;
+        if (pitch < (int)(DISPLAY_WIDTH * sizeof(uint16_t)) || pitch % sizeof(uint16_t) != 0) {
+            state->target.unlock(state->target.user);
+            return NULL;
+        }
+        
+        state->target_locked = true;
+        state->stride = pitch / (int)sizeof(uint16_t);
+        ctx->current_buffer = pixels;
+        ctx->back_buffer = pixels;
+    }
+    
+    *stride = state->stride;
+    return (uint16_t *)ctx->current_buffer;
+}
+
+static bool areas_touch(const display_area_t *a, const display_area_t *b) {
+    return a->x < b->x + b->width + DISPLAY_SIM_DIRTY_GAP && b->x < a->x + a->width + DISPLAY_SIM_DIRTY_GAP &&
+           a->y <= b->y + b->height && b->y <= a->y + a->height;
+}
+
+static void area_union(display_area_t *a, const display_area_t *b) {
+    int x2 = (a->x + a->width > b->x + b->width) ? a->x + a->width : b->x + b->width;
+    int y2 = (a->y + a->height > b->y + b->height) ? a->y + a->height : b->y + b->height;
+    a->x = (a->x < b->x) ? a->x : b->x;
+    a->y = (a->y < b->y) ? a->y : b->y;
+    a->width = x2 - a->x;
+    a->height = y2 - a->y;
+}
+
+static int area_growth(const display_area_t *a, const display_area_t *b) {
+    display_area_t merged = *a;
+    area_union(&merged, b);
+    return merged.width * merged.height - a->width * a->height;
+}
+
+// Adds one changed run of a row. Rows arrive top to bottom, so only areas
+// reaching the row above can absorb it.
+static void add_dirty_run(sim_display_state_t *state, int x_start, int x_end, int y) {
+    display_area_t run = {x_start, y, x_end - x_start, 1};
+    
+    int target = -1;
+    for (int i = 0; i < state->dirty_count && target < 0; i++) {
+        if (areas_touch(&state->dirty[i], &run)) target = i;
+    }
+    
+    if (target < 0 && state->dirty_count < DISPLAY_SIM_MAX_DIRTY_AREAS) {
+        state->dirty[state->dirty_count++] = run;
+        return;
+    }
+    if (target < 0) {
+        // Out of areas: grow whichever one needs the fewest extra pixels
+        target = 0;
+        for (int i = 1; i < state->dirty_count; i++) {
+            if (area_growth(&state->dirty[i], &run) < area_growth(&state->dirty[target], &run)) target = i;
+        }
+    }
+    area_union(&state->dirty[target], &run);
+    
+    // The grown area may now reach others; fold them in so no pixel is uploaded twice
+    for (int i = 0; i < state->dirty_count; i++) {
+        if (i == target || !areas_touch(&state->dirty[i], &state->dirty[target])) continue;
+        
+        area_union(&state->dirty[target], &state->dirty[i]);
+        state->dirty[i] = state->dirty[--state->dirty_count];
+        if (target == state->dirty_count) target = i;
+        i = -1;
+    }
+}
+
+static void track_dirty(sim_display_state_t *state, const uint16_t *next, const uint16_t *previous) {
+    state->dirty_count = 0;
+    
+    if (state->dirty_all) {
+        display_area_t screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+        state->dirty[state->dirty_count++] = screen;
+        state->dirty_all = false;
+    } else {
+        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+            const uint16_t *a = next + y * DISPLAY_WIDTH;
+            const uint16_t *b = previous + y * DISPLAY_WIDTH;
+            if (memcmp(a, b, DISPLAY_WIDTH * sizeof(uint16_t)) == 0) continue;
+            
+            int x = 0;
+            while (x < DISPLAY_WIDTH) {
+                while (x < DISPLAY_WIDTH && a[x] == b[x]) x++;
+                if (x == DISPLAY_WIDTH) break;
+                
+                // Extend the run across unchanged gaps shorter than DISPLAY_SIM_DIRTY_GAP
+                int start = x;
+                int end = ++x;
+                for (; x < DISPLAY_WIDTH && x - end < DISPLAY_SIM_DIRTY_GAP; x++) {
+                    if (a[x] != b[x]) end = x + 1;
+                }
+                add_dirty_run(state, start, end, y);
+                x = end;
+            }
+        }
+    }
+    
+    state->stats.frames++;
+    state->stats.areas += state->dirty_count;
+    state->stats.full_bytes += DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t);
+    for (int i = 0; i < state->dirty_count; i++) {
+        state->stats.dirty_bytes += (uint64_t)state->dirty[i].width * state->dirty[i].height * sizeof(uint16_t);
+    }
+}
+
+void display_driver_sim_set_dirty_tracking(display_context_t *ctx, bool enabled) {
+    if (!ctx || !ctx->initialized || !get_state(ctx)) return;
+    
+    sim_display_state_t *state = get_state(ctx);
+    if (enabled && !state->dirty_tracking) {
+        memset(&state->stats, 0, sizeof(state->stats));
+        state->dirty_all = true;
+    }
+    state->dirty_tracking = enabled;
+    state->dirty_count = 0;
+}
+
+int display_driver_sim_get_dirty_areas(const display_context_t *ctx, const display_area_t **areas) {
+    if (!ctx || !ctx->initialized || !get_state(ctx) || !areas) return 0;
+    
+    *areas = get_state(ctx)->dirty;
+    return get_state(ctx)->dirty_count;
+}
 
-bool display_driver_init(display_context_t *ctx) {
+void display_driver_sim_get_dirty_stats(const display_context_t *ctx, display_dirty_stats_t *stats) {
+    if (!stats) return;
+    
+    memset(stats, 0, sizeof(*stats));
+    if (ctx && ctx->initialized && get_state(ctx)) *stats = get_state(ctx)->stats;
+}
+
+bool display_driver_sim_set_target(display_context_t *ctx, const display_target_t *target) {
+    if (!ctx || !ctx->initialized) return false;
+    if (target && (!target->lock || !target->unlock)) return false;
+    
+    sim_display_state_t *state = get_state(ctx);
+    if (!state) return false;
+    if (state->target.lock) {
+        if (state->target_locked) state->target.unlock(state->target.user);
+        
+        // Our buffers were parked in driver-owned slots while the target was in use
+        ctx->front_buffer = state->own_front;
+        ctx->back_buffer = state->own_back;
+        ctx->current_buffer = ctx->back_buffer;
+        state->stride = DISPLAY_WIDTH;
+        memset(&state->target, 0, sizeof(state->target));
+        state->target_locked = false;
+    }
+    
+    if (target) {
+        state->own_front = ctx->front_buffer;
+        state->own_back = ctx->back_buffer;
+        state->target = *target;
+        ctx->front_buffer = NULL;
+        ctx->back_buffer = NULL;
+        ctx->current_buffer = NULL;
+        state->dirty_count = 0;
+    }
+    return true;
+}
+
+static bool sim_init(display_context_t *ctx) {
     if (!ctx) {
         printf("Invalid display context\n");
         return false;
@@ -80,11 +448,14 @@ bool display_driver_init(display_context_t *ctx) {
     size_t buffer_size = DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t);
     ctx->front_buffer = malloc(buffer_size);
     ctx->back_buffer = malloc(buffer_size);
+    ctx->driver_data = calloc(1, sizeof(sim_display_state_t));
 
-    if (!ctx->front_buffer || !ctx->back_buffer) {
+    if (!ctx->front_buffer || !ctx->back_buffer || !ctx->driver_data) {
         printf("Failed to allocate display buffers\n");
         if (ctx->front_buffer) free(ctx->front_buffer);
         if (ctx->back_buffer) free(ctx->back_buffer);
+        if (ctx->driver_data) free(ctx->driver_data);
+        ctx->driver_data = NULL;
         return false;
     }
 
@@ -92,17 +463,21 @@ bool display_driver_init(display_context_t *ctx) {
     memset(ctx->front_buffer, 0, buffer_size);
     memset(ctx->back_buffer, 0, buffer_size);
     ctx->current_buffer = ctx->back_buffer;
+    get_state(ctx)->stride = DISPLAY_WIDTH;
 
     ctx->initialized = true;
     printf("Desktop simulator display driver initialized successfully\n");
     return true;
 }
 
-void display_driver_deinit(display_context_t *ctx) {
+static void sim_deinit(display_context_t *ctx) {
     if (!ctx || !ctx->initialized) {
         return;
     }
 
+    // Hand a locked target back and restore our own buffers before freeing them
+    display_driver_sim_set_target(ctx, NULL);
+
     // Free buffers
     if (ctx->front_buffer) {
         free(ctx->front_buffer);
@@ -112,28 +487,33 @@ void display_driver_deinit(display_context_t *ctx) {
         free(ctx->back_buffer);
         ctx->back_buffer = NULL;
     }
+    free(ctx->driver_data);
+    ctx->driver_data = NULL;
 
     ctx->initialized = false;
     printf("Desktop simulator display driver deinitialized\n");
 }
 
-void display_driver_clear_screen(display_context_t *ctx, uint16_t color) {
-    if (!ctx || !ctx->initialized || !ctx->current_buffer) {
+static void sim_clear_screen(display_context_t *ctx, uint16_t color) {
+    int stride;
+    uint16_t *buffer = draw_buffer(ctx, &stride);
+    if (!buffer) {
         return;
     }
 
-    uint16_t *buffer = (uint16_t *)ctx->current_buffer;
-    uint32_t pixel_count = DISPLAY_WIDTH * DISPLAY_HEIGHT;
-    for (uint32_t i = 0; i < pixel_count; i++) {
-        buffer[i] = color;
-    }
-}
-
-void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color) {
-    if (!ctx || !ctx->initialized || !ctx->current_buffer) {
+    // Unpadded rows are one contiguous span
+    fill_span_fn_t fill = get_fill_span();
+    if (stride == DISPLAY_WIDTH) {
+        fill(buffer, DISPLAY_WIDTH * DISPLAY_HEIGHT, color);
         return;
     }
+    for (int row = 0; row < DISPLAY_HEIGHT; row++) {
+        fill(buffer + row * stride, DISPLAY_WIDTH, color);
+    }
+}
 
+static void fill_rect(uint16_t *buffer, int stride, fill_span_fn_t fill, int x, int y, int width, int height,
+                      uint16_t color) {
     // Clip rectangle to screen boundaries
     if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT) return;
     if (x + width < 0 || y + height < 0) return;
@@ -143,73 +523,267 @@ void display_driver_draw_rectangle(display_context_t *ctx, int x, int y, int wid
     int x_end = (x + width > DISPLAY_WIDTH) ? DISPLAY_WIDTH : x + width;
     int y_end = (y + height > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT : y + height;
 
-    uint16_t *buffer = (uint16_t *)ctx->current_buffer;
+    if (x_start >= x_end || y_start >= y_end) return;
+
+    // Full-width rows of an unpadded buffer are contiguous, so they fill as one span
+    if (x_start == 0 && x_end == DISPLAY_WIDTH && stride == DISPLAY_WIDTH) {
+        fill(buffer + y_start * DISPLAY_WIDTH, (uint32_t)((y_end - y_start) * DISPLAY_WIDTH), color);
+        return;
+    }
     
-    // Draw rectangle
     for (int row = y_start; row < y_end; row++) {
-        for (int col = x_start; col < x_end; col++) {
-            buffer[row * DISPLAY_WIDTH + col] = color;
-        }
+        fill(buffer + row * stride + x_start, (uint32_t)(x_end - x_start), color);
     }
 }
 
-void display_driver_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
-    if (!ctx || !ctx->initialized || !ctx->current_buffer || !text) {
+static void sim_draw_rectangle(display_context_t *ctx, int x, int y, int width, int height, uint16_t color) {
+    int stride;
+    uint16_t *buffer = draw_buffer(ctx, &stride);
+    if (!buffer) {
+        return;
+    }
+
+    fill_rect(buffer, stride, get_fill_span(), x, y, width, height, color);
+}
+
+static void sim_draw_rectangles(display_context_t *ctx, const display_rect_t *rects, int count) {
+    int stride;
+    uint16_t *buffer = (rects && count > 0) ? draw_buffer(ctx, &stride) : NULL;
+    if (!buffer) {
         return;
     }
 
-    uint16_t *buffer = (uint16_t *)ctx->current_buffer;
+    fill_span_fn_t fill = get_fill_span();
+    for (int i = 0; i < count; i++) {
+        fill_rect(buffer, stride, fill, rects[i].x, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
+    }
+}
+
+static void sim_draw_bitmap(display_context_t *ctx, int x, int y, int width, int height, const uint16_t *pixels) {
+    int stride;
+    uint16_t *buffer = pixels ? draw_buffer(ctx, &stride) : NULL;
+    if (!buffer) {
+        return;
+    }
+
+    int x_start = (x < 0) ? 0 : x;
+    int y_start = (y < 0) ? 0 : y;
+    int x_end = (x + width > DISPLAY_WIDTH) ? DISPLAY_WIDTH : x + width;
+    int y_end = (y + height > DISPLAY_HEIGHT) ? DISPLAY_HEIGHT : y + height;
+    if (x_start >= x_end || y_start >= y_end) return;
+
+    const uint16_t *source = pixels + (y_start - y) * width + (x_start - x);
+    size_t row_bytes = (size_t)(x_end - x_start) * sizeof(uint16_t);
+    for (int row = y_start; row < y_end; row++) {
+        memcpy(buffer + row * stride + x_start, source, row_bytes);
+        source += width;
+    }
+}
+
+// A bitmap is a copy into the frame buffer, cheaper than its rectangles
+static bool sim_blits_bitmaps(display_context_t *ctx) {
+    (void)ctx;
+    return true;
+}
+
+static void sim_push_rows(display_context_t *ctx, int y, int rows, const uint16_t *pixels) {
+    sim_draw_bitmap(ctx, 0, y, DISPLAY_WIDTH, rows, pixels);
+}
+
+// Draws each glyph from its precomputed spans; only glyphs that cross a
+// screen edge need clipping
+static void draw_glyph_spans(uint16_t *buffer, int stride, int x, int y, const char *text, uint16_t color) {
     int cursor_x = x;
     int cursor_y = y;
 
     while (*text) {
         char ch = *text;
         
-        // Normalize to our limited font set
-        if (ch >= 'a' && ch <= 'z') {
-            ch = (char)(ch - 32); // map to 'A'..'Z'
-        }
-        
         // Handle newline
         if (ch == '\n') {
             cursor_x = x;
-            cursor_y += 8;
+            cursor_y += DISPLAY_FONT_HEIGHT;
             text++;
             continue;
         }
 
-        // Check if character is in our font range (32..90)
-        if (ch >= 32 && ch <= 90) {
-            const uint8_t *glyph = font_8x8[ch - 32];
+        const display_font_span_t *spans;
+        int span_count = display_font_glyph_spans(ch, &spans);
+        bool inside = cursor_x >= 0 && cursor_x + DISPLAY_FONT_WIDTH <= DISPLAY_WIDTH &&
+                      cursor_y >= 0 && cursor_y + DISPLAY_FONT_HEIGHT <= DISPLAY_HEIGHT;
+        for (int i = 0; i < span_count; i++) {
+            int row = cursor_y + spans[i].row;
+            int x_start = cursor_x + spans[i].x;
+            int x_end = x_start + spans[i].width;
+            if (!inside) {
+                if (row < 0 || row >= DISPLAY_HEIGHT) continue;
+                if (x_start < 0) x_start = 0;
+                if (x_end > DISPLAY_WIDTH) x_end = DISPLAY_WIDTH;
+            }
             
-            // Draw 8x8 character
-            for (int row = 0; row < 8; row++) {
-                if (cursor_y + row >= DISPLAY_HEIGHT) break;
-                if (cursor_y + row < 0) continue;
-                
-                uint8_t row_data = glyph[row];
-                for (int col = 0; col < 8; col++) {
-                    if (cursor_x + col >= DISPLAY_WIDTH) break;
-                    if (cursor_x + col < 0) continue;
-                    
-                    // Font data uses LSB-as-left orientation
-                    if (row_data & (1 << col)) {
-                        buffer[(cursor_y + row) * DISPLAY_WIDTH + (cursor_x + col)] = color;
-                    }
-                }
+            uint16_t *dst = buffer + row * stride;
+            for (int px = x_start; px < x_end; px++) {
+                dst[px] = color;
             }
         }
         
-        cursor_x += 8; // Move to next character position
+        cursor_x += DISPLAY_FONT_WIDTH; // Move to next character position
         text++;
     }
 }
 
-void display_driver_swap_buffers(display_context_t *ctx) {
+// Lays out `text` into the run's spans. Returns false if they do not fit.
+static bool layout_text_run(text_run_t *run, const char *text) {
+    int count = 0;
+    int cursor_x = 0;
+    int cursor_y = 0;
+    for (; *text; text++) {
+        if (*text == '\n') {
+            cursor_x = 0;
+            cursor_y += DISPLAY_FONT_HEIGHT;
+            continue;
+        }
+        
+        const display_font_span_t *spans;
+        int span_count = display_font_glyph_spans(*text, &spans);
+        if (count + span_count > DISPLAY_SIM_TEXT_MAX_SPANS) return false;
+        for (int i = 0; i < span_count; i++) {
+            text_span_t span = {(int16_t)(cursor_x + spans[i].x), (int16_t)(cursor_y + spans[i].row),
+                                (int16_t)spans[i].width};
+            run->spans[count++] = span;
+        }
+        cursor_x += DISPLAY_FONT_WIDTH;
+    }
+    
+    run->width = 0;
+    run->height = 0;
+    for (int i = 0; i < count; i++) {
+        if (run->spans[i].x + run->spans[i].width > run->width) run->width = run->spans[i].x + run->spans[i].width;
+        if (run->spans[i].y + 1 > run->height) run->height = run->spans[i].y + 1;
+    }
+    run->span_count = count;
+    return true;
+}
+
+// Returns the cached run of `text`, laying it out on a miss, or NULL if it
+// does not fit a run. The least recently used run is replaced.
+static const text_run_t *get_text_run(sim_display_state_t *state, const char *text) {
+    if (strlen(text) >= DISPLAY_SIM_TEXT_MAX_LENGTH) return NULL;
+    
+    state->text_clock++;
+    text_run_t *oldest = &state->text_runs[0];
+    for (int i = 0; i < DISPLAY_SIM_TEXT_RUNS; i++) {
+        text_run_t *run = &state->text_runs[i];
+        if (run->last_used != 0 && strcmp(run->text, text) == 0) {
+            run->last_used = state->text_clock;
+            state->text_stats.hits++;
+            return run;
+        }
+        if (run->last_used < oldest->last_used) oldest = run;
+    }
+    
+    state->text_stats.misses++;
+    if (!layout_text_run(oldest, text)) {
+        oldest->last_used = 0;
+        return NULL;
+    }
+    strcpy(oldest->text, text);
+    oldest->last_used = state->text_clock;
+    return oldest;
+}
+
+static void draw_text_run(sim_display_state_t *state, uint16_t *buffer, int stride, int x, int y, const char *text,
+                          uint16_t color) {
+    const text_run_t *run = state ? get_text_run(state, text) : NULL;
+    if (!run) {
+        if (state) state->text_stats.uncached++;
+        draw_glyph_spans(buffer, stride, x, y, text, color);
+        return;
+    }
+    
+    // Labels entirely on screen, the usual case, skip clipping
+    if (x >= 0 && y >= 0 && x + run->width <= DISPLAY_WIDTH && y + run->height <= DISPLAY_HEIGHT) {
+        for (int i = 0; i < run->span_count; i++) {
+            uint16_t *dst = buffer + (y + run->spans[i].y) * stride + x + run->spans[i].x;
+            for (int px = 0; px < run->spans[i].width; px++) {
+                dst[px] = color;
+            }
+        }
+        return;
+    }
+    
+    for (int i = 0; i < run->span_count; i++) {
+        int row = y + run->spans[i].y;
+        if (row < 0 || row >= DISPLAY_HEIGHT) continue;
+        int x_start = x + run->spans[i].x;
+        int x_end = x_start + run->spans[i].width;
+        if (x_start < 0) x_start = 0;
+        if (x_end > DISPLAY_WIDTH) x_end = DISPLAY_WIDTH;
+        
+        uint16_t *dst = buffer + row * stride;
+        for (int px = x_start; px < x_end; px++) {
+            dst[px] = color;
+        }
+    }
+}
+
+static void sim_draw_text(display_context_t *ctx, int x, int y, const char *text, uint16_t color) {
+    int stride;
+    uint16_t *buffer = text ? draw_buffer(ctx, &stride) : NULL;
+    if (!buffer) {
+        return;
+    }
+
+    draw_text_run(get_state(ctx), buffer, stride, x, y, text, color);
+}
+
+static void sim_draw_texts(display_context_t *ctx, const display_text_t *texts, int count) {
+    int stride;
+    uint16_t *buffer = (texts && count > 0) ? draw_buffer(ctx, &stride) : NULL;
+    if (!buffer) {
+        return;
+    }
+
+    sim_display_state_t *state = get_state(ctx);
+    for (int i = 0; i < count; i++) {
+        if (texts[i].text) draw_text_run(state, buffer, stride, texts[i].x, texts[i].y, texts[i].text, texts[i].color);
+    }
+}
+
+void display_driver_sim_get_text_stats(const display_context_t *ctx, display_text_stats_t *stats) {
+    if (!stats) return;
+    
+    sim_display_state_t *state = ctx ? get_state(ctx) : NULL;
+    if (state) {
+        *stats = state->text_stats;
+    } else {
+        memset(stats, 0, sizeof(display_text_stats_t));
+    }
+}
+
+static void sim_swap_buffers(display_context_t *ctx) {
     if (!ctx || !ctx->initialized) {
         return;
     }
 
+    // A host target gets the finished frame back; the next drawing call locks
+    // it again
+    sim_display_state_t *state = get_state(ctx);
+    if (state->target.lock) {
+        if (state->target_locked) {
+            state->target.unlock(state->target.user);
+            state->target_locked = false;
+        }
+        ctx->current_buffer = NULL;
+        ctx->back_buffer = NULL;
+        return;
+    }
+
+    // The back buffer becomes the visible frame; compare it with the one it replaces
+    if (state->dirty_tracking) {
+        track_dirty(state, (const uint16_t *)ctx->back_buffer, (const uint16_t *)ctx->front_buffer);
+    }
+
     // Swap front and back buffers
     void *temp = ctx->front_buffer;
     ctx->front_buffer = ctx->back_buffer;
@@ -217,7 +791,7 @@ void display_driver_swap_buffers(display_context_t *ctx) {
     ctx->current_buffer = ctx->back_buffer;
 }
 
-void display_driver_flush(display_context_t *ctx) {
+static void sim_flush(display_context_t *ctx) {
     if (!ctx || !ctx->initialized || !ctx->front_buffer) {
         return;
     }
@@ -226,13 +800,15 @@ void display_driver_flush(display_context_t *ctx) {
     // The actual rendering to SDL is handled by the simulator main loop
 }
 
-void display_driver_task_handler(void) {
-    // For desktop simulator, this is a no-op
-    // No LVGL task handling needed
-}
-
-uint16_t display_driver_get_pixel(display_context_t *ctx, int x, int y) {
-    if (!ctx || !ctx->initialized || !ctx->front_buffer) {
+static uint16_t sim_get_pixel(display_context_t *ctx, int x, int y) {
+    if (!ctx || !ctx->initialized || !ctx->current_buffer) {
+        return 0;
+    }
+    
+    // Reads never lock a target: between a swap and the next draw call the
+    // frame is the target's, and nothing is being composed
+    sim_display_state_t *state = get_state(ctx);
+    if (state->target.lock && !state->target_locked) {
         return 0;
     }
     
@@ -241,6 +817,24 @@ uint16_t display_driver_get_pixel(display_context_t *ctx, int x, int y) {
         return 0;
     }
     
-    uint16_t *buffer = (uint16_t *)ctx->front_buffer;
-    return buffer[y * DISPLAY_WIDTH + x];
-}
\ No newline at end of file
+    // Read back the frame being composed, which is what the tests draw into
+    const uint16_t *buffer = (const uint16_t *)ctx->current_buffer;
+    return buffer[y * state->stride + x];
+}
+
+const display_backend_t display_backend_sim = {
+    "sim",
+    sim_init,
+    sim_deinit,
+    sim_clear_screen,
+    sim_draw_rectangle,
+    sim_draw_rectangles,
+    sim_draw_text,
+    sim_draw_texts,
+    sim_draw_bitmap,
+    sim_blits_bitmaps,
+    sim_push_rows,
+    sim_swap_buffers,
+    sim_flush,
+    sim_get_pixel,
+};
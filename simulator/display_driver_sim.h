@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "display_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Simulator-only extensions of the display driver, used by the headless
+// renderer, its tests and benchmarks. They act on contexts running the
+// simulator backend (display_backend.h) and do nothing for any other.
+
+// Implementations of the span fill behind clear_screen and draw_rectangle.
+// SWAR stores one machine word (two or four pixels) at a time on any host;
+// the vector kernels are only available on x86 hosts with the matching
+// instruction set.
+typedef enum {
+    DISPLAY_FILL_KERNEL_SCALAR,
+    DISPLAY_FILL_KERNEL_SWAR,
+    DISPLAY_FILL_KERNEL_SSE2,
+    DISPLAY_FILL_KERNEL_AVX2
+} display_fill_kernel_t;
+
+// Sets `count` pixels starting at `dst` to `color`. `dst` only needs the
+// alignment of a uint16_t. Uses the fastest kernel the CPU supports unless
+// one was selected explicitly.
+void display_driver_sim_fill_span(uint16_t *dst, uint32_t count, uint16_t color);
+bool display_driver_sim_fill_kernel_supported(display_fill_kernel_t kernel);
+// Returns false and keeps the current kernel if `kernel` is not supported
+bool display_driver_sim_set_fill_kernel(display_fill_kernel_t kernel);
+display_fill_kernel_t display_driver_sim_get_fill_kernel(void);
+const char *display_driver_sim_fill_kernel_name(display_fill_kernel_t kernel);
+
+// Dirty-region tracking. When enabled, every swap compares the new front
+// buffer with the frame it replaces and records the areas that changed, so a
+// window only has to upload those. Runs of changed pixels closer than
+// DISPLAY_SIM_DIRTY_GAP merge, as do runs that overlap a run on the row above.
+// The first swap after enabling marks the whole screen.
+#define DISPLAY_SIM_MAX_DIRTY_AREAS 16
+#define DISPLAY_SIM_DIRTY_GAP 8
+
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} display_area_t;
+
+typedef struct {
+    uint64_t frames;
+    uint64_t areas;
+    uint64_t dirty_bytes;              // Bytes inside the dirty areas
+    uint64_t full_bytes;               // Bytes full-frame uploads would have moved
+} display_dirty_stats_t;
+
+// Enabling also resets the statistics
+void display_driver_sim_set_dirty_tracking(display_context_t *ctx, bool enabled);
+// Areas of the front buffer that changed at the last swap. Returns the number
+// of areas, 0 when nothing changed or tracking is off.
+int display_driver_sim_get_dirty_areas(const display_context_t *ctx, const display_area_t **areas);
+void display_driver_sim_get_dirty_stats(const display_context_t *ctx, display_dirty_stats_t *stats);
+
+// Text run cache behind display_driver_draw_text(). The first draw of a string
+// lays it out into spans of the 8x8 font; later draws of the same string, in
+// any color and at any position, are a single pass over those spans. The
+// least recently used run is replaced; longer or denser text is drawn glyph
+// by glyph.
+#define DISPLAY_SIM_TEXT_RUNS 8
+#define DISPLAY_SIM_TEXT_MAX_LENGTH 32
+#define DISPLAY_SIM_TEXT_MAX_SPANS 256
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t uncached;                 // Draws of text that does not fit a run
+} display_text_stats_t;
+
+void display_driver_sim_get_text_stats(const display_context_t *ctx, display_text_stats_t *stats);
+
+// Host-supplied render target, such as a locked SDL streaming texture. While
+// one is set, the driver draws straight into the memory `lock` returns, using
+// its pitch, instead of into its own buffers; no frame is copied afterwards.
+// The first drawing call of a frame locks the target and
+// display_driver_swap_buffers() unlocks it, handing the frame over. Locked
+// memory starts with undefined contents, so every frame must cover the whole
+// screen; front_buffer is NULL and dirty tracking reports no areas.
+typedef struct {
+    // Returns writable memory for a DISPLAY_WIDTH x DISPLAY_HEIGHT RGB565 frame
+    // and its row pitch in bytes
+    bool (*lock)(void *user, void **pixels, int *pitch);
+    void (*unlock)(void *user);
+    void *user;
+} display_target_t;
+
+// Pass NULL to go back to the driver's own buffers. Returns false if the
+// target lacks a callback.
+bool display_driver_sim_set_target(display_context_t *ctx, const display_target_t *target);
+
+#ifdef __cplusplus
+}
+#endif
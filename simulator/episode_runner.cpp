@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "game_sim.h"
+#include "game_sim_policy.h"
+}
+
+#include "work_stealing_pool.h"
+
+// Plays many complete episodes headless across every core and reports
+// throughput, the score distribution and how evenly the threads were loaded.
+// Episode i is seeded with (seed + i), so any single episode can be rerun.
+
+#define DEFAULT_EPISODES 100000
+#define DEFAULT_CHUNK 64
+#define DEFAULT_MAX_FRAMES 36000 // Ten minutes of play at 60 FPS
+#define HISTOGRAM_BAR_WIDTH 40
+
+typedef struct {
+    uint64_t episodes;
+    unsigned threads;
+    uint64_t chunk;
+    uint32_t max_frames;
+    uint32_t seed;
+    ice_pillars_rng_mode_t rng_mode;
+    const game_sim_policy_t* policy;
+} runner_options_t;
+
+// Per-thread totals, padded so the counters of neighbouring threads never share a line
+typedef struct alignas(64) {
+    uint64_t frames;
+    uint64_t truncated;
+} runner_thread_totals_t;
+
+static void print_usage(const char* program) {
+    int policy_count = 0;
+    const game_sim_policy_t* policies = game_sim_get_policies(&policy_count);
+    
+    printf("Usage: %s [options]\n", program);
+    printf("  --episodes N     episodes to play (default %d)\n", DEFAULT_EPISODES);
+    printf("  --threads N      worker threads, 0 for all cores (default 0)\n");
+    printf("  --policy NAME    input policy (default autopilot)\n");
+    printf("  --seed N         seed of episode 0 (default %d)\n", ICE_PILLARS_DEFAULT_SEED);
+    printf("  --rng lcg|counter  pillar generator (default counter)\n");
+    printf("  --chunk N        episodes per scheduling chunk (default %d)\n", DEFAULT_CHUNK);
+    printf("  --max-frames N   stop an episode after N frames, 0 for no limit (default %d)\n", DEFAULT_MAX_FRAMES);
+    printf("Policies:\n");
+    for (int i = 0; i < policy_count; i++) {
+        printf("  %-12s %s\n", policies[i].name, policies[i].description);
+    }
+}
+
+static bool parse_options(int argc, char* argv[], runner_options_t* options) {
+    options->episodes = DEFAULT_EPISODES;
+    options->threads = 0;
+    options->chunk = DEFAULT_CHUNK;
+    options->max_frames = DEFAULT_MAX_FRAMES;
+    options->seed = ICE_PILLARS_DEFAULT_SEED;
+    options->rng_mode = ICE_PILLARS_RNG_COUNTER;
+    options->policy = game_sim_find_policy("autopilot");
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            return false;
+        }
+        if (!value) {
+            printf("Missing value for %s\n", arg);
+            return false;
+        }
+        
+        if (strcmp(arg, "--episodes") == 0) {
+            options->episodes = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--threads") == 0) {
+            options->threads = (unsigned)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--chunk") == 0) {
+            options->chunk = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--max-frames") == 0) {
+            options->max_frames = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options->seed = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--rng") == 0) {
+            if (strcmp(value, "lcg") == 0) {
+                options->rng_mode = ICE_PILLARS_RNG_LCG;
+            } else if (strcmp(value, "counter") == 0) {
+                options->rng_mode = ICE_PILLARS_RNG_COUNTER;
+            } else {
+                printf("Unknown generator: %s\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "--policy") == 0) {
+            options->policy = game_sim_find_policy(value);
+            if (!options->policy) {
+                printf("Unknown policy: %s\n", value);
+                return false;
+            }
+        } else {
+            printf("Unknown option: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    
+    return options->episodes > 0 && options->chunk > 0;
+}
+
+static uint32_t score_at_rank(const std::vector<uint64_t>& counts, uint64_t rank) {
+    uint64_t seen = 0;
+    for (size_t score = 0; score < counts.size(); score++) {
+        seen += counts[score];
+        if (seen > rank) return (uint32_t)score;
+    }
+    return counts.empty() ? 0 : (uint32_t)(counts.size() - 1);
+}
+
+static void print_score_distribution(const std::vector<uint32_t>& scores) {
+    uint32_t max_score = *std::max_element(scores.begin(), scores.end());
+    std::vector<uint64_t> counts(max_score + 1, 0);
+    double total = 0.0;
+    for (uint32_t score : scores) {
+        counts[score]++;
+        total += score;
+    }
+    
+    uint64_t n = scores.size();
+    printf("Scores: min %u  mean %.2f  p50 %u  p90 %u  p99 %u  max %u\n",
+           score_at_rank(counts, 0), total / n, score_at_rank(counts, n / 2),
+           score_at_rank(counts, n * 9 / 10), score_at_rank(counts, n * 99 / 100), max_score);
+    
+    // Power-of-two buckets: 0, 1, 2-3, 4-7, ...
+    std::vector<uint64_t> buckets;
+    for (uint32_t score = 0; score <= max_score; score++) {
+        size_t bucket = 0;
+        while ((1u << bucket) <= score) bucket++;
+        if (buckets.size() <= bucket) buckets.resize(bucket + 1, 0);
+        buckets[bucket] += counts[score];
+    }
+    uint64_t largest = *std::max_element(buckets.begin(), buckets.end());
+    
+    for (size_t bucket = 0; bucket < buckets.size(); bucket++) {
+        uint32_t low = bucket ? 1u << (bucket - 1) : 0;
+        uint32_t high = bucket ? (1u << bucket) - 1 : 0;
+        int bar = (int)(buckets[bucket] * HISTOGRAM_BAR_WIDTH / largest);
+        printf("  %6u-%-6u %10llu  %.*s\n", low, high, (unsigned long long)buckets[bucket], bar,
+               "########################################");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    runner_options_t options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    work_stealing_pool pool(options.threads);
+    unsigned threads = pool.thread_count();
+    std::vector<uint32_t> scores(options.episodes);
+    std::vector<runner_thread_totals_t> totals(threads);
+    
+    printf("Policy %s, %llu episodes on %u threads (chunk %llu, %s pillars, frame limit %u)\n",
+           options.policy->name, (unsigned long long)options.episodes, threads,
+           (unsigned long long)options.chunk, options.rng_mode == ICE_PILLARS_RNG_LCG ? "lcg" : "counter",
+           options.max_frames);
+    
+    game_sim_policy_fn decide = options.policy->decide;
+    double wall = pool.parallel_for(options.episodes, options.chunk, [&](uint64_t begin, uint64_t end, unsigned worker) {
+        runner_thread_totals_t local = totals[worker];
+        for (uint64_t episode = begin; episode < end; episode++) {
+            game_world_t world;
+            game_sim_world_init_seeded(&world, options.seed + (uint32_t)episode, options.rng_mode);
+            uint32_t frames = game_sim_run_episode(&world, decide, episode, options.max_frames);
+            
+            local.frames += frames;
+            local.truncated += world.game.state == GAME_STATE_PLAYING;
+            scores[episode] = world.game.score;
+        }
+        totals[worker] = local;
+    });
+    
+    uint64_t frames = 0;
+    uint64_t truncated = 0;
+    double busy = 0.0;
+    for (unsigned w = 0; w < threads; w++) {
+        frames += totals[w].frames;
+        truncated += totals[w].truncated;
+        busy += pool.stats(w).busy_seconds;
+    }
+    
+    printf("\nWall time %.3f s: %.0f episodes/s, %.0f frames/s, %.1f frames per episode\n",
+           wall, options.episodes / wall, frames / wall, (double)frames / options.episodes);
+    printf("Episodes stopped at the frame limit: %llu\n\n", (unsigned long long)truncated);
+    
+    print_score_distribution(scores);
+    
+    printf("\nPer-thread utilization (parallel efficiency %.1f%%)\n", 100.0 * busy / (wall * threads));
+    printf("%8s %12s %10s %8s %8s\n", "thread", "episodes", "chunks", "steals", "busy");
+    for (unsigned w = 0; w < threads; w++) {
+        const work_stealing_worker_stats_t& stats = pool.stats(w);
+        printf("%8u %12llu %10llu %8llu %7.1f%%\n", w, (unsigned long long)stats.items,
+               (unsigned long long)stats.chunks, (unsigned long long)stats.steals,
+               100.0 * stats.busy_seconds / wall);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Code placement has no meaning on the host
+#define IRAM_ATTR
@@ -0,0 +1,22 @@
+#pragma once
+
+// Host stand-ins for the ESP-IDF APIs used by display_st7789.c. The SPI and
+// GPIO calls drive the ST7789 bus emulator (st7789_emulator.h).
+
+typedef int esp_err_t;
+
+#define ESP_OK                0
+#define ESP_FAIL              -1
+#define ESP_ERR_INVALID_ARG   0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_TIMEOUT       0x107
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *esp_err_to_name(esp_err_t code);
+
+#ifdef __cplusplus
+}
+#endif
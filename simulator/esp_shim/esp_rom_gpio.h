@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Busy wait; the emulator adds it to the modeled delay time
+void esp_rom_delay_us(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+// 1 kHz tick, as in the project's sdkconfig
+typedef uint32_t TickType_t;
+
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns at once; the emulator adds the delay to the modeled delay time
+void vTaskDelay(TickType_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "display_driver.h"
+}
+
+// Frame sink for archiving video of runs. submit() copies a finished RGB565
+// frame into a bounded single-producer/single-consumer ring and returns at
+// once; a writer thread converts queued frames and writes them to disk. When
+// the ring is full the frame is dropped and counted, so the game loop never
+// waits on the writer.
+//
+// Two formats: a numbered PPM per frame (P6, RGB888) in a directory, or one
+// YUV4MPEG2 stream. The stream is 4:4:4 (BT.601, limited range) because the
+// 135-pixel width cannot be halved for 4:2:0 chroma.
+
+#define FRAME_DUMP_DEFAULT_QUEUE 8
+#define FRAME_DUMP_DEFAULT_FPS 60
+
+typedef enum {
+    FRAME_DUMP_PPM,
+    FRAME_DUMP_Y4M
+} frame_dump_format_t;
+
+typedef struct {
+    uint64_t submitted;
+    uint64_t written;
+    uint64_t dropped;            // Ring was full
+    uint64_t write_errors;       // Frames the writer failed to write
+} frame_dump_stats_t;
+
+class frame_dump {
+public:
+    static const int frame_pixels = DISPLAY_WIDTH * DISPLAY_HEIGHT;
+    
+    frame_dump() {}
+    ~frame_dump() { close(); }
+    frame_dump(const frame_dump&) = delete;
+    frame_dump& operator=(const frame_dump&) = delete;
+    
+    // A path ending in ".y4m" is a stream, anything else a PPM directory
+    static frame_dump_format_t format_for(const char* path) {
+        size_t length = strlen(path);
+        return (length >= 4 && strcmp(path + length - 4, ".y4m") == 0) ? FRAME_DUMP_Y4M : FRAME_DUMP_PPM;
+    }
+    
+    // PPM directories must exist. Starts the writer thread.
+    bool open(const char* path, frame_dump_format_t format, unsigned queue_frames = FRAME_DUMP_DEFAULT_QUEUE,
+              unsigned fps = FRAME_DUMP_DEFAULT_FPS) {
+        if (running_ || !path || queue_frames == 0) return false;
+        
+        path_ = path;
+        format_ = format;
+        if (format_ == FRAME_DUMP_Y4M) {
+            stream_ = fopen(path, "wb");
+            if (!stream_) return false;
+            fprintf(stream_, "YUV4MPEG2 W%d H%d F%u:1 Ip A1:1 C444\n", DISPLAY_WIDTH, DISPLAY_HEIGHT,
+                    fps ? fps : FRAME_DUMP_DEFAULT_FPS);
+        }
+        
+        slots_.assign((size_t)queue_frames * frame_pixels, 0);
+        capacity_ = queue_frames;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        stopping_.store(false, std::memory_order_relaxed);
+        written_.store(0, std::memory_order_relaxed);
+        write_errors_.store(0, std::memory_order_relaxed);
+        submitted_ = 0;
+        dropped_ = 0;
+        running_ = true;
+        writer_ = std::thread([this] { run_writer(); });
+        return true;
+    }
+    
+    // Producer side; call from one thread only. Copies the frame, or drops it
+    // and returns false if the writer is `queue_frames` frames behind.
+    bool submit(const uint16_t* pixels) {
+        if (!running_ || !pixels) return false;
+        
+        submitted_++;
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+            dropped_++;
+            return false;
+        }
+        
+        memcpy(&slots_[(size_t)(tail % capacity_) * frame_pixels], pixels, frame_pixels * sizeof(uint16_t));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Writes what is still queued, then stops the writer
+    void close() {
+        if (!running_) return;
+        
+        stopping_.store(true, std::memory_order_release);
+        writer_.join();
+        if (stream_) {
+            fclose(stream_);
+            stream_ = NULL;
+        }
+        running_ = false;
+    }
+    
+    bool is_open() const { return running_; }
+    
+    // Producer-side counters are exact; `written` may lag while open
+    frame_dump_stats_t stats() const {
+        frame_dump_stats_t stats;
+        stats.submitted = submitted_;
+        stats.written = written_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_;
+        stats.write_errors = write_errors_.load(std::memory_order_relaxed);
+        return stats;
+    }
+    
+    static void rgb565_to_rgb888(uint16_t pixel, uint8_t* r, uint8_t* g, uint8_t* b) {
+        *r = (uint8_t)((((pixel >> 11) & 0x1F) * 527 + 23) >> 6);
+        *g = (uint8_t)((((pixel >> 5) & 0x3F) * 259 + 33) >> 6);
+        *b = (uint8_t)(((pixel & 0x1F) * 527 + 23) >> 6);
+    }
+
+private:
+    void run_writer() {
+        std::vector<uint8_t> converted((size_t)frame_pixels * 3);
+        uint64_t frame_number = 0;
+        for (;;) {
+            uint64_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                // Checked after an empty ring, and the ring checked again, so
+                // frames submitted before close() are still written
+                if (stopping_.load(std::memory_order_acquire) &&
+                    head == tail_.load(std::memory_order_acquire)) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            
+            const uint16_t* frame = &slots_[(size_t)(head % capacity_) * frame_pixels];
+            bool ok = (format_ == FRAME_DUMP_Y4M) ? write_y4m(frame, converted.data())
+                                                  : write_ppm(frame, converted.data(), frame_number);
+            frame_number++;
+            head_.store(head + 1, std::memory_order_release);
+            if (ok) {
+                written_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                write_errors_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool write_ppm(const uint16_t* frame, uint8_t* rgb, uint64_t frame_number) {
+        for (int i = 0; i < frame_pixels; i++) {
+            rgb565_to_rgb888(frame[i], &rgb[i * 3], &rgb[i * 3 + 1], &rgb[i * 3 + 2]);
+        }
+        
+        char name[32];
+        snprintf(name, sizeof(name), "/frame_%06llu.ppm", (unsigned long long)frame_number);
+        FILE* file = fopen((path_ + name).c_str(), "wb");
+        if (!file) return false;
+        fprintf(file, "P6\n%d %d\n255\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        bool ok = fwrite(rgb, 3, frame_pixels, file) == (size_t)frame_pixels;
+        return fclose(file) == 0 && ok;
+    }
+    
+    // Planar Y, then U, then V
+    bool write_y4m(const uint16_t* frame, uint8_t* planes) {
+        uint8_t* y_plane = planes;
+        uint8_t* u_plane = planes + frame_pixels;
+        uint8_t* v_plane = planes + 2 * frame_pixels;
+        for (int i = 0; i < frame_pixels; i++) {
+            uint8_t r8, g8, b8;
+            rgb565_to_rgb888(frame[i], &r8, &g8, &b8);
+            int r = r8, g = g8, b = b8;
+            y_plane[i] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            u_plane[i] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            v_plane[i] = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+        
+        fputs("FRAME\n", stream_);
+        return fwrite(planes, 1, (size_t)frame_pixels * 3, stream_) == (size_t)frame_pixels * 3;
+    }
+    
+    std::string path_;
+    frame_dump_format_t format_ = FRAME_DUMP_PPM;
+    FILE* stream_ = NULL;
+    bool running_ = false;
+    std::thread writer_;
+    
+    std::vector<uint16_t> slots_;
+    uint64_t capacity_ = 0;
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> write_errors_{0};
+    uint64_t submitted_ = 0;
+    uint64_t dropped_ = 0;
+};
@@ -0,0 +1,187 @@
+#include "game_render_scroll.h"
+#include "display_font.h"
+#include <string.h>
+
+// Columns game_render_pillar() draws for a pillar at x: the outline adds one on each side
+static int pillar_left(float x) {
+    return (int)x - 1;
+}
+
+static int pillar_right(float x) {
+    return (int)x + PILLAR_WIDTH + 1;
+}
+
+static void add_rect(game_render_scroll_plan_t* plan, int x0, int y0, int x1, int y1) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > DISPLAY_WIDTH) x1 = DISPLAY_WIDTH;
+    if (y1 > DISPLAY_HEIGHT) y1 = DISPLAY_HEIGHT;
+    if (x0 >= x1 || y0 >= y1 || plan->rect_count == GAME_RENDER_SCROLL_MAX_RECTS) return;
+    
+    display_rect_t* rect = &plan->rects[plan->rect_count++];
+    rect->x = (int16_t)x0;
+    rect->y = (int16_t)y0;
+    rect->width = (int16_t)(x1 - x0);
+    rect->height = (int16_t)(y1 - y0);
+    rect->color = 0;
+}
+
+// Old and new position of something, as {x0, y0, x1, y1}. One rectangle when they overlap.
+static void add_pair(game_render_scroll_plan_t* plan, int boxes[2][4]) {
+    bool overlap = boxes[0][0] < boxes[1][2] && boxes[1][0] < boxes[0][2] &&
+                   boxes[0][1] < boxes[1][3] && boxes[1][1] < boxes[0][3];
+    if (overlap) {
+        add_rect(plan, boxes[0][0] < boxes[1][0] ? boxes[0][0] : boxes[1][0],
+                 boxes[0][1] < boxes[1][1] ? boxes[0][1] : boxes[1][1],
+                 boxes[0][2] > boxes[1][2] ? boxes[0][2] : boxes[1][2],
+                 boxes[0][3] > boxes[1][3] ? boxes[0][3] : boxes[1][3]);
+        return;
+    }
+    add_rect(plan, boxes[0][0], boxes[0][1], boxes[0][2], boxes[0][3]);
+    add_rect(plan, boxes[1][0], boxes[1][1], boxes[1][2], boxes[1][3]);
+}
+
+// Old and new penguin, as drawn by game_render_penguin(): outline around the
+// body, head poking out above, feet below
+static void add_penguins(game_render_scroll_plan_t* plan, const game_world_t* previous, const game_world_t* current) {
+    int boxes[2][4];
+    const game_world_t* worlds[2] = {previous, current};
+    for (int i = 0; i < 2; i++) {
+        int x = (int)worlds[i]->penguin.x - (i == 0 ? plan->shift : 0);
+        int y = (int)worlds[i]->penguin.y;
+        boxes[i][0] = x - 1;
+        boxes[i][1] = y - PENGUIN_HEIGHT / 4;
+        boxes[i][2] = x + PENGUIN_WIDTH + 1;
+        boxes[i][3] = y + PENGUIN_HEIGHT + 3;
+    }
+    add_pair(plan, boxes);
+}
+
+// Cells display_driver_draw_text() covers for a label: lines break at '\n'
+static void label_box(const display_text_t* label, int shift, int box[4]) {
+    int columns = 0, widest = 0, lines = 1;
+    for (const char* c = label->text; *c; c++) {
+        if (*c == '\n') {
+            columns = 0;
+            lines++;
+        } else if (++columns > widest) {
+            widest = columns;
+        }
+    }
+    box[0] = label->x - shift;
+    box[1] = label->y;
+    box[2] = box[0] + widest * DISPLAY_FONT_WIDTH;
+    box[3] = box[1] + lines * DISPLAY_FONT_HEIGHT;
+}
+
+static bool same_label(const display_text_t* a, const display_text_t* b) {
+    if (!a || !b) return a == b;
+    return a->x == b->x && a->y == b->y && a->color == b->color && strcmp(a->text, b->text) == 0;
+}
+
+// The old label wherever the scroll moved it, and the new one. Nothing when
+// neither the field nor the label moved or changed.
+static void add_labels(game_render_scroll_plan_t* plan, const display_text_t* previous, const display_text_t* current) {
+    if (plan->shift == 0 && same_label(previous, current)) return;
+    
+    int boxes[2][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}};
+    if (previous && previous->text) label_box(previous, plan->shift, boxes[0]);
+    if (current && current->text) label_box(current, 0, boxes[1]);
+    add_pair(plan, boxes);
+}
+
+bool game_render_scroll_plan(game_render_scroll_plan_t* plan, const game_world_t* previous,
+                             const display_text_t* previous_label, const game_world_t* current,
+                             const display_text_t* current_label, game_render_scroll_axis_t axis) {
+    if (!plan || !current) return false;
+    
+    memset(plan, 0, sizeof(*plan));
+    if (!previous) {
+        plan->result = GAME_RENDER_SCROLL_FIRST;
+        return false;
+    }
+    
+    // Pillars on screen in both frames must all have moved by the same whole
+    // number of pixels. A slot whose pillar moved right was respawned.
+    bool have_shift = false;
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* before = &previous->pillars.pillars[i];
+        const ice_pillar_t* after = &current->pillars.pillars[i];
+        if (!before->active || !after->active || after->x > before->x) continue;
+        
+        int shift = (int)before->x - (int)after->x;
+        if (have_shift && shift != plan->shift) {
+            plan->result = GAME_RENDER_SCROLL_UNEVEN;
+            return false;
+        }
+        plan->shift = shift;
+        have_shift = true;
+    }
+    
+    if (plan->shift > 0 && axis != GAME_RENDER_SCROLL_AXIS_X) {
+        plan->result = GAME_RENDER_SCROLL_WRONG_AXIS;
+        return false;
+    }
+    if (plan->shift >= DISPLAY_WIDTH) {
+        plan->result = GAME_RENDER_SCROLL_TOO_FAR;
+        return false;
+    }
+    
+    // The strip scrolled in on the right, widened to cover new pillars, and
+    // on the left whatever is left of pillars that went away
+    int strip_left = DISPLAY_WIDTH - plan->shift;
+    int gone_right = 0;
+    for (int i = 0; i < MAX_PILLARS; i++) {
+        const ice_pillar_t* before = &previous->pillars.pillars[i];
+        const ice_pillar_t* after = &current->pillars.pillars[i];
+        bool respawned = before->active && after->active && after->x > before->x;
+        if (after->active && (!before->active || respawned) && pillar_left(after->x) < strip_left) {
+            strip_left = pillar_left(after->x);
+        }
+        if (before->active && (!after->active || respawned) && pillar_right(before->x) - plan->shift > gone_right) {
+            gone_right = pillar_right(before->x) - plan->shift;
+        }
+    }
+    
+    add_rect(plan, strip_left, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    add_rect(plan, 0, 0, gone_right, DISPLAY_HEIGHT);
+    add_penguins(plan, previous, current);
+    add_labels(plan, previous_label, current_label);
+    plan->result = GAME_RENDER_SCROLL_OK;
+    return true;
+}
+
+uint32_t game_render_scroll_plan_pixels(const game_render_scroll_plan_t* plan) {
+    if (!plan || plan->result != GAME_RENDER_SCROLL_OK) return DISPLAY_WIDTH * DISPLAY_HEIGHT;
+    
+    uint32_t pixels = 0;
+    for (int i = 0; i < plan->rect_count; i++) {
+        pixels += (uint32_t)(plan->rects[i].width * plan->rects[i].height);
+    }
+    return pixels;
+}
+
+void game_render_scroll_draw(game_render_list_t* list, display_context_t* display, const game_render_scroll_plan_t* plan,
+                             const game_world_t* current, const display_text_t* label, uint16_t background) {
+    if (!list || !plan || !current) return;
+    
+    if (plan->result != GAME_RENDER_SCROLL_OK) {
+        game_render_list_begin(list, display);
+        game_render_scene(list, current, background);
+        game_render_list_flush(list);
+    } else {
+        // The whole scene is recorded per region; clipping drops what lies outside
+        for (int i = 0; i < plan->rect_count; i++) {
+            const display_rect_t* rect = &plan->rects[i];
+            game_render_list_begin(list, display);
+            game_render_list_set_clip(list, rect->x, rect->y, rect->width, rect->height);
+            game_render_scene(list, current, background);
+            game_render_list_flush(list);
+        }
+    }
+    
+    // Inside the label's region, which was just redrawn, when the plan scrolls
+    if (label && label->text) {
+        display_driver_draw_text(display, label->x, label->y, label->text, label->color);
+    }
+}
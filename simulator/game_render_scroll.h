@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "game_render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Plans a frame for panels that scroll in hardware (the ST7789's VSCRDEF /
+// VSCSAD). When the pillar field has moved by the same whole number of
+// pixels along the panel's scan axis, the panel scrolls the picture it
+// already holds and only the strip the motion exposed and the penguin are
+// redrawn. Anything else falls back to a full redraw.
+//
+// The ST7789 scrolls along its gate lines. Mounted in portrait, as on the
+// M5StickC Plus, those are display rows, while the pillars move along x: only
+// frames where the field did not move take the scrolling path there. That
+// is why the planner lives here, for penguin_render_bench and the tests,
+// rather than in the game_render component.
+//
+// Text over the field, such as the score label, stays put while the panel
+// scrolls its old copy away with the field. The plan redraws where the old
+// label ended up and where the new one goes.
+#define GAME_RENDER_SCROLL_MAX_RECTS 6
+
+typedef enum {
+    GAME_RENDER_SCROLL_AXIS_X,     // Scan lines run along display columns
+    GAME_RENDER_SCROLL_AXIS_Y      // Scan lines are display rows (portrait ST7789)
+} game_render_scroll_axis_t;
+
+typedef enum {
+    GAME_RENDER_SCROLL_OK,         // Scroll by `shift`, then draw `rects`
+    GAME_RENDER_SCROLL_FIRST,      // No previous frame on the panel
+    GAME_RENDER_SCROLL_WRONG_AXIS, // The field moved across the scan lines
+    GAME_RENDER_SCROLL_UNEVEN,     // Pillars moved by different amounts
+    GAME_RENDER_SCROLL_TOO_FAR     // The whole screen would be exposed anyway
+} game_render_scroll_result_t;
+
+typedef struct {
+    game_render_scroll_result_t result;
+    int shift;                     // Pixels the field moved left; the panel scrolls by as much
+    int rect_count;                // Regions to redraw: exposed strip, pillars that came or
+                                   // went, old and new penguin, old and new label
+    display_rect_t rects[GAME_RENDER_SCROLL_MAX_RECTS];
+} game_render_scroll_plan_t;
+
+// Compares the world and label drawn last frame with the ones to draw.
+// `previous` may be NULL for the first frame, either label NULL for none.
+// Returns true when the plan can scroll.
+bool game_render_scroll_plan(game_render_scroll_plan_t* plan, const game_world_t* previous,
+                             const display_text_t* previous_label, const game_world_t* current,
+                             const display_text_t* current_label, game_render_scroll_axis_t axis);
+// Pixels the plan sends to the panel: the redrawn regions, or the whole screen
+uint32_t game_render_scroll_plan_pixels(const game_render_scroll_plan_t* plan);
+// Draws the plan's regions of the current scene, or all of it for a fallback,
+// then the label if there is one. Scrolling the panel itself is left to the
+// caller.
+void game_render_scroll_draw(game_render_list_t* list, display_context_t* display, const game_render_scroll_plan_t* plan,
+                             const game_world_t* current, const display_text_t* label, uint16_t background);
+
+#ifdef __cplusplus
+}
+#endif
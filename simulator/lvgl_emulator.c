@@ -0,0 +1,559 @@
+#include "lvgl_emulator.h"
+#include "lvgl.h"
+#include "display_driver.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Heap charged per allocation, LVGL 8 with LV_MEM_CUSTOM 0 on a 32-bit target
+#define MEM_HEADER_BYTES 8         // TLSF block header
+#define OBJ_BYTES 40               // lv_obj_t
+#define LABEL_BYTES 76             // lv_label_t
+#define SPEC_ATTR_BYTES 32         // _lv_obj_spec_attr_t of an object with children
+#define CHILD_BYTES 4              // Per entry of the children array
+#define LOCAL_STYLE_BYTES 16       // _lv_obj_style_t and lv_style_t of the first local property
+#define STYLE_PROP_BYTES 8         // Per local property: value and id
+#define MIN_BLOCK_BYTES 16
+
+// Label size when the font is Montserrat 14
+#define GLYPH_WIDTH 8
+#define LINE_HEIGHT 16
+
+// Local style properties
+#define PROP_X            (1u << 0)
+#define PROP_Y            (1u << 1)
+#define PROP_WIDTH        (1u << 2)
+#define PROP_HEIGHT       (1u << 3)
+#define PROP_BG_COLOR     (1u << 4)
+#define PROP_BG_OPA       (1u << 5)
+#define PROP_BORDER_WIDTH (1u << 6)
+#define PROP_RADIUS       (1u << 7)
+#define PROP_PAD_TOP      (1u << 8)
+#define PROP_PAD_BOTTOM   (1u << 9)
+#define PROP_PAD_LEFT     (1u << 10)
+#define PROP_PAD_RIGHT    (1u << 11)
+#define PROP_TEXT_COLOR   (1u << 12)
+
+struct _lv_obj_t {
+    lv_obj_t *parent;
+    lv_obj_t **children;
+    uint32_t child_cnt;
+    lv_coord_t x;
+    lv_coord_t y;
+    lv_coord_t w;
+    lv_coord_t h;
+    uint32_t flags;
+    lv_color_t bg_color;
+    lv_opa_t bg_opa;
+    lv_color_t text_color;
+    uint32_t props;                // Local properties set
+    bool label;
+    char *text;                    // Labels only
+    uint32_t style_bytes;          // Heap charged for local properties
+    uint32_t text_bytes;
+};
+
+typedef struct {
+    lv_coord_t x1;
+    lv_coord_t y1;
+    lv_coord_t x2;                 // Inclusive, as lv_area_t
+    lv_coord_t y2;
+} area_t;
+
+struct _lv_disp_t {
+    lv_disp_drv_t *driver;
+};
+
+// Part of a draw buffer being rendered: `pixels` hold `area` row after row
+typedef struct {
+    lv_color_t *pixels;
+    area_t area;
+} render_target_t;
+
+typedef struct {
+    lvgl_emulator_stats_t stats;
+    lv_obj_t *screen;
+    lv_disp_t *display;            // NULL until a driver is registered
+    uint32_t mem_used;
+    uint32_t mem_max_used;
+    uint32_t mem_blocks;
+    area_t inv_areas[LV_INV_BUF_SIZE];
+    int inv_count;
+} lvgl_emulator_t;
+
+static lvgl_emulator_t lvgl;
+static lv_disp_t display;
+static bool (*flush_wait)(void) = NULL;
+
+static uint32_t block_bytes(uint32_t size) {
+    uint32_t bytes = ((size + 3) & ~3u) + MEM_HEADER_BYTES;
+    return bytes < MIN_BLOCK_BYTES ? MIN_BLOCK_BYTES : bytes;
+}
+
+// Charges a resize of one heap block from `old_size` to `new_size` bytes, 0
+// meaning no block. False, with nothing charged, if the heap has no room.
+static bool mem_resize(uint32_t old_size, uint32_t new_size) {
+    uint32_t old_bytes = old_size ? block_bytes(old_size) : 0;
+    uint32_t new_bytes = new_size ? block_bytes(new_size) : 0;
+    if (lvgl.mem_used - old_bytes + new_bytes > LV_MEM_SIZE) {
+        return false;
+    }
+    lvgl.mem_used = lvgl.mem_used - old_bytes + new_bytes;
+    if (lvgl.mem_used > lvgl.mem_max_used) lvgl.mem_max_used = lvgl.mem_used;
+    if (!old_size && new_size) lvgl.mem_blocks++;
+    if (old_size && !new_size) lvgl.mem_blocks--;
+    return true;
+}
+
+static area_t obj_area(const lv_obj_t *obj) {
+    area_t area = {obj->x, obj->y, (lv_coord_t)(obj->x + obj->w - 1), (lv_coord_t)(obj->y + obj->h - 1)};
+    for (const lv_obj_t *parent = obj->parent; parent; parent = parent->parent) {
+        area.x1 += parent->x;
+        area.x2 += parent->x;
+        area.y1 += parent->y;
+        area.y2 += parent->y;
+    }
+    return area;
+}
+
+static bool intersect(area_t *out, const area_t *a, const area_t *b) {
+    out->x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    out->y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    out->x2 = a->x2 < b->x2 ? a->x2 : b->x2;
+    out->y2 = a->y2 < b->y2 ? a->y2 : b->y2;
+    return out->x1 <= out->x2 && out->y1 <= out->y2;
+}
+
+static bool is_visible(const lv_obj_t *obj) {
+    for (; obj; obj = obj->parent) {
+        if (obj->flags & LV_OBJ_FLAG_HIDDEN) return false;
+    }
+    return true;
+}
+
+// lv_inv_area(): areas inside one already listed are skipped, and a full list
+// becomes the whole screen
+static void invalidate_area(area_t area) {
+    area_t screen = {0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1};
+    if (!intersect(&area, &area, &screen)) return;
+    for (int i = 0; i < lvgl.inv_count; i++) {
+        const area_t *listed = &lvgl.inv_areas[i];
+        if (area.x1 >= listed->x1 && area.y1 >= listed->y1 && area.x2 <= listed->x2 && area.y2 <= listed->y2) {
+            return;
+        }
+    }
+    if (lvgl.inv_count == LV_INV_BUF_SIZE) {
+        lvgl.inv_count = 0;
+        area = screen;
+    }
+    lvgl.inv_areas[lvgl.inv_count++] = area;
+    lvgl.stats.invalidations++;
+}
+
+void lv_obj_invalidate(const lv_obj_t *obj) {
+    if (!obj || !is_visible(obj)) return;
+    invalidate_area(obj_area(obj));
+}
+
+// Sets a local style property. Like lv_obj_set_local_style_prop(), setting
+// one redraws the object whether or not the value changed.
+static bool set_prop(lv_obj_t *obj, uint32_t prop, bool redraw) {
+    lvgl.stats.property_writes++;
+    if (!(obj->props & prop)) {
+        uint32_t count = 0;
+        for (uint32_t p = obj->props; p; p &= p - 1) count++;
+        uint32_t old_size = count ? LOCAL_STYLE_BYTES + count * STYLE_PROP_BYTES : 0;
+        uint32_t new_size = LOCAL_STYLE_BYTES + (count + 1) * STYLE_PROP_BYTES;
+        if (!mem_resize(old_size, new_size)) return false;
+        obj->props |= prop;
+        obj->style_bytes = new_size;
+    }
+    if (redraw) lv_obj_invalidate(obj);
+    return true;
+}
+
+static bool add_child(lv_obj_t *parent, lv_obj_t *child) {
+    uint32_t old_size = parent->child_cnt ? SPEC_ATTR_BYTES + parent->child_cnt * CHILD_BYTES : 0;
+    if (!mem_resize(old_size, SPEC_ATTR_BYTES + (parent->child_cnt + 1) * CHILD_BYTES)) return false;
+    lv_obj_t **children = realloc(parent->children, (parent->child_cnt + 1) * sizeof(lv_obj_t *));
+    if (!children) abort();
+    children[parent->child_cnt++] = child;
+    parent->children = children;
+    return true;
+}
+
+static void remove_child(lv_obj_t *parent, lv_obj_t *child) {
+    for (uint32_t i = 0; i < parent->child_cnt; i++) {
+        if (parent->children[i] != child) continue;
+        memmove(&parent->children[i], &parent->children[i + 1], (parent->child_cnt - i - 1) * sizeof(lv_obj_t *));
+        uint32_t old_size = SPEC_ATTR_BYTES + parent->child_cnt * CHILD_BYTES;
+        parent->child_cnt--;
+        mem_resize(old_size, parent->child_cnt ? SPEC_ATTR_BYTES + parent->child_cnt * CHILD_BYTES : 0);
+        return;
+    }
+}
+
+static lv_obj_t *create(lv_obj_t *parent, bool label) {
+    uint32_t size = label ? LABEL_BYTES : OBJ_BYTES;
+    if (!mem_resize(0, size)) {
+        lvgl.stats.failed++;
+        return NULL;
+    }
+    lv_obj_t *obj = calloc(1, sizeof(lv_obj_t));
+    if (!obj) abort();
+    obj->parent = parent;
+    obj->label = label;
+    obj->bg_opa = label ? LV_OPA_TRANSP : LV_OPA_COVER;
+    obj->flags = label ? 0 : LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE;
+    if (parent && !add_child(parent, obj)) {
+        mem_resize(size, 0);
+        free(obj);
+        lvgl.stats.failed++;
+        return NULL;
+    }
+    // New objects start at the parent's corner, 100x50 (labels: their text)
+    obj->w = 100;
+    obj->h = 50;
+    lvgl.stats.objects++;
+    lvgl.stats.created++;
+    if (label) {
+        lv_label_set_text(obj, "Text");
+        if (!obj->text) {
+            lv_obj_del(obj);
+            lvgl.stats.failed++;
+            return NULL;
+        }
+    } else {
+        lv_obj_invalidate(obj);
+    }
+    return obj;
+}
+
+static void destroy(lv_obj_t *obj) {
+    while (obj->child_cnt) {
+        lv_obj_t *child = obj->children[obj->child_cnt - 1];
+        destroy(child);
+    }
+    if (obj->parent) remove_child(obj->parent, obj);
+    mem_resize(obj->label ? LABEL_BYTES : OBJ_BYTES, 0);
+    if (obj->style_bytes) mem_resize(obj->style_bytes, 0);
+    if (obj->text_bytes) mem_resize(obj->text_bytes, 0);
+    free(obj->children);
+    free(obj->text);
+    free(obj);
+    lvgl.stats.objects--;
+}
+
+void lv_init(void) {
+    if (lvgl.screen) destroy(lvgl.screen);
+    memset(&lvgl, 0, sizeof(lvgl));
+    lvgl.screen = create(NULL, false);
+    lvgl.screen->w = DISPLAY_WIDTH;
+    lvgl.screen->h = DISPLAY_HEIGHT;
+    lvgl.screen->flags = 0;
+    lvgl.inv_count = 0;
+    lv_obj_invalidate(lvgl.screen);
+}
+
+lv_obj_t *lv_scr_act(void) {
+    return lvgl.screen;
+}
+
+// lv_refr_obj(): hidden objects and those outside the area are skipped with
+// their children; the rest draw their background or text clipped to the area.
+// Backgrounds are rendered into `target` when there is one.
+static void refresh_obj(const lv_obj_t *obj, const area_t *clip, const render_target_t *target) {
+    lvgl.stats.objects_walked++;
+    if (obj->flags & LV_OBJ_FLAG_HIDDEN) return;
+    area_t area = obj_area(obj);
+    area_t drawn;
+    if (!intersect(&drawn, &area, clip)) return;
+    if (obj->bg_opa != LV_OPA_TRANSP || (obj->label && obj->text[0])) {
+        lvgl.stats.pixels_drawn += (uint64_t)(drawn.x2 - drawn.x1 + 1) * (drawn.y2 - drawn.y1 + 1);
+    }
+    if (target && !obj->label && obj->bg_opa != LV_OPA_TRANSP) {
+        int stride = target->area.x2 - target->area.x1 + 1;
+        for (int y = drawn.y1; y <= drawn.y2; y++) {
+            lv_color_t *row = target->pixels + (y - target->area.y1) * stride;
+            for (int x = drawn.x1; x <= drawn.x2; x++) {
+                row[x - target->area.x1] = obj->bg_color;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < obj->child_cnt; i++) {
+        refresh_obj(obj->children[i], &drawn, target);
+    }
+}
+
+static uint32_t area_size(const area_t *area) {
+    return (uint32_t)(area->x2 - area->x1 + 1) * (uint32_t)(area->y2 - area->y1 + 1);
+}
+
+// lv_refr_join_area(): touching areas are merged when their bounding box is
+// smaller than the two apart
+static void join_areas(bool *joined) {
+    for (int in = 0; in < lvgl.inv_count; in++) {
+        if (joined[in]) continue;
+        for (int from = 0; from < lvgl.inv_count; from++) {
+            if (from == in || joined[from]) continue;
+            area_t *a = &lvgl.inv_areas[in];
+            const area_t *b = &lvgl.inv_areas[from];
+            if (a->x1 > b->x2 + 1 || b->x1 > a->x2 + 1 || a->y1 > b->y2 + 1 || b->y1 > a->y2 + 1) continue;
+            area_t merged = {a->x1 < b->x1 ? a->x1 : b->x1, a->y1 < b->y1 ? a->y1 : b->y1,
+                             a->x2 > b->x2 ? a->x2 : b->x2, a->y2 > b->y2 ? a->y2 : b->y2};
+            if (area_size(&merged) < area_size(a) + area_size(b)) {
+                *a = merged;
+                joined[from] = true;
+            }
+        }
+    }
+}
+
+// Until the buffer's flush is done, or the wait hook gives up on it
+static void wait_flush(lv_disp_draw_buf_t *draw_buf) {
+    while (draw_buf->flushing) {
+        if (!flush_wait || !flush_wait()) {
+            lvgl.stats.flush_stalls++;
+            draw_buf->flushing = 0;
+            return;
+        }
+    }
+}
+
+// lv_refr_area(): the area is rendered in parts of as many rows as the draw
+// buffer holds. With two buffers the next part is rendered while the last is
+// flushed, and only its flush waits.
+static void refresh_area(const area_t *area) {
+    lv_disp_drv_t *driver = lvgl.display ? lvgl.display->driver : NULL;
+    if (!driver || !driver->draw_buf || !driver->draw_buf->buf1 || !driver->flush_cb) {
+        refresh_obj(lvgl.screen, area, NULL);
+        return;
+    }
+    
+    lv_disp_draw_buf_t *draw_buf = driver->draw_buf;
+    int width = area->x2 - area->x1 + 1;
+    int rows = (int)draw_buf->size / width;
+    if (rows < 1) rows = 1;
+    for (int y = area->y1; y <= area->y2; y += rows) {
+        int last = (y + rows - 1 < area->y2) ? y + rows - 1 : area->y2;
+        area_t part = {area->x1, (lv_coord_t)y, area->x2, (lv_coord_t)last};
+        if (!draw_buf->buf2) wait_flush(draw_buf);
+        render_target_t target = {(lv_color_t *)draw_buf->buf_act, part};
+        refresh_obj(lvgl.screen, &part, &target);
+        
+        wait_flush(draw_buf);
+        draw_buf->flushing = 1;
+        lvgl.stats.flushes++;
+        lvgl.stats.flushed_pixels += area_size(&part);
+        lv_area_t flushed = {part.x1, part.y1, part.x2, part.y2};
+        driver->flush_cb(driver, &flushed, target.pixels);
+        if (draw_buf->buf2) {
+            draw_buf->buf_act = (draw_buf->buf_act == draw_buf->buf1) ? draw_buf->buf2 : draw_buf->buf1;
+        }
+    }
+}
+
+uint32_t lv_timer_handler(void) {
+    if (lvgl.inv_count && lvgl.screen) {
+        bool joined[LV_INV_BUF_SIZE] = {false};
+        join_areas(joined);
+        for (int i = 0; i < lvgl.inv_count; i++) {
+            if (!joined[i]) refresh_area(&lvgl.inv_areas[i]);
+        }
+        lvgl.stats.refreshes++;
+    }
+    lvgl.inv_count = 0;
+    return 1;
+}
+
+void lv_disp_draw_buf_init(lv_disp_draw_buf_t *draw_buf, void *buf1, void *buf2, uint32_t size_in_px_cnt) {
+    if (!draw_buf) return;
+    memset(draw_buf, 0, sizeof(*draw_buf));
+    draw_buf->buf1 = buf1;
+    draw_buf->buf2 = buf2;
+    draw_buf->buf_act = buf1;
+    draw_buf->size = size_in_px_cnt;
+}
+
+void lv_disp_drv_init(lv_disp_drv_t *driver) {
+    if (!driver) return;
+    memset(driver, 0, sizeof(*driver));
+}
+
+lv_disp_t *lv_disp_drv_register(lv_disp_drv_t *driver) {
+    if (!driver) return NULL;
+    display.driver = driver;
+    lvgl.display = &display;
+    if (lvgl.screen) lv_obj_invalidate(lvgl.screen);
+    return lvgl.display;
+}
+
+void lv_disp_flush_ready(lv_disp_drv_t *disp_drv) {
+    if (disp_drv && disp_drv->draw_buf) disp_drv->draw_buf->flushing = 0;
+}
+
+void lv_mem_monitor(lv_mem_monitor_t *mon) {
+    if (!mon) return;
+    memset(mon, 0, sizeof(*mon));
+    mon->total_size = LV_MEM_SIZE;
+    mon->free_size = LV_MEM_SIZE - lvgl.mem_used;
+    mon->free_biggest_size = mon->free_size;
+    mon->free_cnt = 1;
+    mon->used_cnt = lvgl.mem_blocks;
+    mon->max_used = lvgl.mem_max_used;
+    mon->used_pct = (uint8_t)(100 * lvgl.mem_used / LV_MEM_SIZE);
+}
+
+void lvgl_emulator_get_stats(lvgl_emulator_stats_t *stats) {
+    if (!stats) return;
+    *stats = lvgl.stats;
+}
+
+void lvgl_emulator_clear_stats(void) {
+    uint32_t objects = lvgl.stats.objects;
+    memset(&lvgl.stats, 0, sizeof(lvgl.stats));
+    lvgl.stats.objects = objects;
+}
+
+void lvgl_emulator_set_flush_wait(bool (*wait)(void)) {
+    flush_wait = wait;
+}
+
+lv_obj_t *lv_obj_create(lv_obj_t *parent) {
+    return create(parent, false);
+}
+
+void lv_obj_del(lv_obj_t *obj) {
+    if (!obj) return;
+    lv_obj_invalidate(obj);
+    if (obj == lvgl.screen) lvgl.screen = NULL;
+    destroy(obj);
+}
+
+uint32_t lv_obj_get_child_cnt(const lv_obj_t *obj) {
+    return obj ? obj->child_cnt : 0;
+}
+
+// Position and size are local style properties too, but only moving or
+// resizing the object redraws it
+void lv_obj_set_pos(lv_obj_t *obj, lv_coord_t x, lv_coord_t y) {
+    if (!obj || !set_prop(obj, PROP_X, false) || !set_prop(obj, PROP_Y, false)) return;
+    if (obj->x == x && obj->y == y) return;
+    lv_obj_invalidate(obj);
+    obj->x = x;
+    obj->y = y;
+    lv_obj_invalidate(obj);
+}
+
+void lv_obj_set_size(lv_obj_t *obj, lv_coord_t w, lv_coord_t h) {
+    if (!obj || !set_prop(obj, PROP_WIDTH, false) || !set_prop(obj, PROP_HEIGHT, false)) return;
+    if (obj->w == w && obj->h == h) return;
+    lv_obj_invalidate(obj);
+    obj->w = w;
+    obj->h = h;
+    lv_obj_invalidate(obj);
+}
+
+lv_coord_t lv_obj_get_x(const lv_obj_t *obj) {
+    return obj ? obj->x : 0;
+}
+
+lv_coord_t lv_obj_get_y(const lv_obj_t *obj) {
+    return obj ? obj->y : 0;
+}
+
+lv_coord_t lv_obj_get_width(const lv_obj_t *obj) {
+    return obj ? obj->w : 0;
+}
+
+lv_coord_t lv_obj_get_height(const lv_obj_t *obj) {
+    return obj ? obj->h : 0;
+}
+
+void lv_obj_add_flag(lv_obj_t *obj, lv_obj_flag_t f) {
+    if (!obj) return;
+    lvgl.stats.property_writes++;
+    if ((f & LV_OBJ_FLAG_HIDDEN) && !(obj->flags & LV_OBJ_FLAG_HIDDEN)) lv_obj_invalidate(obj);
+    obj->flags |= f;
+}
+
+void lv_obj_clear_flag(lv_obj_t *obj, lv_obj_flag_t f) {
+    if (!obj) return;
+    lvgl.stats.property_writes++;
+    bool shown = (f & LV_OBJ_FLAG_HIDDEN) && (obj->flags & LV_OBJ_FLAG_HIDDEN);
+    obj->flags &= ~(uint32_t)f;
+    if (shown) lv_obj_invalidate(obj);
+}
+
+bool lv_obj_has_flag(const lv_obj_t *obj, lv_obj_flag_t f) {
+    return obj && (obj->flags & f) == (uint32_t)f;
+}
+
+void lv_obj_set_style_bg_color(lv_obj_t *obj, lv_color_t value, lv_style_selector_t selector) {
+    (void)selector;
+    if (obj && set_prop(obj, PROP_BG_COLOR, true)) obj->bg_color = value;
+}
+
+void lv_obj_set_style_bg_opa(lv_obj_t *obj, lv_opa_t value, lv_style_selector_t selector) {
+    (void)selector;
+    if (obj && set_prop(obj, PROP_BG_OPA, true)) obj->bg_opa = value;
+}
+
+void lv_obj_set_style_border_width(lv_obj_t *obj, lv_coord_t value, lv_style_selector_t selector) {
+    (void)value;
+    (void)selector;
+    if (obj) set_prop(obj, PROP_BORDER_WIDTH, true);
+}
+
+void lv_obj_set_style_radius(lv_obj_t *obj, lv_coord_t value, lv_style_selector_t selector) {
+    (void)value;
+    (void)selector;
+    if (obj) set_prop(obj, PROP_RADIUS, true);
+}
+
+// Four properties, as in LVGL
+void lv_obj_set_style_pad_all(lv_obj_t *obj, lv_coord_t value, lv_style_selector_t selector) {
+    (void)value;
+    (void)selector;
+    if (!obj) return;
+    set_prop(obj, PROP_PAD_TOP, true);
+    set_prop(obj, PROP_PAD_BOTTOM, true);
+    set_prop(obj, PROP_PAD_LEFT, true);
+    set_prop(obj, PROP_PAD_RIGHT, true);
+}
+
+void lv_obj_set_style_text_color(lv_obj_t *obj, lv_color_t value, lv_style_selector_t selector) {
+    (void)selector;
+    if (obj && set_prop(obj, PROP_TEXT_COLOR, true)) obj->text_color = value;
+}
+
+lv_color_t lv_obj_get_style_bg_color(const lv_obj_t *obj, uint32_t part) {
+    (void)part;
+    lv_color_t none = {0};
+    return obj ? obj->bg_color : none;
+}
+
+lv_obj_t *lv_label_create(lv_obj_t *parent) {
+    return create(parent, true);
+}
+
+// Reallocates the text and sizes the label to it
+void lv_label_set_text(lv_obj_t *obj, const char *text) {
+    if (!obj || !obj->label || !text) return;
+    lvgl.stats.property_writes++;
+    uint32_t size = (uint32_t)strlen(text) + 1;
+    if (!mem_resize(obj->text_bytes, size)) return;
+    char *copy = realloc(obj->text, size);
+    if (!copy) abort();
+    memcpy(copy, text, size);
+    obj->text = copy;
+    obj->text_bytes = size;
+    
+    lv_obj_invalidate(obj);
+    obj->w = (lv_coord_t)((size - 1) * GLYPH_WIDTH);
+    obj->h = LINE_HEIGHT;
+    lv_obj_invalidate(obj);
+}
+
+char *lv_label_get_text(const lv_obj_t *obj) {
+    return (obj && obj->label) ? obj->text : NULL;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host stand-in for LVGL, behind lvgl_shim/lvgl.h. Keeps the object tree in a
+// modeled heap of LV_MEM_SIZE bytes: every object, label, local style
+// property and label text is charged what it takes in LVGL 8 on a 32-bit
+// target, and creation fails once the heap is full. Property changes
+// invalidate the object's old and new area; lv_timer_handler() redraws the
+// invalidated areas the way LVGL's refresh does, walking the whole tree for
+// each and drawing what is visible in it.
+//
+// With a display registered, each area is rendered into the draw buffer in
+// parts of as many rows as it holds and handed to the flush callback, the
+// buffers swapping after each flush. Backgrounds are rendered; label text is
+// not, so a label leaves the pixels under it as they were. Before rendering
+// into a buffer still being flushed the emulator calls the flush wait hook,
+// which stands in for the flush completing on its own, until the flush is
+// done.
+typedef struct {
+    uint32_t objects;                  // Alive, screen included
+    uint64_t created;
+    uint64_t failed;                   // Creations the heap had no room for
+    uint64_t property_writes;          // Position, size, style, flag and text setters
+    uint64_t invalidations;            // Areas added to the invalid list
+    uint64_t refreshes;                // lv_timer_handler() calls with something to redraw
+    uint64_t objects_walked;           // Objects visited by refreshes
+    uint64_t pixels_drawn;             // Object pixels drawn by refreshes
+    uint64_t flushes;                  // flush_cb calls
+    uint64_t flushed_pixels;
+    uint64_t flush_stalls;             // Flushes still pending when the wait hook gave up
+} lvgl_emulator_stats_t;
+
+void lvgl_emulator_get_stats(lvgl_emulator_stats_t *stats);
+// Counters only; `objects` stays
+void lvgl_emulator_clear_stats(void);
+// Called while a flush is pending and its buffer is needed again; returns
+// false when the flush cannot complete. NULL gives up at once.
+void lvgl_emulator_set_flush_wait(bool (*wait)(void));
+
+#ifdef __cplusplus
+}
+#endif
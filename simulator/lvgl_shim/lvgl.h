@@ -0,0 +1,151 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The subset of the LVGL 8 API the LVGL backend (display_driver.c and its
+// object pool) uses, with LVGL's names and signatures, implemented by
+// lvgl_emulator.c. Objects live in a modeled LVGL heap of LV_MEM_SIZE bytes
+// and their changes are refreshed as LVGL would, through the registered
+// display's draw buffers and flush callback, so object count, heap use and
+// refresh work can be measured on the host. lvgl_emulator.h has the
+// measurements.
+
+// As main/lv_conf.h
+#define LV_MEM_SIZE (48U * 1024U)
+#define LV_INV_BUF_SIZE 32
+
+typedef int16_t lv_coord_t;
+typedef uint8_t lv_opa_t;
+typedef uint32_t lv_style_selector_t;
+
+// LV_COLOR_DEPTH 16
+typedef union {
+    struct {
+        uint16_t blue : 5;
+        uint16_t green : 6;
+        uint16_t red : 5;
+    } ch;
+    uint16_t full;
+} lv_color_t;
+
+#define LV_PART_MAIN 0
+#define LV_OPA_TRANSP 0
+#define LV_OPA_COVER 255
+
+typedef enum {
+    LV_OBJ_FLAG_HIDDEN = (1 << 0),
+    LV_OBJ_FLAG_CLICKABLE = (1 << 1),
+    LV_OBJ_FLAG_SCROLLABLE = (1 << 4)
+} lv_obj_flag_t;
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef struct _lv_disp_t lv_disp_t;
+
+// Corners inclusive
+typedef struct {
+    lv_coord_t x1;
+    lv_coord_t y1;
+    lv_coord_t x2;
+    lv_coord_t y2;
+} lv_area_t;
+
+typedef struct {
+    void *buf1;
+    void *buf2;
+    void *buf_act;                     // The one being rendered into
+    uint32_t size;                     // In pixels
+    volatile int flushing;             // Set before flush_cb, cleared by lv_disp_flush_ready()
+} lv_disp_draw_buf_t;
+
+typedef struct _lv_disp_drv_t {
+    lv_coord_t hor_res;
+    lv_coord_t ver_res;
+    lv_disp_draw_buf_t *draw_buf;
+    void (*flush_cb)(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
+    void *user_data;
+} lv_disp_drv_t;
+
+typedef struct {
+    uint32_t total_size;
+    uint32_t free_cnt;
+    uint32_t free_size;
+    uint32_t free_biggest_size;
+    uint32_t used_cnt;
+    uint32_t max_used;
+    uint8_t used_pct;
+    uint8_t frag_pct;
+} lv_mem_monitor_t;
+
+static inline lv_color_t lv_color_make(uint8_t r, uint8_t g, uint8_t b) {
+    lv_color_t color;
+    color.ch.red = r >> 3;
+    color.ch.green = g >> 2;
+    color.ch.blue = b >> 3;
+    return color;
+}
+
+static inline lv_color_t lv_color_hex(uint32_t c) {
+    return lv_color_make((uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+}
+
+static inline lv_coord_t lv_area_get_width(const lv_area_t *area_p) {
+    return (lv_coord_t)(area_p->x2 - area_p->x1 + 1);
+}
+
+static inline lv_coord_t lv_area_get_height(const lv_area_t *area_p) {
+    return (lv_coord_t)(area_p->y2 - area_p->y1 + 1);
+}
+
+static inline uint32_t lv_area_get_size(const lv_area_t *area_p) {
+    return (uint32_t)lv_area_get_width(area_p) * (uint32_t)lv_area_get_height(area_p);
+}
+
+// Deletes every object and empties the heap, then creates the screen.
+// Unregisters the display.
+void lv_init(void);
+lv_obj_t *lv_scr_act(void);
+// Redraws the invalidated areas
+uint32_t lv_timer_handler(void);
+void lv_mem_monitor(lv_mem_monitor_t *mon);
+
+void lv_disp_draw_buf_init(lv_disp_draw_buf_t *draw_buf, void *buf1, void *buf2, uint32_t size_in_px_cnt);
+void lv_disp_drv_init(lv_disp_drv_t *driver);
+// One display: registering another replaces it
+lv_disp_t *lv_disp_drv_register(lv_disp_drv_t *driver);
+void lv_disp_flush_ready(lv_disp_drv_t *disp_drv);
+
+// NULL where LVGL would stop on LV_ASSERT_MALLOC
+lv_obj_t *lv_obj_create(lv_obj_t *parent);
+void lv_obj_del(lv_obj_t *obj);
+void lv_obj_invalidate(const lv_obj_t *obj);
+uint32_t lv_obj_get_child_cnt(const lv_obj_t *obj);
+void lv_obj_set_pos(lv_obj_t *obj, lv_coord_t x, lv_coord_t y);
+void lv_obj_set_size(lv_obj_t *obj, lv_coord_t w, lv_coord_t h);
+lv_coord_t lv_obj_get_x(const lv_obj_t *obj);
+lv_coord_t lv_obj_get_y(const lv_obj_t *obj);
+lv_coord_t lv_obj_get_width(const lv_obj_t *obj);
+lv_coord_t lv_obj_get_height(const lv_obj_t *obj);
+void lv_obj_add_flag(lv_obj_t *obj, lv_obj_flag_t f);
+void lv_obj_clear_flag(lv_obj_t *obj, lv_obj_flag_t f);
+bool lv_obj_has_flag(const lv_obj_t *obj, lv_obj_flag_t f);
+
+void lv_obj_set_style_bg_color(lv_obj_t *obj, lv_color_t value, lv_style_selector_t selector);
+void lv_obj_set_style_bg_opa(lv_obj_t *obj, lv_opa_t value, lv_style_selector_t selector);
+void lv_obj_set_style_border_width(lv_obj_t *obj, lv_coord_t value, lv_style_selector_t selector);
+void lv_obj_set_style_radius(lv_obj_t *obj, lv_coord_t value, lv_style_selector_t selector);
+void lv_obj_set_style_pad_all(lv_obj_t *obj, lv_coord_t value, lv_style_selector_t selector);
+void lv_obj_set_style_text_color(lv_obj_t *obj, lv_color_t value, lv_style_selector_t selector);
+lv_color_t lv_obj_get_style_bg_color(const lv_obj_t *obj, uint32_t part);
+
+lv_obj_t *lv_label_create(lv_obj_t *parent);
+void lv_label_set_text(lv_obj_t *obj, const char *text);
+char *lv_label_get_text(const lv_obj_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
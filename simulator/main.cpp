@@ -1,14 +1,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <SDL2/SDL.h>
+#include <vector>
 
+#include "frame_dump.h"
 
 extern "C" {
 #include "game_engine.h"
 #include "penguin_physics.h"
 #include "ice_pillars.h"
 #include "display_driver.h"
+#include "display_driver_sim.h"
+#include "game_render_sprite.h"
+#include "game_sim.h"
+#include "game_sim_replay.h"
 }
 
 #define WINDOW_WIDTH 540   // 4x scale of 135
@@ -16,6 +23,8 @@ extern "C" {
 #define SCALE_FACTOR 4
 #define TARGET_FPS 60
 #define FRAME_TIME_MS (1000 / TARGET_FPS)
+#define REPLAY_RING_SIZE 4096
+#define UPLOAD_STATS_FRAMES (TARGET_FPS * 10)
 
 typedef struct {
     SDL_Window* window;
@@ -113,18 +122,25 @@ static void handle_events(simulator_context_t* sim_ctx) {
     }
 }
 
+// Zero-copy mode: the display driver draws straight into the locked texture
+static bool lock_texture(void* user, void** pixels, int* pitch) {
+    return SDL_LockTexture((SDL_Texture*)user, NULL, pixels, pitch) == 0;
+}
+
+static void unlock_texture(void* user) {
+    SDL_UnlockTexture((SDL_Texture*)user);
+}
+
 static void render_frame(simulator_context_t* sim_ctx, display_context_t* display_ctx) {
-    void* pixels;
-    int pitch;
-    
-    if (SDL_LockTexture(sim_ctx->texture, NULL, &pixels, &pitch) == 0) {
-        // Copy framebuffer to SDL texture row by row
-        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
-            memcpy((uint8_t*)pixels + y * pitch,
-                   (uint8_t*)display_ctx->front_buffer + y * DISPLAY_WIDTH * sizeof(uint16_t),
-                   DISPLAY_WIDTH * sizeof(uint16_t));
-        }
-        SDL_UnlockTexture(sim_ctx->texture);
+    // Upload only what changed since the last frame; the texture keeps the
+    // rest. In zero-copy mode the frame is already in the texture and there
+    // are no areas.
+    const display_area_t* areas;
+    int area_count = display_driver_sim_get_dirty_areas(display_ctx, &areas);
+    for (int i = 0; i < area_count; i++) {
+        SDL_Rect rect = {areas[i].x, areas[i].y, areas[i].width, areas[i].height};
+        const uint16_t* source = (const uint16_t*)display_ctx->front_buffer + areas[i].y * DISPLAY_WIDTH + areas[i].x;
+        SDL_UpdateTexture(sim_ctx->texture, &rect, source, DISPLAY_WIDTH * sizeof(uint16_t));
     }
     
     // Clear renderer
@@ -138,65 +154,117 @@ static void render_frame(simulator_context_t* sim_ctx, display_context_t* displa
     SDL_RenderPresent(sim_ctx->renderer);
 }
 
-static void draw_game_objects(display_context_t* display_ctx, 
-                             penguin_t* penguin, 
-                             ice_pillars_context_t* pillars_ctx,
-                             game_context_t* game_ctx) {
-    // Clear screen
-    display_driver_clear_screen(display_ctx, COLOR_DARK_BLUE);
-    
-    // Draw pillars
-    for (int i = 0; i < MAX_PILLARS; i++) {
-        ice_pillar_t* pillar = ice_pillars_get_pillar(pillars_ctx, i);
-        // Only draw if pillar is active and has nonzero height
-        if (pillar && pillar->active && pillar->top_height > 0 && pillar->bottom_height > 0) {
-            int pillar_x = (int)pillar->x;
-            
-            // Draw top pillar with border
-            display_driver_draw_rectangle(display_ctx, pillar_x, 0, PILLAR_WIDTH, pillar->top_height, COLOR_ICE_BLUE);
-            display_driver_draw_rectangle(display_ctx, pillar_x, 0, 2, pillar->top_height, COLOR_WHITE);
-            display_driver_draw_rectangle(display_ctx, pillar_x + PILLAR_WIDTH - 2, 0, 2, pillar->top_height, COLOR_WHITE);
-            
-            // Draw bottom pillar with border  
-            display_driver_draw_rectangle(display_ctx, pillar_x, pillar->bottom_y, PILLAR_WIDTH, pillar->bottom_height, COLOR_ICE_BLUE);
-            display_driver_draw_rectangle(display_ctx, pillar_x, pillar->bottom_y, 2, pillar->bottom_height, COLOR_WHITE);
-            display_driver_draw_rectangle(display_ctx, pillar_x + PILLAR_WIDTH - 2, pillar->bottom_y, 2, pillar->bottom_height, COLOR_WHITE);
-        }
+// Input of the game in progress. The ring is drained into `payload` every frame
+// and the whole replay is written to `directory` at game over.
+typedef struct {
+    const char* directory;       // NULL when not recording
+    int games_saved;
+    uint8_t ring[REPLAY_RING_SIZE];
+    game_sim_replay_recorder_t recorder;
+    std::vector<uint8_t> payload;
+} replay_capture_t;
+
+static void replay_capture_start(replay_capture_t* capture, uint32_t seed, ice_pillars_rng_mode_t mode) {
+    game_sim_replay_recorder_init(&capture->recorder, capture->ring, sizeof(capture->ring), seed, mode);
+    capture->payload.clear();
+}
+
+static void replay_capture_drain(replay_capture_t* capture) {
+    uint8_t chunk[256];
+    uint32_t count;
+    while ((count = game_sim_replay_recorder_drain(&capture->recorder, chunk, sizeof(chunk))) > 0) {
+        capture->payload.insert(capture->payload.end(), chunk, chunk + count);
     }
+}
+
+static void replay_capture_save(replay_capture_t* capture, uint32_t final_score) {
+    game_sim_replay_recorder_finish(&capture->recorder, final_score);
+    replay_capture_drain(capture);
+    if (!capture->directory) return;
     
-    // Draw penguin with better appearance
-    int penguin_x = penguin_physics_get_screen_x(penguin);
-    int penguin_y = penguin_physics_get_screen_y(penguin);
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/replay_%04d.pdr", capture->directory, capture->games_saved);
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("Could not write replay %s\n", path);
+        return;
+    }
     
-    // Draw penguin body (black)
-    display_driver_draw_rectangle(display_ctx, penguin_x, penguin_y, PENGUIN_WIDTH, PENGUIN_HEIGHT, COLOR_BLACK);
+    uint8_t header[GAME_SIM_REPLAY_HEADER_SIZE];
+    game_sim_replay_write_header(&capture->recorder.header, header);
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(capture->payload.data(), 1, capture->payload.size(), file);
+    fclose(file);
     
-    // Draw penguin belly (white)
-    display_driver_draw_rectangle(display_ctx, penguin_x + 2, penguin_y + 2, PENGUIN_WIDTH - 4, PENGUIN_HEIGHT - 4, COLOR_WHITE);
+    capture->games_saved++;
+    printf("Saved replay %s (%lu frames, %zu bytes)\n", path,
+           (unsigned long)capture->recorder.header.frame_count, sizeof(header) + capture->payload.size());
+}
+
+static void draw_game_objects(display_context_t* display_ctx, game_render_sprite_cache_t* sprites,
+                              const game_world_t* world) {
+    const game_context_t* game_ctx = &world->game;
     
-    // Draw penguin beak (orange/yellow) - fixed to be inside penguin bounds
-    display_driver_draw_rectangle(display_ctx, penguin_x + PENGUIN_WIDTH - 3, penguin_y + PENGUIN_HEIGHT/2 - 1, 3, 2, COLOR_YELLOW);
+    // Pillars and penguin are blitted from pre-rendered sprites; text is drawn on top
+    game_render_scene_sprites(sprites, display_ctx, world, COLOR_DARK_BLUE);
     
-    // Draw score (simple text representation)
-    char score_text[32];
-    snprintf(score_text, sizeof(score_text), "Score: %lu", (unsigned long)game_ctx->score);
-    display_driver_draw_text(display_ctx, 5, 5, score_text, COLOR_WHITE);
+    // Draw score (simple text representation), formatted again only when it
+    // changes; the driver draws an unchanged label from its text run cache
+    static char score_text[32];
+    static uint32_t shown_score = UINT32_MAX;
+    if (game_ctx->score != shown_score) {
+        snprintf(score_text, sizeof(score_text), "Score: %lu", (unsigned long)game_ctx->score);
+        shown_score = game_ctx->score;
+    }
+    // All of the frame's text goes to the driver as one batch
+    display_text_t texts[3];
+    int text_count = 0;
+    texts[text_count++] = {5, 5, COLOR_WHITE, score_text};
     
     if (game_ctx->state == GAME_STATE_GAME_OVER) {
-        display_driver_draw_text(display_ctx, 30, 100, "GAME OVER", COLOR_RED);
-        display_driver_draw_text(display_ctx, 20, 120, "SPACE to restart", COLOR_WHITE);
+        texts[text_count++] = {30, 100, COLOR_RED, "GAME OVER"};
+        texts[text_count++] = {20, 120, COLOR_WHITE, "SPACE to restart"};
     } else if (game_ctx->state == GAME_STATE_START) {
-        display_driver_draw_text(display_ctx, 20, 100, "DIVING PENGUIN", COLOR_WHITE);
-        display_driver_draw_text(display_ctx, 10, 120, "SPACE to start", COLOR_WHITE);
+        texts[text_count++] = {20, 100, COLOR_WHITE, "DIVING PENGUIN"};
+        texts[text_count++] = {10, 120, COLOR_WHITE, "SPACE to start"};
     }
+    display_driver_draw_texts(display_ctx, texts, text_count);
     
     // Swap buffers
     display_driver_swap_buffers(display_ctx);
 }
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    static replay_capture_t capture;
+    static game_render_sprite_cache_t sprite_cache;
+    static frame_dump dump;
+    bool zero_copy = false;
+    const char* dump_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            capture.directory = argv[++i];
+        } else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dump_path = argv[++i];
+        } else if (strcmp(argv[i], "--zero-copy") == 0) {
+            zero_copy = true;
+        } else {
+            printf("Usage: %s [--record DIR] [--dump PATH] [--zero-copy]\n", argv[0]);
+            printf("  --record DIR   save every finished game as DIR/replay_NNNN.pdr\n");
+            printf("  --dump PATH    write every frame to PATH.y4m, or as PATH/frame_NNNNNN.ppm\n");
+            printf("  --zero-copy    draw straight into the locked SDL texture instead of\n");
+            printf("                 uploading the changed areas of a frame buffer\n");
+            return 1;
+        }
+    }
+    if (dump_path && zero_copy) {
+        // Frames drawn into the texture are gone once it is unlocked
+        printf("--dump needs the driver's own frame buffers and cannot be used with --zero-copy\n");
+        return 1;
+    }
+    if (dump_path && !dump.open(dump_path, frame_dump::format_for(dump_path))) {
+        printf("Could not open frame dump %s\n", dump_path);
+        return 1;
+    }
     
     printf("Starting Penguin Dive Game Simulator...\n");
     printf("Controls: SPACE key or mouse click to dive\n");
@@ -204,9 +272,10 @@ int main(int argc, char* argv[]) {
     
     simulator_context_t sim_ctx = {0};
     display_context_t display_ctx = {0};
-    game_context_t game_ctx;
-    penguin_t penguin = {0};
-    ice_pillars_context_t pillars_ctx = {0};
+    game_world_t world = {};
+    game_context_t& game_ctx = world.game;
+    penguin_t& penguin = world.penguin;
+    ice_pillars_context_t& pillars_ctx = world.pillars;
     
     // Initialize SDL
     if (!init_sdl(&sim_ctx)) {
@@ -220,6 +289,18 @@ int main(int argc, char* argv[]) {
         return -1;
     }
     
+    if (zero_copy) {
+        display_target_t target = {lock_texture, unlock_texture, sim_ctx.texture};
+        display_driver_sim_set_target(&display_ctx, &target);
+    } else {
+        display_driver_sim_set_dirty_tracking(&display_ctx, true);
+    }
+    uint64_t frames_drawn = 0;
+    if (!game_render_sprite_cache_init(&sprite_cache, GAME_RENDER_SPRITE_DEFAULT_BUDGET)) {
+        // The empty cache composes every object directly
+        printf("Sprite cache disabled, drawing pillars and penguin directly\n");
+    }
+    
     game_engine_init(&game_ctx);
     penguin_physics_init(&penguin);
     ice_pillars_init(&pillars_ctx);
@@ -238,42 +319,60 @@ int main(int argc, char* argv[]) {
         
         // Update game logic at target framerate
         if (current_time - last_time >= FRAME_TIME_MS) {
-            // Handle state transitions
-            if (game_ctx.state == GAME_STATE_START && sim_ctx.button_pressed) {
-                game_engine_start_game(&game_ctx);
-            } else if (game_ctx.state == GAME_STATE_GAME_OVER && sim_ctx.button_pressed) {
-                game_engine_restart_game(&game_ctx);
-                penguin_physics_init(&penguin);
-                ice_pillars_reset(&pillars_ctx);
+            // Handle state transitions. Every game starts from the default
+            // pillar seed, the same as on the device.
+            if ((game_ctx.state == GAME_STATE_START || game_ctx.state == GAME_STATE_GAME_OVER) &&
+                sim_ctx.button_pressed) {
+                uint32_t high_score = game_ctx.high_score;
+                game_sim_world_init_seeded(&world, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_LCG);
+                game_ctx.high_score = high_score;
+                replay_capture_start(&capture, ICE_PILLARS_DEFAULT_SEED, ICE_PILLARS_RNG_LCG);
             }
             
             if (game_ctx.state == GAME_STATE_PLAYING) {
-                // Update penguin physics
-                penguin_physics_update(&penguin, sim_ctx.button_pressed);
-                
-                // Update pillars
-                ice_pillars_update(&pillars_ctx, game_engine_get_difficulty_multiplier(&game_ctx));
-                
-                // Check for pillar passing
-                int penguin_x = penguin_physics_get_screen_x(&penguin);
-                if (ice_pillars_check_passed(&pillars_ctx, penguin_x)) {
-                    printf("Pillar passed! Score: %lu\n", (unsigned long)game_ctx.score);
-                }
-                
-                // Check for collisions
-                int penguin_y = penguin_physics_get_screen_y(&penguin);
-                if (ice_pillars_check_collision(&pillars_ctx, penguin_x, penguin_y, PENGUIN_WIDTH, PENGUIN_HEIGHT)) {
-                    printf("Collision detected! Final score: %lu\n", (unsigned long)game_ctx.score);
-                    game_engine_end_game(&game_ctx);
+                // Same frame update as the headless simulation, so recordings replay exactly
+                game_sim_replay_recorder_record(&capture.recorder, sim_ctx.button_pressed);
+                if (game_sim_world_step(&world, sim_ctx.button_pressed)) {
+                    replay_capture_drain(&capture);
+                } else {
+                    printf("Game over! Final score: %lu\n", (unsigned long)game_ctx.score);
+                    replay_capture_save(&capture, game_ctx.score);
                 }
-                
-                // Update game engine
-                game_engine_update(&game_ctx);
             }
             
             // Render frame
-            draw_game_objects(&display_ctx, &penguin, &pillars_ctx, &game_ctx);
+            draw_game_objects(&display_ctx, &sprite_cache, &world);
             render_frame(&sim_ctx, &display_ctx);
+            dump.submit((const uint16_t*)display_ctx.front_buffer);
+            
+            display_dirty_stats_t stats;
+            display_driver_sim_get_dirty_stats(&display_ctx, &stats);
+            if (++frames_drawn % UPLOAD_STATS_FRAMES == 0) {
+                if (zero_copy) {
+                    printf("Texture upload: none, frames are drawn into the locked texture\n");
+                } else {
+                    printf("Texture upload: %.1f KB/frame in %.1f areas, %.1f%% of full frames saved (%.1f MB)\n",
+                           stats.dirty_bytes / 1024.0 / stats.frames, (double)stats.areas / stats.frames,
+                           100.0 * (stats.full_bytes - stats.dirty_bytes) / stats.full_bytes,
+                           (stats.full_bytes - stats.dirty_bytes) / (1024.0 * 1024.0));
+                }
+                
+                const game_render_sprite_stats_t* cache = &sprite_cache.stats;
+                printf("Sprite cache: %lu hits, %lu misses, %lu evictions, %lu sprites in %.1f KB (peak %.1f KB)\n",
+                       (unsigned long)cache->hits, (unsigned long)cache->misses, (unsigned long)cache->evictions,
+                       (unsigned long)cache->sprites, cache->bytes / 1024.0, cache->peak_bytes / 1024.0);
+                
+                display_text_stats_t text;
+                display_driver_sim_get_text_stats(&display_ctx, &text);
+                printf("Text runs: %llu hits, %llu misses, %llu uncached\n", (unsigned long long)text.hits,
+                       (unsigned long long)text.misses, (unsigned long long)text.uncached);
+                
+                if (dump.is_open()) {
+                    frame_dump_stats_t dumped = dump.stats();
+                    printf("Frame dump: %llu written, %llu dropped\n", (unsigned long long)dumped.written,
+                           (unsigned long long)dumped.dropped);
+                }
+            }
             
             last_time = current_time;
         }
@@ -283,6 +382,14 @@ int main(int argc, char* argv[]) {
     }
     
     // Cleanup
+    if (dump.is_open()) {
+        dump.close();
+        frame_dump_stats_t dumped = dump.stats();
+        printf("Frame dump: %llu frames written to %s, %llu dropped, %llu failed\n",
+               (unsigned long long)dumped.written, dump_path, (unsigned long long)dumped.dropped,
+               (unsigned long long)dumped.write_errors);
+    }
+    game_render_sprite_cache_deinit(&sprite_cache);
     display_driver_deinit(&display_ctx);
     cleanup_sdl(&sim_ctx);
     
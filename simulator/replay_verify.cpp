@@ -0,0 +1,330 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "game_sim.h"
+#include "game_sim_policy.h"
+#include "game_sim_replay.h"
+}
+
+#include "work_stealing_pool.h"
+
+// Re-simulates submitted replays across every core and reports any whose
+// claimed score does not reproduce. Replays come from files, directories
+// (every *.pdr inside) or stdin ("-"), where any number of replays may be
+// concatenated. --synthetic records autopilot games in memory instead, which
+// is how the throughput is measured without a corpus on disk.
+//
+// The seed and pillar generator are part of the submission, so a replay could
+// pick an easy pillar sequence and still reproduce its score. Loaded replays
+// must therefore use the seed and mode the device plays, or the ones given
+// with --expect-seed and --expect-mode; others are rejected without being
+// simulated.
+
+#define DEFAULT_CHUNK 8
+#define REPLAY_EXTENSION ".pdr"
+#define SYNTHETIC_RING_SIZE (64 * 1024)
+
+typedef struct {
+    unsigned threads;
+    uint64_t chunk;
+    uint64_t synthetic;
+    uint32_t seed;
+    uint32_t expect_seed;
+    ice_pillars_rng_mode_t expect_mode;
+    std::vector<std::string> inputs;
+} verify_options_t;
+
+typedef struct {
+    std::string name;
+    std::vector<uint8_t> data;
+} replay_entry_t;
+
+typedef struct alignas(64) {
+    uint64_t frames;
+} verify_thread_totals_t;
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [options] [PATH | -]...\n", program);
+    printf("  PATH             replay file, or directory of *%s files\n", REPLAY_EXTENSION);
+    printf("  -                read concatenated replays from stdin\n");
+    printf("  --threads N      worker threads, 0 for all cores (default 0)\n");
+    printf("  --chunk N        replays per scheduling chunk (default %d)\n", DEFAULT_CHUNK);
+    printf("  --synthetic N    verify N recorded autopilot games instead of reading replays\n");
+    printf("  --seed N         seed of the first synthetic game (default %d)\n", ICE_PILLARS_DEFAULT_SEED);
+    printf("  --expect-seed N  pillar seed replays must use (default %d, as the device)\n", ICE_PILLARS_DEFAULT_SEED);
+    printf("  --expect-mode M  pillar generator replays must use: lcg or counter (default lcg)\n");
+    printf("Exit status is 0 when every replay verifies, 2 on any mismatch or rejected\n");
+    printf("seed or mode, 1 on errors.\n");
+}
+
+static bool parse_options(int argc, char* argv[], verify_options_t* options) {
+    options->threads = 0;
+    options->chunk = DEFAULT_CHUNK;
+    options->synthetic = 0;
+    options->seed = ICE_PILLARS_DEFAULT_SEED;
+    options->expect_seed = ICE_PILLARS_DEFAULT_SEED;
+    options->expect_mode = ICE_PILLARS_RNG_LCG;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            return false;
+        }
+        if (strncmp(arg, "--", 2) != 0) {
+            options->inputs.push_back(arg);
+            continue;
+        }
+        
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            printf("Missing value for %s\n", arg);
+            return false;
+        }
+        
+        if (strcmp(arg, "--threads") == 0) {
+            options->threads = (unsigned)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--chunk") == 0) {
+            options->chunk = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--synthetic") == 0) {
+            options->synthetic = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options->seed = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--expect-seed") == 0) {
+            options->expect_seed = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--expect-mode") == 0) {
+            if (strcmp(value, "lcg") == 0) {
+                options->expect_mode = ICE_PILLARS_RNG_LCG;
+            } else if (strcmp(value, "counter") == 0) {
+                options->expect_mode = ICE_PILLARS_RNG_COUNTER;
+            } else {
+                printf("Unknown pillar generator: %s\n", value);
+                return false;
+            }
+        } else {
+            printf("Unknown option: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    
+    return options->chunk > 0 && (options->synthetic > 0 || !options->inputs.empty());
+}
+
+static bool read_stream(FILE* file, std::vector<uint8_t>* data) {
+    uint8_t buffer[64 * 1024];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data->insert(data->end(), buffer, buffer + count);
+    }
+    return !ferror(file);
+}
+
+// Splits a stream of back-to-back replays using the payload size in each header.
+// Anything that does not parse becomes one final entry, reported as malformed.
+static void split_replays(const std::string& name, const std::vector<uint8_t>& data,
+                          std::vector<replay_entry_t>* replays) {
+    size_t pos = 0;
+    int index = 0;
+    while (pos < data.size()) {
+        game_sim_replay_header_t header;
+        size_t size = data.size() - pos;
+        if (game_sim_replay_read_header(data.data() + pos, size, &header) &&
+            size - GAME_SIM_REPLAY_HEADER_SIZE >= header.payload_size) {
+            size = GAME_SIM_REPLAY_HEADER_SIZE + header.payload_size;
+        }
+        
+        replay_entry_t entry;
+        entry.name = name + "#" + std::to_string(index++);
+        entry.data.assign(data.begin() + pos, data.begin() + pos + size);
+        replays->push_back(std::move(entry));
+        pos += size;
+    }
+}
+
+static bool load_file(const std::filesystem::path& path, std::vector<replay_entry_t>* replays) {
+    FILE* file = fopen(path.string().c_str(), "rb");
+    if (!file) {
+        printf("Cannot open %s\n", path.string().c_str());
+        return false;
+    }
+    
+    replay_entry_t entry;
+    entry.name = path.string();
+    bool ok = read_stream(file, &entry.data);
+    fclose(file);
+    if (ok) replays->push_back(std::move(entry));
+    return ok;
+}
+
+static bool load_inputs(const std::vector<std::string>& inputs, std::vector<replay_entry_t>* replays) {
+    for (const std::string& input : inputs) {
+        if (input == "-") {
+            std::vector<uint8_t> data;
+            if (!read_stream(stdin, &data)) return false;
+            split_replays("stdin", data, replays);
+            continue;
+        }
+        
+        std::error_code error;
+        if (!std::filesystem::is_directory(input, error)) {
+            if (!load_file(input, replays)) return false;
+            continue;
+        }
+        
+        // Sorted so reports come out in the same order on every run
+        std::vector<std::filesystem::path> paths;
+        for (const auto& item : std::filesystem::directory_iterator(input, error)) {
+            if (item.is_regular_file() && item.path().extension() == REPLAY_EXTENSION) {
+                paths.push_back(item.path());
+            }
+        }
+        if (error) {
+            printf("Cannot list %s: %s\n", input.c_str(), error.message().c_str());
+            return false;
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const std::filesystem::path& path : paths) {
+            if (!load_file(path, replays)) return false;
+        }
+    }
+    return true;
+}
+
+static const char* mode_name(ice_pillars_rng_mode_t mode) {
+    return mode == ICE_PILLARS_RNG_LCG ? "lcg" : "counter";
+}
+
+// True when a replay parses and uses the expected pillar sequence
+static bool accepted(const verify_options_t& options, const std::vector<uint8_t>& data) {
+    game_sim_replay_header_t header;
+    if (!game_sim_replay_read_header(data.data(), data.size(), &header)) return true; // Reported as a mismatch
+    return header.seed == options.expect_seed && header.rng_mode == options.expect_mode;
+}
+
+static void drain_recorder(game_sim_replay_recorder_t* recorder, std::vector<uint8_t>* data) {
+    size_t size = data->size();
+    data->resize(size + game_sim_replay_recorder_pending(recorder));
+    game_sim_replay_recorder_drain(recorder, data->data() + size, (uint32_t)(data->size() - size));
+}
+
+static void record_synthetic(work_stealing_pool& pool, const verify_options_t& options,
+                             std::vector<replay_entry_t>* replays) {
+    replays->resize(options.synthetic);
+    pool.parallel_for(options.synthetic, options.chunk, [&](uint64_t begin, uint64_t end, unsigned) {
+        std::vector<uint8_t> ring(SYNTHETIC_RING_SIZE);
+        for (uint64_t g = begin; g < end; g++) {
+            uint32_t seed = options.seed + (uint32_t)g;
+            game_world_t world;
+            game_sim_replay_recorder_t recorder;
+            game_sim_world_init_seeded(&world, seed, ICE_PILLARS_RNG_COUNTER);
+            game_sim_replay_recorder_init(&recorder, ring.data(), (uint32_t)ring.size(), seed, ICE_PILLARS_RNG_COUNTER);
+            
+            replay_entry_t& entry = (*replays)[g];
+            entry.name = "synthetic#" + std::to_string(g);
+            entry.data.resize(GAME_SIM_REPLAY_HEADER_SIZE);
+            
+            bool running = true;
+            while (running) {
+                bool pressed = game_sim_policy_autopilot(&world, g);
+                game_sim_replay_recorder_record(&recorder, pressed);
+                running = game_sim_world_step(&world, pressed);
+                
+                if (game_sim_replay_recorder_pending(&recorder) > SYNTHETIC_RING_SIZE / 2) {
+                    drain_recorder(&recorder, &entry.data);
+                }
+            }
+            game_sim_replay_recorder_finish(&recorder, world.game.score);
+            
+            drain_recorder(&recorder, &entry.data);
+            game_sim_replay_write_header(&recorder.header, entry.data.data());
+        }
+    });
+}
+
+int main(int argc, char* argv[]) {
+    verify_options_t options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    work_stealing_pool pool(options.threads);
+    unsigned threads = pool.thread_count();
+    
+    std::vector<replay_entry_t> replays;
+    if (options.synthetic > 0) {
+        record_synthetic(pool, options, &replays);
+    } else if (!load_inputs(options.inputs, &replays)) {
+        return 1;
+    }
+    if (replays.empty()) {
+        printf("No replays found\n");
+        return 1;
+    }
+    
+    // Synthetic games are recorded here with seeds of their own choosing
+    std::vector<uint8_t> rejected(replays.size(), 0);
+    if (options.synthetic == 0) {
+        for (size_t r = 0; r < replays.size(); r++) {
+            rejected[r] = !accepted(options, replays[r].data);
+        }
+    }
+    
+    std::vector<game_sim_replay_result_t> results(replays.size());
+    std::vector<verify_thread_totals_t> totals(threads);
+    
+    double wall = pool.parallel_for(replays.size(), options.chunk, [&](uint64_t begin, uint64_t end, unsigned worker) {
+        uint64_t frames = 0;
+        for (uint64_t r = begin; r < end; r++) {
+            if (rejected[r]) continue;
+            game_world_t world;
+            game_sim_replay_play(replays[r].data.data(), replays[r].data.size(), &world, &results[r]);
+            frames += results[r].frames;
+        }
+        totals[worker].frames += frames;
+    });
+    
+    uint64_t frames = 0;
+    for (unsigned w = 0; w < threads; w++) {
+        frames += totals[w].frames;
+    }
+    
+    uint64_t mismatches = 0;
+    uint64_t rejections = 0;
+    for (size_t r = 0; r < replays.size(); r++) {
+        game_sim_replay_header_t header;
+        if (rejected[r]) {
+            rejections++;
+            game_sim_replay_read_header(replays[r].data.data(), replays[r].data.size(), &header);
+            printf("REJECTED %s: seed %lu, %s pillars; expected seed %lu, %s pillars\n", replays[r].name.c_str(),
+                   (unsigned long)header.seed, mode_name(header.rng_mode), (unsigned long)options.expect_seed,
+                   mode_name(options.expect_mode));
+            continue;
+        }
+        if (results[r].matches) continue;
+        mismatches++;
+        
+        
+        if (!game_sim_replay_read_header(replays[r].data.data(), replays[r].data.size(), &header)) {
+            printf("MISMATCH %s: not a replay\n", replays[r].name.c_str());
+            continue;
+        }
+        printf("MISMATCH %s: claims score %lu in %lu frames, simulated score %lu in %lu frames%s\n",
+               replays[r].name.c_str(), (unsigned long)header.final_score, (unsigned long)header.frame_count,
+               (unsigned long)results[r].score, (unsigned long)results[r].frames,
+               results[r].game_over ? "" : " without game over");
+    }
+    
+    printf("Verified %zu replays on %u threads in %.3f s: %.0f frames/s, %.1f frames per replay\n",
+           replays.size(), threads, wall, frames / wall, (double)frames / replays.size());
+    printf("Mismatches: %llu\n", (unsigned long long)mismatches);
+    printf("Rejected: %llu\n", (unsigned long long)rejections);
+    
+    return (mismatches || rejections) ? 2 : 0;
+}
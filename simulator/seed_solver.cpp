@@ -0,0 +1,267 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "game_sim.h"
+#include "game_sim_solver.h"
+}
+
+#include "work_stealing_pool.h"
+
+// Level curation: bounds how long any player could survive each seed by
+// tracking every reachable penguin state against the seed's pillars. Seed i
+// of a run is (seed + i). Seeds whose bound is short cannot be survived for
+// long no matter how they are played.
+//
+// With --witness each seed also gets a lower bound: the longest play the
+// witness search finds, replayed through game_sim_world_step() to check it.
+// Where the two bounds meet, the seed's survival time is known exactly.
+//
+// Upper bounds are solved four seeds at a time and run at about 1200 whole
+// games per second per core with AVX2, about 500 without. The witness search
+// plays every distinct penguin state for real and costs about 0.25 s a game.
+
+#define DEFAULT_SEEDS 10000
+#define DEFAULT_CHUNK 64 // Whole lanes of seeds, with little idle at the end of a chunk
+#define DEFAULT_MAX_FRAMES 36000 // Ten minutes of play at 60 FPS
+
+typedef struct {
+    uint64_t seeds;
+    unsigned threads;
+    uint64_t chunk;
+    uint32_t max_frames;
+    uint32_t seed;
+    int subpixel_bits;
+    ice_pillars_rng_mode_t rng_mode;
+    uint32_t threshold;            // 0: solve whole games up to max_frames
+    bool witness;
+    bool list;
+} solver_options_t;
+
+// Per worker: the grid, and the witness search with room for one game's inputs
+typedef struct {
+    game_sim_solver_t solver;
+    game_sim_solver_witness_t witness;
+    std::vector<uint8_t> inputs;
+} solver_worker_t;
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [options]\n", program);
+    printf("  --seeds N        seeds to solve (default %d)\n", DEFAULT_SEEDS);
+    printf("  --seed N         first seed (default %d)\n", ICE_PILLARS_DEFAULT_SEED);
+    printf("  --rng lcg|counter  pillar generator (default counter)\n");
+    printf("  --threads N      worker threads, 0 for all cores (default 0)\n");
+    printf("  --chunk N        seeds per scheduling chunk (default %d)\n", DEFAULT_CHUNK);
+    printf("  --max-frames N   stop solving a seed after N frames (default %d)\n", DEFAULT_MAX_FRAMES);
+    printf("  --threshold N    curate: stop each seed once its bound reaches N frames and count\n");
+    printf("                   the seeds no play survives that long (replaces --max-frames)\n");
+    printf("  --subpixel N     track y in 1/2^N pixel steps, 0-%d; finer is tighter and slower (default %d)\n",
+           GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS, GAME_SIM_SOLVER_DEFAULT_SUBPIXEL_BITS);
+    printf("  --witness        also find each seed's longest play, a lower bound, and replay it\n");
+    printf("  --list           print the bounds of every seed\n");
+    printf("Whole games run at about 1200 seeds/s per core with AVX2; --witness adds about\n");
+    printf("0.25 s per seed.\n");
+}
+
+static bool parse_options(int argc, char* argv[], solver_options_t* options) {
+    options->seeds = DEFAULT_SEEDS;
+    options->threads = 0;
+    options->chunk = DEFAULT_CHUNK;
+    options->max_frames = DEFAULT_MAX_FRAMES;
+    options->seed = ICE_PILLARS_DEFAULT_SEED;
+    options->subpixel_bits = GAME_SIM_SOLVER_DEFAULT_SUBPIXEL_BITS;
+    options->rng_mode = ICE_PILLARS_RNG_COUNTER;
+    options->threshold = 0;
+    options->witness = false;
+    options->list = false;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            return false;
+        }
+        if (strcmp(arg, "--list") == 0) {
+            options->list = true;
+            continue;
+        }
+        if (strcmp(arg, "--witness") == 0) {
+            options->witness = true;
+            continue;
+        }
+        
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            printf("Missing value for %s\n", arg);
+            return false;
+        }
+        
+        if (strcmp(arg, "--seeds") == 0) {
+            options->seeds = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options->seed = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--threads") == 0) {
+            options->threads = (unsigned)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--chunk") == 0) {
+            options->chunk = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--max-frames") == 0) {
+            options->max_frames = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--threshold") == 0) {
+            options->threshold = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--subpixel") == 0) {
+            options->subpixel_bits = atoi(value);
+        } else if (strcmp(arg, "--rng") == 0) {
+            if (strcmp(value, "lcg") == 0) {
+                options->rng_mode = ICE_PILLARS_RNG_LCG;
+            } else if (strcmp(value, "counter") == 0) {
+                options->rng_mode = ICE_PILLARS_RNG_COUNTER;
+            } else {
+                printf("Unknown generator: %s\n", value);
+                return false;
+            }
+        } else {
+            printf("Unknown option: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    
+    // A seed's bound only matters up to the threshold, so solving stops there
+    if (options->threshold > 0) {
+        options->max_frames = options->threshold;
+    }
+    return options->seeds > 0 && options->chunk > 0 && options->max_frames > 0;
+}
+
+// Plays the inputs on a fresh world and returns the frames survived
+static uint32_t replay_survival(uint32_t seed, ice_pillars_rng_mode_t mode, const uint8_t* inputs, uint32_t count) {
+    game_world_t world;
+    game_sim_world_init_seeded(&world, seed, mode);
+    uint32_t frames = 0;
+    while (frames < count && game_sim_world_step(&world, inputs[frames] != 0)) {
+        frames++;
+    }
+    return frames;
+}
+
+static void print_bound_stats(const char* name, std::vector<uint32_t> sorted) {
+    std::sort(sorted.begin(), sorted.end());
+    uint64_t n = sorted.size();
+    double total = 0.0;
+    for (uint32_t frames : sorted) {
+        total += frames;
+    }
+    printf("%s in frames: min %u  mean %.0f  p10 %u  p50 %u  p90 %u  max %u\n", name, sorted[0], total / n,
+           sorted[n / 10], sorted[n / 2], sorted[n * 9 / 10], sorted[n - 1]);
+}
+
+int main(int argc, char* argv[]) {
+    solver_options_t options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    // Every worker gets its own copy of the grid; building it once is enough
+    game_sim_solver_t prototype;
+    if (!game_sim_solver_init(&prototype, options.subpixel_bits)) {
+        printf("Unsupported subpixel resolution: %d\n", options.subpixel_bits);
+        return 1;
+    }
+    
+    work_stealing_pool pool(options.threads);
+    unsigned threads = pool.thread_count();
+    std::vector<solver_worker_t> workers(threads);
+    for (solver_worker_t& worker : workers) {
+        worker.solver = prototype;
+        if (options.witness) {
+            if (!game_sim_solver_witness_init(&worker.witness, &prototype)) {
+                printf("Out of memory for the witness search\n");
+                return 1;
+            }
+            worker.inputs.resize((size_t)options.max_frames + 1);
+        }
+    }
+    std::vector<uint32_t> bounds(options.seeds);
+    std::vector<uint32_t> lower(options.witness ? options.seeds : 0);
+    std::vector<uint8_t> verified(options.witness ? options.seeds : 0);
+    
+    printf("Solving %llu seeds on %u threads (%s pillars, %d velocity rows of %d cells, frame limit %u%s)\n",
+           (unsigned long long)options.seeds, threads, options.rng_mode == ICE_PILLARS_RNG_LCG ? "lcg" : "counter",
+           prototype.row_count, prototype.cells, options.max_frames, options.witness ? ", with witnesses" : "");
+    
+    double wall = pool.parallel_for(options.seeds, options.chunk, [&](uint64_t begin, uint64_t end, unsigned index) {
+        solver_worker_t* worker = &workers[index];
+        game_sim_solver_max_survival_many(&worker->solver, options.seed + (uint32_t)begin, (uint32_t)(end - begin),
+                                          options.rng_mode, options.max_frames, &bounds[begin]);
+        if (!options.witness) {
+            return;
+        }
+        
+        for (uint64_t s = begin; s < end; s++) {
+            uint32_t seed = options.seed + (uint32_t)s;
+            uint32_t count = 0;
+            lower[s] = game_sim_solver_min_survival(&worker->witness, &worker->solver, seed, options.rng_mode,
+                                                    options.max_frames, worker->inputs.data(), &count);
+            verified[s] = count > 0 &&
+                          replay_survival(seed, options.rng_mode, worker->inputs.data(), count) == lower[s];
+        }
+    });
+    
+    if (options.list) {
+        for (uint64_t s = 0; s < options.seeds; s++) {
+            if (options.witness) {
+                printf("%u %u %u\n", options.seed + (uint32_t)s, lower[s], bounds[s]);
+            } else {
+                printf("%u %u\n", options.seed + (uint32_t)s, bounds[s]);
+            }
+        }
+    }
+    
+    double busy = 0.0;
+    for (unsigned w = 0; w < threads; w++) {
+        busy += pool.stats(w).busy_seconds;
+    }
+    
+    uint64_t n = bounds.size();
+    uint64_t capped = 0;
+    for (uint32_t frames : bounds) {
+        capped += frames >= options.max_frames;
+    }
+    
+    printf("\nWall time %.3f s: %.0f seeds/s, %.0f seeds/s per thread\n", wall, n / wall, busy > 0.0 ? n / busy : 0.0);
+    print_bound_stats("Survival upper bound", bounds);
+    printf("Seeds that may last the whole frame limit: %llu\n", (unsigned long long)capped);
+    if (options.threshold > 0) {
+        printf("Seeds no play survives %u frames: %llu\n", options.threshold, (unsigned long long)(n - capped));
+    }
+    
+    int status = 0;
+    if (options.witness) {
+        uint64_t exact = 0;
+        uint64_t failed = 0;
+        uint64_t invalid = 0;
+        for (uint64_t s = 0; s < n; s++) {
+            exact += lower[s] == bounds[s];
+            failed += !verified[s];
+            invalid += lower[s] > bounds[s];
+        }
+        print_bound_stats("Survival lower bound", lower);
+        printf("Seeds solved exactly: %llu of %llu\n", (unsigned long long)exact, (unsigned long long)n);
+        
+        // A replay that disagrees, or a play longer than the upper bound,
+        // means the search and the game have drifted apart
+        if (failed > 0 || invalid > 0) {
+            printf("Witnesses that failed to replay: %llu, exceeding the upper bound: %llu\n",
+                   (unsigned long long)failed, (unsigned long long)invalid);
+            status = 1;
+        }
+    }
+    
+    for (solver_worker_t& worker : workers) {
+        game_sim_solver_witness_deinit(&worker.witness);
+    }
+    return status;
+}
@@ -0,0 +1,465 @@
+#include "st7789_emulator.h"
+#include "display_driver.h"
+#include "display_st7789.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "esp_rom_gpio.h"
+#include "freertos/task.h"
+#include <string.h>
+
+// Power-on values from the ST7789V datasheet
+#define RESET_COLMOD 0x66
+#define PANEL_ID1 0x85
+
+// Queued and not yet collected transactions the emulator can hold
+#define MAX_QUEUED 16
+
+typedef struct {
+    spi_transaction_t *trans;
+    uint64_t end_ns;
+    uint64_t bus_ns;
+    bool completed;
+} queued_trans_t;
+
+struct spi_device_t {
+    spi_device_interface_config_t config;
+};
+
+typedef struct {
+    st7789_emulator_config_t config;
+    st7789_emulator_stats_t stats;
+    st7789_emulator_panel_t panel;
+    
+    bool bus_initialized;
+    int max_transfer_bytes;
+    bool device_added;
+    struct spi_device_t device;
+    
+    uint32_t dc_level;
+    uint32_t rst_level;
+    
+    uint64_t now_ns;                   // Modeled time of the caller
+    uint64_t bus_free_ns;              // When the bus finishes what is queued
+    queued_trans_t queue[MAX_QUEUED];
+    int queue_head;
+    int queue_count;
+    
+    uint8_t command;                   // Last command; its parameters follow
+    int param_count;
+    uint8_t params[4];
+    bool writing_memory;
+    uint16_t column;                   // GRAM write position
+    uint16_t row;
+    int partial_count;                 // Bytes of a pixel split across transactions
+    uint8_t partial[3];
+    
+    uint16_t gram[ST7789_EMULATOR_GRAM_WIDTH * ST7789_EMULATOR_GRAM_HEIGHT];
+} st7789_emulator_t;
+
+static st7789_emulator_t emulator;
+
+static void panel_reset(void) {
+    st7789_emulator_panel_t *panel = &emulator.panel;
+    panel->sleeping = true;
+    panel->display_on = false;
+    panel->inverted = false;
+    panel->colmod = RESET_COLMOD;
+    panel->madctl = 0;
+    panel->x_start = 0;
+    panel->x_end = ST7789_EMULATOR_GRAM_WIDTH - 1;
+    panel->y_start = 0;
+    panel->y_end = ST7789_EMULATOR_GRAM_HEIGHT - 1;
+    panel->resets++;
+    emulator.writing_memory = false;
+    emulator.partial_count = 0;
+}
+
+void st7789_emulator_reset(const st7789_emulator_config_t *config) {
+    memset(&emulator, 0, sizeof(emulator));
+    if (config) emulator.config = *config;
+    emulator.dc_level = 1;
+    emulator.rst_level = 1;
+    panel_reset();
+    emulator.panel.resets = 0;
+}
+
+void st7789_emulator_clear_stats(void) {
+    memset(&emulator.stats, 0, sizeof(emulator.stats));
+}
+
+void st7789_emulator_get_stats(st7789_emulator_stats_t *stats) {
+    if (stats) *stats = emulator.stats;
+}
+
+void st7789_emulator_get_panel(st7789_emulator_panel_t *panel) {
+    if (panel) *panel = emulator.panel;
+}
+
+uint64_t st7789_emulator_now_ns(void) {
+    return emulator.now_ns;
+}
+
+uint16_t st7789_emulator_gram_pixel(int x, int y) {
+    if (x < 0 || x >= ST7789_EMULATOR_GRAM_WIDTH || y < 0 || y >= ST7789_EMULATOR_GRAM_HEIGHT) return 0;
+    return emulator.gram[y * ST7789_EMULATOR_GRAM_WIDTH + x];
+}
+
+// Stores a pixel at the write position and advances it through the window,
+// wrapping to the top when it runs off the bottom
+static void store_pixel(uint16_t color) {
+    st7789_emulator_panel_t *panel = &emulator.panel;
+    if (emulator.column < ST7789_EMULATOR_GRAM_WIDTH && emulator.row < ST7789_EMULATOR_GRAM_HEIGHT) {
+        emulator.gram[emulator.row * ST7789_EMULATOR_GRAM_WIDTH + emulator.column] = color;
+        emulator.stats.pixels++;
+    }
+    
+    if (emulator.column < panel->x_end) {
+        emulator.column++;
+        return;
+    }
+    emulator.column = panel->x_start;
+    emulator.row = (emulator.row < panel->y_end) ? emulator.row + 1 : panel->y_start;
+}
+
+static void write_memory(const uint8_t *data, size_t len) {
+    // 16-bit pixels are RGB565 high byte first; 18-bit ones are three bytes
+    // with six significant bits each. Other formats are not decoded.
+    int pixel_bytes = ((emulator.panel.colmod & 0x07) == 0x05) ? 2 : 3;
+    for (size_t i = 0; i < len; i++) {
+        emulator.partial[emulator.partial_count++] = data[i];
+        if (emulator.partial_count < pixel_bytes) continue;
+        
+        emulator.partial_count = 0;
+        const uint8_t *p = emulator.partial;
+        if (pixel_bytes == 2) {
+            store_pixel((uint16_t)((p[0] << 8) | p[1]));
+        } else {
+            store_pixel((uint16_t)(((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3)));
+        }
+    }
+}
+
+static void begin_command(uint8_t command) {
+    st7789_emulator_panel_t *panel = &emulator.panel;
+    emulator.command = command;
+    emulator.param_count = 0;
+    emulator.writing_memory = false;
+    emulator.partial_count = 0;
+    
+    switch (command) {
+        case ST7789_SWRESET:
+            panel_reset();
+            break;
+        case ST7789_SLPIN:
+            panel->sleeping = true;
+            break;
+        case ST7789_SLPOUT:
+            panel->sleeping = false;
+            break;
+        case ST7789_INVOFF:
+            panel->inverted = false;
+            break;
+        case ST7789_INVON:
+            panel->inverted = true;
+            break;
+        case ST7789_DISPOFF:
+            panel->display_on = false;
+            break;
+        case ST7789_DISPON:
+            panel->display_on = true;
+            break;
+        case ST7789_RAMWR:
+            emulator.column = panel->x_start;
+            emulator.row = panel->y_start;
+            emulator.writing_memory = true;
+            break;
+        case ST7789_RAMWRC:
+            emulator.writing_memory = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static void command_parameter(uint8_t value) {
+    st7789_emulator_panel_t *panel = &emulator.panel;
+    if (emulator.param_count < (int)sizeof(emulator.params)) emulator.params[emulator.param_count] = value;
+    emulator.param_count++;
+    
+    const uint8_t *p = emulator.params;
+    switch (emulator.command) {
+        case ST7789_CASET:
+            if (emulator.param_count == 4) {
+                panel->x_start = (uint16_t)((p[0] << 8) | p[1]);
+                panel->x_end = (uint16_t)((p[2] << 8) | p[3]);
+            }
+            break;
+        case ST7789_RASET:
+            if (emulator.param_count == 4) {
+                panel->y_start = (uint16_t)((p[0] << 8) | p[1]);
+                panel->y_end = (uint16_t)((p[2] << 8) | p[3]);
+            }
+            break;
+        case ST7789_MADCTL:
+            if (emulator.param_count == 1) panel->madctl = value;
+            break;
+        case ST7789_COLMOD:
+            if (emulator.param_count == 1) panel->colmod = value;
+            break;
+        default:
+            break;
+    }
+}
+
+// First byte of the answer to a read command
+static uint8_t read_response(void) {
+    const st7789_emulator_panel_t *panel = &emulator.panel;
+    switch (emulator.command) {
+        case ST7789_RDDID:
+            return PANEL_ID1;
+        case ST7789_RDDST:
+            return (uint8_t)(0x80 | (panel->madctl & 0x70));
+        case ST7789_RDDPM:
+            return (uint8_t)(0x08 | (panel->sleeping ? 0 : 0x10) | (panel->display_on ? 0x04 : 0) | 0x80);
+        case ST7789_RDDCOLMOD:
+            return (uint8_t)(panel->colmod & 0x77);
+        default:
+            return 0;
+    }
+}
+
+static uint64_t transaction_ns(size_t bytes) {
+    uint32_t clock = emulator.config.clock_hz ? emulator.config.clock_hz
+                                              : (uint32_t)emulator.device.config.clock_speed_hz;
+    uint64_t ns = emulator.config.transaction_overhead_ns;
+    if (clock > 0) ns += (uint64_t)bytes * 8 * 1000000000ull / clock;
+    return ns;
+}
+
+// Validates a transaction and returns its byte counts
+static esp_err_t check_transaction(spi_device_handle_t handle, const spi_transaction_t *trans,
+                                   size_t *tx_bytes, size_t *rx_bytes) {
+    if (handle != &emulator.device || !emulator.device_added || !trans) return ESP_ERR_INVALID_ARG;
+    
+    bool has_tx = (trans->flags & SPI_TRANS_USE_TXDATA) || trans->tx_buffer;
+    bool has_rx = (trans->flags & SPI_TRANS_USE_RXDATA) || trans->rx_buffer;
+    *tx_bytes = has_tx ? (trans->length + 7) / 8 : 0;
+    *rx_bytes = has_rx ? ((trans->rxlength ? trans->rxlength : trans->length) + 7) / 8 : 0;
+    if (*tx_bytes > (size_t)emulator.max_transfer_bytes || *rx_bytes > (size_t)emulator.max_transfer_bytes) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+// Sends a transaction to the panel, between the device's hooks. A queued
+// transaction is checked again here, since the device may have been removed
+// since; one that no longer passes is counted as an error and not sent.
+static void execute_transaction(spi_transaction_t *trans, uint64_t bus_ns) {
+    size_t tx_bytes, rx_bytes;
+    if (check_transaction(&emulator.device, trans, &tx_bytes, &rx_bytes) != ESP_OK) {
+        emulator.stats.errors++;
+        return;
+    }
+    if (emulator.device.config.pre_cb) emulator.device.config.pre_cb(trans);
+    
+    emulator.stats.transactions++;
+    emulator.stats.bus_ns += bus_ns;
+    
+    // Held in reset, the panel ignores the bus
+    if (emulator.rst_level) {
+        const uint8_t *tx = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data
+                                                                  : (const uint8_t *)trans->tx_buffer;
+        if (emulator.dc_level == 0) {
+            // Command bytes; a second byte would be another command
+            for (size_t i = 0; i < tx_bytes; i++) {
+                begin_command(tx[i]);
+            }
+            emulator.stats.command_bytes += tx_bytes;
+        } else if (emulator.writing_memory) {
+            write_memory(tx, tx_bytes);
+            emulator.stats.pixel_bytes += tx_bytes;
+        } else {
+            for (size_t i = 0; i < tx_bytes; i++) {
+                command_parameter(tx[i]);
+            }
+            emulator.stats.parameter_bytes += tx_bytes;
+        }
+    }
+    
+    if (rx_bytes > 0) {
+        uint8_t *rx = (trans->flags & SPI_TRANS_USE_RXDATA) ? trans->rx_data : (uint8_t *)trans->rx_buffer;
+        memset(rx, 0, rx_bytes);
+        rx[0] = emulator.rst_level ? read_response() : 0;
+        emulator.stats.read_bytes += rx_bytes;
+    }
+    
+    if (emulator.device.config.post_cb) emulator.device.config.post_cb(trans);
+}
+
+// Moves time forward, finishing queued transactions that end by then
+static void advance_to(uint64_t time_ns) {
+    if (time_ns > emulator.now_ns) emulator.now_ns = time_ns;
+    
+    for (int i = 0; i < emulator.queue_count; i++) {
+        queued_trans_t *entry = &emulator.queue[(emulator.queue_head + i) % MAX_QUEUED];
+        if (entry->completed) continue;
+        if (entry->end_ns > emulator.now_ns) break;
+        execute_transaction(entry->trans, entry->bus_ns);
+        entry->completed = true;
+    }
+}
+
+void st7789_emulator_advance(uint64_t ns) {
+    advance_to(emulator.now_ns + ns);
+}
+
+bool st7789_emulator_run_next(void) {
+    for (int i = 0; i < emulator.queue_count; i++) {
+        const queued_trans_t *entry = &emulator.queue[(emulator.queue_head + i) % MAX_QUEUED];
+        if (!entry->completed) {
+            advance_to(entry->end_ns);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        default: return "ESP_FAIL";
+    }
+}
+
+void esp_rom_delay_us(uint32_t us) {
+    emulator.stats.delay_ns += (uint64_t)us * 1000;
+    advance_to(emulator.now_ns + (uint64_t)us * 1000);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    emulator.stats.delay_ns += (uint64_t)ticks * 1000000;
+    advance_to(emulator.now_ns + (uint64_t)ticks * 1000000);
+}
+
+esp_err_t gpio_config(const gpio_config_t *config) {
+    return config ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    level = level ? 1 : 0;
+    if (gpio_num == TFT_DC_PIN) {
+        emulator.dc_level = level;
+    } else if (gpio_num == TFT_RST_PIN) {
+        // The panel resets on the rising edge that ends a reset pulse
+        if (!emulator.rst_level && level) {
+            panel_reset();
+            emulator.command = 0;
+        }
+        emulator.rst_level = level;
+    }
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan) {
+    (void)host;
+    (void)dma_chan;
+    if (!bus_config || emulator.bus_initialized) return ESP_ERR_INVALID_STATE;
+    
+    // ESP-IDF's limit without an explicit size
+    emulator.max_transfer_bytes = bus_config->max_transfer_sz > 0 ? bus_config->max_transfer_sz : 4092;
+    emulator.bus_initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host) {
+    (void)host;
+    if (!emulator.bus_initialized || emulator.device_added) return ESP_ERR_INVALID_STATE;
+    
+    emulator.bus_initialized = false;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle) {
+    (void)host;
+    if (!dev_config || !handle) return ESP_ERR_INVALID_ARG;
+    if (!emulator.bus_initialized || emulator.device_added) return ESP_ERR_INVALID_STATE;
+    
+    emulator.device.config = *dev_config;
+    emulator.device_added = true;
+    *handle = &emulator.device;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+    if (handle != &emulator.device || !emulator.device_added) return ESP_ERR_INVALID_ARG;
+    
+    emulator.device_added = false;
+    return ESP_OK;
+}
+
+// Blocking: the caller waits for the bus. Like ESP-IDF, not allowed while
+// queued transactions are still to be collected.
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+    size_t tx_bytes, rx_bytes;
+    esp_err_t ret = check_transaction(handle, trans, &tx_bytes, &rx_bytes);
+    if (ret == ESP_OK && emulator.queue_count > 0) ret = ESP_ERR_INVALID_STATE;
+    if (ret != ESP_OK) {
+        emulator.stats.errors++;
+        return ret;
+    }
+    
+    uint64_t bus_ns = transaction_ns(tx_bytes + rx_bytes);
+    emulator.now_ns += bus_ns;
+    emulator.bus_free_ns = emulator.now_ns;
+    execute_transaction(trans, bus_ns);
+    return ESP_OK;
+}
+
+// Returns at once; the transaction runs once the bus is free, in modeled
+// time. At most the device's queue_size transactions may be queued or
+// waiting to be collected; beyond that the call fails instead of blocking.
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t ticks_to_wait) {
+    (void)ticks_to_wait;
+    size_t tx_bytes, rx_bytes;
+    esp_err_t ret = check_transaction(handle, trans, &tx_bytes, &rx_bytes);
+    int limit = emulator.device.config.queue_size;
+    if (limit <= 0 || limit > MAX_QUEUED) limit = MAX_QUEUED;
+    if (ret == ESP_OK && emulator.queue_count >= limit) ret = ESP_ERR_TIMEOUT;
+    if (ret != ESP_OK) {
+        emulator.stats.errors++;
+        return ret;
+    }
+    
+    queued_trans_t *entry = &emulator.queue[(emulator.queue_head + emulator.queue_count) % MAX_QUEUED];
+    entry->trans = trans;
+    entry->bus_ns = transaction_ns(tx_bytes + rx_bytes);
+    uint64_t start_ns = emulator.bus_free_ns > emulator.now_ns ? emulator.bus_free_ns : emulator.now_ns;
+    entry->end_ns = start_ns + entry->bus_ns;
+    entry->completed = false;
+    emulator.bus_free_ns = entry->end_ns;
+    emulator.queue_count++;
+    emulator.stats.queued++;
+    return ESP_OK;
+}
+
+// Blocking waits advance modeled time to the end of the oldest transaction
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc,
+                                      TickType_t ticks_to_wait) {
+    if (handle != &emulator.device || !trans_desc) return ESP_ERR_INVALID_ARG;
+    if (emulator.queue_count == 0) return ESP_ERR_TIMEOUT;
+    
+    queued_trans_t *entry = &emulator.queue[emulator.queue_head];
+    if (!entry->completed) {
+        if (ticks_to_wait == 0) return ESP_ERR_TIMEOUT;
+        advance_to(entry->end_ns);
+    }
+    
+    *trans_desc = entry->trans;
+    emulator.queue_head = (emulator.queue_head + 1) % MAX_QUEUED;
+    emulator.queue_count--;
+    return ESP_OK;
+}
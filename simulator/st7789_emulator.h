@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host stand-in for the ST7789 panel on its SPI bus. Implements the
+// spi_device_transmit()/gpio_set_level() family of esp_shim/, decodes the
+// command stream the LVGL backend's display_st7789.c sends into a 240x320
+// GRAM, and counts what crossed the bus. Bus time is modeled from the bits
+// moved at the SPI clock plus a fixed cost per transaction.
+//
+// Time is modeled, never slept. Blocking transfers, busy waits and task
+// delays move the caller's clock forward; queued transactions run on the bus
+// timeline behind each other and reach the panel, between the device's pre-
+// and post-transaction hooks, once the caller's clock passes their end.
+#define ST7789_EMULATOR_GRAM_WIDTH  240
+#define ST7789_EMULATOR_GRAM_HEIGHT 320
+
+typedef struct {
+    uint32_t clock_hz;                 // 0: the clock the device was added with
+    uint32_t transaction_overhead_ns;  // Driver, chip select and DMA setup per transaction
+} st7789_emulator_config_t;
+
+typedef struct {
+    uint64_t transactions;             // Sent to the panel
+    uint64_t queued;                   // Of those, queued with spi_device_queue_trans()
+    uint64_t command_bytes;
+    uint64_t parameter_bytes;          // Data bytes of commands other than memory writes
+    uint64_t pixel_bytes;              // Data bytes of RAMWR / RAMWRC
+    uint64_t read_bytes;
+    uint64_t pixels;                   // Pixels stored into GRAM
+    uint64_t errors;                   // Rejected transactions
+    uint64_t bus_ns;
+    uint64_t delay_ns;                 // esp_rom_delay_us() and vTaskDelay()
+} st7789_emulator_stats_t;
+
+typedef struct {
+    bool sleeping;
+    bool display_on;
+    bool inverted;
+    uint8_t colmod;
+    uint8_t madctl;
+    uint16_t x_start;                  // Window set by CASET / RASET, inclusive
+    uint16_t x_end;
+    uint16_t y_start;
+    uint16_t y_end;
+    uint32_t resets;                   // Hardware and software
+} st7789_emulator_panel_t;
+
+// Powers the panel up from scratch: GRAM black, statistics cleared, bus and
+// device released. NULL selects the device's clock and no overhead.
+void st7789_emulator_reset(const st7789_emulator_config_t *config);
+void st7789_emulator_clear_stats(void);
+void st7789_emulator_get_stats(st7789_emulator_stats_t *stats);
+void st7789_emulator_get_panel(st7789_emulator_panel_t *panel);
+// Caller time since the reset
+uint64_t st7789_emulator_now_ns(void);
+// Models `ns` of work by the caller while queued transactions go on
+void st7789_emulator_advance(uint64_t ns);
+// Waits for the next queued transaction to finish; false if none is pending
+bool st7789_emulator_run_next(void);
+// RGB565 at a GRAM address, 0 outside the GRAM
+uint16_t st7789_emulator_gram_pixel(int x, int y);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <string.h>
 
 // Simple test framework for simulator environment
 #define TEST_ASSERT(condition, message) \
@@ -19,8 +20,30 @@ extern "C" {
 #include "penguin_physics.h"
 #include "ice_pillars.h"
 #include "display_driver.h"
+#include "display_driver_sim.h"
+#include "display_backend.h"
+#include "display_font.h"
+#include "display_st7789.h"
+#include "st7789_emulator.h"
+#include "display_lvgl_pool.h"
+#include "lvgl_emulator.h"
+#include "game_render_sprite.h"
+#include "game_render_band.h"
+#include "game_render_scroll.h"
+#include "game_sim.h"
+#include "game_sim_policy.h"
+#include "game_sim_snapshot.h"
+#include "game_sim_replay.h"
+#include "game_sim_solver.h"
 }
 
+#include <atomic>
+#include <thread>
+#include <filesystem>
+#include <vector>
+#include "work_stealing_pool.h"
+#include "frame_dump.h"
+
 int test_integration_game_flow() {
     printf("\n=== Integration Test: Complete Game Flow ===\n");
     
@@ -91,7 +114,8 @@ int test_visual_rendering() {
     
     // Test text rendering
     display_driver_draw_text(&display_ctx, 5, 5, "Score: 123", COLOR_WHITE);
-    TEST_ASSERT(display_driver_get_pixel(&display_ctx, 5, 5) == COLOR_WHITE, 
+    // Top row of the 8x8 'S' glyph lights columns 1-4
+    TEST_ASSERT(display_driver_get_pixel(&display_ctx, 6, 5) == COLOR_WHITE, 
                "Text renders correctly");
     
     display_driver_deinit(&display_ctx);
@@ -206,6 +230,1627 @@ int test_performance_simulation() {
     return 0;
 }
 
+int test_batched_worlds_match_scalar() {
+    printf("\n=== Headless Test: Batched Worlds Match Scalar Stepping ===\n");
+    
+    const int world_count = 19;
+    const int frames = 3000;
+    
+    game_sim_batch_t batch;
+    TEST_ASSERT(game_sim_batch_init(&batch, world_count), "Batch of worlds allocates");
+    
+    uint8_t buttons[world_count];
+    for (int frame = 0; frame < frames; frame++) {
+        for (int w = 0; w < world_count; w++) {
+            buttons[w] = ((frame + w * 11) % (60 + w)) < 25;
+        }
+        game_sim_batch_step(&batch, buttons);
+    }
+    
+    bool identical = true;
+    for (int w = 0; w < world_count; w++) {
+        game_world_t expected;
+        game_world_t actual;
+        game_sim_world_init(&expected);
+        for (int frame = 0; frame < frames; frame++) {
+            game_sim_world_step(&expected, ((frame + w * 11) % (60 + w)) < 25);
+        }
+        game_sim_batch_get_world(&batch, w, &actual);
+        
+        identical = identical &&
+            expected.game.state == actual.game.state &&
+            expected.game.frame_count == actual.game.frame_count &&
+            expected.game.score == actual.game.score &&
+            memcmp(&expected.penguin.y, &actual.penguin.y, sizeof(float)) == 0 &&
+            memcmp(&expected.penguin.velocity_y, &actual.penguin.velocity_y, sizeof(float)) == 0 &&
+            expected.pillars.active_count == actual.pillars.active_count;
+        for (int i = 0; i < MAX_PILLARS; i++) {
+            identical = identical &&
+                expected.pillars.pillars[i].active == actual.pillars.pillars[i].active &&
+                memcmp(&expected.pillars.pillars[i].x, &actual.pillars.pillars[i].x, sizeof(float)) == 0 &&
+                expected.pillars.pillars[i].top_height == actual.pillars.pillars[i].top_height;
+        }
+    }
+    TEST_ASSERT(identical, "Batched worlds are bit-identical to scalar worlds");
+    
+    game_sim_batch_deinit(&batch);
+    
+    printf("Batched world test completed successfully!\n");
+    return 0;
+}
+
+int test_physics_kernels_match_scalar() {
+    printf("\n=== Headless Test: Vector Physics Kernels Match Scalar Physics ===\n");
+    
+    const int penguin_count = 29;
+    const int frames = 4000;
+    const penguin_batch_kernel_t kernels[] = {
+        PENGUIN_BATCH_KERNEL_SCALAR, PENGUIN_BATCH_KERNEL_SSE2, PENGUIN_BATCH_KERNEL_AVX2
+    };
+    penguin_batch_kernel_t default_kernel = penguin_physics_get_batch_kernel();
+    
+    for (penguin_batch_kernel_t kernel : kernels) {
+        if (!penguin_physics_set_batch_kernel(kernel)) {
+            printf("SKIP: %s kernel not supported on this CPU\n", penguin_physics_batch_kernel_name(kernel));
+            continue;
+        }
+        
+        penguin_t expected[penguin_count];
+        float x[penguin_count], y[penguin_count], velocity[penguin_count], acceleration[penguin_count];
+        uint8_t pressed[penguin_count], was_pressed[penguin_count];
+        uint32_t duration[penguin_count];
+        penguin_batch_t batch = {x, y, velocity, acceleration, pressed, was_pressed, duration};
+        
+        for (int i = 0; i < penguin_count; i++) {
+            penguin_physics_init(&expected[i]);
+            expected[i].y = (float)(i * 8);
+            x[i] = expected[i].x;
+            y[i] = expected[i].y;
+            velocity[i] = expected[i].velocity_y;
+            acceleration[i] = expected[i].acceleration_y;
+            pressed[i] = expected[i].button_pressed;
+            was_pressed[i] = expected[i].was_button_pressed;
+            duration[i] = expected[i].button_press_duration;
+        }
+        
+        bool identical = true;
+        for (int frame = 0; frame < frames; frame++) {
+            uint8_t buttons[penguin_count];
+            for (int i = 0; i < penguin_count; i++) {
+                buttons[i] = ((frame * 7 + i * 13) % (40 + i)) < 15;
+                penguin_physics_update(&expected[i], buttons[i]);
+            }
+            penguin_physics_update_batch(&batch, buttons, NULL, penguin_count);
+            
+            for (int i = 0; i < penguin_count; i++) {
+                identical = identical &&
+                    memcmp(&expected[i].y, &y[i], sizeof(float)) == 0 &&
+                    memcmp(&expected[i].velocity_y, &velocity[i], sizeof(float)) == 0 &&
+                    memcmp(&expected[i].acceleration_y, &acceleration[i], sizeof(float)) == 0 &&
+                    expected[i].button_press_duration == duration[i];
+            }
+        }
+        
+        char message[96];
+        snprintf(message, sizeof(message), "%s kernel is bit-identical to penguin_physics_update()",
+                 penguin_physics_batch_kernel_name(kernel));
+        TEST_ASSERT(identical, message);
+    }
+    
+    penguin_physics_set_batch_kernel(default_kernel);
+    
+    printf("Physics kernel test completed successfully!\n");
+    return 0;
+}
+
+int test_physics_advance_matches_stepping() {
+    printf("\n=== Headless Test: Physics Fast-Forward Matches Stepping ===\n");
+    
+    // Start heights across every binade of the play field, with both inputs
+    // and each velocity the game produces at the start of a hold
+    const float velocities[] = {-3.5f, -1.25f, 0.0f, 0.75f, 3.5f};
+    int mismatches = 0;
+    int cases = 0;
+    for (float y = 0.0f; y <= 220.0f; y += 0.731f) {
+        for (float velocity : velocities) {
+            for (int pressed = 0; pressed < 2; pressed++) {
+                penguin_t start;
+                penguin_physics_init(&start);
+                start.y = y;
+                start.velocity_y = velocity;
+                
+                penguin_t expected = start;
+                for (uint32_t span = 1; span <= 300; span++) {
+                    penguin_physics_update(&expected, pressed);
+                    penguin_t actual = start;
+                    penguin_physics_advance(&actual, pressed, span);
+                    mismatches += memcmp(&expected.y, &actual.y, sizeof(float)) != 0 ||
+                                  memcmp(&expected.velocity_y, &actual.velocity_y, sizeof(float)) != 0 ||
+                                  expected.button_press_duration != actual.button_press_duration;
+                    cases++;
+                }
+            }
+        }
+    }
+    
+    printf("%d spans checked\n", cases);
+    TEST_ASSERT(mismatches == 0, "penguin_physics_advance() is bit-identical to stepping");
+    
+    printf("Physics fast-forward test completed successfully!\n");
+    return 0;
+}
+
+int test_pillar_rng_per_world() {
+    printf("\n=== Headless Test: Per-World Pillar Generators ===\n");
+    
+    // Two worlds stepped in lockstep with the same seed must see the same level,
+    // even when a third world is re-initialized between their steps
+    game_world_t first;
+    game_world_t second;
+    game_world_t other;
+    game_sim_world_init(&first);
+    game_sim_world_init(&second);
+    game_sim_world_init_seeded(&other, 99, ICE_PILLARS_RNG_COUNTER);
+    
+    bool same_level = true;
+    for (int frame = 0; frame < 2000; frame++) {
+        bool pressed = (frame % 50) < 20;
+        game_sim_world_step(&first, pressed);
+        if (frame % 100 == 0) {
+            game_sim_world_init_seeded(&other, 99 + frame, ICE_PILLARS_RNG_COUNTER);
+        }
+        game_sim_world_step(&other, pressed);
+        game_sim_world_step(&second, pressed);
+        same_level = same_level && first.pillars.rng.state == second.pillars.rng.state;
+    }
+    TEST_ASSERT(same_level, "Worlds with the same seed generate the same pillars");
+    
+    // Jumping straight to a spawn gives the same generator state as spawning up to it
+    ice_pillars_rng_mode_t modes[] = {ICE_PILLARS_RNG_LCG, ICE_PILLARS_RNG_COUNTER};
+    for (ice_pillars_rng_mode_t mode : modes) {
+        ice_pillars_context_t sequential;
+        ice_pillars_context_t jumped;
+        ice_pillars_init_seeded(&sequential, 4242, mode);
+        ice_pillars_init_seeded(&jumped, 4242, mode);
+        for (int n = 0; n < 1000; n++) {
+            ice_pillars_spawn_pillar(&sequential);
+            ice_pillars_reset(&sequential);
+        }
+        ice_pillars_seek_spawn(&jumped, 1000);
+        
+        ice_pillars_spawn_pillar(&sequential);
+        ice_pillars_spawn_pillar(&jumped);
+        TEST_ASSERT(sequential.pillars[0].gap_size == jumped.pillars[0].gap_size &&
+                    sequential.pillars[0].top_height == jumped.pillars[0].top_height &&
+                    sequential.rng.state == jumped.rng.state,
+                    mode == ICE_PILLARS_RNG_LCG ? "LCG seek matches sequential spawning"
+                                                : "Counter seek matches sequential spawning");
+    }
+    
+    printf("Pillar generator test completed successfully!\n");
+    return 0;
+}
+
+int test_episode_runner_pool() {
+    printf("\n=== Headless Test: Work-Stealing Episode Runner ===\n");
+    
+    // Every item runs exactly once, however the chunks get stolen
+    const uint64_t item_count = 10007;
+    std::vector<std::atomic<int>> runs(item_count);
+    for (auto& count : runs) count = 0;
+    
+    work_stealing_pool pool(6);
+    pool.parallel_for(item_count, 17, [&](uint64_t begin, uint64_t end, unsigned) {
+        for (uint64_t i = begin; i < end; i++) runs[i]++;
+    });
+    
+    bool exactly_once = true;
+    for (auto& count : runs) exactly_once = exactly_once && count == 1;
+    uint64_t items = 0;
+    for (unsigned w = 0; w < pool.thread_count(); w++) items += pool.stats(w).items;
+    TEST_ASSERT(exactly_once && items == item_count, "Pool runs every item exactly once");
+    
+    // Episodes are pure functions of (seed, policy, episode number)
+    int policy_count = 0;
+    const game_sim_policy_t* policies = game_sim_get_policies(&policy_count);
+    bool repeatable = true;
+    for (int p = 0; p < policy_count; p++) {
+        for (uint64_t episode = 0; episode < 4; episode++) {
+            game_world_t first;
+            game_world_t again;
+            game_sim_world_init_seeded(&first, 500 + (uint32_t)episode, ICE_PILLARS_RNG_COUNTER);
+            game_sim_world_init_seeded(&again, 500 + (uint32_t)episode, ICE_PILLARS_RNG_COUNTER);
+            uint32_t frames = game_sim_run_episode(&first, policies[p].decide, episode, 20000);
+            repeatable = repeatable &&
+                frames == game_sim_run_episode(&again, policies[p].decide, episode, 20000) &&
+                first.game.score == again.game.score && frames > 0;
+        }
+    }
+    TEST_ASSERT(repeatable, "Episodes replay identically for every policy");
+    TEST_ASSERT(game_sim_find_policy("autopilot") != NULL && game_sim_find_policy("nope") == NULL,
+                "Policies are found by name");
+    
+    printf("Episode runner test completed successfully!\n");
+    return 0;
+}
+
+int test_snapshot_rollback() {
+    printf("\n=== Headless Test: Snapshot and Rollback ===\n");
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 77, ICE_PILLARS_RNG_COUNTER);
+    game_sim_run_episode(&world, game_sim_policy_autopilot, 1, 600);
+    
+    game_sim_snapshot_t snapshot;
+    game_sim_snapshot_save(&world, &snapshot);
+    TEST_ASSERT(sizeof(snapshot) == GAME_SIM_SNAPSHOT_SIZE, "Snapshot is two cache lines");
+    
+    game_world_t expected = world;
+    game_sim_run_episode(&expected, game_sim_policy_autopilot, 1, 2000);
+    
+    game_sim_run_episode(&world, game_sim_policy_periodic, 4, 300);
+    game_sim_snapshot_restore(&snapshot, &world);
+    game_sim_run_episode(&world, game_sim_policy_autopilot, 1, 2000);
+    
+    TEST_ASSERT(world.game.state == expected.game.state &&
+                world.game.score == expected.game.score &&
+                world.game.frame_count == expected.game.frame_count &&
+                memcmp(&world.penguin.y, &expected.penguin.y, sizeof(float)) == 0 &&
+                world.pillars.rng.draw_count == expected.pillars.rng.draw_count,
+                "Restored world replays identically");
+    
+    printf("Snapshot test completed successfully!\n");
+    return 0;
+}
+
+int test_replay_record_and_play() {
+    printf("\n=== Headless Test: Replay Recording and Playback ===\n");
+    
+    int matched = 0;
+    int corrupted_rejected = 0;
+    const int games = 20;
+    for (int g = 0; g < games; g++) {
+        ice_pillars_rng_mode_t mode = (g % 2) ? ICE_PILLARS_RNG_COUNTER : ICE_PILLARS_RNG_LCG;
+        uint8_t ring[64];
+        game_sim_replay_recorder_t recorder;
+        game_sim_replay_recorder_init(&recorder, ring, sizeof(ring), 500 + g, mode);
+        
+        game_world_t world;
+        game_sim_world_init_seeded(&world, 500 + g, mode);
+        std::vector<uint8_t> replay(GAME_SIM_REPLAY_HEADER_SIZE);
+        uint8_t chunk[64];
+        bool running = true;
+        while (running) {
+            bool pressed = game_sim_policy_periodic(&world, g);
+            game_sim_replay_recorder_record(&recorder, pressed);
+            running = game_sim_world_step(&world, pressed);
+            uint32_t n = game_sim_replay_recorder_drain(&recorder, chunk, sizeof(chunk));
+            replay.insert(replay.end(), chunk, chunk + n);
+        }
+        game_sim_replay_recorder_finish(&recorder, world.game.score);
+        uint32_t n = game_sim_replay_recorder_drain(&recorder, chunk, sizeof(chunk));
+        replay.insert(replay.end(), chunk, chunk + n);
+        game_sim_replay_write_header(&recorder.header, replay.data());
+        
+        game_world_t played;
+        game_sim_replay_result_t result;
+        if (game_sim_replay_play(replay.data(), replay.size(), &played, &result) &&
+            result.frames == world.game.frame_count &&
+            memcmp(&played.penguin.y, &world.penguin.y, sizeof(float)) == 0) {
+            matched++;
+        }
+        
+        // Flipping the first run changes every later input
+        replay[GAME_SIM_REPLAY_HEADER_SIZE] ^= 1;
+        corrupted_rejected += !game_sim_replay_play(replay.data(), replay.size(), &played, NULL);
+    }
+    
+    TEST_ASSERT(matched == games, "Every recorded game plays back identically");
+    TEST_ASSERT(corrupted_rejected == games, "Corrupted input streams are detected");
+    
+    printf("Replay test completed successfully!\n");
+    return 0;
+}
+
+// The game loop records while another thread drains the ring, as on the device
+int test_replay_recorder_concurrent_drain() {
+    printf("\n=== Headless Test: Replay Recorder Drained Concurrently ===\n");
+    
+    const int frames = 50000;
+    auto input = [](int frame) { return (frame / (1 + frame % 7)) % 2 == 1; };
+    
+    // Single-threaded reference
+    std::vector<uint8_t> reference(frames * GAME_SIM_REPLAY_MAX_VARINT_SIZE);
+    game_sim_replay_recorder_t recorder;
+    game_sim_replay_recorder_init(&recorder, reference.data(), (uint32_t)reference.size(), 1, ICE_PILLARS_RNG_LCG);
+    for (int f = 0; f < frames; f++) game_sim_replay_recorder_record(&recorder, input(f));
+    game_sim_replay_recorder_finish(&recorder, 0);
+    reference.resize(game_sim_replay_recorder_pending(&recorder));
+    
+    // A small ring, so the two threads wrap it many times
+    uint8_t ring[32];
+    game_sim_replay_recorder_init(&recorder, ring, sizeof(ring), 1, ICE_PILLARS_RNG_LCG);
+    std::atomic<bool> done(false);
+    std::vector<uint8_t> drained;
+    std::thread reader([&]() {
+        uint8_t chunk[8];
+        while (true) {
+            bool last = done.load(std::memory_order_acquire);
+            uint32_t n = game_sim_replay_recorder_drain(&recorder, chunk, sizeof(chunk));
+            drained.insert(drained.end(), chunk, chunk + n);
+            if (last && n == 0) break;
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+    for (int f = 0; f < frames; f++) {
+        // Leave room for a run, as a recorder sized for the drain rate would
+        while (game_sim_replay_recorder_pending(&recorder) > sizeof(ring) - GAME_SIM_REPLAY_MAX_VARINT_SIZE) {
+            std::this_thread::yield();
+        }
+        game_sim_replay_recorder_record(&recorder, input(f));
+    }
+    while (game_sim_replay_recorder_pending(&recorder) > sizeof(ring) - GAME_SIM_REPLAY_MAX_VARINT_SIZE) {
+        std::this_thread::yield();
+    }
+    game_sim_replay_recorder_finish(&recorder, 0);
+    done.store(true, std::memory_order_release);
+    reader.join();
+    
+    TEST_ASSERT(!recorder.overflowed, "The ring never overflows while it is drained");
+    TEST_ASSERT(drained == reference, "Drained bytes match a single-threaded recording");
+    return 0;
+}
+
+int test_event_driven_matches_frame_loop() {
+    printf("\n=== Headless Test: Event-Driven Simulation Matches Frame Loop ===\n");
+    
+    // The input pattern of the frame-rate consistency integration test: hold
+    // for 90 frames, release for 90, until the game ends
+    int identical = 0;
+    uint64_t frames = 0;
+    uint64_t jumps = 0;
+    const int games = 200;
+    for (int g = 0; g < games; g++) {
+        ice_pillars_rng_mode_t mode = (g % 2) ? ICE_PILLARS_RNG_COUNTER : ICE_PILLARS_RNG_LCG;
+        game_world_t stepped;
+        game_world_t advanced;
+        game_sim_world_init_seeded(&stepped, 700 + g, mode);
+        game_sim_world_init_seeded(&advanced, 700 + g, mode);
+        
+        bool same = true;
+        while (stepped.game.state == GAME_STATE_PLAYING && same) {
+            bool pressed = (stepped.game.frame_count % 180) < 90;
+            uint32_t span = 90 - stepped.game.frame_count % 90;
+            for (uint32_t f = 0; f < span && game_sim_world_step(&stepped, pressed); f++) {
+            }
+            
+            uint32_t before = advanced.game.frame_count;
+            game_sim_world_advance(&advanced, pressed, span);
+            jumps++;
+            
+            game_sim_snapshot_t expected;
+            game_sim_snapshot_t actual;
+            game_sim_snapshot_save(&stepped, &expected);
+            game_sim_snapshot_save(&advanced, &actual);
+            same = memcmp(&expected, &actual, sizeof(expected)) == 0;
+            frames += advanced.game.frame_count - before;
+        }
+        identical += same;
+    }
+    
+    printf("%llu frames in %llu constant-input spans\n", (unsigned long long)frames, (unsigned long long)jumps);
+    TEST_ASSERT(identical == games, "Event-driven games end in the same state as frame-by-frame games");
+    
+    printf("Event-driven test completed successfully!\n");
+    return 0;
+}
+
+int test_seed_solver_bounds_real_games() {
+    printf("\n=== Headless Test: Seed Solver Bounds Real Games ===\n");
+    
+    // Random, periodic and autopilot inputs at every resolution. Random play
+    // keeps hitting the screen edges, which exercises the clamped states.
+    static game_sim_solver_t solver;
+    uint64_t frames = 0;
+    int outside = 0;
+    int outlived = 0;
+    for (int bits = 0; bits <= GAME_SIM_SOLVER_MAX_SUBPIXEL_BITS; bits++) {
+        TEST_ASSERT(game_sim_solver_init(&solver, bits), "Solver builds its grid");
+        
+        for (uint32_t g = 0; g < 24; g++) {
+            ice_pillars_rng_mode_t mode = (g % 2) ? ICE_PILLARS_RNG_COUNTER : ICE_PILLARS_RNG_LCG;
+            game_world_t world;
+            game_sim_world_init_seeded(&world, 900 + g, mode);
+            game_sim_solver_reset(&solver, 900 + g, mode);
+            
+            uint32_t random = g * 2654435761u + 1;
+            bool running = true;
+            while (running) {
+                bool pressed;
+                if (g % 3 == 0) {
+                    pressed = game_sim_policy_autopilot(&world, g);
+                } else if (g % 3 == 1) {
+                    random = random * 1664525u + 1013904223u;
+                    pressed = random >> 31;
+                } else {
+                    pressed = (world.game.frame_count / (5 + g)) % 2 == 0;
+                }
+                running = game_sim_world_step(&world, pressed);
+                bool alive = game_sim_solver_step(&solver);
+                outside += running && (!alive || !game_sim_solver_is_reachable(&solver, &world.penguin));
+                frames++;
+            }
+            
+            uint32_t bound = game_sim_solver_max_survival(&solver, 900 + g, mode, 100000);
+            outlived += world.game.frame_count - 1 > bound;
+        }
+    }
+    
+    printf("%llu frames checked\n", (unsigned long long)frames);
+    TEST_ASSERT(outside == 0, "Every real penguin state lies inside the tracked set");
+    TEST_ASSERT(outlived == 0, "No game outlives its seed's survival bound");
+    
+    printf("Seed solver test completed successfully!\n");
+    return 0;
+}
+
+int test_seed_solver_witness_replays() {
+    printf("\n=== Headless Test: Seed Solver Witnesses Replay ===\n");
+    
+    // Whole games, so every witness crosses many saved stretches
+    static game_sim_solver_t solver;
+    static uint8_t inputs[100001];
+    uint32_t bounds[6];
+    int mismatched = 0;
+    int replayed = 0;
+    int ordered = 0;
+    int exact = 0;
+    for (int bits = 0; bits <= 1; bits++) {
+        TEST_ASSERT(game_sim_solver_init(&solver, bits), "Solver builds its grid");
+        game_sim_solver_witness_t witness;
+        TEST_ASSERT(game_sim_solver_witness_init(&witness, &solver), "Witness search allocates");
+        
+        game_sim_solver_max_survival_many(&solver, 12345, 6, ICE_PILLARS_RNG_COUNTER, 100000, bounds);
+        for (uint32_t i = 0; i < 6; i++) {
+            uint32_t seed = 12345 + i;
+            mismatched += bounds[i] != game_sim_solver_max_survival(&solver, seed, ICE_PILLARS_RNG_COUNTER, 100000);
+            
+            uint32_t count;
+            uint32_t lower = game_sim_solver_min_survival(&witness, &solver, seed, ICE_PILLARS_RNG_COUNTER, 100000,
+                                                          inputs, &count);
+            game_world_t world;
+            game_sim_world_init_seeded(&world, seed, ICE_PILLARS_RNG_COUNTER);
+            uint32_t survived = 0;
+            while (survived < count && game_sim_world_step(&world, inputs[survived])) {
+                survived++;
+            }
+            replayed += survived == lower && count == lower + 1;
+            ordered += lower <= bounds[i];
+            exact += lower == bounds[i];
+        }
+        game_sim_solver_witness_deinit(&witness);
+    }
+    
+    printf("%d of 12 seeds solved exactly\n", exact);
+    TEST_ASSERT(mismatched == 0, "Seeds solved in lanes get the same bound as one at a time");
+    TEST_ASSERT(replayed == 12, "Every witness survives exactly its lower bound when replayed");
+    TEST_ASSERT(ordered == 12, "No lower bound exceeds the upper bound");
+    
+    printf("Seed solver witness test completed successfully!\n");
+    return 0;
+}
+
+int test_fill_kernels_match_scalar() {
+    printf("\n=== Headless Test: Span Fill Kernels Match Per-Pixel Fill ===\n");
+    
+    const display_fill_kernel_t kernels[] = {
+        DISPLAY_FILL_KERNEL_SCALAR, DISPLAY_FILL_KERNEL_SWAR, DISPLAY_FILL_KERNEL_SSE2, DISPLAY_FILL_KERNEL_AVX2
+    };
+    const int buffer_size = 256;
+    const uint16_t background = 0xA5A5;
+    display_fill_kernel_t default_kernel = display_driver_sim_get_fill_kernel();
+    
+    display_context_t display_ctx;
+    display_driver_init(&display_ctx);
+    
+    for (display_fill_kernel_t kernel : kernels) {
+        if (!display_driver_sim_set_fill_kernel(kernel)) {
+            printf("SKIP: %s kernel not supported on this CPU\n", display_driver_sim_fill_kernel_name(kernel));
+            continue;
+        }
+        
+        // Every start alignment and length, so each head, body and tail path
+        // runs, with guard pixels on both sides that must stay untouched
+        alignas(64) uint16_t actual[buffer_size];
+        uint16_t expected[buffer_size];
+        bool identical = true;
+        for (int offset = 0; offset < 32; offset++) {
+            for (int count = 0; count <= 160; count++) {
+                uint16_t color = (uint16_t)(offset * 977 + count * 131);
+                for (int i = 0; i < buffer_size; i++) {
+                    actual[i] = expected[i] = background;
+                }
+                for (int i = 0; i < count; i++) {
+                    expected[offset + i] = color;
+                }
+                display_driver_sim_fill_span(actual + offset, (uint32_t)count, color);
+                identical = identical && memcmp(actual, expected, sizeof(expected)) == 0;
+            }
+        }
+        
+        char message[96];
+        snprintf(message, sizeof(message), "%s spans fill exactly their pixels",
+                 display_driver_sim_fill_kernel_name(kernel));
+        TEST_ASSERT(identical, message);
+        
+        // Clipped, partial-width and full-width rectangles
+        display_driver_clear_screen(&display_ctx, COLOR_DARK_BLUE);
+        display_driver_draw_rectangle(&display_ctx, -7, -3, 20, 15, COLOR_YELLOW);
+        display_driver_draw_rectangle(&display_ctx, 121, 230, 30, 30, COLOR_ICE_BLUE);
+        display_driver_draw_rectangle(&display_ctx, 0, 100, DISPLAY_WIDTH, 5, COLOR_WHITE);
+        display_driver_draw_rectangle(&display_ctx, 40, 50, 0, 10, COLOR_RED);
+        
+        int wrong = 0;
+        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+            for (int x = 0; x < DISPLAY_WIDTH; x++) {
+                uint16_t want = COLOR_DARK_BLUE;
+                if (x < 13 && y < 12) want = COLOR_YELLOW;
+                if (x >= 121 && y >= 230) want = COLOR_ICE_BLUE;
+                if (y >= 100 && y < 105) want = COLOR_WHITE;
+                wrong += display_driver_get_pixel(&display_ctx, x, y) != want;
+            }
+        }
+        snprintf(message, sizeof(message), "%s rectangles clip to the screen",
+                 display_driver_sim_fill_kernel_name(kernel));
+        TEST_ASSERT(wrong == 0, message);
+    }
+    
+    display_driver_sim_set_fill_kernel(default_kernel);
+    display_driver_deinit(&display_ctx);
+    
+    printf("Fill kernel test completed successfully!\n");
+    return 0;
+}
+
+int test_dirty_areas_cover_changes() {
+    printf("\n=== Headless Test: Dirty Areas Cover Every Changed Pixel ===\n");
+    
+    display_context_t display_ctx;
+    display_driver_init(&display_ctx);
+    display_driver_sim_set_dirty_tracking(&display_ctx, true);
+    
+    std::vector<uint16_t> previous(DISPLAY_WIDTH * DISPLAY_HEIGHT, 0);
+    int uncovered = 0;
+    int overlapping = 0;
+    for (int frame = 0; frame < 120; frame++) {
+        // Two pillars sliding left and a penguin bobbing up and down
+        display_driver_clear_screen(&display_ctx, COLOR_DARK_BLUE);
+        for (int p = 0; p < 2; p++) {
+            int x = DISPLAY_WIDTH - (frame * 2 + p * 80) % (DISPLAY_WIDTH + PILLAR_WIDTH);
+            display_driver_draw_rectangle(&display_ctx, x, 0, PILLAR_WIDTH, 70 + p * 30, COLOR_ICE_BLUE);
+            display_driver_draw_rectangle(&display_ctx, x, 160 + p * 20, PILLAR_WIDTH, 80, COLOR_ICE_BLUE);
+        }
+        display_driver_draw_rectangle(&display_ctx, 30, 100 + (frame % 20), PENGUIN_WIDTH, PENGUIN_HEIGHT, COLOR_BLACK);
+        display_driver_swap_buffers(&display_ctx);
+        
+        const display_area_t* areas;
+        int count = display_driver_sim_get_dirty_areas(&display_ctx, &areas);
+        const uint16_t* front = (const uint16_t*)display_ctx.front_buffer;
+        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+            for (int x = 0; x < DISPLAY_WIDTH; x++) {
+                int covering = 0;
+                for (int i = 0; i < count; i++) {
+                    covering += x >= areas[i].x && x < areas[i].x + areas[i].width &&
+                                y >= areas[i].y && y < areas[i].y + areas[i].height;
+                }
+                uncovered += front[y * DISPLAY_WIDTH + x] != previous[y * DISPLAY_WIDTH + x] && covering == 0;
+                overlapping += covering > 1;
+            }
+        }
+        
+        // What a window would hold after uploading only the dirty areas
+        for (int i = 0; i < count; i++) {
+            for (int y = areas[i].y; y < areas[i].y + areas[i].height; y++) {
+                memcpy(&previous[y * DISPLAY_WIDTH + areas[i].x], &front[y * DISPLAY_WIDTH + areas[i].x],
+                       areas[i].width * sizeof(uint16_t));
+            }
+        }
+    }
+    TEST_ASSERT(uncovered == 0, "Every changed pixel lies in a dirty area");
+    TEST_ASSERT(overlapping == 0, "Dirty areas never overlap");
+    TEST_ASSERT(memcmp(previous.data(), display_ctx.front_buffer, previous.size() * sizeof(uint16_t)) == 0,
+                "Uploading dirty areas reproduces the frame");
+    
+    display_dirty_stats_t stats;
+    display_driver_sim_get_dirty_stats(&display_ctx, &stats);
+    printf("%.1f%% of full-frame upload bytes saved, %.1f areas per frame\n",
+           100.0 * (stats.full_bytes - stats.dirty_bytes) / stats.full_bytes, (double)stats.areas / stats.frames);
+    TEST_ASSERT(stats.frames == 120 && stats.dirty_bytes * 4 < stats.full_bytes,
+                "Moving objects upload a fraction of each frame");
+    
+    // Redrawing the same frame uploads nothing
+    memcpy(display_ctx.back_buffer, display_ctx.front_buffer, previous.size() * sizeof(uint16_t));
+    display_driver_swap_buffers(&display_ctx);
+    const display_area_t* areas;
+    TEST_ASSERT(display_driver_sim_get_dirty_areas(&display_ctx, &areas) == 0, "Identical frames have no dirty areas");
+    
+    display_driver_deinit(&display_ctx);
+    
+    printf("Dirty area test completed successfully!\n");
+    return 0;
+}
+
+// Text drawn bit by bit from the font bitmaps, as the driver used to
+static void draw_text_reference(uint16_t* buffer, int x, int y, const char* text, uint16_t color) {
+    int cursor_x = x;
+    int cursor_y = y;
+    for (; *text; text++) {
+        if (*text == '\n') {
+            cursor_x = x;
+            cursor_y += DISPLAY_FONT_HEIGHT;
+            continue;
+        }
+        const uint8_t* glyph = display_font_glyph(*text);
+        for (int row = 0; glyph && row < DISPLAY_FONT_HEIGHT; row++) {
+            for (int col = 0; col < DISPLAY_FONT_WIDTH; col++) {
+                int px = cursor_x + col;
+                int py = cursor_y + row;
+                if (px < 0 || px >= DISPLAY_WIDTH || py < 0 || py >= DISPLAY_HEIGHT) continue;
+                if (glyph[row] & (1 << col)) buffer[py * DISPLAY_WIDTH + px] = color;
+            }
+        }
+        cursor_x += DISPLAY_FONT_WIDTH;
+    }
+}
+
+int test_text_spans_match_glyph_bits() {
+    printf("\n=== Headless Test: Span Text Matches Glyph Bits ===\n");
+    
+    static uint16_t expected[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    const uint16_t background = 0x1234;
+    
+    display_context_t display_ctx;
+    display_driver_init(&display_ctx);
+    
+    auto matches = [&](int x, int y, const char* text, uint16_t color) {
+        display_driver_clear_screen(&display_ctx, background);
+        display_driver_draw_text(&display_ctx, x, y, text, color);
+        for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
+            expected[i] = background;
+        }
+        draw_text_reference(expected, x, y, text, color);
+        return memcmp(display_ctx.current_buffer, expected, sizeof(expected)) == 0;
+    };
+    
+    // Every character code, at positions on screen and across each edge
+    const int positions[][2] = {{3, 5}, {-4, 20}, {DISPLAY_WIDTH - 5, 40}, {60, -3}, {60, DISPLAY_HEIGHT - 4}};
+    bool identical = true;
+    for (const auto& position : positions) {
+        for (int code = 1; code < 128; code++) {
+            char text[2] = {(char)code, '\0'};
+            if (text[0] == '\n') continue;
+            identical = identical && matches(position[0], position[1], text, 0xFFE0);
+        }
+    }
+    TEST_ASSERT(identical, "Span text draws exactly the set bits of each glyph");
+    
+    // Labels drawn again from their cached runs, in other colors and places
+    const char* labels[] = {"Score: 1234567890", "GAME OVER", "Two\nlines", "Mixed case ~{}"};
+    display_text_stats_t before;
+    display_driver_sim_get_text_stats(&display_ctx, &before);
+    for (int pass = 0; pass < 3; pass++) {
+        for (const auto& position : positions) {
+            for (const char* label : labels) {
+                identical = identical && matches(position[0], position[1], label, (uint16_t)(0xF800 >> pass));
+            }
+        }
+    }
+    display_text_stats_t after;
+    display_driver_sim_get_text_stats(&display_ctx, &after);
+    TEST_ASSERT(identical, "Cached text runs match glyph bits, clipped at every edge");
+    TEST_ASSERT(after.misses - before.misses == 4 && after.hits - before.hits == 56,
+                "Each label is laid out once and drawn from its run afterwards");
+    
+    identical = matches(-2, 100, "A line far too long for any cached text run", COLOR_WHITE);
+    display_driver_sim_get_text_stats(&display_ctx, &after);
+    TEST_ASSERT(identical && after.uncached == before.uncached + 1, "Text too long for a run is drawn glyph by glyph");
+    
+    display_driver_deinit(&display_ctx);
+    return 0;
+}
+
+// Render target standing in for a locked SDL texture: rows padded past the
+// screen width, filled with a guard value that drawing must not touch
+struct test_target_t {
+    static const int pitch_pixels = DISPLAY_WIDTH + 13;
+    static const uint16_t guard = 0xBEEF;
+    uint16_t pixels[pitch_pixels * DISPLAY_HEIGHT];
+    int locks;
+    int unlocks;
+    bool locked;
+};
+
+static bool test_target_lock(void* user, void** pixels, int* pitch) {
+    test_target_t* target = (test_target_t*)user;
+    if (target->locked) return false;
+    target->locked = true;
+    target->locks++;
+    *pixels = target->pixels;
+    *pitch = test_target_t::pitch_pixels * (int)sizeof(uint16_t);
+    return true;
+}
+
+static void test_target_unlock(void* user) {
+    test_target_t* target = (test_target_t*)user;
+    target->locked = false;
+    target->unlocks++;
+}
+
+int test_target_rendering_matches_buffers() {
+    printf("\n=== Headless Test: Rendering Into A Padded Target ===\n");
+    
+    static test_target_t target;
+    static game_render_sprite_cache_t sprites;
+    for (int i = 0; i < test_target_t::pitch_pixels * DISPLAY_HEIGHT; i++) {
+        target.pixels[i] = test_target_t::guard;
+    }
+    
+    display_context_t buffered, direct;
+    display_driver_init(&buffered);
+    display_driver_init(&direct);
+    game_render_sprite_cache_init(&sprites, GAME_RENDER_SPRITE_DEFAULT_BUDGET);
+    display_target_t callbacks = {test_target_lock, test_target_unlock, &target};
+    TEST_ASSERT(display_driver_sim_set_target(&direct, &callbacks), "Target with both callbacks is accepted");
+    TEST_ASSERT(direct.front_buffer == NULL && target.locks == 0, "Target is not locked before the first draw");
+    
+    // Same frames, with every drawing call, into both
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 99, ICE_PILLARS_RNG_COUNTER);
+    static uint16_t row[DISPLAY_WIDTH * 3];
+    for (int i = 0; i < DISPLAY_WIDTH * 3; i++) {
+        row[i] = (uint16_t)(i * 37);
+    }
+    bool identical = true;
+    bool padding_intact = true;
+    const int frames = 120;
+    for (int frame = 0; frame < frames; frame++) {
+        game_sim_world_step(&world, game_sim_policy_autopilot(&world, 1));
+        display_context_t* contexts[] = {&buffered, &direct};
+        for (display_context_t* ctx : contexts) {
+            game_render_scene_sprites(&sprites, ctx, &world, COLOR_DARK_BLUE);
+            display_driver_draw_rectangle(ctx, -5, 200, DISPLAY_WIDTH + 10, 4, COLOR_RED);
+            display_driver_push_rows(ctx, 230, 3, row);
+            display_driver_draw_text(ctx, 4, 4, "Score: 42", COLOR_WHITE);
+            display_driver_draw_text(ctx, DISPLAY_WIDTH - 12, 100 + frame % 40, "edge", COLOR_YELLOW);
+        }
+        
+        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+            for (int x = 0; x < DISPLAY_WIDTH; x++) {
+                uint16_t expected = display_driver_get_pixel(&buffered, x, y);
+                identical = identical && display_driver_get_pixel(&direct, x, y) == expected;
+            }
+            for (int x = DISPLAY_WIDTH; x < test_target_t::pitch_pixels; x++) {
+                uint16_t padding = target.pixels[y * test_target_t::pitch_pixels + x];
+                padding_intact = padding_intact && padding == test_target_t::guard;
+            }
+        }
+        display_driver_swap_buffers(&buffered);
+        display_driver_swap_buffers(&direct);
+    }
+    TEST_ASSERT(identical, "Frames drawn into the target match the driver's own buffers");
+    TEST_ASSERT(padding_intact, "Row padding of the target is never written");
+    TEST_ASSERT(target.locks == frames && target.unlocks == frames && !target.locked,
+                "Target is locked once per frame and unlocked at every swap");
+    TEST_ASSERT(display_driver_get_pixel(&direct, 0, 0) == 0 && target.locks == frames && !target.locked,
+                "Reading after a swap does not lock the target");
+    
+    // Back to the driver's buffers
+    display_driver_draw_rectangle(&direct, 0, 0, 4, 4, COLOR_GREEN);
+    TEST_ASSERT(display_driver_sim_set_target(&direct, NULL) && target.unlocks == frames + 1 && !target.locked,
+                "Clearing the target unlocks it");
+    display_driver_draw_rectangle(&direct, 0, 0, 4, 4, COLOR_GREEN);
+    TEST_ASSERT(direct.front_buffer != NULL && display_driver_get_pixel(&direct, 3, 3) == COLOR_GREEN,
+                "Driver draws into its own buffers again");
+    
+    game_render_sprite_cache_deinit(&sprites);
+    display_driver_deinit(&buffered);
+    display_driver_deinit(&direct);
+    return 0;
+}
+
+// Reference frames for the renderer comparisons below
+static uint16_t render_expected[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+
+static void copy_render_frame(display_context_t* ctx, uint16_t* out) {
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            out[y * DISPLAY_WIDTH + x] = display_driver_get_pixel(ctx, x, y);
+        }
+    }
+}
+
+static int render_mismatches(display_context_t* ctx) {
+    int mismatches = 0;
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            mismatches += display_driver_get_pixel(ctx, x, y) != render_expected[y * DISPLAY_WIDTH + x];
+        }
+    }
+    return mismatches;
+}
+
+int test_render_list_matches_direct_drawing() {
+    printf("\n=== Headless Test: Display List Matches Direct Drawing ===\n");
+    
+    static game_render_list_t list;
+    static game_render_flush_scratch_t scratch;
+    game_render_list_init(&list, &scratch);
+    display_context_t ctx;
+    TEST_ASSERT(display_driver_init(&ctx), "Display initializes");
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 4242, ICE_PILLARS_RNG_COUNTER);
+    bool identical = true;
+    bool once = true;
+    for (int frame = 0; frame < 600 && world.game.state == GAME_STATE_PLAYING; frame++) {
+        game_sim_world_step(&world, game_sim_policy_autopilot(&world, 3));
+        if (frame % 10 != 0) continue;
+        
+        display_driver_clear_screen(&ctx, COLOR_RED);
+        game_render_list_begin(&list, &ctx);
+        game_render_scene(&list, &world, COLOR_DARK_BLUE);
+        game_render_list_flush_direct(&list);
+        copy_render_frame(&ctx, render_expected);
+        
+        display_driver_clear_screen(&ctx, COLOR_RED);
+        game_render_list_begin(&list, &ctx);
+        game_render_scene(&list, &world, COLOR_DARK_BLUE);
+        game_render_list_flush(&list);
+        identical = identical && render_mismatches(&ctx) == 0;
+        once = once && list.stats.visible_pixels == DISPLAY_WIDTH * DISPLAY_HEIGHT &&
+               list.stats.written_pixels == list.stats.visible_pixels &&
+               list.stats.recorded_pixels > list.stats.written_pixels;
+    }
+    TEST_ASSERT(identical, "Flushing the resolved list draws what drawing every command does");
+    TEST_ASSERT(once, "Each visible pixel is written once, fewer than recorded");
+    
+    // Uncovered pixels are left alone and overlapping layers resolve in order
+    display_driver_clear_screen(&ctx, COLOR_RED);
+    game_render_list_begin(&list, &ctx);
+    game_render_list_rect(&list, 10, 10, 20, 20, COLOR_BLUE);
+    game_render_list_rect(&list, 15, 15, 20, 20, COLOR_WHITE);
+    game_render_list_rect(&list, -5, 230, 20, 40, COLOR_YELLOW);
+    game_render_list_rect(&list, 50, 50, 0, 10, COLOR_GREEN);
+    game_render_list_flush(&list);
+    TEST_ASSERT(display_driver_get_pixel(&ctx, 5, 5) == COLOR_RED && display_driver_get_pixel(&ctx, 10, 10) == COLOR_BLUE &&
+                display_driver_get_pixel(&ctx, 20, 20) == COLOR_WHITE &&
+                display_driver_get_pixel(&ctx, 34, 34) == COLOR_WHITE &&
+                display_driver_get_pixel(&ctx, 35, 35) == COLOR_RED &&
+                display_driver_get_pixel(&ctx, 0, 239) == COLOR_YELLOW &&
+                display_driver_get_pixel(&ctx, 50, 50) == COLOR_RED,
+                "Uncovered pixels stay and later rectangles win");
+    TEST_ASSERT(list.stats.commands == 3 && list.stats.visible_pixels == 400 + 400 - 225 + 15 * 10 &&
+                list.stats.written_pixels == list.stats.visible_pixels,
+                "Empty rectangles are dropped and overlaps counted once");
+    
+    // A full list flushes early and still produces the right frame
+    const int commands = GAME_RENDER_MAX_COMMANDS * 2 + 7;
+    display_driver_clear_screen(&ctx, COLOR_BLACK);
+    for (int i = 0; i < commands; i++) {
+        display_driver_draw_rectangle(&ctx, (i * 37) % 120, (i * 53) % 220, 15 + i % 9, 20, (uint16_t)(i * 997));
+    }
+    copy_render_frame(&ctx, render_expected);
+    display_driver_clear_screen(&ctx, COLOR_BLACK);
+    game_render_list_begin(&list, &ctx);
+    for (int i = 0; i < commands; i++) {
+        game_render_list_rect(&list, (i * 37) % 120, (i * 53) % 220, 15 + i % 9, 20, (uint16_t)(i * 997));
+    }
+    game_render_list_flush(&list);
+    TEST_ASSERT(render_mismatches(&ctx) == 0 && list.stats.commands == (uint32_t)commands,
+                "Overflowing list keeps the drawing order");
+    
+    display_driver_deinit(&ctx);
+    return 0;
+}
+
+int test_render_sprites_match_composition() {
+    printf("\n=== Headless Test: Sprites Match Composition ===\n");
+    
+    static game_render_list_t list;
+    static game_render_flush_scratch_t scratch;
+    game_render_list_init(&list, &scratch);
+    static game_render_sprite_cache_t cache;
+    display_context_t ctx;
+    TEST_ASSERT(display_driver_init(&ctx), "Display initializes");
+    TEST_ASSERT(game_render_sprite_cache_init(&cache, GAME_RENDER_SPRITE_DEFAULT_BUDGET), "Cache initializes");
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 777, ICE_PILLARS_RNG_COUNTER);
+    int frames = 0;
+    bool identical = true;
+    for (int frame = 0; frame < 900 && world.game.state == GAME_STATE_PLAYING; frame++) {
+        game_sim_world_step(&world, game_sim_policy_autopilot(&world, 1));
+        if (frame % 7 != 0) continue;
+        
+        game_render_list_begin(&list, &ctx);
+        game_render_scene(&list, &world, COLOR_DARK_BLUE);
+        game_render_list_flush(&list);
+        copy_render_frame(&ctx, render_expected);
+        
+        display_driver_clear_screen(&ctx, COLOR_RED);
+        game_render_scene_sprites(&cache, &ctx, &world, COLOR_DARK_BLUE);
+        identical = identical && render_mismatches(&ctx) == 0;
+        frames++;
+    }
+    TEST_ASSERT(frames > 50 && identical, "Blitting cached sprites draws the composed frames");
+    TEST_ASSERT(cache.stats.hits > cache.stats.misses && cache.stats.bytes <= GAME_RENDER_SPRITE_DEFAULT_BUDGET,
+                "Sprites are reused within the budget");
+    game_render_sprite_cache_deinit(&cache);
+    
+    // Sprites too large for the budget are composed in place instead
+    TEST_ASSERT(game_render_sprite_cache_init(&cache, 1024), "Small cache initializes");
+    game_sim_world_init_seeded(&world, 31, ICE_PILLARS_RNG_LCG);
+    for (int frame = 0; frame < 200; frame++) {
+        game_sim_world_step(&world, frame % 20 < 8);
+    }
+    game_render_list_begin(&list, &ctx);
+    game_render_scene(&list, &world, COLOR_DARK_BLUE);
+    game_render_list_flush(&list);
+    copy_render_frame(&ctx, render_expected);
+    display_driver_clear_screen(&ctx, COLOR_RED);
+    game_render_scene_sprites(&cache, &ctx, &world, COLOR_DARK_BLUE);
+    TEST_ASSERT(render_mismatches(&ctx) == 0 && cache.stats.bytes <= 1024,
+                "Sprites over the budget are composed in place");
+    
+    game_render_sprite_cache_deinit(&cache);
+    display_driver_deinit(&ctx);
+    return 0;
+}
+
+int test_render_bands_match_sprites() {
+    printf("\n=== Headless Test: Bands Match Sprites ===\n");
+    
+    static game_render_sprite_cache_t cache;
+    static game_render_band_renderer_t renderer;
+    static game_render_band_scene_t scene;
+    display_context_t ctx;
+    TEST_ASSERT(display_driver_init(&ctx), "Display initializes");
+    TEST_ASSERT(game_render_sprite_cache_init(&cache, GAME_RENDER_SPRITE_DEFAULT_BUDGET), "Cache initializes");
+    // As stated in the CONFIG_DISPLAY_DRIVER_BANDED help
+    TEST_ASSERT(sizeof(game_render_band_renderer_t) < 7 * 1024 + 512,
+                "The band renderer stays near 7.2 KB, buffers and display list included");
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 4242, ICE_PILLARS_RNG_COUNTER);
+    int frames = 0;
+    bool identical = true;
+    for (int frame = 0; frame < 900 && world.game.state == GAME_STATE_PLAYING; frame++) {
+        game_sim_world_step(&world, game_sim_policy_autopilot(&world, 1));
+        if (frame % 5 != 0) continue;
+        
+        // Text crossing band edges and the screen edges, lowercase and a newline
+        char score[32];
+        snprintf(score, sizeof(score), "Score: %d", frame);
+        game_render_scene_sprites(&cache, &ctx, &world, COLOR_DARK_BLUE);
+        display_driver_draw_text(&ctx, 4, 4, score, COLOR_WHITE);
+        display_driver_draw_text(&ctx, 100, 8 + frame % 240, "ab\ncd", COLOR_YELLOW);
+        display_driver_draw_text(&ctx, -3, 230, "edge", COLOR_RED);
+        copy_render_frame(&ctx, render_expected);
+        
+        display_driver_clear_screen(&ctx, COLOR_MAGENTA);
+        game_render_band_scene_begin(&scene, COLOR_DARK_BLUE);
+        game_render_band_scene_world(&scene, &world);
+        game_render_band_scene_text(&scene, 4, 4, score, COLOR_WHITE);
+        game_render_band_scene_text(&scene, 100, 8 + frame % 240, "ab\ncd", COLOR_YELLOW);
+        game_render_band_scene_text(&scene, -3, 230, "edge", COLOR_RED);
+        game_render_band_present(&renderer, &ctx, &scene);
+        identical = identical && render_mismatches(&ctx) == 0;
+        frames++;
+    }
+    TEST_ASSERT(frames > 50 && identical, "Banded frames match the sprite backend's");
+    TEST_ASSERT(renderer.bands_pushed ==
+                (uint32_t)frames * ((DISPLAY_HEIGHT + GAME_RENDER_BAND_ROWS - 1) / GAME_RENDER_BAND_ROWS),
+                "Every band of every frame is pushed");
+    
+    game_render_sprite_cache_deinit(&cache);
+    display_driver_deinit(&ctx);
+    return 0;
+}
+
+// Hardware scroll: shifts every row of the panel picture left, wrapping
+static void scroll_panel(uint16_t* panel, int shift) {
+    uint16_t row[DISPLAY_WIDTH];
+    for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+        uint16_t* line = &panel[y * DISPLAY_WIDTH];
+        for (int x = 0; x < DISPLAY_WIDTH; x++) {
+            row[x] = line[(x + shift) % DISPLAY_WIDTH];
+        }
+        memcpy(line, row, sizeof(row));
+    }
+}
+
+int test_render_scroll_plan_matches_full_redraw() {
+    printf("\n=== Headless Test: Scroll Plan Matches Full Redraw ===\n");
+    
+    static game_render_list_t list;
+    static game_render_flush_scratch_t scratch;
+    game_render_list_init(&list, &scratch);
+    display_context_t ctx;
+    TEST_ASSERT(display_driver_init(&ctx), "Display initializes");
+    
+    const game_render_scroll_axis_t axes[] = {GAME_RENDER_SCROLL_AXIS_X, GAME_RENDER_SCROLL_AXIS_Y};
+    for (int a = 0; a < 2; a++) {
+        game_world_t world, previous;
+        game_sim_world_init_seeded(&world, 99, ICE_PILLARS_RNG_COUNTER);
+        char texts[2][32];
+        display_text_t labels[2] = {{4, 4, COLOR_WHITE, texts[0]}, {4, 4, COLOR_WHITE, texts[1]}};
+        int scrolled = 0, still = 0, wrong_axis = 0, score_changes = 0;
+        uint64_t planned_pixels = 0;
+        bool identical = true;
+        bool first_only = true;
+        for (int frame = 0; frame < 1500; frame++) {
+            const display_text_t* label = &labels[frame % 2];
+            const display_text_t* previous_label = &labels[(frame + 1) % 2];
+            snprintf(texts[frame % 2], sizeof(texts[0]), "Score: %lu", (unsigned long)world.game.score);
+            
+            // Scroll the panel's last picture and redraw what the plan lists
+            game_render_scroll_plan_t plan;
+            bool ok = game_render_scroll_plan(&plan, frame ? &previous : NULL, previous_label, &world, label, axes[a]);
+            first_only = first_only && (frame == 0) == (plan.result == GAME_RENDER_SCROLL_FIRST);
+            if (ok) {
+                scroll_panel(render_expected, plan.shift);
+                display_driver_draw_bitmap(&ctx, 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, render_expected);
+                scrolled += plan.shift > 0;
+                still += plan.shift == 0;
+                score_changes += plan.shift > 0 && strcmp(label->text, previous_label->text) != 0;
+                planned_pixels += game_render_scroll_plan_pixels(&plan);
+            }
+            wrong_axis += plan.result == GAME_RENDER_SCROLL_WRONG_AXIS;
+            game_render_scroll_draw(&list, &ctx, &plan, &world, label, COLOR_DARK_BLUE);
+            copy_render_frame(&ctx, render_expected);
+            
+            display_driver_clear_screen(&ctx, COLOR_RED);
+            game_render_list_begin(&list, &ctx);
+            game_render_scene(&list, &world, COLOR_DARK_BLUE);
+            game_render_list_flush(&list);
+            display_driver_draw_text(&ctx, label->x, label->y, label->text, label->color);
+            identical = identical && render_mismatches(&ctx) == 0;
+            
+            previous = world;
+            if (!game_sim_world_step(&world, game_sim_policy_autopilot(&world, 5))) {
+                game_sim_world_init_seeded(&world, 100 + frame, ICE_PILLARS_RNG_COUNTER);
+            }
+        }
+        
+        TEST_ASSERT(first_only, "Only the first frame has nothing to scroll");
+        TEST_ASSERT(identical, "Scrolled frames with their redrawn regions match full redraws, score included");
+        // Short-path frames send under a tenth of the screen on average
+        TEST_ASSERT(still > 50 && planned_pixels * 10 < (uint64_t)(scrolled + still) * DISPLAY_WIDTH * DISPLAY_HEIGHT,
+                    "Planned frames send a fraction of the screen");
+        if (axes[a] == GAME_RENDER_SCROLL_AXIS_X) {
+            TEST_ASSERT(scrolled > 1000 && wrong_axis == 0, "Field motion scrolls along x-scan lines");
+            TEST_ASSERT(score_changes > 0, "The score changed on frames the panel scrolled");
+        } else {
+            // Rows of the portrait panel cannot follow the field
+            TEST_ASSERT(scrolled == 0 && wrong_axis > 1000, "Field motion falls back on the portrait panel");
+        }
+    }
+    
+    display_driver_deinit(&ctx);
+    return 0;
+}
+
+int test_sprite_cache_disabled_draws_directly() {
+    printf("\n=== Headless Test: Sprite Cache With No Budget ===\n");
+    
+    static game_render_sprite_cache_t cached, disabled;
+    TEST_ASSERT(!game_render_sprite_cache_init(&disabled, 0), "Zero budget reports the cache as disabled");
+    game_render_sprite_cache_init(&cached, GAME_RENDER_SPRITE_DEFAULT_BUDGET);
+    
+    display_context_t with_cache, without_cache;
+    display_driver_init(&with_cache);
+    display_driver_init(&without_cache);
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 7, ICE_PILLARS_RNG_COUNTER);
+    bool identical = true;
+    for (int frame = 0; frame < 120; frame++) {
+        game_sim_world_step(&world, game_sim_policy_autopilot(&world, 1));
+        game_render_scene_sprites(&cached, &with_cache, &world, COLOR_DARK_BLUE);
+        game_render_scene_sprites(&disabled, &without_cache, &world, COLOR_DARK_BLUE);
+        for (int y = 0; y < DISPLAY_HEIGHT; y++) {
+            for (int x = 0; x < DISPLAY_WIDTH; x++) {
+                uint16_t expected = display_driver_get_pixel(&with_cache, x, y);
+                identical = identical && display_driver_get_pixel(&without_cache, x, y) == expected;
+            }
+        }
+        display_driver_swap_buffers(&with_cache);
+        display_driver_swap_buffers(&without_cache);
+    }
+    TEST_ASSERT(identical, "Composing every object directly matches the cached sprites");
+    TEST_ASSERT(disabled.stats.hits == 0 && disabled.stats.sprites == 0 && disabled.stats.peak_bytes == 0,
+                "Disabled cache holds nothing");
+    
+    game_render_sprite_cache_deinit(&cached);
+    game_render_sprite_cache_deinit(&disabled);
+    display_driver_deinit(&with_cache);
+    display_driver_deinit(&without_cache);
+    return 0;
+}
+
+int test_batched_drawing_matches_single_calls() {
+    printf("\n=== Headless Test: Batched Drawing Matches Single Calls ===\n");
+    
+    display_context_t single, batched;
+    display_driver_init(&single);
+    display_driver_init(&batched);
+    
+    // Overlapping rectangles, some across or beyond every edge, in random order
+    static display_rect_t rects[500];
+    uint32_t seed = 12345;
+    auto next = [&seed](int range) {
+        seed = seed * 1664525u + 1013904223u;
+        return (int)((seed >> 8) % (uint32_t)range);
+    };
+    for (display_rect_t& rect : rects) {
+        rect.x = (int16_t)(next(DISPLAY_WIDTH + 60) - 30);
+        rect.y = (int16_t)(next(DISPLAY_HEIGHT + 60) - 30);
+        rect.width = (int16_t)(next(80) - 5);
+        rect.height = (int16_t)(next(80) - 5);
+        rect.color = (uint16_t)next(0x10000);
+    }
+    display_driver_clear_screen(&single, COLOR_DARK_BLUE);
+    display_driver_clear_screen(&batched, COLOR_DARK_BLUE);
+    for (const display_rect_t& rect : rects) {
+        display_driver_draw_rectangle(&single, rect.x, rect.y, rect.width, rect.height, rect.color);
+    }
+    display_driver_draw_rectangles(&batched, rects, 500);
+    TEST_ASSERT(memcmp(single.current_buffer, batched.current_buffer, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2) == 0,
+                "A batch of rectangles draws what the same rectangles drawn one by one do, in order");
+    
+    const display_text_t texts[] = {
+        {5, 5, COLOR_WHITE, "Score: 17"},
+        {-6, 100, COLOR_RED, "GAME OVER"},
+        {20, 120, COLOR_YELLOW, NULL},
+        {DISPLAY_WIDTH - 20, DISPLAY_HEIGHT - 4, COLOR_GREEN, "Two\nlines"},
+        {8, 8, COLOR_CYAN, "Score: 17"},
+    };
+    for (const display_text_t& text : texts) {
+        display_driver_draw_text(&single, text.x, text.y, text.text, text.color);
+    }
+    display_driver_draw_texts(&batched, texts, 5);
+    TEST_ASSERT(memcmp(single.current_buffer, batched.current_buffer, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2) == 0,
+                "A batch of texts draws what the same texts drawn one by one do, skipping empty entries");
+    
+    display_driver_draw_rectangles(&batched, NULL, 3);
+    display_driver_draw_rectangles(&batched, rects, 0);
+    display_driver_draw_texts(&batched, NULL, 2);
+    TEST_ASSERT(memcmp(single.current_buffer, batched.current_buffer, DISPLAY_WIDTH * DISPLAY_HEIGHT * 2) == 0,
+                "Empty batches draw nothing");
+    
+    display_driver_deinit(&single);
+    display_driver_deinit(&batched);
+    return 0;
+}
+
+int test_backends_null_and_recording() {
+    printf("\n=== Headless Test: Null And Recording Backends ===\n");
+    
+    static game_render_sprite_cache_t sprites;
+    game_render_sprite_cache_init(&sprites, GAME_RENDER_SPRITE_DEFAULT_BUDGET);
+    static uint16_t row[DISPLAY_WIDTH * 2];
+    for (int i = 0; i < DISPLAY_WIDTH * 2; i++) {
+        row[i] = (uint16_t)(i * 91);
+    }
+    auto draw_frame = [&](display_context_t* ctx, const game_world_t* world) {
+        game_render_scene_sprites(&sprites, ctx, world, COLOR_DARK_BLUE);
+        const display_rect_t bars[] = {{-3, 220, 50, 3, COLOR_RED}, {40, 221, 20, 10, COLOR_GREEN}};
+        display_driver_draw_rectangles(ctx, bars, 2);
+        display_driver_push_rows(ctx, 236, 2, row);
+        const display_text_t texts[] = {{4, 4, COLOR_WHITE, "Score: 7"}, {-5, 60, COLOR_YELLOW, "edge"}};
+        display_driver_draw_texts(ctx, texts, 2);
+    };
+    
+    display_context_t null_ctx, record_ctx, direct, replayed;
+    TEST_ASSERT(display_driver_init_backend(&null_ctx, &display_backend_null) &&
+                display_driver_init_backend(&record_ctx, &display_backend_record) && display_driver_init(&direct) &&
+                display_driver_init(&replayed), "Every backend initializes");
+    TEST_ASSERT(display_driver_get_backend(&direct) == &display_backend_sim &&
+                strcmp(display_driver_get_backend(&null_ctx)->name, "null") == 0,
+                "Plain init picks the simulator backend");
+    display_context_t uninitialized = {};
+    TEST_ASSERT(display_driver_blits_bitmaps(&null_ctx) && display_driver_blits_bitmaps(&record_ctx) &&
+                display_driver_blits_bitmaps(&direct) && !display_driver_blits_bitmaps(&uninitialized),
+                "Each backend answers whether it blits bitmaps");
+    
+    game_world_t world;
+    game_sim_world_init_seeded(&world, 5, ICE_PILLARS_RNG_COUNTER);
+    const int frames = 60;
+    bool identical = true;
+    bool faithful = true;
+    for (int frame = 0; frame < frames; frame++) {
+        game_sim_world_step(&world, game_sim_policy_autopilot(&world, 1));
+        draw_frame(&null_ctx, &world);
+        draw_frame(&record_ctx, &world);
+        draw_frame(&direct, &world);
+        
+        // Replay the frame's calls into a second simulator context
+        display_recording_t recording;
+        display_backend_get_recording(&record_ctx, &recording);
+        faithful = faithful && recording.dropped == 0;
+        display_backend_replay(&recording, &replayed);
+        display_backend_clear_recording(&record_ctx);
+        identical = identical && memcmp(direct.current_buffer, replayed.current_buffer,
+                                        DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t)) == 0;
+        
+        display_driver_swap_buffers(&null_ctx);
+        display_driver_swap_buffers(&record_ctx);
+        display_driver_swap_buffers(&direct);
+        display_driver_swap_buffers(&replayed);
+    }
+    TEST_ASSERT(faithful && identical, "Replaying recorded calls draws the same frames as drawing them directly");
+    
+    display_call_counts_t null_counts, record_counts, none;
+    display_backend_get_counts(&null_ctx, &null_counts);
+    display_backend_get_counts(&record_ctx, &record_counts);
+    TEST_ASSERT(null_counts.clears == (uint64_t)frames && null_counts.swaps == (uint64_t)frames &&
+                null_counts.texts == 2u * frames && null_counts.rectangles >= 2u * frames &&
+                null_counts.bitmaps > (uint64_t)frames && null_counts.flushes == 0,
+                "Null backend counts every call, batch entries included");
+    TEST_ASSERT(memcmp(&null_counts, &record_counts, sizeof(null_counts)) == 0,
+                "Recording backend counts the same calls");
+    TEST_ASSERT(!display_backend_get_counts(&direct, &none) && none.clears == 0,
+                "Simulator contexts have no call counts");
+    TEST_ASSERT(display_driver_get_pixel(&null_ctx, 10, 10) == 0 && null_ctx.front_buffer == NULL,
+                "Null backend has no pixels");
+    
+    display_target_t target = {test_target_lock, test_target_unlock, NULL};
+    display_dirty_stats_t stats;
+    display_driver_sim_get_dirty_stats(&null_ctx, &stats);
+    TEST_ASSERT(!display_driver_sim_set_target(&null_ctx, &target) && stats.frames == 0,
+                "Simulator extensions ignore other backends");
+    
+    game_render_sprite_cache_deinit(&sprites);
+    display_driver_deinit(&null_ctx);
+    display_driver_deinit(&record_ctx);
+    display_driver_deinit(&direct);
+    display_driver_deinit(&replayed);
+    TEST_ASSERT(display_driver_get_backend(&record_ctx) == NULL, "Deinit releases the backend");
+    return 0;
+}
+
+int test_frame_dump_formats_and_drops() {
+    printf("\n=== Headless Test: Frame Dump Formats And Drops ===\n");
+    
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "penguin_frame_dump_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    
+    static uint16_t frame[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    const uint16_t colors[] = {COLOR_RED, COLOR_GREEN, COLOR_WHITE};
+    
+    // PPM: one file per frame; a ring deep enough for every frame drops none
+    frame_dump ppm;
+    TEST_ASSERT(frame_dump::format_for(directory.string().c_str()) == FRAME_DUMP_PPM &&
+                ppm.open(directory.string().c_str(), FRAME_DUMP_PPM, 4), "PPM dump opens on a directory");
+    for (uint16_t color : colors) {
+        for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
+            frame[i] = color;
+        }
+        frame[DISPLAY_WIDTH + 1] = COLOR_BLACK;
+        ppm.submit(frame);
+    }
+    ppm.close();
+    frame_dump_stats_t stats = ppm.stats();
+    TEST_ASSERT(stats.submitted == 3 && stats.written == 3 && stats.dropped == 0, "Closing writes every queued frame");
+    
+    const uint8_t expected[][3] = {{255, 0, 0}, {0, 255, 0}, {255, 255, 255}};
+    bool pixels_match = true;
+    for (int f = 0; f < 3; f++) {
+        char name[32];
+        snprintf(name, sizeof(name), "frame_%06d.ppm", f);
+        FILE* file = fopen((directory / name).string().c_str(), "rb");
+        if (!file) return 1;
+        int width = 0, height = 0, max = 0;
+        pixels_match = pixels_match && fscanf(file, "P6 %d %d %d", &width, &height, &max) == 3 &&
+                       width == DISPLAY_WIDTH && height == DISPLAY_HEIGHT && max == 255;
+        fgetc(file);
+        std::vector<uint8_t> rgb((size_t)width * height * 3);
+        pixels_match = pixels_match && fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+        fclose(file);
+        pixels_match = pixels_match && memcmp(&rgb[0], expected[f], 3) == 0 &&
+                       rgb[(DISPLAY_WIDTH + 1) * 3] == 0 && rgb[(DISPLAY_WIDTH + 1) * 3 + 1] == 0;
+    }
+    TEST_ASSERT(pixels_match, "PPM frames hold the RGB565 frames expanded to RGB888");
+    
+    // Y4M: flooding a two-frame ring never blocks; whatever does not fit is dropped
+    std::string stream_path = (directory / "run.y4m").string();
+    frame_dump y4m;
+    TEST_ASSERT(frame_dump::format_for(stream_path.c_str()) == FRAME_DUMP_Y4M &&
+                y4m.open(stream_path.c_str(), FRAME_DUMP_Y4M, 2), "Y4M dump opens a stream");
+    for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
+        frame[i] = (i < DISPLAY_WIDTH) ? COLOR_WHITE : COLOR_BLACK;
+    }
+    const int submitted = 500;
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < submitted; f++) {
+        y4m.submit(frame);
+    }
+    double submit_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    y4m.close();
+    stats = y4m.stats();
+    printf("%d submits in %.3f ms, %lu written, %lu dropped\n", submitted, submit_seconds * 1000.0,
+           (unsigned long)stats.written, (unsigned long)stats.dropped);
+    TEST_ASSERT(stats.submitted == (uint64_t)submitted && stats.written + stats.dropped == (uint64_t)submitted &&
+                stats.written >= 2 && stats.write_errors == 0, "Every frame is either written or counted as dropped");
+    TEST_ASSERT(!y4m.submit(frame) && y4m.stats().submitted == (uint64_t)submitted, "A closed dump takes no frames");
+    
+    FILE* stream = fopen(stream_path.c_str(), "rb");
+    if (!stream) return 1;
+    char header[64] = {0};
+    bool stream_ok = fgets(header, sizeof(header), stream) != NULL &&
+                     strcmp(header, "YUV4MPEG2 W135 H240 F60:1 Ip A1:1 C444\n") == 0;
+    char marker[7] = {0};
+    stream_ok = stream_ok && fread(marker, 1, 6, stream) == 6 && strcmp(marker, "FRAME\n") == 0;
+    std::vector<uint8_t> planes((size_t)DISPLAY_WIDTH * DISPLAY_HEIGHT * 3);
+    stream_ok = stream_ok && fread(planes.data(), 1, planes.size(), stream) == planes.size();
+    fseek(stream, 0, SEEK_END);
+    long size = ftell(stream);
+    fclose(stream);
+    const size_t frame_bytes = 6 + planes.size();
+    stream_ok = stream_ok && size == (long)(strlen(header) + stats.written * frame_bytes);
+    const size_t u = (size_t)DISPLAY_WIDTH * DISPLAY_HEIGHT;
+    TEST_ASSERT(stream_ok && planes[0] == 235 && planes[DISPLAY_WIDTH] == 16 && planes[u] == 128 &&
+                planes[2 * u] == 128, "Y4M stream holds 4:4:4 BT.601 frames of the dumped size");
+    
+    std::filesystem::remove_all(directory);
+    return 0;
+}
+
+int test_st7789_emulator_decodes_driver_stream() {
+    printf("\n=== Headless Test: ST7789 Emulator Decodes Driver Stream ===\n");
+    
+    st7789_emulator_config_t config = {40000000, 0};
+    st7789_emulator_reset(&config);
+    TEST_ASSERT(display_st7789_open(), "Panel opens on the emulated bus");
+    
+    st7789_emulator_panel_t panel;
+    st7789_emulator_get_panel(&panel);
+    TEST_ASSERT(!panel.sleeping && panel.display_on && panel.colmod == ST7789_COLMOD_RGB565 && panel.resets == 2,
+                "Init sequence resets, wakes and turns on the panel in RGB565");
+    TEST_ASSERT(display_st7789_read_register(ST7789_RDDID) == 0x85 &&
+                (display_st7789_read_register(ST7789_RDDPM) & 0x14) == 0x14 &&
+                display_st7789_read_register(ST7789_RDDCOLMOD) == ST7789_COLMOD_RGB565,
+                "Register reads report the panel state");
+    
+    // Area in panel byte order lands at the panel offset, row by row
+    const int width = 5, height = 3;
+    uint16_t pixels[width * height];
+    for (int i = 0; i < width * height; i++) {
+        uint16_t color = (uint16_t)(0x1234 + i * 0x0101);
+        pixels[i] = (uint16_t)((color >> 8) | (color << 8));
+    }
+    st7789_emulator_clear_stats();
+    display_st7789_write_area(10, 20, width, height, pixels);
+    
+    bool gram_matches = true;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint16_t expected = (uint16_t)(0x1234 + (y * width + x) * 0x0101);
+            gram_matches &= st7789_emulator_gram_pixel(DISPLAY_OFFSET_X + 10 + x, DISPLAY_OFFSET_Y + 20 + y) == expected;
+        }
+    }
+    gram_matches &= st7789_emulator_gram_pixel(DISPLAY_OFFSET_X + 10 + width, DISPLAY_OFFSET_Y + 20) == 0;
+    TEST_ASSERT(gram_matches, "Written area lands in GRAM at the display offset");
+    
+    // CASET + 4, RASET + 4, RAMWR + pixels: six transactions
+    st7789_emulator_stats_t stats;
+    st7789_emulator_get_stats(&stats);
+    uint64_t bytes = stats.command_bytes + stats.parameter_bytes + stats.pixel_bytes;
+    TEST_ASSERT(stats.transactions == 6 && stats.command_bytes == 3 && stats.parameter_bytes == 8 &&
+                stats.pixel_bytes == (uint64_t)width * height * 2 && stats.pixels == (uint64_t)width * height,
+                "Counters split commands, parameters and pixels");
+    // 25 ns per bit at 40 MHz
+    TEST_ASSERT(stats.bus_ns == bytes * 8 * 25, "Bus time follows the bits moved at the configured clock");
+    
+    config.transaction_overhead_ns = 10000;
+    st7789_emulator_reset(&config);
+    TEST_ASSERT(display_st7789_open(), "Panel reopens after an emulator reset");
+    st7789_emulator_clear_stats();
+    display_st7789_write_area(10, 20, width, height, pixels);
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(stats.bus_ns == bytes * 8 * 25 + 6 * 10000, "Each transaction adds the configured overhead");
+    
+    // A whole frame in one area exceeds the bus's max transfer and is refused
+    static uint16_t frame[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    st7789_emulator_clear_stats();
+    display_st7789_write_area(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, frame);
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(stats.errors == 1 && stats.pixels == 0, "Oversized transfers are rejected");
+    
+    display_st7789_close();
+    return 0;
+}
+
+static void count_st7789_flush(void* arg) {
+    (*(int*)arg)++;
+}
+
+int test_st7789_queued_flush_overlaps_rendering() {
+    printf("\n=== Headless Test: ST7789 Queued Flush Overlaps Rendering ===\n");
+    
+    st7789_emulator_config_t config = {40000000, 10000};
+    st7789_emulator_reset(&config);
+    TEST_ASSERT(display_st7789_open(), "Panel opens on the emulated bus");
+    
+    const int rows = 24;
+    static uint16_t chunk[DISPLAY_WIDTH * 24];
+    for (int i = 0; i < DISPLAY_WIDTH * rows; i++) {
+        chunk[i] = (uint16_t)((COLOR_ICE_BLUE >> 8) | (COLOR_ICE_BLUE << 8));
+    }
+    
+    // Queueing returns before the bus has moved anything
+    int flushed = 0;
+    st7789_emulator_clear_stats();
+    uint64_t start = st7789_emulator_now_ns();
+    TEST_ASSERT(display_st7789_queue_area(0, 0, DISPLAY_WIDTH, rows, chunk, count_st7789_flush, &flushed),
+                "Area queues");
+    st7789_emulator_stats_t stats;
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(st7789_emulator_now_ns() == start && stats.transactions == 0 && flushed == 0,
+                "Queueing does not wait for the bus");
+    
+    // Rendering the next chunk while the bus works: done fires once, from
+    // the last transaction, with DC driven by the pre-transaction hook
+    st7789_emulator_advance(100000000);
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(flushed == 1 && stats.transactions == 6 && stats.queued == 6 && stats.command_bytes == 3 &&
+                stats.parameter_bytes == 8 && stats.pixels == (uint64_t)DISPLAY_WIDTH * rows,
+                "Completion fires after the whole area is sent");
+    TEST_ASSERT(st7789_emulator_gram_pixel(DISPLAY_OFFSET_X, DISPLAY_OFFSET_Y) == COLOR_ICE_BLUE &&
+                st7789_emulator_gram_pixel(DISPLAY_OFFSET_X + DISPLAY_WIDTH - 1, DISPLAY_OFFSET_Y + rows - 1) ==
+                COLOR_ICE_BLUE, "Queued area lands in GRAM");
+    
+    // Back to back without waiting. The repeated area needs no window, and
+    // the one below it continues the memory write with RAMWRC.
+    st7789_emulator_clear_stats();
+    display_st7789_queue_area(0, 0, DISPLAY_WIDTH, rows, chunk, count_st7789_flush, &flushed);
+    display_st7789_queue_area(0, rows, DISPLAY_WIDTH, rows, chunk, count_st7789_flush, &flushed);
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(flushed == 1 && stats.transactions == 0 && stats.errors == 0, "Areas queue back to back");
+    display_st7789_wait_idle();
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(flushed == 3 && stats.transactions == 4 && stats.command_bytes == 2 && stats.parameter_bytes == 0,
+                "Cached window and write continuation leave two transactions per area");
+    TEST_ASSERT(st7789_emulator_gram_pixel(DISPLAY_OFFSET_X, DISPLAY_OFFSET_Y + rows) == COLOR_ICE_BLUE &&
+                st7789_emulator_gram_pixel(DISPLAY_OFFSET_X + DISPLAY_WIDTH - 1, DISPLAY_OFFSET_Y + 2 * rows - 1) ==
+                COLOR_ICE_BLUE && st7789_emulator_gram_pixel(DISPLAY_OFFSET_X, DISPLAY_OFFSET_Y + 2 * rows) == 0,
+                "Continued write lands right below the previous area");
+    
+    // A narrower area resends the columns and rows
+    st7789_emulator_clear_stats();
+    display_st7789_write_area(10, rows, 20, 2, chunk);
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(stats.transactions == 6 && st7789_emulator_gram_pixel(DISPLAY_OFFSET_X + 10, DISPLAY_OFFSET_Y + rows) ==
+                COLOR_ICE_BLUE, "Changed columns set a new window");
+    
+    // Blocking calls after queued ones collect them first
+    display_st7789_queue_area(0, 0, DISPLAY_WIDTH, rows, chunk, count_st7789_flush, &flushed);
+    TEST_ASSERT(display_st7789_read_register(ST7789_RDDCOLMOD) == ST7789_COLMOD_RGB565 && flushed == 4,
+                "Register reads wait for queued areas");
+    st7789_emulator_get_stats(&stats);
+    TEST_ASSERT(stats.errors == 0, "No transaction was refused");
+    
+    display_st7789_close();
+    return 0;
+}
+
+int test_lvgl_pool_reuses_objects() {
+    printf("\n=== Headless Test: LVGL Pool Reuses Objects ===\n");
+    
+    lv_init();
+    TEST_ASSERT(display_lvgl_pool_init(lv_scr_act()), "Pool creates its layers");
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    uint32_t empty_heap = mem.total_size - mem.free_size;
+    
+    const display_rect_t rects[3] = {
+        {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_DARK_BLUE},
+        {40, 0, 30, 80, COLOR_ICE_BLUE},
+        {20, 100, 20, 20, COLOR_YELLOW}
+    };
+    for (int frame = 0; frame < 2; frame++) {
+        lvgl_emulator_clear_stats();
+        display_lvgl_pool_begin_frame();
+        for (int i = 0; i < 3; i++) {
+            display_lvgl_pool_rect(rects[i].x, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
+        }
+        display_lvgl_pool_text(4, 4, "Score: 1", COLOR_WHITE);
+        display_lvgl_pool_end_frame();
+        lv_timer_handler();
+    }
+    
+    display_lvgl_pool_stats_t stats;
+    display_lvgl_pool_get_stats(&stats);
+    lvgl_emulator_stats_t lvgl_stats;
+    lvgl_emulator_get_stats(&lvgl_stats);
+    TEST_ASSERT(stats.created == 4 && stats.rects == 3 && stats.labels == 1, "First frame creates one object per draw");
+    TEST_ASSERT(lvgl_stats.objects == 1 + 2 + 4, "Screen, two layers and the drawn objects exist");
+    TEST_ASSERT(lvgl_stats.property_writes == 0 && lvgl_stats.invalidations == 0 && lvgl_stats.refreshes == 0,
+                "An unchanged frame sets nothing and redraws nothing");
+    
+    // A smaller frame hides the objects it did not draw with
+    lvgl_emulator_clear_stats();
+    display_lvgl_pool_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
+    display_lvgl_pool_end_frame();
+    display_lvgl_pool_get_stats(&stats);
+    lvgl_emulator_get_stats(&lvgl_stats);
+    TEST_ASSERT(stats.created == 4 && stats.hidden == 3, "Unused objects are hidden, not deleted");
+    TEST_ASSERT(lvgl_stats.property_writes == 1 + 3, "Only the color and the hidden flags are set");
+    TEST_ASSERT(lv_obj_get_child_cnt(lv_scr_act()) == 2, "Objects sit on the layers");
+    
+    // Frames alternating in size settle: no more objects, no more heap
+    lv_mem_monitor(&mem);
+    uint32_t settled_max = mem.max_used;
+    for (int frame = 0; frame < 1000; frame++) {
+        char text[16];
+        snprintf(text, sizeof(text), "Score: %d", frame / 60);
+        int count = (frame % 2) ? 3 : 1;
+        for (int i = 0; i < count; i++) {
+            display_lvgl_pool_rect(rects[i].x + frame % 5, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
+        }
+        display_lvgl_pool_text(4, 4, text, COLOR_WHITE);
+        display_lvgl_pool_end_frame();
+        lv_timer_handler();
+    }
+    display_lvgl_pool_get_stats(&stats);
+    lv_mem_monitor(&mem);
+    TEST_ASSERT(stats.created == 4 && mem.max_used == settled_max, "Objects and heap stay flat");
+    
+    // A frame without a clear, like the game over texts, draws over the last
+    // cleared frame instead of replacing it
+    display_lvgl_pool_clear();
+    for (int i = 0; i < 3; i++) {
+        display_lvgl_pool_rect(rects[i].x, rects[i].y, rects[i].width, rects[i].height, rects[i].color);
+    }
+    display_lvgl_pool_text(4, 4, "Score: 9", COLOR_WHITE);
+    display_lvgl_pool_end_frame();
+    display_lvgl_pool_get_stats(&stats);
+    uint32_t hidden = stats.hidden;
+    for (int frame = 0; frame < 10; frame++) {
+        display_lvgl_pool_text(10, 100, "Game Over", COLOR_WHITE);
+        display_lvgl_pool_end_frame();
+    }
+    display_lvgl_pool_get_stats(&stats);
+    TEST_ASSERT(stats.hidden == hidden, "Overlay frames hide nothing the cleared frame drew");
+    TEST_ASSERT(stats.created == 5 && stats.labels == 2, "Repeated overlay frames reuse one object");
+    
+    // The next cleared frame hides what it does not draw again, overlay included
+    display_lvgl_pool_clear();
+    display_lvgl_pool_rect(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
+    display_lvgl_pool_end_frame();
+    display_lvgl_pool_get_stats(&stats);
+    TEST_ASSERT(stats.hidden == hidden + 2 + 2, "Cleared frame hides the rest");
+    
+    // Draws past the pool are dropped
+    display_lvgl_pool_clear();
+    for (int i = 0; i <= DISPLAY_LVGL_POOL_RECTS; i++) {
+        bool drawn = display_lvgl_pool_rect(i % DISPLAY_WIDTH, 0, 1, 1, COLOR_RED);
+        if (i == DISPLAY_LVGL_POOL_RECTS) {
+            TEST_ASSERT(!drawn, "Rectangle past the pool is not drawn");
+        }
+    }
+    display_lvgl_pool_end_frame();
+    display_lvgl_pool_get_stats(&stats);
+    TEST_ASSERT(stats.dropped == 1 && stats.rects == DISPLAY_LVGL_POOL_RECTS, "Pool holds at most its size");
+    
+    display_lvgl_pool_deinit();
+    lvgl_emulator_get_stats(&lvgl_stats);
+    lv_mem_monitor(&mem);
+    TEST_ASSERT(lvgl_stats.objects == 1 && mem.total_size - mem.free_size < empty_heap,
+                "Deinit deletes the layers and everything on them");
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     (void)argc;
     (void)argv;
@@ -218,6 +1863,32 @@ int main(int argc, char* argv[]) {
     result |= test_visual_rendering();
     result |= test_collision_scenarios();
     result |= test_performance_simulation();
+    result |= test_batched_worlds_match_scalar();
+    result |= test_physics_kernels_match_scalar();
+    result |= test_physics_advance_matches_stepping();
+    result |= test_pillar_rng_per_world();
+    result |= test_episode_runner_pool();
+    result |= test_snapshot_rollback();
+    result |= test_replay_record_and_play();
+    result |= test_replay_recorder_concurrent_drain();
+    result |= test_event_driven_matches_frame_loop();
+    result |= test_seed_solver_bounds_real_games();
+    result |= test_seed_solver_witness_replays();
+    result |= test_fill_kernels_match_scalar();
+    result |= test_dirty_areas_cover_changes();
+    result |= test_text_spans_match_glyph_bits();
+    result |= test_target_rendering_matches_buffers();
+    result |= test_render_list_matches_direct_drawing();
+    result |= test_render_sprites_match_composition();
+    result |= test_render_bands_match_sprites();
+    result |= test_render_scroll_plan_matches_full_redraw();
+    result |= test_sprite_cache_disabled_draws_directly();
+    result |= test_batched_drawing_matches_single_calls();
+    result |= test_backends_null_and_recording();
+    result |= test_frame_dump_formats_and_drops();
+    result |= test_st7789_emulator_decodes_driver_stream();
+    result |= test_st7789_queued_flush_overlaps_rendering();
+    result |= test_lvgl_pool_reuses_objects();
     
     if (result == 0) {
         printf("\n=== ALL TESTS PASSED ===\n");
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool for host-side batch jobs whose items vary wildly in cost.
+// parallel_for() splits [0, count) into fixed-size chunks dealt round-robin to
+// per-worker deques. A worker pops chunks from the back of its own deque and,
+// once it runs dry, steals from the front of a victim's deque, so long items on
+// one core never strand work queued behind them. No new work is created while a
+// job runs, so a worker that finds every deque empty can exit.
+
+typedef struct {
+    double busy_seconds;         // Time spent inside the job body
+    uint64_t chunks;
+    uint64_t items;
+    uint64_t steals;
+} work_stealing_worker_stats_t;
+
+class work_stealing_pool {
+public:
+    explicit work_stealing_pool(unsigned thread_count)
+        : thread_count_(thread_count ? thread_count : default_thread_count()),
+          workers_(thread_count_) {}
+    
+    static unsigned default_thread_count() {
+        unsigned count = std::thread::hardware_concurrency();
+        return count ? count : 1;
+    }
+    
+    unsigned thread_count() const { return thread_count_; }
+    
+    // Runs body(begin, end, worker_index) over every chunk of [0, count) and
+    // returns the wall time of the whole job in seconds
+    template <typename Body>
+    double parallel_for(uint64_t count, uint64_t chunk_size, Body body) {
+        if (chunk_size == 0) chunk_size = 1;
+        
+        for (unsigned w = 0; w < thread_count_; w++) {
+            workers_[w].chunks.clear();
+            workers_[w].stats = work_stealing_worker_stats_t{};
+        }
+        
+        uint64_t chunk_index = 0;
+        for (uint64_t begin = 0; begin < count; begin += chunk_size, chunk_index++) {
+            chunk_t chunk = {begin, std::min(count, begin + chunk_size)};
+            workers_[chunk_index % thread_count_].chunks.push_back(chunk);
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count_);
+        for (unsigned w = 0; w < thread_count_; w++) {
+            threads.emplace_back([this, w, &body] { run_worker(w, body); });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    const work_stealing_worker_stats_t& stats(unsigned worker) const {
+        return workers_[worker].stats;
+    }
+
+private:
+    struct chunk_t {
+        uint64_t begin;
+        uint64_t end;
+    };
+    
+    // Padded to a cache line so workers never share one
+    struct alignas(64) worker_t {
+        std::mutex lock;
+        std::deque<chunk_t> chunks;
+        work_stealing_worker_stats_t stats;
+    };
+    
+    bool pop_local(unsigned w, chunk_t* chunk) {
+        std::lock_guard<std::mutex> guard(workers_[w].lock);
+        if (workers_[w].chunks.empty()) return false;
+        *chunk = workers_[w].chunks.back();
+        workers_[w].chunks.pop_back();
+        return true;
+    }
+    
+    bool steal(unsigned thief, uint32_t* rng, chunk_t* chunk) {
+        // Start at a random victim so thieves spread out instead of all
+        // hammering the same neighbour
+        *rng = *rng * 1664525u + 1013904223u;
+        unsigned first = (*rng >> 8) % thread_count_;
+        
+        for (unsigned i = 0; i < thread_count_; i++) {
+            unsigned victim = (first + i) % thread_count_;
+            if (victim == thief) continue;
+            
+            std::lock_guard<std::mutex> guard(workers_[victim].lock);
+            if (workers_[victim].chunks.empty()) continue;
+            *chunk = workers_[victim].chunks.front();
+            workers_[victim].chunks.pop_front();
+            return true;
+        }
+        return false;
+    }
+    
+    template <typename Body>
+    void run_worker(unsigned w, Body& body) {
+        work_stealing_worker_stats_t stats = {};
+        uint32_t rng = 0x9E3779B9u * (w + 1);
+        chunk_t chunk;
+        
+        for (;;) {
+            if (!pop_local(w, &chunk)) {
+                if (!steal(w, &rng, &chunk)) break;
+                stats.steals++;
+            }
+            
+            auto start = std::chrono::steady_clock::now();
+            body(chunk.begin, chunk.end, w);
+            stats.busy_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            stats.chunks++;
+            stats.items += chunk.end - chunk.begin;
+        }
+        
+        workers_[w].stats = stats;
+    }
+    
+    unsigned thread_count_;
+    std::vector<worker_t> workers_;
+};